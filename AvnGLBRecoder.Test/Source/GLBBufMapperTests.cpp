@@ -0,0 +1,298 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include "RecoderTestUtils.h"
+
+#include <GLTFSDK/Deserialize.h>
+#include <GLTFSDK/ExtensionsKHR.h>
+
+using namespace glTF::UnitTest;
+using namespace Test;
+
+namespace
+{
+    std::unique_ptr<GLBBufMapper> LoadGLB(const std::filesystem::path& sourcePath, const std::shared_ptr<const IImageTranscoder>& transcoder, Document& document)
+    {
+        auto glbReader = std::make_shared<GLBResourceReader>(std::make_shared<StreamReader>(sourcePath.parent_path()), std::make_shared<std::ifstream>(sourcePath, std::ios_base::binary));
+        document = Deserialize(glbReader->GetJson(), KHR::GetKHRExtensionDeserializer());
+
+        auto bufMapper = std::make_unique<GLBBufMapper>(sourcePath, glbReader, transcoder);
+        bufMapper->LoadDocument(document);
+        return bufMapper;
+    }
+
+    void RecodeGLB(const std::filesystem::path& sourcePath, const std::filesystem::path& recodedPath, const std::shared_ptr<const IImageTranscoder>& transcoder)
+    {
+        Document document;
+        auto bufMapper = LoadGLB(sourcePath, transcoder, document);
+        bufMapper->RecodeImages(document, 2U);
+        bufMapper->SaveNewGLB(document, recodedPath);
+    }
+
+    // Writes a GLB with an image in its own buffer view and another whose buffer view is aliased or overlapped by a second
+    // buffer view. When 'alias' is true the second view has exactly the same range and is used by a third image, otherwise
+    // it covers the end of the image and the start of the other data that follows it.
+    void CreateOverlappingGLB(const std::filesystem::path& path, bool alias)
+    {
+        auto bufferBuilder = BufferBuilder(std::make_unique<GLBResourceWriter>(std::make_shared<StreamWriter>(path.parent_path())));
+
+        bufferBuilder.AddBuffer(GLB_BUFFER_ID);
+
+        Document document;
+
+        AddImage(document, bufferBuilder.AddBufferView(imageData1).id);
+
+        const BufferView shared = bufferBuilder.AddBufferView(imageData0);
+        AddImage(document, shared.id);
+
+        bufferBuilder.AddBufferView(otherData);
+        bufferBuilder.Output(document);
+
+        BufferView bufferView;
+        bufferView.bufferId = shared.bufferId;
+        bufferView.byteOffset = alias ? shared.byteOffset : shared.byteOffset + 4U;
+        bufferView.byteLength = alias ? shared.byteLength : 5U;
+
+        auto& overlapping = document.bufferViews.Append(std::move(bufferView), AppendIdPolicy::GenerateOnEmpty);
+        if (alias)
+        {
+            AddImage(document, overlapping.id);
+        }
+
+        WriteGLB(bufferBuilder, document, path);
+    }
+}
+
+namespace Test
+{
+    GLTFSDK_TEST_CLASS(GLBBufMapperTests)
+    {
+        GLTFSDK_TEST_METHOD(GLBBufMapperTests, GLBBufMapper_RecodeImages)
+        {
+            const auto folder = std::filesystem::temp_directory_path() / "GLBBufMapperTests";
+            std::filesystem::create_directories(folder);
+
+            const auto sourcePath = folder / "source.glb";
+            const auto recodedPath = folder / "recoded.glb";
+
+            CreateGLB(sourcePath);
+
+            auto transcoder = std::make_shared<FakeTranscoder>();
+            RecodeGLB(sourcePath, recodedPath, transcoder);
+
+            // The duplicate image is only transcoded once
+            Assert::AreEqual<size_t>(2U, transcoder->GetTranscodeCount());
+
+            {
+                GLBResourceReader recodedReader(std::make_shared<StreamReader>(folder), std::make_shared<std::ifstream>(recodedPath, std::ios_base::binary));
+                auto recoded = Deserialize(recodedReader.GetJson(), KHR::GetKHRExtensionDeserializer());
+
+                // The duplicate image's buffer view is dropped and both images share the one that's kept
+                Assert::AreEqual<size_t>(3U, recoded.bufferViews.Size());
+                Assert::AreEqual(recoded.images[0].bufferViewId, recoded.images[1].bufferViewId);
+
+                const std::vector<const std::vector<uint8_t>*> expectedData = { &imageData0, &imageData0, &imageData1 };
+
+                for (size_t i = 0U; i < recoded.images.Size(); i++)
+                {
+                    Assert::AreEqual(std::string("image/ktx2"), recoded.images[i].mimeType);
+                    Assert::IsTrue(FakeTranscoder::Transcode(*expectedData[i]) == recodedReader.ReadBinaryData(recoded, recoded.images[i]));
+
+                    const auto& extension = recoded.textures[i].GetExtension<KHR::Textures::TextureBasisU>();
+                    Assert::AreEqual(recoded.images[i].id, extension.imageId);
+                }
+
+                Assert::IsTrue(otherData == recodedReader.ReadBinaryData<uint8_t>(recoded, recoded.bufferViews[2]));
+
+                Assert::IsTrue(recoded.extensionsRequired.count(KHR::Textures::TEXTUREBASISU_NAME) > 0U);
+            }
+
+            std::filesystem::remove_all(folder);
+        }
+
+        GLTFSDK_TEST_METHOD(GLBBufMapperTests, GLBBufMapper_RecodeImagesWithExtensions)
+        {
+            const auto folder = std::filesystem::temp_directory_path() / "GLBBufMapperTests";
+            std::filesystem::create_directories(folder);
+
+            const auto sourcePath = folder / "source.glb";
+            const auto recodedPath = folder / "recoded.glb";
+
+            // The duplicate image's buffer view is still dropped when a known extension is used...
+            CreateGLB(sourcePath, KHR::Materials::UNLIT_NAME);
+            RecodeGLB(sourcePath, recodedPath, std::make_shared<FakeTranscoder>());
+
+            {
+                GLBResourceReader recodedReader(std::make_shared<StreamReader>(folder), std::make_shared<std::ifstream>(recodedPath, std::ios_base::binary));
+                auto recoded = Deserialize(recodedReader.GetJson(), KHR::GetKHRExtensionDeserializer());
+
+                Assert::AreEqual<size_t>(3U, recoded.bufferViews.Size());
+                Assert::AreEqual(recoded.images[0].bufferViewId, recoded.images[1].bufferViewId);
+
+                // Re-encoded images are only referred to by the extension, never by the core source
+                for (const auto& texture : recoded.textures.Elements())
+                {
+                    Assert::IsTrue(texture.imageId.empty());
+                    Assert::IsTrue(texture.HasExtension<KHR::Textures::TextureBasisU>());
+                }
+            }
+
+            // ...but kept when an unknown extension might refer to it
+            CreateGLB(sourcePath, "EXT_unknown");
+            RecodeGLB(sourcePath, recodedPath, std::make_shared<FakeTranscoder>());
+
+            {
+                GLBResourceReader recodedReader(std::make_shared<StreamReader>(folder), std::make_shared<std::ifstream>(recodedPath, std::ios_base::binary));
+                auto recoded = Deserialize(recodedReader.GetJson(), KHR::GetKHRExtensionDeserializer());
+
+                Assert::AreEqual<size_t>(4U, recoded.bufferViews.Size());
+                Assert::AreEqual(recoded.images[0].bufferViewId, recoded.images[1].bufferViewId);
+                Assert::IsTrue(otherData == recodedReader.ReadBinaryData<uint8_t>(recoded, recoded.bufferViews[3]));
+            }
+
+            std::filesystem::remove_all(folder);
+        }
+
+        GLTFSDK_TEST_METHOD(GLBBufMapperTests, GLBBufMapper_RecodeImagesMultipleBuffers)
+        {
+            const auto folder = std::filesystem::temp_directory_path() / "GLBBufMapperTests";
+            std::filesystem::create_directories(folder);
+
+            const auto sourcePath = folder / "source.glb";
+            const auto recodedPath = folder / "recoded.glb";
+
+            // Writes a GLB with an image in the BIN chunk and another image and some other data in an external buffer
+            {
+                auto bufferBuilder = BufferBuilder(std::make_unique<GLBResourceWriter>(std::make_shared<StreamWriter>(folder)));
+
+                bufferBuilder.AddBuffer(GLB_BUFFER_ID);
+
+                Document document;
+                AddImage(document, bufferBuilder.AddBufferView(imageData0).id);
+
+                bufferBuilder.AddBuffer("external");
+                AddImage(document, bufferBuilder.AddBufferView(imageData1).id);
+                bufferBuilder.AddBufferView(otherData);
+                bufferBuilder.Output(document);
+
+                WriteGLB(bufferBuilder, document, sourcePath);
+            }
+
+            auto transcoder = std::make_shared<FakeTranscoder>();
+
+            {
+                Document document;
+                auto bufMapper = LoadGLB(sourcePath, transcoder, document);
+
+                // Each buffer lists its own buffer views
+                const auto& layout = bufMapper->GetLayout();
+                Assert::AreEqual<size_t>(2U, layout.size());
+                Assert::IsTrue(layout[0].isGLB);
+                Assert::IsTrue(!layout[1].isGLB);
+                Assert::IsTrue(std::vector<size_t>{ 0U } == layout[0].bvOrder);
+                Assert::IsTrue(std::vector<size_t>{ 1U, 2U } == layout[1].bvOrder);
+
+                bufMapper->RecodeImages(document, 2U);
+                bufMapper->SaveNewGLB(document, recodedPath);
+            }
+
+            // Only the image in the BIN chunk is recoded
+            Assert::AreEqual<size_t>(1U, transcoder->GetTranscodeCount());
+
+            {
+                GLBResourceReader recodedReader(std::make_shared<StreamReader>(folder), std::make_shared<std::ifstream>(recodedPath, std::ios_base::binary));
+                auto recoded = Deserialize(recodedReader.GetJson(), KHR::GetKHRExtensionDeserializer());
+
+                Assert::AreEqual<size_t>(2U, recoded.buffers.Size());
+                Assert::AreEqual(std::string("image/ktx2"), recoded.images[0].mimeType);
+                Assert::IsTrue(FakeTranscoder::Transcode(imageData0) == recodedReader.ReadBinaryData(recoded, recoded.images[0]));
+
+                // The external buffer is still referred to, along with the image it holds
+                Assert::AreEqual(std::string("image/png"), recoded.images[1].mimeType);
+                Assert::AreEqual(recoded.images[1].id, recoded.textures[1].imageId);
+                Assert::IsTrue(imageData1 == recodedReader.ReadBinaryData(recoded, recoded.images[1]));
+                Assert::IsTrue(otherData == recodedReader.ReadBinaryData<uint8_t>(recoded, recoded.bufferViews[2]));
+            }
+
+            std::filesystem::remove_all(folder);
+        }
+
+        GLTFSDK_TEST_METHOD(GLBBufMapperTests, GLBBufMapper_RecodeImagesAliasedBufferViews)
+        {
+            const auto folder = std::filesystem::temp_directory_path() / "GLBBufMapperTests";
+            std::filesystem::create_directories(folder);
+
+            const auto sourcePath = folder / "source.glb";
+            const auto recodedPath = folder / "recoded.glb";
+
+            CreateOverlappingGLB(sourcePath, true);
+
+            auto transcoder = std::make_shared<FakeTranscoder>();
+            RecodeGLB(sourcePath, recodedPath, transcoder);
+
+            // Images in aliased buffer views are skipped rather than recoded
+            Assert::AreEqual<size_t>(1U, transcoder->GetTranscodeCount());
+
+            {
+                GLBResourceReader recodedReader(std::make_shared<StreamReader>(folder), std::make_shared<std::ifstream>(recodedPath, std::ios_base::binary));
+                auto recoded = Deserialize(recodedReader.GetJson(), KHR::GetKHRExtensionDeserializer());
+
+                Assert::AreEqual<size_t>(4U, recoded.bufferViews.Size());
+                Assert::AreEqual(std::string("image/ktx2"), recoded.images[0].mimeType);
+                Assert::IsTrue(FakeTranscoder::Transcode(imageData1) == recodedReader.ReadBinaryData(recoded, recoded.images[0]));
+
+                // Both views still cover the same range, which is unchanged
+                const auto& shared = recoded.bufferViews[1];
+                const auto& alias = recoded.bufferViews[3];
+                Assert::AreEqual(shared.byteOffset, alias.byteOffset);
+                Assert::AreEqual(shared.byteLength, alias.byteLength);
+
+                for (size_t i = 1U; i < recoded.images.Size(); i++)
+                {
+                    Assert::AreEqual(std::string("image/png"), recoded.images[i].mimeType);
+                    Assert::IsTrue(imageData0 == recodedReader.ReadBinaryData(recoded, recoded.images[i]));
+                }
+
+                Assert::IsTrue(otherData == recodedReader.ReadBinaryData<uint8_t>(recoded, recoded.bufferViews[2]));
+            }
+
+            std::filesystem::remove_all(folder);
+        }
+
+        GLTFSDK_TEST_METHOD(GLBBufMapperTests, GLBBufMapper_RecodeImagesOverlappingBufferViews)
+        {
+            const auto folder = std::filesystem::temp_directory_path() / "GLBBufMapperTests";
+            std::filesystem::create_directories(folder);
+
+            const auto sourcePath = folder / "source.glb";
+            const auto recodedPath = folder / "recoded.glb";
+
+            CreateOverlappingGLB(sourcePath, false);
+
+            auto transcoder = std::make_shared<FakeTranscoder>();
+            RecodeGLB(sourcePath, recodedPath, transcoder);
+
+            // The image whose buffer view is overlapped is skipped rather than recoded
+            Assert::AreEqual<size_t>(1U, transcoder->GetTranscodeCount());
+
+            {
+                GLBResourceReader recodedReader(std::make_shared<StreamReader>(folder), std::make_shared<std::ifstream>(recodedPath, std::ios_base::binary));
+                auto recoded = Deserialize(recodedReader.GetJson(), KHR::GetKHRExtensionDeserializer());
+
+                Assert::AreEqual<size_t>(4U, recoded.bufferViews.Size());
+                Assert::AreEqual(std::string("image/ktx2"), recoded.images[0].mimeType);
+                Assert::AreEqual(std::string("image/png"), recoded.images[1].mimeType);
+                Assert::IsTrue(imageData0 == recodedReader.ReadBinaryData(recoded, recoded.images[1]));
+                Assert::IsTrue(otherData == recodedReader.ReadBinaryData<uint8_t>(recoded, recoded.bufferViews[2]));
+
+                // The overlapping view still covers the end of the image and the start of the other data
+                const std::vector<uint8_t> expected = { imageData0[4], imageData0[5], imageData0[6], otherData[0], otherData[1] };
+                Assert::IsTrue(expected == recodedReader.ReadBinaryData<uint8_t>(recoded, recoded.bufferViews[3]));
+            }
+
+            std::filesystem::remove_all(folder);
+        }
+    };
+}
@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include "RecodeCache.h"
+
+#include <chrono>
+#include <fstream>
+
+using namespace glTF::UnitTest;
+
+namespace
+{
+    std::filesystem::path CreateCacheFolder()
+    {
+        const auto folder = std::filesystem::temp_directory_path() / "RecodeCacheTests";
+        std::filesystem::remove_all(folder);
+        return folder;
+    }
+
+    std::filesystem::path GetEntryPath(const std::filesystem::path& folder, const std::string& key)
+    {
+        return folder / (key + ".recoded");
+    }
+}
+
+namespace Test
+{
+    GLTFSDK_TEST_CLASS(RecodeCacheTests)
+    {
+        GLTFSDK_TEST_METHOD(RecodeCacheTests, RecodeCache_StoreLookup)
+        {
+            const auto folder = CreateCacheFolder();
+
+            {
+                RecodeCache cache(folder, 1024U);
+
+                const auto key = RecodeCache::MakeKey("hash", "settings");
+                const std::vector<uint8_t> data = { 1U, 2U, 3U, 4U };
+
+                std::vector<uint8_t> found;
+                Assert::IsTrue(!cache.Lookup(key, found));
+
+                cache.Store(key, data);
+
+                Assert::IsTrue(cache.Lookup(key, found));
+                Assert::IsTrue(data == found);
+
+                // Different encoder settings produce a different key
+                Assert::IsTrue(!cache.Lookup(RecodeCache::MakeKey("hash", "other settings"), found));
+            }
+
+            std::filesystem::remove_all(folder);
+        }
+
+        GLTFSDK_TEST_METHOD(RecodeCacheTests, RecodeCache_Trim)
+        {
+            const auto folder = CreateCacheFolder();
+
+            {
+                RecodeCache cache(folder, 25U);
+
+                const std::vector<uint8_t> data(10U, 0U);
+                const auto now = std::filesystem::file_time_type::clock::now();
+
+                // Stores three 10 byte entries, the first of which is used least recently
+                const std::vector<std::string> keys = { "a", "b", "c" };
+
+                for (size_t i = 0U; i < keys.size(); i++)
+                {
+                    cache.Store(keys[i], data);
+                    std::filesystem::last_write_time(GetEntryPath(folder, keys[i]), now - std::chrono::minutes(keys.size() - i));
+                }
+
+                // A temporary entry that is still being written and one left behind by a recoder that didn't finish
+                const auto freshTemp = folder / "d.tmp1";
+                const auto staleTemp = folder / "e.tmp2";
+
+                std::ofstream(freshTemp).put('x');
+                std::ofstream(staleTemp).put('x');
+                std::filesystem::last_write_time(staleTemp, now - std::chrono::hours(2));
+
+                cache.Trim();
+
+                std::vector<uint8_t> found;
+                Assert::IsTrue(!cache.Lookup("a", found));
+                Assert::IsTrue(cache.Lookup("b", found));
+                Assert::IsTrue(cache.Lookup("c", found));
+
+                Assert::IsTrue(std::filesystem::exists(freshTemp));
+                Assert::IsTrue(!std::filesystem::exists(staleTemp));
+            }
+
+            std::filesystem::remove_all(folder);
+        }
+    };
+}
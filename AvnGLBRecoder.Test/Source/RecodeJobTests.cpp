@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include "RecodeJob.h"
+#include "RecoderTestUtils.h"
+
+#include <fstream>
+
+using namespace glTF::UnitTest;
+
+namespace Test
+{
+    GLTFSDK_TEST_CLASS(RecodeJobTests)
+    {
+        GLTFSDK_TEST_METHOD(RecodeJobTests, RecodeBatch_TwoInputs)
+        {
+            const auto folder = std::filesystem::temp_directory_path() / "RecodeJobTests";
+            const auto outFolder = folder / "out";
+            std::filesystem::create_directories(folder / "a");
+            std::filesystem::create_directories(outFolder);
+
+            CreateGLB(folder / "first.glb");
+            CreateGLB(folder / "a" / "second.glb");
+
+            // Relative paths in the manifest are relative to the manifest's folder
+            const auto manifestPath = folder / "batch.txt";
+            std::ofstream(manifestPath) << "first.glb\n" << (folder / "a" / "second.glb").u8string() << "\n";
+
+            auto jobs = GetBatchJobs(manifestPath, outFolder);
+            Assert::AreEqual<size_t>(2U, jobs.size());
+            Assert::IsTrue(outFolder / "first.glb" == jobs[0].glbNew);
+            Assert::IsTrue(outFolder / "second.glb" == jobs[1].glbNew);
+
+            // The duplicate image in each GLB is only transcoded once
+            auto transcoder = std::make_shared<FakeTranscoder>();
+            Assert::IsTrue(RecodeBatch(jobs, transcoder, 2U, nullptr));
+            Assert::AreEqual<size_t>(4U, transcoder->GetTranscodeCount());
+
+            for (const auto& job : jobs)
+            {
+                Assert::IsTrue(job.error.empty());
+                Assert::IsTrue(std::filesystem::exists(job.glbNew));
+            }
+
+            std::filesystem::remove_all(folder);
+        }
+
+        GLTFSDK_TEST_METHOD(RecodeJobTests, GetBatchJobs_OutputCollision)
+        {
+            const auto folder = std::filesystem::temp_directory_path() / "RecodeJobTests";
+            std::filesystem::create_directories(folder);
+
+            // GLBs in different folders with the same filename would be written to the same output
+            const auto manifestPath = folder / "batch.txt";
+            std::ofstream(manifestPath) << "a/model.glb\n" << "b/model.glb\n";
+
+            Assert::ExpectException<std::runtime_error>([&]()
+            {
+                GetBatchJobs(manifestPath, folder / "out");
+            });
+
+            std::filesystem::remove_all(folder);
+        }
+    };
+}
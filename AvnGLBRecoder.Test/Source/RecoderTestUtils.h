@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "GLBBufMapper.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/GLBResourceWriter.h>
+#include <GLTFSDK/Serialize.h>
+
+#include <atomic>
+
+namespace Test
+{
+    const std::vector<uint8_t> imageData0 = { 0x89U, 'P', 'N', 'G', 1U, 2U, 3U };
+    const std::vector<uint8_t> imageData1 = { 0x89U, 'P', 'N', 'G', 4U, 5U, 6U, 7U, 8U };
+    const std::vector<uint8_t> otherData = { 10U, 11U, 12U, 13U, 14U };
+
+    class StreamReader : public IStreamReader
+    {
+    public:
+        StreamReader(std::filesystem::path pathBase) : m_pathBase(std::move(pathBase))
+        {
+        }
+
+        std::shared_ptr<std::istream> GetInputStream(const std::string& filename) const override
+        {
+            return std::make_shared<std::ifstream>(m_pathBase / std::filesystem::u8path(filename), std::ios_base::binary);
+        }
+
+    private:
+        std::filesystem::path m_pathBase;
+    };
+
+    // Stands in for an encoder: prefixes each image with a marker and counts how many it was given
+    class FakeTranscoder : public IImageTranscoder
+    {
+    public:
+        std::vector<uint8_t> Transcode(const uint8_t* data, size_t size, const std::string& mimeType, const std::string&) const override
+        {
+            glTF::UnitTest::Assert::AreEqual(std::string("image/png"), mimeType);
+
+            m_transcodeCount++;
+
+            return Transcode(std::vector<uint8_t>(data, data + size));
+        }
+
+        static std::vector<uint8_t> Transcode(const std::vector<uint8_t>& data)
+        {
+            std::vector<uint8_t> result = { 'f', 'a', 'k', 'e' };
+            result.insert(result.end(), data.begin(), data.end());
+            return result;
+        }
+
+        std::string GetMimeType() const override
+        {
+            return "image/ktx2";
+        }
+
+        std::string GetSettings() const override
+        {
+            return "fake";
+        }
+
+        size_t GetTranscodeCount() const
+        {
+            return m_transcodeCount;
+        }
+
+    private:
+        mutable std::atomic<size_t> m_transcodeCount = 0U;
+    };
+
+    // Adds a PNG image stored in the given buffer view, and a texture that uses it
+    inline void AddImage(Document& document, const std::string& bufferViewId)
+    {
+        Image image;
+        image.bufferViewId = bufferViewId;
+        image.mimeType = "image/png";
+
+        Texture texture;
+        texture.imageId = document.images.Append(std::move(image), AppendIdPolicy::GenerateOnEmpty).id;
+        document.textures.Append(std::move(texture), AppendIdPolicy::GenerateOnEmpty);
+    }
+
+    inline void WriteGLB(BufferBuilder& bufferBuilder, const Document& document, const std::filesystem::path& path)
+    {
+        auto& glbWriter = static_cast<GLBResourceWriter&>(bufferBuilder.GetResourceWriter());
+        glbWriter.Flush(Serialize(document), path.filename().u8string());
+    }
+
+    // Writes a GLB with three textured images, the first two of which are identical, and a buffer view of other data
+    inline void CreateGLB(const std::filesystem::path& path, const std::string& extensionUsed = {})
+    {
+        auto bufferBuilder = BufferBuilder(std::make_unique<GLBResourceWriter>(std::make_shared<StreamWriter>(path.parent_path())));
+
+        bufferBuilder.AddBuffer(GLB_BUFFER_ID);
+
+        Document document;
+
+        for (const auto* data : { &imageData0, &imageData0, &imageData1 })
+        {
+            AddImage(document, bufferBuilder.AddBufferView(*data).id);
+        }
+
+        bufferBuilder.AddBufferView(otherData);
+        bufferBuilder.Output(document);
+
+        if (!extensionUsed.empty())
+        {
+            document.extensionsUsed.insert(extensionUsed);
+        }
+
+        WriteGLB(bufferBuilder, document, path);
+    }
+}
@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include "Sha256.h"
+
+using namespace glTF::UnitTest;
+
+namespace Test
+{
+    GLTFSDK_TEST_CLASS(Sha256Tests)
+    {
+        GLTFSDK_TEST_METHOD(Sha256Tests, Sha256_KnownAnswers)
+        {
+            {
+                Sha256 sha;
+                Assert::AreEqual(std::string("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"), sha.Finish());
+            }
+
+            {
+                Sha256 sha;
+                sha.Update("abc");
+                Assert::AreEqual(std::string("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"), sha.Finish());
+            }
+
+            {
+                // Spans two blocks, so the length is written to a block of its own
+                Sha256 sha;
+                sha.Update("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq");
+                Assert::AreEqual(std::string("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"), sha.Finish());
+            }
+        }
+
+        GLTFSDK_TEST_METHOD(Sha256Tests, Sha256_Incremental)
+        {
+            const std::string message = "The quick brown fox jumps over the lazy dog";
+
+            // The result doesn't depend on how the data is split between updates
+            for (size_t split = 0U; split <= message.size(); split++)
+            {
+                Sha256 sha;
+                sha.Update(message.data(), split);
+                sha.Update(message.data() + split, message.size() - split);
+                Assert::AreEqual(std::string("d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592"), sha.Finish());
+            }
+        }
+    };
+}
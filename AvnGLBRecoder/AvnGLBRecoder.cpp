@@ -3,80 +3,18 @@
 
 #include <iostream>
 #include <filesystem>
-#include <fstream>
 #include <sstream>
 
 #include <GLTFSDK/GLTF.h>
-#include <GLTFSDK/GLBResourceReader.h>
-#include <GLTFSDK/Deserialize.h>
+#include <GLTFSDK/Parallel.h>
 
-#include "GLBBufMapper.h"
+#include "RecodeJob.h"
 
 using namespace Microsoft::glTF;
 
-class StreamReader : public IStreamReader {
-public:
-    StreamReader(std::filesystem::path pathBase) : m_pathBase(std::move(pathBase)) {
-        assert(m_pathBase.has_root_path());
-    }
-
-    // Resolves the relative URIs of any external resources declared in the glTF manifest
-    std::shared_ptr<std::istream> GetInputStream(const std::string& filename) const override {
-        // In order to construct a valid stream:
-        // 1. The filename argument will be encoded as UTF-8 so use filesystem::u8path to
-        //    correctly construct a path instance.
-        // 2. Generate an absolute path by concatenating m_pathBase with the specified filename
-        //    path. The filesystem::operator/ uses the platform's preferred directory separator
-        //    if appropriate.
-        // 3. Always open the file stream in binary mode. The glTF SDK will handle any text
-        //    encoding issues for us.
-        auto streamPath = m_pathBase / std::filesystem::path(filename);
-        auto stream = std::make_shared<std::ifstream>(streamPath, std::ios_base::binary);
-
-        // Check if the stream has no errors and is ready for I/O operations
-        if (!stream || !(*stream)) {
-            throw std::runtime_error("Unable to create a valid input stream for uri: " + filename);
-        }
-
-        return stream;
-    }
-
-private:
-    std::filesystem::path m_pathBase;
-};
-
-void RecodeGLB(const std::filesystem::path& glbPath, const std::filesystem::path& glbNew) {
-    std::cout << "Processing GLB at - " << glbPath << std::endl;
-
-    auto streamReader = std::make_unique<StreamReader>(glbPath.parent_path());
-    auto glbStream = streamReader->GetInputStream(glbPath.filename().string()); 
-    auto glbResourceReader = std::make_shared<GLBResourceReader>(std::move(streamReader), std::move(glbStream));
-
-    std::string manifest = glbResourceReader->GetJson(); // Get the manifest from the JSON chunk
-
-    Document document;
-
-    try {
-        document = Deserialize(manifest);
-    } catch (const GLTFException& ex) {
-        std::stringstream ss;
-
-        ss << "Microsoft::glTF::Deserialize failed: ";
-        ss << ex.what();
-
-        throw std::runtime_error(ss.str());
-    }
-
-    std::cout << "### GLB Info - " << glbPath.filename() << " ###" << std::endl << std::endl;
-    std::cout << "Image count: " << document.images.Size() << ", texture count: " << document.textures.Size() << std::endl;
-    std::cout << "Buffer count: " << document.buffers.Size() << ", Buffer views: " << document.bufferViews.Size() << std::endl;
-
-    GLBBufMapper bufMapper(glbPath, glbResourceReader);
-    bufMapper.LoadDocument(document);
-    bufMapper.RecodeImages(document);
-
-    bufMapper.SaveNewGLB(document, glbNew);
-
+// Images are encoded by basisu, using the current folder for its input and output files
+std::shared_ptr<const IImageTranscoder> CreateTranscoder() {
+    return ExternalCommandTranscoder::CreateBasisU(std::filesystem::current_path());
 }
 
 int main(int argc, char* argv[])
@@ -84,21 +22,72 @@ int main(int argc, char* argv[])
     try {
         std::cout << "Avantis GLB recoder utility..." << std::endl;
 
-        if (argc != 3U) {
-            std::cerr << "Usage: " << argv[0] << " <original glb> <new glb>" << std::endl;
+        // Split the command line into options and positional arguments
+        std::vector<std::string> args;
+        unsigned int maxJobs = static_cast<unsigned int>(Parallel::GetThreadCount());
+        std::filesystem::path cacheFolder;
+        uintmax_t cacheMB = 1024;
+
+        for (int i = 1; i < argc; i++) {
+            if (std::string(argv[i]) == "-j" && (i + 1) < argc) {
+                int jobs = atoi(argv[++i]);
+                if (jobs <= 0) {
+                    std::stringstream ss;
+                    ss << "Command line option -j - " << argv[i] << " - must be a positive number of jobs";
+                    throw std::runtime_error(ss.str());
+                }
+                maxJobs = static_cast<unsigned int>(jobs);
+            } else if (std::string(argv[i]) == "-cache" && (i + 1) < argc) {
+                cacheFolder = argv[++i];
+            } else if (std::string(argv[i]) == "-cache-size" && (i + 1) < argc) {
+                int mb = atoi(argv[++i]);
+                if (mb <= 0) {
+                    std::stringstream ss;
+                    ss << "Command line option -cache-size - " << argv[i] << " - must be a positive number of MB";
+                    throw std::runtime_error(ss.str());
+                }
+                cacheMB = static_cast<uintmax_t>(mb);
+            } else {
+                args.push_back(argv[i]);
+            }
+        }
+
+        bool isBatch = !args.empty() && args[0] == "-batch";
+
+        if (args.size() != (isBatch ? 3U : 2U)) {
+            std::cerr << "Usage: " << argv[0] << " <original glb> <new glb> [options]" << std::endl;
+            std::cerr << "       " << argv[0] << " -batch <glb folder | manifest file> <output folder> [options]" << std::endl;
+            std::cerr << "Options: -j <max concurrent image jobs>" << std::endl;
+            std::cerr << "         -cache <folder> [-cache-size <MB, default 1024>]" << std::endl;
             throw std::runtime_error("Unexpected number of command line arguments");
         }
 
-        std::filesystem::path path = argv[1U];
+        auto MakeAbsolute = [](std::filesystem::path path) {
+            if (path.is_relative()) {
+                auto pathCurrent = std::filesystem::current_path();
 
-        if (path.is_relative()) {
-            auto pathCurrent = std::filesystem::current_path();
+                // Convert the relative path into an absolute path by appending the command line argument to the current path
+                pathCurrent /= path;
+                pathCurrent.swap(path);
+            }
+            return path;
+        };
 
-            // Convert the relative path into an absolute path by appending the command line argument to the current path
-            pathCurrent /= path;
-            pathCurrent.swap(path);
+        std::shared_ptr<const RecodeCache> cache;
+        if (!cacheFolder.empty()) {
+            cache = std::make_shared<RecodeCache>(MakeAbsolute(cacheFolder), cacheMB * 1024 * 1024);
         }
 
+        if (isBatch) {
+            std::filesystem::path outFolder = MakeAbsolute(args[2U]);
+            std::filesystem::create_directories(outFolder);
+
+            auto jobs = GetBatchJobs(MakeAbsolute(args[1U]), outFolder);
+            return RecodeBatch(jobs, CreateTranscoder(), maxJobs, cache) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        std::filesystem::path path = MakeAbsolute(args[0U]);
+
         if (!path.has_filename()) {
             throw std::runtime_error("Command line argument path has no filename");
         }
@@ -115,19 +104,12 @@ int main(int argc, char* argv[])
         };
 
         if (pathFileExt == MakePathExt(GLB_EXTENSION)) {
-            std::filesystem::path newGLB = argv[2U];
-            if (newGLB.is_relative()) {
-                auto pathCurrent = std::filesystem::current_path();
-
-                // Convert the relative path into an absolute path by appending the command line argument to the current path
-                pathCurrent /= newGLB;
-                pathCurrent.swap(newGLB);
-            }
+            std::filesystem::path newGLB = MakeAbsolute(args[1U]);
 
-            RecodeGLB(path, newGLB);
+            RecodeGLB(path, newGLB, CreateTranscoder(), maxJobs, cache);
         } else {
             std::stringstream ss;
-            ss << "Command line argument - " << argv[1U] << " - filename extension must be .glb";
+            ss << "Command line argument - " << args[0U] << " - filename extension must be .glb";
             throw std::runtime_error(ss.str());
         }
     } catch (const std::runtime_error& ex) {
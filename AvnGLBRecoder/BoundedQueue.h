@@ -0,0 +1,48 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+// A FIFO queue for handing work between pipeline stages. Push blocks while the queue is full so a
+// fast stage can't run arbitrarily far ahead of a slow one. Once Close has been called Pop drains
+// the remaining items and then returns false.
+template<typename T>
+class BoundedQueue {
+public:
+	explicit BoundedQueue(size_t capacity) : _capacity(capacity), _closed(false) {
+	}
+
+	void Push(T item) {
+		std::unique_lock<std::mutex> lock(_mutex);
+		_notFull.wait(lock, [this]() { return _items.size() < _capacity; });
+		_items.push_back(std::move(item));
+		_notEmpty.notify_one();
+	}
+
+	bool Pop(T& item) {
+		std::unique_lock<std::mutex> lock(_mutex);
+		_notEmpty.wait(lock, [this]() { return !_items.empty() || _closed; });
+		if (_items.empty()) {
+			return false;
+		}
+		item = std::move(_items.front());
+		_items.pop_front();
+		_notFull.notify_one();
+		return true;
+	}
+
+	void Close() {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_closed = true;
+		_notEmpty.notify_all();
+	}
+
+private:
+	std::mutex _mutex;
+	std::condition_variable _notFull;
+	std::condition_variable _notEmpty;
+	std::deque<T> _items;
+	const size_t _capacity;
+	bool _closed;
+};
@@ -1,18 +1,70 @@
 #include "GLBBufMapper.h"
+#include "Sha256.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 
+#include <GLTFSDK/ExtensionsKHR.h>
+#include <GLTFSDK/ExtensionsMOZ.h>
+#include <GLTFSDK/ExtensionsMSFT.h>
 #include <GLTFSDK/Serialize.h>
-#include <GLTFSDK/GLBResourceWriter.h>
+#include <GLTFSDK/GLBRewriter.h>
+#include <GLTFSDK/Parallel.h>
+
+namespace {
+	// Extensions that are known not to refer to buffer views
+	const std::unordered_set<std::string> BufferViewFreeExtensions = {
+		KHR::Materials::PBRSPECULARGLOSSINESS_NAME,
+		KHR::Materials::UNLIT_NAME,
+		MSFT::Nodes::LOD_NAME,
+		KHR::Textures::TEXTUREBASISU_NAME,
+		MOZ::Textures::HUBSTEXTUREBASIS_NAME,
+		KHR::TextureInfos::TEXTURETRANSFORM_NAME,
+		"KHR_lights_punctual",
+		"KHR_materials_clearcoat",
+		"KHR_materials_emissive_strength",
+		"KHR_materials_ior",
+		"KHR_materials_sheen",
+		"KHR_materials_specular",
+		"KHR_materials_transmission",
+		"KHR_materials_variants",
+		"KHR_materials_volume",
+		"KHR_mesh_quantization",
+		"EXT_mesh_gpu_instancing",
+		"EXT_texture_webp",
+		"MSFT_texture_dds"
+	};
+
+	// Collects the buffer views referred to by the document's extensions. Returns false if it uses an
+	// extension that isn't known, which may refer to buffer views that can't be found.
+	bool GetExtensionBufferViews(const Document& doc, std::unordered_set<std::string>& bufferViewIds) {
+		for (auto& extension : doc.extensionsUsed) {
+			if (extension != KHR::MeshPrimitives::DRACOMESHCOMPRESSION_NAME && !BufferViewFreeExtensions.count(extension)) {
+				std::cout << "Extension " << extension << " may refer to buffer views" << std::endl;
+				return false;
+			}
+		}
 
-#include "jute.h"
-#include "rapidjson/document.h"
-#include "rapidjson/writer.h"
-#include "rapidjson/stringbuffer.h"
+		for (auto& mesh : doc.meshes.Elements()) {
+			for (auto& primitive : mesh.primitives) {
+				if (primitive.HasExtension<KHR::MeshPrimitives::DracoMeshCompression>()) {
+					bufferViewIds.insert(primitive.GetExtension<KHR::MeshPrimitives::DracoMeshCompression>().bufferViewId);
+				} else if (primitive.extensions.count(KHR::MeshPrimitives::DRACOMESHCOMPRESSION_NAME)) {
+					return false;	// Left untyped by the deserializer
+				}
+			}
+		}
+
+		return true;
+	}
+}
 
-GLBBufMapper::GLBBufMapper(const std::filesystem::path& glbPath, const std::shared_ptr<GLBResourceReader>& glbReader)
-	: _originalGLB(glbPath), _glbReader(glbReader) {
+GLBBufMapper::GLBBufMapper(const std::filesystem::path& glbPath, const std::shared_ptr<GLBResourceReader>& glbReader, std::shared_ptr<const IImageTranscoder> transcoder)
+	: _originalGLB(glbPath), _glbReader(glbReader), _transcoder(std::move(transcoder)) {
 	auto filename = _originalGLB.filename().native();
 
 
@@ -22,55 +74,102 @@ GLBBufMapper::~GLBBufMapper() {
 
 }
 
+void GLBBufMapper::SetCache(std::shared_ptr<const RecodeCache> cache) {
+	_cache = std::move(cache);
+}
+
 void GLBBufMapper::LoadDocument(const Microsoft::glTF::Document& doc) {
 	_bufferViews.clear();
-	_bufOrder.clear();
-	
-	// Until we know better, we'll assume that all GLBs only have one buffer for all BVs
-	if (1 == doc.buffers.Size()) {
-		// Create a local collection to represent the buffer views so that they can be remapped.
-		_bufferViews.reserve(doc.bufferViews.Size());
-		_bufOrder.reserve(doc.bufferViews.Size());
-
-		for (int i = 0; i < doc.bufferViews.Size(); i++) {
-			auto& bv = doc.bufferViews.Get(i);
-			if (atoi(bv.id.c_str()) != i) {
-				std::stringstream ss;
-				ss << "GLB buffer view - id:" << bv.id << " - not ordered correctly - index = " << i;
-				throw std::runtime_error(ss.str());
-			}
-			if (bv.bufferId != "0") {
-				std::stringstream ss;
-				ss << "GLB buffer view - id:" << bv.id << " - refers to buffer Id:" << bv.bufferId;
-				throw std::runtime_error(ss.str());
-			}
+	_layout.clear();
+
+	_layout.resize(doc.buffers.Size());
+	for (int i = 0; i < doc.buffers.Size(); i++) {
+		auto& buf = doc.buffers.Get(i);
+		_layout[i].bufferId = buf.id;
+		// We allow "uri": "data:," to refer to a GLB buffer
+		_layout[i].isGLB = buf.uri.empty() || buf.uri == EMPTY_URI;
+	}
+
+	// Create a local collection to represent the buffer views so that they can be remapped.
+	_bufferViews.reserve(doc.bufferViews.Size());
+
+	for (int i = 0; i < doc.bufferViews.Size(); i++) {
+		auto& bv = doc.bufferViews.Get(i);
+		if (atoi(bv.id.c_str()) != i) {
+			std::stringstream ss;
+			ss << "GLB buffer view - id:" << bv.id << " - not ordered correctly - index = " << i;
+			throw std::runtime_error(ss.str());
+		}
+
+		BufferViewInfo bvi;
+		bvi.bvId = i;
+		bvi.bufIdx = static_cast<uint32_t>(doc.buffers.GetIndex(bv.bufferId));
+		bvi.len = bv.byteLength;
+		bvi.offset = bv.byteOffset;
+		bvi.aliasOf = i;
+		_bufferViews.emplace_back(bvi);
+	}
+
+	// Work out where each BufferView appears in its buffer - sort by (buffer, offset) rather than inserting one at a time
+	std::vector<uint32_t> bufOrder(_bufferViews.size());
+	for (uint32_t i = 0; i < bufOrder.size(); i++) {
+		bufOrder[i] = i;
+	}
+
+	std::sort(bufOrder.begin(), bufOrder.end(), [this](uint32_t lhs, uint32_t rhs) {
+		auto& l = _bufferViews[lhs];
+		auto& r = _bufferViews[rhs];
+		return std::tie(l.bufIdx, l.offset, l.len, l.bvId) < std::tie(r.bufIdx, r.offset, r.len, r.bvId);
+	});
 
-			//std::cout << "BV #" << bv.id << " -> off:" << bv.byteOffset << ", len:" << bv.byteLength << std::endl;
+	for (auto bvId : bufOrder) {
+		_layout[_bufferViews[bvId].bufIdx].bvOrder.push_back(bvId);
+	}
 
-			BufferViewInfo bvi;
-			bvi.bvId = i;
-			bvi.len = bv.byteLength;
-			bvi.offset = bv.byteOffset;
-			_bufferViews.emplace_back(bvi);
+	// Flag buffer views that alias or overlap one another - these can't be moved independently
+	size_t overlapCount = 0, aliasCount = 0;
+	for (auto& layout : _layout) {
+		auto& order = layout.bvOrder;
+		size_t spanEnd = 0;
+		size_t spanUnmarked = 0;	// First view of the current run of overlapping views that hasn't been flagged yet
+
+		for (size_t k = 0; k < order.size(); k++) {
+			auto& bvi = _bufferViews[order[k]];
+
+			if (k > 0 && bvi.offset < spanEnd) {
+				auto& bviPrev = _bufferViews[order[k - 1]];
+				if (bvi.offset == bviPrev.offset && bvi.len == bviPrev.len) {
+					bvi.aliasOf = bviPrev.aliasOf;
+					aliasCount++;
+				}
 
-			// Now work out where this BufferView appears in the buffer
-			auto itBuf = _bufOrder.begin();
-			while ((itBuf != _bufOrder.end()) && (bv.byteOffset > _bufferViews[*itBuf].offset)) {
-				itBuf++;
+				for (; spanUnmarked <= k; spanUnmarked++) {
+					_bufferViews[order[spanUnmarked]].overlaps = true;
+					overlapCount++;
+				}
+				spanEnd = std::max(spanEnd, bvi.offset + bvi.len);
+			} else {
+				spanUnmarked = k;
+				spanEnd = bvi.offset + bvi.len;
 			}
-			_bufOrder.insert(itBuf, i);
 		}
+	}
 
-		std::cout << std::endl << "Buffer View list in Buffer order --->" << std::endl;
-		auto it = _bufOrder.begin();
-		while (it != _bufOrder.end()) {
+	for (auto& layout : _layout) {
+		std::cout << std::endl << "Buffer View list in Buffer order - buffer #" << layout.bufferId << (layout.isGLB ? " (GLB)" : "") << " --->" << std::endl;
+		auto it = layout.bvOrder.begin();
+		while (it != layout.bvOrder.end()) {
 			auto& bvi = _bufferViews[*it];
 			std::cout << "BV #" << bvi.bvId << " -> off:" << bvi.offset << ", len:" << bvi.len;
-			
-			if (it != _bufOrder.begin()) {
+
+			if (bvi.aliasOf != bvi.bvId) {
+				std::cout << " --- alias of BV #" << bvi.aliasOf;
+			} else if (bvi.overlaps) {
+				std::cout << " --- overlaps another buffer view";
+			} else if (it != layout.bvOrder.begin()) {
 				auto& bviPrev = _bufferViews[*(it - 1)];
 				auto next_offset = bviPrev.offset + bviPrev.len;
-				if (bvi.offset != next_offset) {
+				if (bvi.offset != next_offset && !bviPrev.overlaps) {
 					if (0 == bvi.offset % 4) {
 						std::cout << " --- pad " << (bvi.offset - next_offset) << " bytes";
 					} else {
@@ -81,17 +180,25 @@ void GLBBufMapper::LoadDocument(const Microsoft::glTF::Document& doc) {
 			std::cout << std::endl;
 			it++;
 		}
-	} else {
-		std::stringstream ss;
-		ss << "GLB contains " << doc.buffers.Size() << " buffers - only single buffer GLBs are supported at the moment";
-		throw std::runtime_error(ss.str());
+	}
+
+	if (0 < overlapCount) {
+		std::cout << std::endl << overlapCount << " buffer views overlap others (" << aliasCount << " are exact aliases) and will not be recoded" << std::endl;
 	}
 }
 
-void GLBBufMapper::RecodeImages(const Microsoft::glTF::Document& doc) {
+const std::vector<GLBBufMapper::BufferLayout>& GLBBufMapper::GetLayout() const {
+	return _layout;
+}
+
+void GLBBufMapper::RecodeImages(Microsoft::glTF::Document& doc, unsigned int maxJobs) {
 	if (0 < _bufferViews.size()) {
-		std::cout << std::endl << "Found " << doc.images.Size() << " images to re-encode..." << std::endl;
- 		// Create a local collection to represent the buffer views so that they can be remapped.
+		std::cout << std::endl << "Found " << doc.images.Size() << " images to re-encode using up to " << maxJobs << " jobs..." << std::endl;
+
+		// Images that share a buffer view only need to be recoded once
+		std::vector<size_t> jobImages;
+		std::vector<bool> bvQueued(_bufferViews.size(), false);
+
 		for (int i = 0; i < doc.images.Size(); i++) {
 			auto& img = doc.images.Get(i);
 			if (atoi(img.id.c_str()) != i) {
@@ -100,55 +207,160 @@ void GLBBufMapper::RecodeImages(const Microsoft::glTF::Document& doc) {
 				throw std::runtime_error(ss.str());
 			}
 
+			if (img.bufferViewId.empty()) {
+				std::cout << "Skipping image id:" << img.id << " - not stored in a buffer view" << std::endl;
+				continue;
+			}
+
+			auto bvId = atoi(img.bufferViewId.c_str());
+			auto& bvi = _bufferViews[bvId];
+			if (!_layout[bvi.bufIdx].isGLB) {
+				std::cout << "Skipping image id:" << img.id << " - BV #" << bvId << " is not stored in the GLB buffer" << std::endl;
+				continue;
+			}
+			if (bvi.overlaps) {
+				std::cout << "Skipping image id:" << img.id << " - BV #" << bvId << " overlaps other buffer views" << std::endl;
+				continue;
+			}
+
+			if (!bvQueued[bvId]) {
+				bvQueued[bvId] = true;
+				jobImages.push_back(i);
+			}
+		}
+
+		// Exported GLBs often embed the same image several times, each in its own buffer view, so
+		// hash the payloads and only encode (and write) each distinct image once. The bytes and hash
+		// are kept for the encode pass so each image is only read and hashed once.
+		std::vector<SourceImage> sources(jobImages.size());
+
+		Parallel::For(jobImages.size(), maxJobs, [&](size_t job) {
+			sources[job] = ReadImage(doc, doc.images.Get(jobImages[job]));
+		});
+
+		std::unordered_map<std::string, size_t> uniqueImages;	// Hash -> index into jobImages of the first image with that hash
+		std::vector<size_t> uniqueJobs;
+		std::unordered_map<uint32_t, uint32_t> duplicateBVs;	// Buffer view of a duplicate image -> buffer view that will be kept
+
+		for (size_t job = 0; job < jobImages.size(); job++) {
+			auto itUnique = uniqueImages.emplace(sources[job].hash, job);
+			if (itUnique.second) {
+				uniqueJobs.push_back(job);
+			} else {
+				std::vector<uint8_t>().swap(sources[job].data);
+				auto bvId = atoi(doc.images.Get(jobImages[job]).bufferViewId.c_str());
+				auto bvKept = atoi(doc.images.Get(jobImages[itUnique.first->second]).bufferViewId.c_str());
+				duplicateBVs[bvId] = bvKept;
+			}
+		}
+
+		if (!duplicateBVs.empty()) {
+			std::cout << duplicateBVs.size() << " images are duplicates and will share a buffer view with an identical image" << std::endl;
+		}
+
+		std::vector<RecodeResult> results(uniqueJobs.size());
+
+		Parallel::For(uniqueJobs.size(), maxJobs, [&](size_t job) {
+			auto& source = sources[uniqueJobs[job]];
+			results[job] = RecodeImage(doc.images.Get(jobImages[uniqueJobs[job]]), source);
+			std::vector<uint8_t>().swap(source.data);
+		});
+
+		// Collect the results in image order so the output doesn't depend on job scheduling
+		bool cacheUpdated = false;
+		for (size_t job = 0; job < uniqueJobs.size(); job++) {
+			auto& img = doc.images.Get(jobImages[uniqueJobs[job]]);
 			auto& bvi = _bufferViews[atoi(img.bufferViewId.c_str())];
-			std::cout << "Re-encoding image id:" << img.id << ", BV #" << img.bufferViewId << " -> off:"
-				<< bvi.offset << ", len:" << bvi.len << std::endl;
+			auto& result = results[job];
+
+			std::cout << result.log;
+			cacheUpdated |= !result.fromCache;
+
+			bvi.new_len = result.data.size();
+			bvi.newData = std::move(result.data);
+			bvi.bv_updated = true;
+		}
+
+		if (_cache && cacheUpdated) {
+			_cache->Trim();
+		}
+
+		// Point duplicate images at the buffer view that was kept and adjust the Mime type of every
+		// image that refers to a re-encoded buffer view
+		for (auto img : doc.images.Elements()) {
+			if (img.bufferViewId.empty()) {
+				continue;
+			}
+
+			bool imageUpdated = false;
+
+			auto itDuplicate = duplicateBVs.find(atoi(img.bufferViewId.c_str()));
+			if (itDuplicate != duplicateBVs.end()) {
+				_bufferViews[itDuplicate->first].bv_removed = true;
+				img.bufferViewId = std::to_string(itDuplicate->second);
+				imageUpdated = true;
+			}
+
+			if (_bufferViews[atoi(img.bufferViewId.c_str())].bv_updated) {
+				img.mimeType = _transcoder->GetMimeType();
+				imageUpdated = true;
+			}
 
-			RecodeImage(doc, img, bvi);
+			if (imageUpdated) {
+				doc.images.Replace(img);
+			}
 		}
 	} else {
 		throw std::runtime_error("No BufferViews found in the GLB");
 	}
 }
 
-void GLBBufMapper::RecodeImage(const Document& doc, const Image& img, BufferViewInfo& bvi) {
+GLBBufMapper::SourceImage GLBBufMapper::ReadImage(const Document& doc, const Image& img) {
+	SourceImage source;
+	{
+		std::lock_guard<std::mutex> lock(_readerMutex);
+		source.data = _glbReader->ReadBinaryData(doc, img);
+	}
+
+	Sha256 sha;
+	sha.Update(img.mimeType);
+	sha.Update("", 1);
+	sha.Update(source.data.data(), source.data.size());
+	source.hash = sha.Finish();
+	return source;
+}
+
+GLBBufMapper::RecodeResult GLBBufMapper::RecodeImage(const Image& img, const SourceImage& source) {
 	try {
-		auto data = _glbReader->ReadBinaryData(doc, img);
+		RecodeResult result;
+		std::stringstream log;
 
-		std::string filenameBase = "image_" + img.id + "_" + "BV" + img.bufferViewId;
+		auto& bvi = _bufferViews[atoi(img.bufferViewId.c_str())];
+		log << "Re-encoding image id:" << img.id << ", BV #" << img.bufferViewId << " -> off:"
+			<< bvi.offset << ", len:" << bvi.len << std::endl;
 
-		auto mime = img.mimeType;
-		std::string orgImgFile = filenameBase + "." + mime.substr(mime.find_last_of('/') + 1);
+		auto& data = source.data;
+		std::string name = "image_" + img.id + "_" + "BV" + img.bufferViewId;
 
-		std::cout << "Image ID:" << img.id << ", mime: " << img.mimeType << " -> Saved " << data.size() << " bytes to " << orgImgFile << std::endl;
-		
-		std::ofstream imgFile(orgImgFile, std::ios::out | std::ios::binary);
-		if (imgFile.is_open()) {
-			imgFile.write(reinterpret_cast<const char*>(data.data()), data.size());
-			imgFile.close();
+		std::string cacheKey;
+		if (_cache) {
+			cacheKey = RecodeCache::MakeKey(source.hash, _transcoder->GetSettings());
+			result.fromCache = _cache->Lookup(cacheKey, result.data);
 		}
- 
-		std::string basisFile = filenameBase + ".basis";
-		std::string cmd = "basisu.exe -mipmap -comp_level 1 -q 192 -file " + orgImgFile + " -output_file " + basisFile;
 
-		auto rvSystem = std::system(cmd.c_str());
-		std::cout << "RV: " << rvSystem << " COMMAND :- " << cmd << std::endl;
+		if (!result.fromCache) {
+			result.data = _transcoder->Transcode(data.data(), data.size(), img.mimeType, name);
 
-		if (std::filesystem::exists(basisFile)) {
-			auto bf = std::filesystem::path(basisFile);
-			bvi.basisDataFile = basisFile;
-			bvi.new_len = std::filesystem::file_size(bf);
-			bvi.bv_updated = true;
+			if (_cache) {
+				_cache->Store(cacheKey, result.data);
+			}
+		}
 
-			std::cout << "Basis encoded file generated - " << basisFile << " - " << bvi.new_len << " bytes" << std::endl;
+		log << "Image ID:" << img.id << ", mime: " << img.mimeType << " -> " << data.size() << " bytes re-encoded to "
+			<< result.data.size() << " bytes of " << _transcoder->GetMimeType() << (result.fromCache ? " (cached)" : "") << std::endl;
 
-			// Adjust the Mime type...
-			const_cast<Image&>(img).mimeType = "image/basis";
-		} else {
-			std::stringstream ss;
-			ss << "Re-encoded Basis file wasn't created - " << basisFile;
-			throw std::runtime_error(ss.str());
-		}
+		result.log = log.str();
+		return result;
 	} catch (const std::exception& ex) {
 		std::stringstream ss;
 		ss << "Exception caught while recoding image - " << ex.what();
@@ -166,120 +378,109 @@ void GLBBufMapper::SaveNewGLB(Document& doc, std::filesystem::path glbNew) {
 	std::cout << std::endl << "Constructing new GLB -> " << glbNew << std::endl;
 
 	auto streamWriter = std::make_unique<StreamWriter>(glbNew.parent_path());
-	auto resWriter = std::make_unique<GLBResourceWriter>(std::move(streamWriter));
-	auto os = resWriter->GetBufferStream(GLB_BUFFER_ID);
-
-	uint8_t padBuf[4] = { 0,0,0,0 };
+	GLBRewriter rewriter(_glbReader, std::move(streamWriter));
+
+	// Buffer views left behind by duplicate images can only be dropped when nothing else refers to
+	// them - unknown extensions may hold buffer view indices, so nothing is dropped when one is used
+	std::unordered_set<std::string> extensionBufferViews;
+	bool canRemove = GetExtensionBufferViews(doc, extensionBufferViews);
+
+	for (auto& bvi : _bufferViews) {
+		if (bvi.bv_removed && canRemove) {
+			auto bvId = std::to_string(bvi.bvId);
+			bool referenced = extensionBufferViews.count(bvId) > 0;
+			for (auto& accessor : doc.accessors.Elements()) {
+				referenced |= (accessor.bufferViewId == bvId || accessor.sparse.indicesBufferViewId == bvId || accessor.sparse.valuesBufferViewId == bvId);
+			}
 
-	long offset_adjustment = 0;
-	auto it = _bufOrder.begin();
-	while (it != _bufOrder.end()) {
-		auto& bvi = _bufferViews[*it];
-		auto& bv = const_cast<BufferView&>(doc.bufferViews.Get(bvi.bvId));
+			if (!referenced) {
+				std::cout << "BV #" << bvi.bvId << " - removed, duplicate image data" << std::endl;
+				rewriter.RemoveBufferView(std::to_string(bvi.bvId));
+				continue;
+			}
+		}
 
 		if (bvi.bv_updated) {
-			// This buffer view has been re-encoded so read the new data from the basis file
-			std::ifstream strmBasis(bvi.basisDataFile, std::ios::in | std::ios::binary);
-			if (strmBasis.is_open()) {
-				auto basisData = StreamUtils::ReadBinaryFull<char>(strmBasis);
-				StreamUtils::WriteBinary(*os, basisData.data(), basisData.size());
-				std::cout << "BV #" << bv.id << " - read " << basisData.size() << " bytes from re-encoded basis data - write_ptr=" << os->tellp() << std::endl;
-
-				bv.byteOffset += offset_adjustment;
-
-				uint32_t padLen = 0;
-				// If the byte-length of the re-encoded basis data is not a multiple of 4, then we need to pad at the end.
-				if (0 != (bvi.new_len % 4)) {
-					padLen = 4 - (bvi.new_len % 4);
-					std::cout << "Padding with " << padLen << " bytes" << std::endl;
-					StreamUtils::WriteBinary(*os, padBuf, padLen);
-				}
+			std::cout << "BV #" << bvi.bvId << " - " << bvi.newData.size() << " bytes of re-encoded image data" << std::endl;
+			rewriter.SetBufferViewData(std::to_string(bvi.bvId), std::move(bvi.newData));
+		}
+	}
 
-				// Update the length of the buffer view.
-				bv.byteLength = bvi.new_len;
-				offset_adjustment += (-((long)bvi.len - (long)bvi.new_len)) + padLen;
-			}
-		} else {
-			auto bvData = _glbReader->ReadBinaryData<uint8_t>(doc, bv);
-			StreamUtils::WriteBinary(*os, bvData.data(), bvData.size());
-			bv.byteOffset += offset_adjustment;
-			std::cout << "BV #" << bv.id << " - read " << bvData.size() << " bytes from existing GLB - write_ptr=" << os->tellp() << std::endl;
+	// Unchanged buffer views are copied straight from the original GLB when the rewriter is flushed. The
+	// rewriter reuses the GLB buffer's layout worked out by LoadDocument rather than sorting it again.
+	auto itLayout = std::find_if(_layout.begin(), _layout.end(), [](const BufferLayout& layout) { return layout.isGLB; });
+	if (itLayout != _layout.end()) {
+		rewriter.Update(doc, itLayout->bvOrder);
+	} else {
+		rewriter.Update(doc);
+	}
+
+	for (auto& layout : _layout) {
+		if (!layout.isGLB) {
+			continue;
 		}
 
-		it++;
+		for (auto bvId : layout.bvOrder) {
+			if (!doc.bufferViews.Has(std::to_string(bvId))) {
+				continue;
+			}
+
+			auto& bv = doc.bufferViews.Get(std::to_string(bvId));
+			auto& bvi = _bufferViews[bvId];
+			bvi.new_offset = bv.byteOffset;
+			bvi.new_len = bv.byteLength;
+			std::cout << "BV #" << bv.id << " -> off:" << bvi.new_offset << ", len:" << bvi.new_len << (bvi.bv_updated ? " (re-encoded)" : "") << std::endl;
+		}
 	}
 
 	std::cout << "Extensions -> used:" << doc.extensionsUsed.size() << ", reqd: " << doc.extensionsRequired.size() << std::endl;
-	const_cast<std::unordered_set<std::string>&>(doc.extensionsUsed).insert("MOZ_HUBS_texture_basis");
-	const_cast<std::unordered_set<std::string>&>(doc.extensionsRequired).insert("MOZ_HUBS_texture_basis");
 
-	//auto& texture = doc.textures.Get(0);
-	//const_cast<std::unordered_map<std::string, std::string>&>(texture.extensions).insert(std::make_pair("MOZ_HUBS_texture_basis", ""));
-	//std::cout << "Textures (" << doc.textures.Size() << "): " << std::endl;
+	// Textures refer to their re-encoded images through the extension for the new image format
+	bool isKTX2 = (_transcoder->GetMimeType() == "image/ktx2");
+	const char* extensionName = isKTX2 ? KHR::Textures::TEXTUREBASISU_NAME : MOZ::Textures::HUBSTEXTUREBASIS_NAME;
+	size_t texturesUpdated = 0;
 
-	os->flush();
+	for (auto texture : doc.textures.Elements()) {
+		if (texture.imageId.empty()) {
+			continue;
+		}
 
-	std::string manifest;
-	try {
-		// Serialize the glTF Document into a JSON manifest
-		manifest = Serialize(doc, SerializeFlags::None);
-
-		//auto texturesPos = manifest.find("\"textures\":");
-		//"textures":[{"sampler":0,"source":0
-		//std::cout << "Found [textures] entry at offset : " << texturesPos << std::endl;
-		//manifest = manifest.insert(texturesPos + 35, ",\"extensions\":{\"MOZ_HUBS_texture_basis\":{\"source\":0}}");
-
-/* 		auto jsonDoc = jute::parser::parse(manifest);
-		jute::jValue& texturesList = jsonDoc["textures"];
-		std::cout << "Found " << texturesList.size() << " textures found in JSON doc" << std::endl;
-
-		for (int i = 0; i < texturesList.size(); i++) {
-			std::cout << "Texture #" << i << ": contains " << texturesList[i].size() << " elements" << std::endl;
-			std::cout << "String: " << texturesList[i].to_string() << std::endl;
-			auto jvExts = jute::jValue(jute::JOBJECT);
-			jute::jValue jvbasis(jute::JOBJECT);
-			jute::jValue jvSrc(jute::JNUMBER);
-			jvSrc.set_string(std::to_string(i));
-			jvbasis.add_property("source", jvSrc);
-			jvExts.add_property("MOZ_HUBS_texture_basis", jvbasis);
-
-			//jvExts.set_string(("{\"MOZ_HUBS_texture_basis\":{\"source\":0}}"));
-
-			texturesList[i].add_property("extensions", jvExts);
-			std::cout << "New Texture: " << texturesList[i].to_string() << std::endl;
+		auto& img = doc.images.Get(texture.imageId);
+		if (img.bufferViewId.empty() || !_bufferViews[atoi(img.bufferViewId.c_str())].bv_updated) {
+			continue;
 		}
 
-		manifest = jsonDoc.to_string();*/
-
-		rapidjson::Document jsonDoc;
-		jsonDoc.Parse(manifest.c_str());
-		auto texturesList = jsonDoc["textures"].GetArray();
-		std::cout << "Found " << texturesList.Size() << " textures found in JSON doc" << std::endl;
-
-		for (int i = 0; i < texturesList.Size(); i++) {
-			auto& texture = texturesList[i];
-			rapidjson::Value jvSrc;
-			jvSrc.SetString("PANTS!!");
-			
-			rapidjson::Value jvExts;
-			jvExts.SetString("MOZ_HUBS_texture_basis");
-			texture.AddMember(rapidjson::StringRef("MOZ_HUBS_texture_basis"), rapidjson::StringRef("PANTS"), jsonDoc.GetAllocator());
-
-			//std::cout << "Texture #" << i << ": contains " << texture.MemberCount() << " members" << std::endl;
-			/*auto itMember = texture.MemberBegin();
-			while (itMember != texture.MemberEnd()) {
-				std::cout << "Mem -> " << (*itMember).name.GetString() << " := " << (*itMember).value.GetString() << std::endl;
-				itMember++;
-			}*/
-
-			rapidjson::StringBuffer sbuf;
-			rapidjson::Writer<rapidjson::StringBuffer> writer(sbuf);
-			texture.Accept(writer);
-			std::cout << "String: " << sbuf.GetString() << std::endl;
+		// An untyped copy of the extension would otherwise be serialized alongside the typed one
+		texture.extensions.erase(extensionName);
+
+		if (isKTX2) {
+			auto extension = std::make_unique<KHR::Textures::TextureBasisU>();
+			extension->imageId = texture.imageId;
+			texture.SetExtension(std::move(extension));
+		} else {
+			auto extension = std::make_unique<MOZ::Textures::HubsTextureBasis>();
+			extension->imageId = texture.imageId;
+			texture.SetExtension(std::move(extension));
 		}
 
-		//manifest = jsonDoc.to_string();
+		// The core source may only refer to PNG or JPEG images, so the re-encoded image is only
+		// referred to by the extension
+		texture.imageId.clear();
+
+		doc.textures.Replace(texture);
+		texturesUpdated++;
+	}
 
+	if (texturesUpdated > 0) {
+		std::cout << texturesUpdated << " textures now use " << extensionName << std::endl;
+		doc.extensionsUsed.insert(extensionName);
+		doc.extensionsRequired.insert(extensionName);
+	}
+
+	std::string manifest;
+	try {
+		// Serialize the glTF Document into a JSON manifest
+		manifest = Serialize(doc, MOZ::GetMOZExtensionSerializer(KHR::GetKHRExtensionSerializer()), SerializeFlags::None);
 	} catch (const GLTFException& ex) {
 		std::stringstream ss;
 
@@ -288,5 +489,7 @@ void GLBBufMapper::SaveNewGLB(Document& doc, std::filesystem::path glbNew) {
 
 		throw std::runtime_error(ss.str());
 	}
-	resWriter->Flush(manifest, glbNew.string());
+
+	// Both ends are files, so unchanged ranges of the original GLB can be copied by the kernel
+	rewriter.FlushToFile(manifest, _originalGLB.string(), glbNew.string());
 }
\ No newline at end of file
@@ -2,11 +2,15 @@
 
 #include <fstream>
 #include <filesystem>
+#include <mutex>
 
 #include <GLTFSDK/GLTF.h>
 #include <GLTFSDK/Document.h>
 #include <GLTFSDK/GLBResourceReader.h>
 
+#include "ImageTranscoder.h"
+#include "RecodeCache.h"
+
 using namespace Microsoft::glTF;
 
 class StreamWriter : public IStreamWriter {
@@ -42,40 +46,82 @@ private:
 
 class GLBBufMapper {
 public:
-	GLBBufMapper(const std::filesystem::path& glbPath, const std::shared_ptr<GLBResourceReader>& glbReader);
+	GLBBufMapper(const std::filesystem::path& glbPath, const std::shared_ptr<GLBResourceReader>& glbReader, std::shared_ptr<const IImageTranscoder> transcoder);
 	~GLBBufMapper();
 
+	// Re-encoded images are looked up in, and added to, the cache when one is set
+	void SetCache(std::shared_ptr<const RecodeCache> cache);
+
 	void LoadDocument(const Document& doc);
-	void RecodeImages(const Document& doc);
+	void RecodeImages(Document& doc, unsigned int maxJobs);
 
 	void SaveNewGLB(Document& doc, std::filesystem::path glbNew);
 
+	// The buffer views of a single buffer in the order they appear in that buffer
+	struct BufferLayout {
+		std::string bufferId;
+		bool isGLB;
+		std::vector<size_t> bvOrder;
+
+		BufferLayout() {
+			isGLB = false;
+		}
+	};
+
+	const std::vector<BufferLayout>& GetLayout() const;
+
 private:
 
 	struct BufferViewInfo {
 		uint32_t bvId;
+		uint32_t bufIdx;
 		size_t offset;
 		size_t len;
 
+		uint32_t aliasOf;	// Lowest id of the buffer views with exactly the same range, or bvId if there are none
+		bool overlaps;		// Shares some bytes with another buffer view (including aliases)
+
 		bool bv_updated;
+		bool bv_removed;	// Duplicate image data - its images now refer to another buffer view
 		size_t new_offset;
 		size_t new_len;
 
-		std::string basisDataFile;
+		std::vector<uint8_t> newData;
 
 		BufferViewInfo() {
-			bvId = 0;
+			bvId = bufIdx = 0;
 			offset = len = 0;
-			bv_updated = false;
+			aliasOf = 0;
+			overlaps = false;
+			bv_updated = bv_removed = false;
 			new_offset = new_len = 0;
 		}
 	};
 
+	// Output of a single image recode job
+	struct RecodeResult {
+		std::vector<uint8_t> data;
+		std::string log;
+		bool fromCache = false;
+	};
+
+	// An image's bytes as read from the GLB, with a SHA-256 of its MIME type and bytes
+	struct SourceImage {
+		std::vector<uint8_t> data;
+		std::string hash;
+	};
+
 	std::vector<BufferViewInfo> _bufferViews;
-	std::vector<uint32_t> _bufOrder;
+	std::vector<BufferLayout> _layout;
 	std::shared_ptr<GLBResourceReader> _glbReader;
+	std::shared_ptr<const IImageTranscoder> _transcoder;
+	std::shared_ptr<const RecodeCache> _cache;
+
+	SourceImage ReadImage(const Document& doc, const Image& img);
+	RecodeResult RecodeImage(const Image& img, const SourceImage& source);
 
-	void RecodeImage(const Document& doc, const Image& img, BufferViewInfo& bvi);
+	// The GLB reader shares a single input stream so reads from recode jobs must be serialized
+	std::mutex _readerMutex;
 
 	std::filesystem::path _originalGLB;
 	std::filesystem::path _imgFolder;
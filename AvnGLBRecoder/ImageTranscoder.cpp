@@ -0,0 +1,77 @@
+#include "ImageTranscoder.h"
+
+#include <fstream>
+#include <sstream>
+
+#include <GLTFSDK/StreamUtils.h>
+
+using namespace Microsoft::glTF;
+
+namespace {
+	void ReplaceAll(std::string& str, const std::string& from, const std::string& to) {
+		for (auto pos = str.find(from); pos != std::string::npos; pos = str.find(from, pos + to.length())) {
+			str.replace(pos, from.length(), to);
+		}
+	}
+
+	// Removes the temporary files used by a single transcode, whether or not it succeeded
+	struct TempFiles {
+		std::vector<std::filesystem::path> paths;
+
+		~TempFiles() {
+			for (auto& path : paths) {
+				std::error_code ec;
+				std::filesystem::remove(path, ec);
+			}
+		}
+	};
+}
+
+ExternalCommandTranscoder::ExternalCommandTranscoder(std::string commandTemplate, std::string outputExt, std::string outputMimeType, std::filesystem::path workFolder)
+	: _commandTemplate(std::move(commandTemplate)), _outputExt(std::move(outputExt)), _outputMimeType(std::move(outputMimeType)), _workFolder(std::move(workFolder)) {
+}
+
+std::vector<uint8_t> ExternalCommandTranscoder::Transcode(const uint8_t* data, size_t size, const std::string& mimeType, const std::string& name) const {
+	TempFiles tempFiles;
+
+	auto inputFile = _workFolder / (name + "." + mimeType.substr(mimeType.find_last_of('/') + 1));
+	auto outputFile = _workFolder / (name + "." + _outputExt);
+	tempFiles.paths = { inputFile, outputFile };
+
+	{
+		std::ofstream imgFile(inputFile, std::ios::out | std::ios::binary);
+		if (!imgFile.is_open()) {
+			std::stringstream ss;
+			ss << "Unable to create temporary image file - " << inputFile;
+			throw std::runtime_error(ss.str());
+		}
+		imgFile.write(reinterpret_cast<const char*>(data), size);
+	}
+
+	std::string cmd = _commandTemplate;
+	ReplaceAll(cmd, "{input}", inputFile.string());
+	ReplaceAll(cmd, "{output}", outputFile.string());
+
+	auto rvSystem = std::system(cmd.c_str());
+
+	std::ifstream encodedFile(outputFile, std::ios::in | std::ios::binary);
+	if (!encodedFile.is_open()) {
+		std::stringstream ss;
+		ss << "Re-encoded image file wasn't created - " << outputFile << " - RV: " << rvSystem << " COMMAND :- " << cmd;
+		throw std::runtime_error(ss.str());
+	}
+
+	return StreamUtils::ReadBinaryFull<uint8_t>(encodedFile);
+}
+
+std::string ExternalCommandTranscoder::GetMimeType() const {
+	return _outputMimeType;
+}
+
+std::string ExternalCommandTranscoder::GetSettings() const {
+	return _commandTemplate + "|" + _outputMimeType;
+}
+
+std::unique_ptr<ExternalCommandTranscoder> ExternalCommandTranscoder::CreateBasisU(std::filesystem::path workFolder) {
+	return std::make_unique<ExternalCommandTranscoder>("basisu.exe -mipmap -comp_level 1 -q 192 -file {input} -output_file {output}", "basis", "image/basis", std::move(workFolder));
+}
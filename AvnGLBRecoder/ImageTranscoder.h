@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Re-encodes a single image held in memory. Implementations must be safe to call from several
+// recode jobs at once.
+class IImageTranscoder {
+public:
+	virtual ~IImageTranscoder() = default;
+
+	// Encodes size bytes of image data of the given mime type and returns the encoded image.
+	// The name uniquely identifies the image within the GLB and may be used for diagnostics.
+	virtual std::vector<uint8_t> Transcode(const uint8_t* data, size_t size, const std::string& mimeType, const std::string& name) const = 0;
+
+	// Mime type of the images returned by Transcode
+	virtual std::string GetMimeType() const = 0;
+
+	// Describes the encoder and its options - images transcoded with different settings must not share cache entries
+	virtual std::string GetSettings() const = 0;
+};
+
+// Transcodes images by running an external encoder, e.g. basisu. The command line is built from a
+// template where {input} and {output} are replaced by the paths of temporary files in the working
+// folder; the encoder must write its result to {output}.
+class ExternalCommandTranscoder : public IImageTranscoder {
+public:
+	ExternalCommandTranscoder(std::string commandTemplate, std::string outputExt, std::string outputMimeType, std::filesystem::path workFolder);
+
+	std::vector<uint8_t> Transcode(const uint8_t* data, size_t size, const std::string& mimeType, const std::string& name) const override;
+	std::string GetMimeType() const override;
+	std::string GetSettings() const override;
+
+	// Encodes to .basis files using basisu.exe, i.e. the recoder's original behaviour
+	static std::unique_ptr<ExternalCommandTranscoder> CreateBasisU(std::filesystem::path workFolder);
+
+private:
+	std::string _commandTemplate;
+	std::string _outputExt;
+	std::string _outputMimeType;
+	std::filesystem::path _workFolder;
+};
@@ -0,0 +1,146 @@
+#include "RecodeCache.h"
+#include "Sha256.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include <GLTFSDK/StreamUtils.h>
+
+using namespace Microsoft::glTF;
+
+namespace {
+	const char* CacheEntryExt = ".recoded";
+	const char* TempEntryExt = ".tmp";
+
+	// Temporary entries older than this were left behind by a recoder that didn't finish writing them
+	const auto StaleTempAge = std::chrono::hours(1);
+}
+
+RecodeCache::RecodeCache(std::filesystem::path folder, uintmax_t maxBytes)
+	: _folder(std::move(folder)), _maxBytes(maxBytes) {
+	std::filesystem::create_directories(_folder);
+}
+
+std::string RecodeCache::MakeKey(const std::string& imageHash, const std::string& encoderSettings) {
+	Sha256 sha;
+	sha.Update(encoderSettings);
+	sha.Update("", 1);
+	sha.Update(imageHash);
+	return sha.Finish();
+}
+
+bool RecodeCache::Lookup(const std::string& key, std::vector<uint8_t>& data) const {
+	auto path = EntryPath(key);
+
+	std::ifstream entry(path, std::ios::in | std::ios::binary);
+	if (!entry.is_open()) {
+		return false;
+	}
+
+	try {
+		data = StreamUtils::ReadBinaryFull<uint8_t>(entry);
+	} catch (const std::runtime_error&) {
+		// The entry may have been evicted by another process while we were reading it
+		return false;
+	}
+
+	// Mark the entry as recently used so eviction removes older entries first
+	std::error_code ec;
+	std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+
+	return true;
+}
+
+void RecodeCache::Store(const std::string& key, const std::vector<uint8_t>& data) const {
+	// Write to a uniquely named temporary file and then rename it into place so readers never see a partial entry
+	std::stringstream tmpName;
+	tmpName << key << TempEntryExt << std::hex << std::random_device{}() << std::random_device{}();
+	auto tmpPath = _folder / tmpName.str();
+
+	{
+		std::ofstream entry(tmpPath, std::ios::out | std::ios::binary);
+		if (!entry.is_open()) {
+			std::stringstream ss;
+			ss << "Unable to create recode cache entry - " << tmpPath;
+			throw std::runtime_error(ss.str());
+		}
+		StreamUtils::WriteBinary(entry, data);
+
+		entry.close();
+		if (entry.fail()) {
+			std::error_code ec;
+			std::filesystem::remove(tmpPath, ec);
+
+			std::stringstream ss;
+			ss << "Unable to write recode cache entry - " << tmpPath;
+			throw std::runtime_error(ss.str());
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tmpPath, EntryPath(key), ec);
+	if (ec) {
+		// Another process may have published the same entry first - either copy is fine
+		std::filesystem::remove(tmpPath, ec);
+	}
+}
+
+void RecodeCache::Trim() const {
+	struct Entry {
+		std::filesystem::path path;
+		std::filesystem::file_time_type lastUsed;
+		uintmax_t size;
+	};
+
+	std::vector<Entry> entries;
+	uintmax_t totalBytes = 0;
+
+	const auto staleTime = std::filesystem::file_time_type::clock::now() - StaleTempAge;
+
+	std::error_code ec;
+	for (auto& dirEntry : std::filesystem::directory_iterator(_folder, ec)) {
+		if (dirEntry.path().extension().string().compare(0, strlen(TempEntryExt), TempEntryExt) == 0) {
+			// Temporary entries are still being written unless they are stale
+			auto lastWrite = dirEntry.last_write_time(ec);
+			if (!ec && lastWrite < staleTime) {
+				std::filesystem::remove(dirEntry.path(), ec);
+			}
+			continue;
+		}
+
+		if (dirEntry.path().extension() != CacheEntryExt) {
+			continue;
+		}
+
+		Entry entry{ dirEntry.path(), dirEntry.last_write_time(ec), dirEntry.file_size(ec) };
+		if (!ec) {
+			totalBytes += entry.size;
+			entries.push_back(std::move(entry));
+		}
+	}
+
+	if (totalBytes <= _maxBytes) {
+		return;
+	}
+
+	std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) {
+		return lhs.lastUsed < rhs.lastUsed;
+	});
+
+	for (auto& entry : entries) {
+		if (totalBytes <= _maxBytes) {
+			break;
+		}
+		if (std::filesystem::remove(entry.path, ec)) {
+			totalBytes -= entry.size;
+		}
+	}
+}
+
+std::filesystem::path RecodeCache::EntryPath(const std::string& key) const {
+	return _folder / (key + CacheEntryExt);
+}
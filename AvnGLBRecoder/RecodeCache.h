@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Persistent cache of re-encoded images, keyed by a hash of the source image and the encoder
+// settings. Entries are published with an atomic rename so several recoder processes can share
+// one cache folder. When the folder grows beyond maxBytes the least recently used entries are
+// evicted.
+class RecodeCache {
+public:
+	RecodeCache(std::filesystem::path folder, uintmax_t maxBytes);
+
+	// 'imageHash' is a SHA-256 of the source image's MIME type and bytes
+	static std::string MakeKey(const std::string& imageHash, const std::string& encoderSettings);
+
+	bool Lookup(const std::string& key, std::vector<uint8_t>& data) const;
+	void Store(const std::string& key, const std::vector<uint8_t>& data) const;
+
+	// Evicts entries until the cache fits in maxBytes and removes stale temporary entries left by
+	// recoders that didn't finish writing them
+	void Trim() const;
+
+private:
+	std::filesystem::path EntryPath(const std::string& key) const;
+
+	std::filesystem::path _folder;
+	uintmax_t _maxBytes;
+};
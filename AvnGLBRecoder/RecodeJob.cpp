@@ -0,0 +1,215 @@
+#include "RecodeJob.h"
+
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+#include <GLTFSDK/Deserialize.h>
+#include <GLTFSDK/ExtensionsKHR.h>
+#include <GLTFSDK/ExtensionsMOZ.h>
+
+#include "BoundedQueue.h"
+
+namespace {
+    class StreamReader : public IStreamReader {
+    public:
+        StreamReader(std::filesystem::path pathBase) : m_pathBase(std::move(pathBase)) {
+            assert(m_pathBase.has_root_path());
+        }
+
+        // Resolves the relative URIs of any external resources declared in the glTF manifest
+        std::shared_ptr<std::istream> GetInputStream(const std::string& filename) const override {
+            // In order to construct a valid stream:
+            // 1. The filename argument will be encoded as UTF-8 so use filesystem::u8path to
+            //    correctly construct a path instance.
+            // 2. Generate an absolute path by concatenating m_pathBase with the specified filename
+            //    path. The filesystem::operator/ uses the platform's preferred directory separator
+            //    if appropriate.
+            // 3. Always open the file stream in binary mode. The glTF SDK will handle any text
+            //    encoding issues for us.
+            auto streamPath = m_pathBase / std::filesystem::path(filename);
+            auto stream = std::make_shared<std::ifstream>(streamPath, std::ios_base::binary);
+
+            // Check if the stream has no errors and is ready for I/O operations
+            if (!stream || !(*stream)) {
+                throw std::runtime_error("Unable to create a valid input stream for uri: " + filename);
+            }
+
+            return stream;
+        }
+
+    private:
+        std::filesystem::path m_pathBase;
+    };
+
+    template<typename Fn>
+    void RunStage(RecodeJob& job, std::chrono::steady_clock::duration& stageTime, Fn fn) {
+        if (!job.error.empty()) {
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        try {
+            fn();
+        } catch (const std::exception& ex) {
+            job.error = ex.what();
+            job.bufMapper.reset();
+        }
+        stageTime = std::chrono::steady_clock::now() - start;
+    }
+
+    void LoadGLB(RecodeJob& job, std::shared_ptr<const IImageTranscoder> transcoder, std::shared_ptr<const RecodeCache> cache) {
+        std::cout << "Processing GLB at - " << job.glbPath << std::endl;
+
+        auto streamReader = std::make_unique<StreamReader>(job.glbPath.parent_path());
+        auto glbStream = streamReader->GetInputStream(job.glbPath.filename().string()); 
+        auto glbResourceReader = std::make_shared<GLBResourceReader>(std::move(streamReader), std::move(glbStream));
+
+        std::string manifest = glbResourceReader->GetJson(); // Get the manifest from the JSON chunk
+
+        try {
+            job.document = Deserialize(manifest, MOZ::GetMOZExtensionDeserializer(KHR::GetKHRExtensionDeserializer()));
+        } catch (const GLTFException& ex) {
+            std::stringstream ss;
+
+            ss << "Microsoft::glTF::Deserialize failed: ";
+            ss << ex.what();
+
+            throw std::runtime_error(ss.str());
+        }
+
+        auto& document = job.document;
+        std::cout << "### GLB Info - " << job.glbPath.filename() << " ###" << std::endl << std::endl;
+        std::cout << "Image count: " << document.images.Size() << ", texture count: " << document.textures.Size() << std::endl;
+        std::cout << "Buffer count: " << document.buffers.Size() << ", Buffer views: " << document.bufferViews.Size() << std::endl;
+
+        job.bufMapper = std::make_unique<GLBBufMapper>(job.glbPath, glbResourceReader, std::move(transcoder));
+        job.bufMapper->SetCache(std::move(cache));
+        job.bufMapper->LoadDocument(document);
+    }
+
+    void SaveGLB(RecodeJob& job) {
+        job.bufMapper->SaveNewGLB(job.document, job.glbNew);
+
+        // Release the source GLB and the re-encoded images as soon as the new GLB has been written
+        job.bufMapper.reset();
+        job.document = Document();
+    }
+}
+
+void RecodeGLB(const std::filesystem::path& glbPath, const std::filesystem::path& glbNew, std::shared_ptr<const IImageTranscoder> transcoder, unsigned int maxJobs, std::shared_ptr<const RecodeCache> cache) {
+    RecodeJob job;
+    job.glbPath = glbPath;
+    job.glbNew = glbNew;
+
+    LoadGLB(job, std::move(transcoder), std::move(cache));
+    job.bufMapper->RecodeImages(job.document, maxJobs);
+    SaveGLB(job);
+}
+
+std::vector<RecodeJob> GetBatchJobs(const std::filesystem::path& input, const std::filesystem::path& outFolder) {
+    std::vector<std::filesystem::path> glbPaths;
+
+    if (std::filesystem::is_directory(input)) {
+        for (auto& entry : std::filesystem::directory_iterator(input)) {
+            if (entry.is_regular_file() && entry.path().extension() == "." + std::string(GLB_EXTENSION)) {
+                glbPaths.push_back(entry.path());
+            }
+        }
+        std::sort(glbPaths.begin(), glbPaths.end());
+    } else {
+        std::ifstream manifest(input);
+        if (!manifest.is_open()) {
+            std::stringstream ss;
+            ss << "Unable to open batch manifest - " << input;
+            throw std::runtime_error(ss.str());
+        }
+
+        std::string line;
+        while (std::getline(manifest, line)) {
+            line.erase(line.find_last_not_of(" \t\r") + 1);
+            if (!line.empty()) {
+                std::filesystem::path glbPath = line;
+                glbPaths.push_back(glbPath.is_relative() ? input.parent_path() / glbPath : glbPath);
+            }
+        }
+    }
+
+    std::vector<RecodeJob> jobs(glbPaths.size());
+    std::map<std::filesystem::path, std::filesystem::path> outputs; // New GLB -> the GLB it is recoded from
+
+    for (size_t i = 0; i < glbPaths.size(); i++) {
+        jobs[i].glbPath = glbPaths[i];
+        jobs[i].glbNew = outFolder / glbPaths[i].filename();
+
+        if (std::filesystem::exists(jobs[i].glbNew) && std::filesystem::equivalent(jobs[i].glbPath, jobs[i].glbNew)) {
+            std::stringstream ss;
+            ss << "Batch output would overwrite its input - " << jobs[i].glbPath;
+            throw std::runtime_error(ss.str());
+        }
+
+        auto itOutput = outputs.emplace(jobs[i].glbNew, jobs[i].glbPath);
+        if (!itOutput.second) {
+            std::stringstream ss;
+            ss << "Batch inputs - " << itOutput.first->second << " and " << jobs[i].glbPath << " - would both be written to " << jobs[i].glbNew;
+            throw std::runtime_error(ss.str());
+        }
+    }
+
+    return jobs;
+}
+
+bool RecodeBatch(std::vector<RecodeJob>& jobs, std::shared_ptr<const IImageTranscoder> transcoder, unsigned int maxJobs, std::shared_ptr<const RecodeCache> cache) {
+    // Small queues are enough to keep every stage busy while bounding the number of GLBs in memory
+    BoundedQueue<RecodeJob*> encodeQueue(2);
+    BoundedQueue<RecodeJob*> writeQueue(2);
+
+    std::thread loader([&]() {
+        for (auto& job : jobs) {
+            RunStage(job, job.loadTime, [&]() { LoadGLB(job, transcoder, cache); });
+            encodeQueue.Push(&job);
+        }
+        encodeQueue.Close();
+    });
+
+    std::thread encoder([&]() {
+        RecodeJob* job;
+        while (encodeQueue.Pop(job)) {
+            RunStage(*job, job->encodeTime, [&]() { job->bufMapper->RecodeImages(job->document, maxJobs); });
+            writeQueue.Push(job);
+        }
+        writeQueue.Close();
+    });
+
+    RecodeJob* job;
+    while (writeQueue.Pop(job)) {
+        RunStage(*job, job->writeTime, [&]() { SaveGLB(*job); });
+    }
+
+    loader.join();
+    encoder.join();
+
+    auto ms = [](std::chrono::steady_clock::duration d) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(d).count();
+    };
+
+    size_t failed = 0;
+    std::chrono::steady_clock::duration total{};
+
+    std::cout << std::endl << "### Batch summary (load / encode / write ms) ###" << std::endl;
+    for (auto& job : jobs) {
+        std::cout << job.glbPath.filename().string() << " - " << ms(job.loadTime) << " / " << ms(job.encodeTime) << " / " << ms(job.writeTime);
+        if (!job.error.empty()) {
+            std::cout << " - FAILED: " << job.error;
+            failed++;
+        }
+        std::cout << std::endl;
+        total += job.loadTime + job.encodeTime + job.writeTime;
+    }
+    std::cout << jobs.size() << " GLBs, " << failed << " failed, " << ms(total) << " ms of stage time" << std::endl;
+
+    return 0 == failed;
+}
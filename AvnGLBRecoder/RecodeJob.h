@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GLBBufMapper.h"
+
+// State of a single GLB as it moves through the load, encode and write stages
+struct RecodeJob {
+    std::filesystem::path glbPath;
+    std::filesystem::path glbNew;
+
+    Document document;
+    std::unique_ptr<GLBBufMapper> bufMapper;
+
+    std::chrono::steady_clock::duration loadTime{};
+    std::chrono::steady_clock::duration encodeTime{};
+    std::chrono::steady_clock::duration writeTime{};
+    std::string error;
+};
+
+// Recodes the images of a single GLB and writes the result to glbNew
+void RecodeGLB(const std::filesystem::path& glbPath, const std::filesystem::path& glbNew, std::shared_ptr<const IImageTranscoder> transcoder, unsigned int maxJobs, std::shared_ptr<const RecodeCache> cache);
+
+// Builds the list of GLBs to recode from either a folder of .glb files or a manifest listing one
+// GLB path per line (relative paths are relative to the manifest). The new GLBs are written to
+// outFolder using the same filenames, so inputs from different folders must not share a filename.
+std::vector<RecodeJob> GetBatchJobs(const std::filesystem::path& input, const std::filesystem::path& outFolder);
+
+// Recodes every job, loading the next GLB while the images of the current one are encoded and the
+// previous one is written. Returns false if any GLB failed.
+bool RecodeBatch(std::vector<RecodeJob>& jobs, std::shared_ptr<const IImageTranscoder> transcoder, unsigned int maxJobs, std::shared_ptr<const RecodeCache> cache);
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Incremental SHA-256, used to content-address recoded images
+class Sha256 {
+public:
+	Sha256();
+
+	void Update(const void* data, size_t size);
+	void Update(const std::string& str);
+
+	// Completes the hash and returns it as 64 lowercase hex digits. The object must not be updated afterwards.
+	std::string Finish();
+
+private:
+	void Transform(const uint8_t* block);
+
+	std::array<uint32_t, 8> _state;
+	std::array<uint8_t, 64> _block;
+	size_t _blockLen;
+	uint64_t _totalLen;
+};
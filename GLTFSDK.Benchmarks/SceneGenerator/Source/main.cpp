@@ -0,0 +1,215 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/GLBResourceWriter.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/IStreamWriter.h>
+#include <GLTFSDK/Serialize.h>
+
+#include "SceneGenerator.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <cstdlib>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::Benchmarks;
+
+namespace
+{
+    // Writes every resource to a file in the same folder as the generated glTF or GLB
+    class StreamWriter : public IStreamWriter
+    {
+    public:
+        StreamWriter(std::string pathBase) : m_pathBase(std::move(pathBase))
+        {
+        }
+
+        std::shared_ptr<std::ostream> GetOutputStream(const std::string& filename) const override
+        {
+            auto stream = std::make_shared<std::ofstream>(m_pathBase + filename, std::ios_base::binary);
+
+            // Check if the stream has no errors and is ready for I/O operations
+            if (!stream || !(*stream))
+            {
+                throw std::runtime_error("Unable to create a valid output stream for uri: " + filename);
+            }
+
+            return stream;
+        }
+
+    private:
+        std::string m_pathBase;
+    };
+
+    void PrintUsage()
+    {
+        std::cout << "Usage: SceneGenerator <output .gltf | .glb> [options]\n"
+            << "Options: -nodes <count>          Number of nodes (default 1)\n"
+            << "         -depth <levels>         Maximum depth of the node hierarchy (default 1)\n"
+            << "         -fanout <count>         Maximum children per node (default 1)\n"
+            << "         -meshes <count>         Number of meshes, each with four accessors (default 1)\n"
+            << "         -vertices <count>       Vertices per mesh (default 1024)\n"
+            << "         -interleaved            Interleave each mesh's vertex attributes\n"
+            << "         -sparse <ratio>         Fraction of vertices displaced by a sparse morph target (default 0)\n"
+            << "         -extras <bytes>         Length of each node's extras (default 0)\n"
+            << "         -external <bytes>       Size of an additional external buffer (default 0)\n"
+            << "         -seed <value>           Random seed (default 1)\n";
+    }
+
+    uint64_t ParseCount(const std::string& option, const std::string& value)
+    {
+        std::istringstream ss(value);
+        uint64_t count;
+
+        if (!(ss >> count) || !ss.eof())
+        {
+            throw std::runtime_error("Invalid value for " + option + " - " + value);
+        }
+
+        return count;
+    }
+
+    SceneDesc ParseSceneDesc(int argc, char* argv[])
+    {
+        SceneDesc desc;
+
+        for (int i = 2; i < argc; i++)
+        {
+            const std::string option = argv[i];
+
+            if (option == "-interleaved")
+            {
+                desc.interleaved = true;
+                continue;
+            }
+
+            if (i + 1 == argc)
+            {
+                throw std::runtime_error("Missing value for " + option);
+            }
+
+            const std::string value = argv[++i];
+
+            if (option == "-nodes")
+            {
+                desc.nodeCount = static_cast<size_t>(ParseCount(option, value));
+            }
+            else if (option == "-depth")
+            {
+                desc.depth = static_cast<size_t>(ParseCount(option, value));
+            }
+            else if (option == "-fanout")
+            {
+                desc.fanOut = static_cast<size_t>(ParseCount(option, value));
+            }
+            else if (option == "-meshes")
+            {
+                desc.meshCount = static_cast<size_t>(ParseCount(option, value));
+            }
+            else if (option == "-vertices")
+            {
+                desc.vertexCount = static_cast<size_t>(ParseCount(option, value));
+            }
+            else if (option == "-sparse")
+            {
+                desc.sparseRatio = std::stof(value);
+            }
+            else if (option == "-extras")
+            {
+                desc.extrasSize = static_cast<size_t>(ParseCount(option, value));
+            }
+            else if (option == "-external")
+            {
+                desc.externalBufferSize = ParseCount(option, value);
+            }
+            else if (option == "-seed")
+            {
+                desc.seed = static_cast<uint32_t>(ParseCount(option, value));
+            }
+            else
+            {
+                throw std::runtime_error("Unrecognised option " + option);
+            }
+        }
+
+        return desc;
+    }
+
+    void WriteScene(const std::string& path, const SceneDesc& desc)
+    {
+        const auto separator = path.find_last_of("/\\");
+        const auto folder = (separator == std::string::npos) ? std::string() : path.substr(0U, separator + 1U);
+        const auto filename = path.substr(folder.size());
+        const auto extension = filename.substr(std::min(filename.find_last_of('.'), filename.size()));
+
+        const bool isGLB = (extension == "." + std::string(GLB_EXTENSION));
+
+        if (!isGLB && extension != "." + std::string(GLTF_EXTENSION))
+        {
+            throw std::runtime_error("Output filename extension must be .gltf or .glb");
+        }
+
+        auto streamWriter = std::make_shared<StreamWriter>(folder);
+        std::unique_ptr<GLTFResourceWriter> resourceWriter;
+
+        if (isGLB)
+        {
+            resourceWriter = std::make_unique<GLBResourceWriter>(streamWriter);
+        }
+        else
+        {
+            resourceWriter = std::make_unique<GLTFResourceWriter>(streamWriter);
+        }
+
+        // External buffers are written alongside the output, named after it
+        resourceWriter->SetUriPrefix(filename.substr(0U, filename.size() - extension.size()) + "_");
+
+        const auto start = std::chrono::steady_clock::now();
+
+        BufferBuilder bufferBuilder(std::move(resourceWriter));
+        auto document = GenerateScene(bufferBuilder, desc);
+
+        if (isGLB)
+        {
+            static_cast<GLBResourceWriter&>(bufferBuilder.GetResourceWriter()).Flush(Serialize(document), filename);
+        }
+        else
+        {
+            bufferBuilder.GetResourceWriter().WriteExternal(filename, Serialize(document, SerializeFlags::Pretty));
+        }
+
+        std::cout << "Nodes: " << document.nodes.Size() << ", meshes: " << document.meshes.Size() << ", accessors: " << document.accessors.Size() << "\n";
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "Generated " << path << " in " << elapsed.count() << "s\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        WriteScene(argv[1], ParseSceneDesc(argc, argv));
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Error! - " << ex.what() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
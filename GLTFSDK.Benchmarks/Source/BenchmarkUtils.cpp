@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "BenchmarkUtils.h"
+#include "SceneGenerator.h"
+
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/Serialize.h>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::Benchmarks;
+
+Document Benchmarks::CreateScene(BufferBuilder& bufferBuilder, size_t meshCount, size_t vertexCount)
+{
+    SceneDesc desc;
+    desc.nodeCount = meshCount;
+    desc.meshCount = meshCount;
+    desc.vertexCount = vertexCount;
+
+    return GenerateScene(bufferBuilder, desc);
+}
+
+void Benchmarks::SetAllocationCounter(benchmark::State& state, const AllocationCounter& counter)
+{
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(counter.GetCount()), benchmark::Counter::kAvgIterations);
+}
+
+std::string Benchmarks::CreateManifest(size_t meshCount)
+{
+    BufferBuilder bufferBuilder(std::make_unique<GLTFResourceWriter>(std::make_shared<StreamReaderWriter>()));
+    auto document = CreateScene(bufferBuilder, meshCount, 4U);
+
+    return Serialize(document);
+}
+
+std::string Benchmarks::Base64Encode(const std::vector<uint8_t>& data)
+{
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    std::string encoded;
+    encoded.reserve(((data.size() + 2U) / 3U) * 4U);
+
+    for (size_t i = 0U; i < data.size(); i += 3U)
+    {
+        const size_t remaining = data.size() - i;
+        const uint32_t bits = (data[i] << 16U)
+            | (remaining > 1U ? data[i + 1U] << 8U : 0U)
+            | (remaining > 2U ? data[i + 2U] : 0U);
+
+        encoded.push_back(alphabet[(bits >> 18U) & 0x3F]);
+        encoded.push_back(alphabet[(bits >> 12U) & 0x3F]);
+        encoded.push_back(remaining > 1U ? alphabet[(bits >> 6U) & 0x3F] : '=');
+        encoded.push_back(remaining > 2U ? alphabet[bits & 0x3F] : '=');
+    }
+
+    return encoded;
+}
@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/IStreamReader.h>
+#include <GLTFSDK/IStreamWriter.h>
+
+#include <TestUtilsCommon/AllocationCounter.h>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Benchmarks
+        {
+            // Keeps every stream in memory so the benchmarks measure the SDK rather than the file system
+            class StreamReaderWriter : public IStreamWriter, public IStreamReader
+            {
+            public:
+                std::shared_ptr<std::ostream> GetOutputStream(const std::string& uri) const override
+                {
+                    return GetStream(uri);
+                }
+
+                std::shared_ptr<std::istream> GetInputStream(const std::string& uri) const override
+                {
+                    return GetStream(uri);
+                }
+
+                size_t GetStreamSize(const std::string& uri) const
+                {
+                    return GetStream(uri)->str().size();
+                }
+
+            private:
+                std::shared_ptr<std::stringstream> GetStream(const std::string& uri) const
+                {
+                    auto& stream = m_streams[uri];
+                    if (!stream)
+                    {
+                        stream = std::make_shared<std::stringstream>();
+                    }
+                    return stream;
+                }
+
+                mutable std::unordered_map<std::string, std::shared_ptr<std::stringstream>> m_streams;
+            };
+
+            using Test::AllocationCounter;
+
+            // Reports the allocations counted over all of a benchmark's iterations as a per-iteration average
+            void SetAllocationCounter(benchmark::State& state, const AllocationCounter& counter);
+
+            // Generates meshCount meshes, each with vertexCount vertices and its own (root) node, using the specified buffer builder
+            Document CreateScene(BufferBuilder& bufferBuilder, size_t meshCount, size_t vertexCount);
+
+            // Creates a scene with the specified number of meshes and serializes it. The binary data is discarded
+            // so the size of the manifest is determined only by the number of meshes
+            std::string CreateManifest(size_t meshCount);
+
+            std::string Base64Encode(const std::vector<uint8_t>& data);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "BenchmarkUtils.h"
+
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/MeshPrimitiveUtils.h>
+
+#include <functional>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::Benchmarks;
+
+namespace
+{
+    template<typename T>
+    using MeshPrimitiveGetter = std::function<std::vector<T>(const Document&, const GLTFResourceReader&, const MeshPrimitive&)>;
+
+    // The argument is the number of vertices in the mesh primitive
+    template<typename T>
+    void MeshPrimitiveUtils_Get(benchmark::State& state, MeshPrimitiveGetter<T> getter)
+    {
+        auto readerWriter = std::make_shared<StreamReaderWriter>();
+        BufferBuilder bufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+        const auto document = CreateScene(bufferBuilder, 1U, static_cast<size_t>(state.range(0)));
+        const auto& meshPrimitive = document.meshes.Front().primitives.front();
+
+        GLTFResourceReader reader(readerWriter);
+
+        size_t elementCount = 0U;
+
+        AllocationCounter allocations;
+
+        for (auto _ : state)
+        {
+            auto values = getter(document, reader, meshPrimitive);
+            elementCount = values.size();
+            benchmark::DoNotOptimize(values.data());
+        }
+
+        SetAllocationCounter(state, allocations);
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * elementCount * sizeof(T)));
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * elementCount));
+    }
+
+    void MeshPrimitiveUtils_GetPositions(benchmark::State& state)
+    {
+        MeshPrimitiveUtils_Get<float>(state, [](const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
+        {
+            return MeshPrimitiveUtils::GetPositions(doc, reader, meshPrimitive);
+        });
+    }
+
+    void MeshPrimitiveUtils_GetNormals(benchmark::State& state)
+    {
+        MeshPrimitiveUtils_Get<float>(state, [](const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
+        {
+            return MeshPrimitiveUtils::GetNormals(doc, reader, meshPrimitive);
+        });
+    }
+
+    void MeshPrimitiveUtils_GetTexCoords(benchmark::State& state)
+    {
+        MeshPrimitiveUtils_Get<float>(state, [](const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
+        {
+            return MeshPrimitiveUtils::GetTexCoords_0(doc, reader, meshPrimitive);
+        });
+    }
+
+    void MeshPrimitiveUtils_GetIndices32(benchmark::State& state)
+    {
+        MeshPrimitiveUtils_Get<uint32_t>(state, [](const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
+        {
+            return MeshPrimitiveUtils::GetIndices32(doc, reader, meshPrimitive);
+        });
+    }
+
+    void MeshPrimitiveUtils_GetTriangulatedIndices32(benchmark::State& state)
+    {
+        MeshPrimitiveUtils_Get<uint32_t>(state, [](const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
+        {
+            return MeshPrimitiveUtils::GetTriangulatedIndices32(doc, reader, meshPrimitive);
+        });
+    }
+}
+
+BENCHMARK(MeshPrimitiveUtils_GetPositions)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(MeshPrimitiveUtils_GetNormals)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(MeshPrimitiveUtils_GetTexCoords)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(MeshPrimitiveUtils_GetIndices32)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(MeshPrimitiveUtils_GetTriangulatedIndices32)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,215 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "BenchmarkUtils.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/GLBResourceReader.h>
+#include <GLTFSDK/GLBResourceWriter.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/Serialize.h>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::Benchmarks;
+
+namespace
+{
+    // A single VEC3 float accessor stored with one of the layouts below
+    struct AccessorData
+    {
+        std::shared_ptr<StreamReaderWriter> readerWriter = std::make_shared<StreamReaderWriter>();
+        Document document;
+        std::string accessorId;
+    };
+
+    std::vector<float> CreatePositions(size_t count)
+    {
+        std::vector<float> positions(count * 3U);
+
+        for (size_t i = 0U; i < positions.size(); i++)
+        {
+            positions[i] = static_cast<float>(i);
+        }
+
+        return positions;
+    }
+
+    AccessorData CreatePacked(size_t count)
+    {
+        AccessorData data;
+        BufferBuilder bufferBuilder(std::make_unique<GLTFResourceWriter>(data.readerWriter));
+
+        bufferBuilder.AddBuffer();
+        bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+        data.accessorId = bufferBuilder.AddAccessor(CreatePositions(count), { TYPE_VEC3, COMPONENT_FLOAT }).id;
+        bufferBuilder.Output(data.document);
+
+        return data;
+    }
+
+    AccessorData CreateInterleaved(size_t count)
+    {
+        AccessorData data;
+        BufferBuilder bufferBuilder(std::make_unique<GLTFResourceWriter>(data.readerWriter));
+
+        // Position, normal and texture coordinates
+        const size_t vertexSize = 8U;
+        const std::vector<float> vertices(count * vertexSize, 1.0f);
+
+        const AccessorDesc descs[] =
+        {
+            { TYPE_VEC3, COMPONENT_FLOAT, false, {}, {}, 0U },
+            { TYPE_VEC3, COMPONENT_FLOAT, false, {}, {}, 12U },
+            { TYPE_VEC2, COMPONENT_FLOAT, false, {}, {}, 24U }
+        };
+        std::string ids[3];
+
+        bufferBuilder.AddBuffer();
+        bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+        bufferBuilder.AddAccessors(vertices.data(), count, vertexSize * sizeof(float), descs, 3U, ids);
+        bufferBuilder.Output(data.document);
+
+        data.accessorId = ids[0];
+
+        return data;
+    }
+
+    AccessorData CreateSparse(size_t count)
+    {
+        AccessorData data;
+        BufferBuilder bufferBuilder(std::make_unique<GLTFResourceWriter>(data.readerWriter));
+
+        // One element in every hundred is substituted
+        std::vector<uint32_t> sparseIndices;
+        for (size_t i = 0U; i < count; i += 100U)
+        {
+            sparseIndices.push_back(static_cast<uint32_t>(i));
+        }
+        const std::vector<float> sparseValues(sparseIndices.size() * 3U, -1.0f);
+
+        bufferBuilder.AddBuffer();
+        bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+        auto accessor = bufferBuilder.AddAccessor(CreatePositions(count), { TYPE_VEC3, COMPONENT_FLOAT });
+        auto indicesBufferViewId = bufferBuilder.AddBufferView(sparseIndices).id;
+        auto valuesBufferViewId = bufferBuilder.AddBufferView(sparseValues).id;
+        bufferBuilder.Output(data.document);
+
+        accessor.sparse.count = sparseIndices.size();
+        accessor.sparse.indicesBufferViewId = indicesBufferViewId;
+        accessor.sparse.indicesComponentType = COMPONENT_UNSIGNED_INT;
+        accessor.sparse.valuesBufferViewId = valuesBufferViewId;
+        data.document.accessors.Replace(accessor);
+
+        data.accessorId = accessor.id;
+
+        return data;
+    }
+
+    AccessorData CreateBase64(size_t count)
+    {
+        AccessorData data;
+
+        const auto positions = CreatePositions(count);
+        const auto bytes = reinterpret_cast<const uint8_t*>(positions.data());
+        const size_t byteLength = positions.size() * sizeof(float);
+
+        Buffer buffer;
+        buffer.id = "0";
+        buffer.byteLength = byteLength;
+        buffer.uri = "data:application/octet-stream;base64," + Base64Encode(std::vector<uint8_t>(bytes, bytes + byteLength));
+        data.document.buffers.Append(std::move(buffer));
+
+        BufferView bufferView;
+        bufferView.id = "0";
+        bufferView.bufferId = "0";
+        bufferView.byteLength = byteLength;
+        data.document.bufferViews.Append(std::move(bufferView));
+
+        Accessor accessor;
+        accessor.id = "0";
+        accessor.bufferViewId = "0";
+        accessor.count = count;
+        accessor.type = TYPE_VEC3;
+        accessor.componentType = COMPONENT_FLOAT;
+        data.document.accessors.Append(std::move(accessor));
+
+        data.accessorId = "0";
+
+        return data;
+    }
+
+    // The argument is the number of elements in the accessor
+    void ReadBinaryData(benchmark::State& state, const AccessorData& data)
+    {
+        GLTFResourceReader reader(data.readerWriter);
+        const auto& accessor = data.document.accessors.Get(data.accessorId);
+
+        AllocationCounter allocations;
+
+        for (auto _ : state)
+        {
+            auto values = reader.ReadBinaryData<float>(data.document, accessor);
+            benchmark::DoNotOptimize(values.data());
+        }
+
+        SetAllocationCounter(state, allocations);
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * accessor.count * 3U * sizeof(float)));
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * accessor.count));
+    }
+
+    void ReadBinaryData_Packed(benchmark::State& state)
+    {
+        ReadBinaryData(state, CreatePacked(static_cast<size_t>(state.range(0))));
+    }
+
+    void ReadBinaryData_Interleaved(benchmark::State& state)
+    {
+        ReadBinaryData(state, CreateInterleaved(static_cast<size_t>(state.range(0))));
+    }
+
+    void ReadBinaryData_Sparse(benchmark::State& state)
+    {
+        ReadBinaryData(state, CreateSparse(static_cast<size_t>(state.range(0))));
+    }
+
+    void ReadBinaryData_Base64(benchmark::State& state)
+    {
+        ReadBinaryData(state, CreateBase64(static_cast<size_t>(state.range(0))));
+    }
+
+    // The argument is the number of meshes in the GLB's manifest
+    void GLBResourceReader_Construct(benchmark::State& state)
+    {
+        auto readerWriter = std::make_shared<StreamReaderWriter>();
+        BufferBuilder bufferBuilder(std::make_unique<GLBResourceWriter>(readerWriter));
+
+        auto document = CreateScene(bufferBuilder, static_cast<size_t>(state.range(0)), 4U);
+        static_cast<GLBResourceWriter&>(bufferBuilder.GetResourceWriter()).Flush(Serialize(document), "scene.glb");
+
+        auto glbStream = readerWriter->GetInputStream("scene.glb");
+
+        size_t manifestSize = 0U;
+
+        AllocationCounter allocations;
+
+        // Construction reads the GLB header and the JSON chunk, the BIN chunk is only read on demand
+        for (auto _ : state)
+        {
+            glbStream->clear();
+            glbStream->seekg(0);
+
+            GLBResourceReader reader(readerWriter, glbStream);
+            manifestSize = reader.GetJson().size();
+        }
+
+        SetAllocationCounter(state, allocations);
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * manifestSize));
+    }
+}
+
+BENCHMARK(ReadBinaryData_Packed)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(ReadBinaryData_Interleaved)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(ReadBinaryData_Sparse)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(ReadBinaryData_Base64)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(GLBResourceReader_Construct)->Arg(1)->Arg(100)->Arg(2000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "BenchmarkUtils.h"
+
+#include <GLTFSDK/GLBResourceWriter.h>
+#include <GLTFSDK/Serialize.h>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::Benchmarks;
+
+namespace
+{
+    // Builds and writes a complete GLB - the arguments are the number of meshes and the number of vertices per mesh
+    void GLBResourceWriter_Flush(benchmark::State& state)
+    {
+        const auto meshCount = static_cast<size_t>(state.range(0));
+        const auto vertexCount = static_cast<size_t>(state.range(1));
+
+        size_t glbSize = 0U;
+
+        AllocationCounter allocations;
+
+        for (auto _ : state)
+        {
+            auto readerWriter = std::make_shared<StreamReaderWriter>();
+            BufferBuilder bufferBuilder(std::make_unique<GLBResourceWriter>(readerWriter));
+
+            auto document = CreateScene(bufferBuilder, meshCount, vertexCount);
+            static_cast<GLBResourceWriter&>(bufferBuilder.GetResourceWriter()).Flush(Serialize(document), "scene.glb");
+
+            glbSize = readerWriter->GetStreamSize("scene.glb");
+        }
+
+        SetAllocationCounter(state, allocations);
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * glbSize));
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * meshCount * vertexCount));
+    }
+}
+
+BENCHMARK(GLBResourceWriter_Flush)->Args({ 1, 1 << 16 })->Args({ 100, 1 << 10 })->Args({ 1000, 64 })->Unit(benchmark::kMillisecond);
@@ -0,0 +1,364 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "SceneGenerator.h"
+
+#include <GLTFSDK/GLBResourceWriter.h>
+
+#include <algorithm>
+#include <deque>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::Benchmarks;
+
+namespace
+{
+    // xorshift32 - a fixed algorithm so the generated assets don't depend on the standard library's implementation
+    class Random
+    {
+    public:
+        explicit Random(uint32_t seed) : m_state(seed == 0U ? 1U : seed)
+        {
+        }
+
+        uint32_t Next()
+        {
+            m_state ^= m_state << 13;
+            m_state ^= m_state >> 17;
+            m_state ^= m_state << 5;
+            return m_state;
+        }
+
+        // Returns a value in the range [0, 1)
+        float NextFloat()
+        {
+            return static_cast<float>(Next() >> 8) * (1.0f / 16777216.0f);
+        }
+
+    private:
+        uint32_t m_state;
+    };
+
+    struct MeshData
+    {
+        std::string indicesAccessorId;
+        std::string positionsAccessorId;
+        std::string normalsAccessorId;
+        std::string texCoordsAccessorId;
+
+        size_t sparseCount = 0U;
+        std::string sparseIndicesBufferViewId;
+        std::string sparseValuesBufferViewId;
+        std::vector<float> sparseMin;
+        std::vector<float> sparseMax;
+    };
+
+    const size_t ExternalChunkSize = 64U * 1024U * 1024U;
+
+    MeshData AddMeshData(BufferBuilder& bufferBuilder, const SceneDesc& desc, Random& random)
+    {
+        MeshData meshData;
+
+        const size_t vertexCount = desc.vertexCount;
+
+        // Position, normal and texture coordinates
+        const size_t vertexSize = 8U;
+        std::vector<float> vertices(vertexCount * vertexSize);
+
+        std::vector<float> minValues = { 0.0f, 0.0f, 0.0f };
+        std::vector<float> maxValues = { static_cast<float>((vertexCount - 1U) / 2U), 1.0f, 0.0f };
+
+        // A zig-zag strip of triangles along the x axis with a random height at each vertex
+        for (size_t i = 0U; i < vertexCount; i++)
+        {
+            float* vertex = &vertices[i * vertexSize];
+
+            vertex[0] = static_cast<float>(i / 2U);
+            vertex[1] = static_cast<float>(i % 2U);
+            vertex[2] = random.NextFloat();
+
+            vertex[3] = 0.0f;
+            vertex[4] = 0.0f;
+            vertex[5] = 1.0f;
+
+            vertex[6] = vertex[0] / static_cast<float>(vertexCount);
+            vertex[7] = vertex[1];
+
+            maxValues[2] = std::max(maxValues[2], vertex[2]);
+        }
+
+        std::vector<uint32_t> indices;
+        indices.reserve((vertexCount - 2U) * 3U);
+
+        for (size_t i = 2U; i < vertexCount; i++)
+        {
+            indices.push_back(static_cast<uint32_t>(i - 2U));
+            indices.push_back(static_cast<uint32_t>(i - 1U));
+            indices.push_back(static_cast<uint32_t>(i));
+        }
+
+        bufferBuilder.AddBufferView(BufferViewTarget::ELEMENT_ARRAY_BUFFER);
+        meshData.indicesAccessorId = bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_INT }).id;
+
+        if (desc.interleaved)
+        {
+            const AccessorDesc descs[] =
+            {
+                { TYPE_VEC3, COMPONENT_FLOAT, false, minValues, maxValues, 0U },
+                { TYPE_VEC3, COMPONENT_FLOAT, false, {}, {}, 12U },
+                { TYPE_VEC2, COMPONENT_FLOAT, false, {}, {}, 24U }
+            };
+            std::string ids[3];
+
+            bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+            bufferBuilder.AddAccessors(vertices.data(), vertexCount, vertexSize * sizeof(float), descs, 3U, ids);
+
+            meshData.positionsAccessorId = ids[0];
+            meshData.normalsAccessorId = ids[1];
+            meshData.texCoordsAccessorId = ids[2];
+        }
+        else
+        {
+            std::vector<float> positions, normals, texCoords;
+            positions.reserve(vertexCount * 3U);
+            normals.reserve(vertexCount * 3U);
+            texCoords.reserve(vertexCount * 2U);
+
+            for (size_t i = 0U; i < vertexCount; i++)
+            {
+                const float* vertex = &vertices[i * vertexSize];
+
+                positions.insert(positions.end(), vertex, vertex + 3);
+                normals.insert(normals.end(), vertex + 3, vertex + 6);
+                texCoords.insert(texCoords.end(), vertex + 6, vertex + 8);
+            }
+
+            bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+            meshData.positionsAccessorId = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT, false, minValues, maxValues }).id;
+
+            bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+            meshData.normalsAccessorId = bufferBuilder.AddAccessor(normals, { TYPE_VEC3, COMPONENT_FLOAT }).id;
+
+            bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+            meshData.texCoordsAccessorId = bufferBuilder.AddAccessor(texCoords, { TYPE_VEC2, COMPONENT_FLOAT }).id;
+        }
+
+        if (desc.sparseRatio > 0.0f)
+        {
+            // Sparse indices must be strictly increasing so displace evenly spaced vertices
+            meshData.sparseCount = std::min(vertexCount, std::max<size_t>(1U, static_cast<size_t>(vertexCount * desc.sparseRatio)));
+
+            std::vector<uint32_t> sparseIndices(meshData.sparseCount);
+            std::vector<float> sparseValues(meshData.sparseCount * 3U);
+
+            meshData.sparseMin = { 0.0f, 0.0f, 0.0f };
+            meshData.sparseMax = { 0.0f, 0.0f, 0.0f };
+
+            for (size_t i = 0U; i < meshData.sparseCount; i++)
+            {
+                sparseIndices[i] = static_cast<uint32_t>((i * vertexCount) / meshData.sparseCount);
+
+                for (size_t j = 0U; j < 3U; j++)
+                {
+                    const float value = random.NextFloat() - 0.5f;
+
+                    sparseValues[i * 3U + j] = value;
+                    meshData.sparseMin[j] = std::min(meshData.sparseMin[j], value);
+                    meshData.sparseMax[j] = std::max(meshData.sparseMax[j], value);
+                }
+            }
+
+            meshData.sparseIndicesBufferViewId = bufferBuilder.AddBufferView(sparseIndices).id;
+            meshData.sparseValuesBufferViewId = bufferBuilder.AddBufferView(sparseValues).id;
+        }
+
+        return meshData;
+    }
+
+    void AddExternalBuffer(BufferBuilder& bufferBuilder, uint64_t byteLength, Random& random)
+    {
+        bufferBuilder.AddBuffer("external");
+
+        // The buffer is written in fixed size buffer views so its size isn't limited by the available memory
+        std::vector<uint8_t> chunk(static_cast<size_t>(std::min<uint64_t>(byteLength, ExternalChunkSize)));
+        for (auto& value : chunk)
+        {
+            value = static_cast<uint8_t>(random.Next());
+        }
+
+        for (uint64_t offset = 0U; offset < byteLength; offset += chunk.size())
+        {
+            bufferBuilder.AddBufferView(chunk.data(), static_cast<size_t>(std::min<uint64_t>(byteLength - offset, chunk.size())));
+        }
+    }
+
+    std::string GenerateExtras(size_t length, Random& random)
+    {
+        std::string extras = "{\"payload\":\"";
+        extras.reserve(extras.size() + length + 2U);
+
+        for (size_t i = 0U; i < length; i++)
+        {
+            extras.push_back(static_cast<char>('a' + random.Next() % 26U));
+        }
+
+        extras += "\"}";
+
+        return extras;
+    }
+}
+
+SceneDesc::SceneDesc() :
+    nodeCount(1U),
+    depth(1U),
+    fanOut(1U),
+    meshCount(1U),
+    vertexCount(1024U),
+    interleaved(false),
+    sparseRatio(0.0f),
+    extrasSize(0U),
+    externalBufferSize(0U),
+    seed(1U)
+{
+}
+
+Document Benchmarks::GenerateScene(BufferBuilder& bufferBuilder, const SceneDesc& desc)
+{
+    if (desc.depth == 0U || desc.fanOut == 0U)
+    {
+        throw GLTFException("The node hierarchy's depth and fan-out must both be at least 1");
+    }
+
+    if (desc.meshCount > 0U && desc.vertexCount < 3U)
+    {
+        throw GLTFException("Meshes must have at least 3 vertices");
+    }
+
+    if (desc.sparseRatio < 0.0f || desc.sparseRatio > 1.0f)
+    {
+        throw GLTFException("The sparse ratio must be between 0 and 1");
+    }
+
+    Document document;
+    Random random(desc.seed);
+
+    // GLBs store their binary data in the container's BIN chunk rather than an external buffer
+    const bool isGLB = dynamic_cast<const GLBResourceWriter*>(&bufferBuilder.GetResourceWriter()) != nullptr;
+    bufferBuilder.AddBuffer(isGLB ? GLB_BUFFER_ID : nullptr);
+
+    std::vector<MeshData> meshData;
+    meshData.reserve(desc.meshCount);
+
+    for (size_t i = 0U; i < desc.meshCount; i++)
+    {
+        meshData.push_back(AddMeshData(bufferBuilder, desc, random));
+    }
+
+    if (desc.externalBufferSize > 0U)
+    {
+        AddExternalBuffer(bufferBuilder, desc.externalBufferSize, random);
+    }
+
+    bufferBuilder.Output(document);
+
+    std::vector<std::string> meshIds;
+    meshIds.reserve(desc.meshCount);
+
+    for (size_t i = 0U; i < desc.meshCount; i++)
+    {
+        const auto& data = meshData[i];
+
+        MeshPrimitive meshPrimitive;
+        meshPrimitive.indicesAccessorId = data.indicesAccessorId;
+        meshPrimitive.attributes[ACCESSOR_POSITION] = data.positionsAccessorId;
+        meshPrimitive.attributes[ACCESSOR_NORMAL] = data.normalsAccessorId;
+        meshPrimitive.attributes[ACCESSOR_TEXCOORD_0] = data.texCoordsAccessorId;
+
+        Mesh mesh;
+
+        if (data.sparseCount > 0U)
+        {
+            // The morph target's accessor has no buffer view - all the displacements not stored in the sparse values are zero
+            Accessor accessor;
+            accessor.count = desc.vertexCount;
+            accessor.type = TYPE_VEC3;
+            accessor.componentType = COMPONENT_FLOAT;
+            accessor.min = data.sparseMin;
+            accessor.max = data.sparseMax;
+            accessor.sparse.count = data.sparseCount;
+            accessor.sparse.indicesBufferViewId = data.sparseIndicesBufferViewId;
+            accessor.sparse.indicesComponentType = COMPONENT_UNSIGNED_INT;
+            accessor.sparse.valuesBufferViewId = data.sparseValuesBufferViewId;
+
+            MorphTarget morphTarget;
+            morphTarget.positionsAccessorId = document.accessors.Append(std::move(accessor), AppendIdPolicy::GenerateOnEmpty).id;
+
+            meshPrimitive.targets.push_back(std::move(morphTarget));
+            mesh.weights.push_back(1.0f);
+        }
+
+        Material material;
+        material.name = "Material " + std::to_string(i);
+        material.metallicRoughness.baseColorFactor = Color4(random.NextFloat(), random.NextFloat(), random.NextFloat(), 1.0f);
+        meshPrimitive.materialId = document.materials.Append(std::move(material), AppendIdPolicy::GenerateOnEmpty).id;
+
+        mesh.name = "Mesh " + std::to_string(i);
+        mesh.primitives.push_back(std::move(meshPrimitive));
+
+        meshIds.push_back(document.meshes.Append(std::move(mesh), AppendIdPolicy::GenerateOnEmpty).id);
+    }
+
+    // Nodes are appended after the hierarchy is complete as the container only returns const references
+    std::vector<Node> nodes(desc.nodeCount);
+    std::vector<size_t> nodeDepths(desc.nodeCount);
+    std::deque<size_t> parents;
+
+    Scene scene;
+
+    for (size_t i = 0U; i < desc.nodeCount; i++)
+    {
+        auto& node = nodes[i];
+
+        node.id = std::to_string(i);
+        node.name = "Node " + std::to_string(i);
+        node.translation = Vector3(random.NextFloat(), random.NextFloat(), random.NextFloat());
+
+        if (!meshIds.empty())
+        {
+            node.meshId = meshIds[i % meshIds.size()];
+        }
+
+        if (desc.extrasSize > 0U)
+        {
+            node.extras = GenerateExtras(desc.extrasSize, random);
+        }
+
+        while (!parents.empty() && (nodes[parents.front()].children.size() == desc.fanOut || nodeDepths[parents.front()] + 1U == desc.depth))
+        {
+            parents.pop_front();
+        }
+
+        if (parents.empty())
+        {
+            scene.nodes.push_back(node.id);
+        }
+        else
+        {
+            nodes[parents.front()].children.push_back(node.id);
+            nodeDepths[i] = nodeDepths[parents.front()] + 1U;
+        }
+
+        parents.push_back(i);
+    }
+
+    document.nodes.Reserve(nodes.size());
+
+    for (auto& node : nodes)
+    {
+        document.nodes.Append(std::move(node));
+    }
+
+    document.SetDefaultScene(std::move(scene), AppendIdPolicy::GenerateOnEmpty);
+
+    return document;
+}
@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Document.h>
+
+#include <cstdint>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Benchmarks
+        {
+            // Parameters of a synthetic scene. The same parameters (including the seed) always generate the same asset
+            struct SceneDesc
+            {
+                SceneDesc();
+
+                // Node hierarchy - nodes are added breadth first, each with up to fanOut children and at most depth levels
+                // deep. A new root is started whenever the current tree is full so a fanOut of 1 with a depth equal to the
+                // node count generates a single parent chain
+                size_t nodeCount;
+                size_t depth;
+                size_t fanOut;
+
+                // Meshes are triangle strips with positions, normals and texture coordinates. Each has its own material
+                // and is instanced by every meshCount'th node
+                size_t meshCount;
+                size_t vertexCount;
+                bool interleaved;       // Store each mesh's vertex attributes in a single buffer view with a byte stride
+
+                float sparseRatio;      // The fraction of each mesh's vertices displaced by a sparse morph target, 0 for none
+                size_t extrasSize;      // The length of the string stored in each node's extras, 0 for none
+
+                uint64_t externalBufferSize; // The size of an extra buffer (not referenced by any accessor) written in chunks to an external file
+
+                uint32_t seed;
+            };
+
+            // Writes the scene's binary data using the specified buffer builder and returns its document. When the builder's
+            // resource writer is a GLBResourceWriter the mesh data is stored in the GLB's binary chunk
+            Document GenerateScene(BufferBuilder& bufferBuilder, const SceneDesc& desc);
+        }
+    }
+}
@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "BenchmarkUtils.h"
+
+#include <GLTFSDK/Deserialize.h>
+#include <GLTFSDK/Serialize.h>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::Benchmarks;
+
+namespace
+{
+    // The argument is the number of meshes (each with its own node, material and four accessors)
+    // in the manifest: 1 (small), 100 (medium) and 2000 (huge)
+
+    void Deserialize_Manifest(benchmark::State& state)
+    {
+        const auto manifest = CreateManifest(static_cast<size_t>(state.range(0)));
+
+        AllocationCounter allocations;
+
+        for (auto _ : state)
+        {
+            auto document = Deserialize(manifest);
+            benchmark::DoNotOptimize(document);
+        }
+
+        SetAllocationCounter(state, allocations);
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * manifest.size()));
+    }
+
+    void Serialize_Manifest(benchmark::State& state)
+    {
+        const auto document = Deserialize(CreateManifest(static_cast<size_t>(state.range(0))));
+
+        size_t manifestSize = 0U;
+
+        AllocationCounter allocations;
+
+        for (auto _ : state)
+        {
+            auto manifest = Serialize(document);
+            manifestSize = manifest.size();
+            benchmark::DoNotOptimize(manifest);
+        }
+
+        SetAllocationCounter(state, allocations);
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * manifestSize));
+    }
+}
+
+BENCHMARK(Deserialize_Manifest)->Arg(1)->Arg(100)->Arg(2000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Serialize_Manifest)->Arg(1)->Arg(100)->Arg(2000)->Unit(benchmark::kMicrosecond);
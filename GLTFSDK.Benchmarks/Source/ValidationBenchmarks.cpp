@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "BenchmarkUtils.h"
+
+#include <GLTFSDK/Deserialize.h>
+#include <GLTFSDK/Validation.h>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::Benchmarks;
+
+namespace
+{
+    // The argument is the number of meshes in the document
+    void Validation_Validate(benchmark::State& state)
+    {
+        const auto meshCount = static_cast<size_t>(state.range(0));
+        const auto document = Deserialize(CreateManifest(meshCount));
+
+        AllocationCounter allocations;
+
+        for (auto _ : state)
+        {
+            Validation::Validate(document);
+        }
+
+        SetAllocationCounter(state, allocations);
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * document.accessors.Size()));
+    }
+}
+
+BENCHMARK(Validation_Validate)->Arg(1)->Arg(100)->Arg(2000)->Unit(benchmark::kMicrosecond);
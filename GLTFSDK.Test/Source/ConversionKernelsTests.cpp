@@ -0,0 +1,458 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/ConversionKernels.h>
+#include <GLTFSDK/Math.h>
+#include <GLTFSDK/ResourceReaderUtils.h>
+
+#include "TestUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace Microsoft::glTF::ConversionKernels;
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            namespace
+            {
+                // Element counts that exercise empty input, partial blocks and several whole blocks of every kernel
+                const size_t MaxCount = 70U;
+
+                // Restores the process-wide instruction set when a test completes
+                class InstructionSetScope
+                {
+                public:
+                    InstructionSetScope() : m_instructionSet(GetInstructionSet())
+                    {
+                    }
+
+                    ~InstructionSetScope()
+                    {
+                        SetInstructionSet(m_instructionSet);
+                    }
+
+                private:
+                    const InstructionSet m_instructionSet;
+                };
+
+                std::vector<InstructionSet> GetSupportedInstructionSets()
+                {
+                    std::vector<InstructionSet> instructionSets;
+
+                    for (auto instructionSet : { InstructionSet::Scalar, InstructionSet::SSE2, InstructionSet::AVX2 })
+                    {
+                        if (IsSupported(instructionSet))
+                        {
+                            instructionSets.push_back(instructionSet);
+                        }
+                    }
+
+                    return instructionSets;
+                }
+
+                // Deterministic values that cover each type's full range, including its minimum and maximum
+                template<typename T>
+                std::vector<T> MakeValues(size_t count)
+                {
+                    std::vector<T> values(count);
+
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        values[i] = static_cast<T>(i * 2654435761U + (i % 3 == 0 ? 0U : ~0U));
+                    }
+
+                    return values;
+                }
+
+                std::vector<float> MakeUnitFloats(size_t count)
+                {
+                    std::vector<float> values(count);
+
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        values[i] = static_cast<float>((i * 7919U) % 1001U) / 1000.0f;
+                    }
+
+                    return values;
+                }
+
+                uint32_t PackExpected(float r, float g, float b, float a)
+                {
+                    return
+                        static_cast<uint32_t>(Math::FloatToByte(a)) << 24U |
+                        static_cast<uint32_t>(Math::FloatToByte(b)) << 16U |
+                        static_cast<uint32_t>(Math::FloatToByte(g)) <<  8U |
+                        static_cast<uint32_t>(Math::FloatToByte(r));
+                }
+
+                // Converts from both a separate source buffer and from the front of the destination buffer
+                template<typename TIn, typename TOut, typename FnConvert>
+                void CheckConversion(const std::vector<TIn>& src, const std::vector<TOut>& expected, FnConvert fnConvert)
+                {
+                    std::vector<TOut> dst(expected.size());
+                    fnConvert(src.data(), dst.data(), expected.size());
+
+                    AreEqual(expected, dst);
+
+                    std::vector<TOut> inPlace(std::max(expected.size(), (src.size() * sizeof(TIn) + sizeof(TOut) - 1U) / sizeof(TOut)));
+                    if (!src.empty())
+                    {
+                        std::memcpy(inPlace.data(), src.data(), src.size() * sizeof(TIn));
+                    }
+                    fnConvert(reinterpret_cast<const TIn*>(inPlace.data()), inPlace.data(), expected.size());
+                    inPlace.resize(expected.size());
+
+                    AreEqual(expected, inPlace);
+                }
+
+                template<typename TIn, typename TOut>
+                void CheckWiden(void (*fnWiden)(const TIn*, TOut*, size_t))
+                {
+                    for (size_t count = 0U; count <= MaxCount; count++)
+                    {
+                        const auto src = MakeValues<TIn>(count);
+                        const std::vector<TOut> expected(src.begin(), src.end());
+
+                        CheckConversion(src, expected, fnWiden);
+                    }
+                }
+
+                template<typename T>
+                void CheckToFloat()
+                {
+                    for (bool normalized : { false, true })
+                    {
+                        for (size_t count = 0U; count <= MaxCount; count++)
+                        {
+                            const auto src = MakeValues<T>(count);
+                            std::vector<float> expected(count);
+
+                            for (size_t i = 0U; i < count; i++)
+                            {
+                                expected[i] = normalized ? ComponentToFloat(src[i]) : static_cast<float>(src[i]);
+                            }
+
+                            CheckConversion(src, expected, [normalized](const T* s, float* d, size_t n) { ToFloat(s, d, n, normalized); });
+                        }
+                    }
+                }
+
+                // Expands 'count' primitives from a separate buffer and from raw indices placed as close to the front of
+                // the output buffer as the kernel allows
+                template<typename T>
+                void CheckListExpansion(void (*fnExpand)(const T*, T*, size_t), size_t count, const std::vector<T>& src, const std::vector<T>& expected, size_t offset)
+                {
+                    std::vector<T> dst(expected.size());
+                    fnExpand(src.data(), dst.data(), count);
+
+                    AreEqual(expected, dst);
+
+                    std::vector<T> inPlace(std::max(expected.size(), offset + src.size()));
+                    std::copy(src.begin(), src.end(), inPlace.begin() + offset);
+                    fnExpand(inPlace.data() + offset, inPlace.data(), count);
+                    inPlace.resize(expected.size());
+
+                    AreEqual(expected, inPlace);
+                }
+
+                template<typename T>
+                void CheckTriangleLists()
+                {
+                    for (size_t count = 0U; count <= MaxCount; count++)
+                    {
+                        const auto src = MakeValues<T>(count + 2U);
+                        const size_t offset = count > 0U ? count * 2U - 2U : 0U;
+
+                        std::vector<T> expectedStrip;
+                        std::vector<T> expectedFan;
+
+                        for (size_t i = 0U; i < count; i++)
+                        {
+                            expectedStrip.push_back(src[i]);
+                            expectedStrip.push_back(src[i % 2U == 0U ? i + 1U : i + 2U]);
+                            expectedStrip.push_back(src[i % 2U == 0U ? i + 2U : i + 1U]);
+
+                            expectedFan.push_back(src[0]);
+                            expectedFan.push_back(src[i + 1U]);
+                            expectedFan.push_back(src[i + 2U]);
+                        }
+
+                        CheckListExpansion<T>(&TriangleStripToList, count, src, expectedStrip, offset);
+                        CheckListExpansion<T>(&TriangleFanToList, count, src, expectedFan, offset);
+                    }
+                }
+
+                template<typename T>
+                void CheckLineLists()
+                {
+                    for (size_t count = 0U; count <= MaxCount; count++)
+                    {
+                        const auto src = MakeValues<T>(count + 1U);
+                        const size_t offset = count > 0U ? count - 1U : 0U;
+
+                        std::vector<T> expected;
+
+                        for (size_t i = 0U; i < count; i++)
+                        {
+                            expected.push_back(src[i]);
+                            expected.push_back(src[i + 1U]);
+                        }
+
+                        CheckListExpansion<T>(&LineStripToList, count, src, expected, offset);
+                    }
+                }
+            }
+
+            GLTFSDK_TEST_CLASS(ConversionKernelsTests)
+            {
+                GLTFSDK_TEST_METHOD(ConversionKernelsTests, SetInstructionSet)
+                {
+                    InstructionSetScope scope;
+
+                    Assert::IsTrue(IsSupported(InstructionSet::Scalar));
+                    Assert::IsTrue(IsSupported(GetInstructionSet()));
+
+                    SetInstructionSet(InstructionSet::Scalar);
+                    Assert::IsTrue(InstructionSet::Scalar == GetInstructionSet());
+
+                    for (auto instructionSet : { InstructionSet::SSE2, InstructionSet::AVX2 })
+                    {
+                        if (!IsSupported(instructionSet))
+                        {
+                            Assert::ExpectException<GLTFException>([instructionSet]() { SetInstructionSet(instructionSet); });
+                        }
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(ConversionKernelsTests, Widen)
+                {
+                    InstructionSetScope scope;
+
+                    for (auto instructionSet : GetSupportedInstructionSets())
+                    {
+                        SetInstructionSet(instructionSet);
+
+                        CheckWiden(&WidenU8ToU16);
+                        CheckWiden(&WidenU8ToU32);
+                        CheckWiden(&WidenU16ToU32);
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(ConversionKernelsTests, ToFloat)
+                {
+                    InstructionSetScope scope;
+
+                    for (auto instructionSet : GetSupportedInstructionSets())
+                    {
+                        SetInstructionSet(instructionSet);
+
+                        CheckToFloat<int8_t>();
+                        CheckToFloat<uint8_t>();
+                        CheckToFloat<int16_t>();
+                        CheckToFloat<uint16_t>();
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(ConversionKernelsTests, PackUnorm8)
+                {
+                    InstructionSetScope scope;
+
+                    for (auto instructionSet : GetSupportedInstructionSets())
+                    {
+                        SetInstructionSet(instructionSet);
+
+                        for (size_t count = 0U; count <= MaxCount; count++)
+                        {
+                            const auto rgba = MakeUnitFloats(count * 4U);
+                            const auto rgb = MakeUnitFloats(count * 3U);
+
+                            std::vector<uint32_t> expectedRGBA(count);
+                            std::vector<uint32_t> expectedRGB(count);
+
+                            for (size_t i = 0U; i < count; i++)
+                            {
+                                expectedRGBA[i] = PackExpected(rgba[i * 4U], rgba[i * 4U + 1U], rgba[i * 4U + 2U], rgba[i * 4U + 3U]);
+                                expectedRGB[i] = PackExpected(rgb[i * 3U], rgb[i * 3U + 1U], rgb[i * 3U + 2U], 1.0f);
+                            }
+
+                            CheckConversion(rgba, expectedRGBA, &PackUnorm8x4);
+                            CheckConversion(rgb, expectedRGB, &PackUnorm8x3);
+                        }
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(ConversionKernelsTests, PackUnorm8_Saturates)
+                {
+                    InstructionSetScope scope;
+
+                    const float values[] = { -1.0f, 2.0f, NAN, INFINITY, -INFINITY, 1.0f, 0.0f, 0.5f };
+
+                    std::vector<float> rgba;
+
+                    for (size_t i = 0U; i < 16U; i++)
+                    {
+                        rgba.push_back(values[i % 8U]);
+                    }
+
+                    for (auto instructionSet : GetSupportedInstructionSets())
+                    {
+                        SetInstructionSet(instructionSet);
+
+                        std::vector<uint32_t> packed(4U);
+                        PackUnorm8x4(rgba.data(), packed.data(), packed.size());
+
+                        Assert::AreEqual(0xFF00FF00U, packed[0]);
+                        Assert::AreEqual(0x8000FF00U, packed[1]);
+                        Assert::AreEqual(0xFF00FF00U, packed[2]);
+                        Assert::AreEqual(0x8000FF00U, packed[3]);
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(ConversionKernelsTests, TriangleLists)
+                {
+                    InstructionSetScope scope;
+
+                    for (auto instructionSet : GetSupportedInstructionSets())
+                    {
+                        SetInstructionSet(instructionSet);
+
+                        CheckTriangleLists<uint16_t>();
+                        CheckTriangleLists<uint32_t>();
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(ConversionKernelsTests, LineLists)
+                {
+                    InstructionSetScope scope;
+
+                    for (auto instructionSet : GetSupportedInstructionSets())
+                    {
+                        SetInstructionSet(instructionSet);
+
+                        CheckLineLists<uint16_t>();
+                        CheckLineLists<uint32_t>();
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(ConversionKernelsTests, ExpandRGB8ToRGBA8)
+                {
+                    InstructionSetScope scope;
+
+                    for (auto instructionSet : GetSupportedInstructionSets())
+                    {
+                        SetInstructionSet(instructionSet);
+
+                        for (size_t count = 0U; count <= MaxCount; count++)
+                        {
+                            const auto rgb = MakeValues<uint8_t>(count * 3U);
+                            std::vector<uint32_t> expected(count);
+
+                            for (size_t i = 0U; i < count; i++)
+                            {
+                                expected[i] = 0xFF000000U | rgb[i * 3U + 2U] << 16U | rgb[i * 3U + 1U] << 8U | rgb[i * 3U];
+                            }
+
+                            CheckConversion(rgb, expected, &ExpandRGB8ToRGBA8);
+                        }
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(ConversionKernelsTests, MinMaxFloat3)
+                {
+                    InstructionSetScope scope;
+
+                    for (auto instructionSet : GetSupportedInstructionSets())
+                    {
+                        SetInstructionSet(instructionSet);
+
+                        for (size_t count = 0U; count <= MaxCount; count++)
+                        {
+                            auto values = MakeUnitFloats(count * 3U);
+
+                            for (size_t i = 0U; i < values.size(); i++)
+                            {
+                                values[i] = (values[i] - 0.5f) * static_cast<float>(i % 3U + 1U);
+                            }
+
+                            if (count > 1U)
+                            {
+                                values[count / 2U] = NAN;
+                            }
+
+                            float expectedMin[3] = { 0.25f, 0.25f, 0.25f };
+                            float expectedMax[3] = { 0.25f, 0.25f, 0.25f };
+
+                            for (size_t i = 0U; i < values.size(); i++)
+                            {
+                                if (!std::isnan(values[i]))
+                                {
+                                    expectedMin[i % 3U] = std::min(expectedMin[i % 3U], values[i]);
+                                    expectedMax[i % 3U] = std::max(expectedMax[i % 3U], values[i]);
+                                }
+                            }
+
+                            float min[3] = { 0.25f, 0.25f, 0.25f };
+                            float max[3] = { 0.25f, 0.25f, 0.25f };
+
+                            MinMaxFloat3(values.data(), count, min, max);
+
+                            for (size_t i = 0U; i < 3U; i++)
+                            {
+                                Assert::AreEqual(expectedMin[i], min[i]);
+                                Assert::AreEqual(expectedMax[i], max[i]);
+                            }
+                        }
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(ConversionKernelsTests, NormalizeFloat3)
+                {
+                    InstructionSetScope scope;
+
+                    for (auto instructionSet : GetSupportedInstructionSets())
+                    {
+                        SetInstructionSet(instructionSet);
+
+                        for (size_t count = 0U; count <= MaxCount; count++)
+                        {
+                            auto src = MakeUnitFloats(count * 3U);
+
+                            for (auto& value : src)
+                            {
+                                value = (value - 0.5f) * 10.0f;
+                            }
+
+                            if (count > 1U)
+                            {
+                                std::fill_n(src.begin() + (count / 2U) * 3U, 3U, 0.0f);
+                            }
+
+                            std::vector<float> expected(src.size());
+
+                            for (size_t i = 0U; i < src.size(); i += 3U)
+                            {
+                                const float lengthSquared = src[i] * src[i] + src[i + 1U] * src[i + 1U] + src[i + 2U] * src[i + 2U];
+                                const float scale = lengthSquared > 0.0f ? 1.0f / std::sqrt(lengthSquared) : 0.0f;
+
+                                for (size_t j = 0U; j < 3U; j++)
+                                {
+                                    expected[i + j] = src[i + j] * scale;
+                                }
+                            }
+
+                            CheckConversion(src, expected, [](const float* values, float* dst, size_t floatCount) { NormalizeFloat3(values, dst, floatCount / 3U); });
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,358 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Deserialize.h>
+#include <GLTFSDK/GLBResourceReader.h>
+#include <GLTFSDK/GLBResourceWriter.h>
+#include <GLTFSDK/GLBRewriter.h>
+#include <GLTFSDK/Serialize.h>
+#include "TestUtils.h"
+
+#include <cstdio>
+#include <fstream>
+
+using namespace glTF::UnitTest;
+
+namespace
+{
+    using namespace Microsoft::glTF;
+
+    const std::vector<uint8_t> bufferView0Data = { 0U, 1U, 2U, 3U, 4U, 5U };
+    const std::vector<uint8_t> bufferView1Data = { 10U, 11U, 12U, 13U, 14U, 15U, 16U, 17U };
+    const std::vector<uint8_t> bufferView2Data = { 20U, 21U, 22U, 23U, 24U };
+
+    std::shared_ptr<GLBResourceReader> CreateGLB(const std::shared_ptr<Test::StreamReaderWriter>& readerWriter, const std::string& uri)
+    {
+        auto bufferBuilder = BufferBuilder(std::make_unique<GLBResourceWriter>(readerWriter));
+
+        bufferBuilder.AddBuffer(GLB_BUFFER_ID);
+        bufferBuilder.AddBufferView(bufferView0Data);
+        bufferBuilder.AddBufferView(bufferView1Data);
+        bufferBuilder.AddBufferView(bufferView2Data);
+
+        Document document;
+        bufferBuilder.Output(document);
+
+        auto& glbWriter = static_cast<GLBResourceWriter&>(bufferBuilder.GetResourceWriter());
+        glbWriter.Flush(Serialize(document), uri);
+
+        return std::make_shared<GLBResourceReader>(readerWriter, readerWriter->GetInputStream(uri));
+    }
+
+    void WriteFile(const std::string& path, std::istream& stream)
+    {
+        std::ofstream file(path, std::ios_base::binary | std::ios_base::trunc);
+
+        stream.seekg(0);
+        file << stream.rdbuf();
+    }
+}
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            GLTFSDK_TEST_CLASS(GLBRewriterTests)
+            {
+                GLTFSDK_TEST_METHOD(GLBRewriterTests, GLBRewriter_Unchanged)
+                {
+                    auto readerWriter = std::make_shared<StreamReaderWriter>();
+                    auto glbReader = CreateGLB(readerWriter, "source.glb");
+                    auto document = Deserialize(glbReader->GetJson());
+
+                    GLBRewriter rewriter(glbReader, readerWriter);
+                    rewriter.Update(document);
+                    rewriter.Flush(Serialize(document), "rewritten.glb");
+
+                    GLBResourceReader rewrittenReader(readerWriter, readerWriter->GetInputStream("rewritten.glb"));
+                    auto rewrittenDocument = Deserialize(rewrittenReader.GetJson());
+
+                    Assert::IsTrue(document == rewrittenDocument);
+
+                    AreEqual(bufferView0Data, rewrittenReader.ReadBinaryData<uint8_t>(rewrittenDocument, rewrittenDocument.bufferViews[0]));
+                    AreEqual(bufferView1Data, rewrittenReader.ReadBinaryData<uint8_t>(rewrittenDocument, rewrittenDocument.bufferViews[1]));
+                    AreEqual(bufferView2Data, rewrittenReader.ReadBinaryData<uint8_t>(rewrittenDocument, rewrittenDocument.bufferViews[2]));
+                }
+
+                GLTFSDK_TEST_METHOD(GLBRewriterTests, GLBRewriter_ReplaceBufferView)
+                {
+                    auto readerWriter = std::make_shared<StreamReaderWriter>();
+                    auto glbReader = CreateGLB(readerWriter, "source.glb");
+                    auto document = Deserialize(glbReader->GetJson());
+
+                    const std::vector<uint8_t> replacementData = { 30U, 31U, 32U, 33U, 34U, 35U, 36U, 37U, 38U, 39U, 40U };
+
+                    GLBRewriter rewriter(glbReader, readerWriter);
+                    rewriter.SetBufferViewData(document.bufferViews[1].id, replacementData);
+                    rewriter.Update(document);
+                    rewriter.Flush(Serialize(document), "rewritten.glb");
+
+                    GLBResourceReader rewrittenReader(readerWriter, readerWriter->GetInputStream("rewritten.glb"));
+                    auto rewrittenDocument = Deserialize(rewrittenReader.GetJson());
+
+                    Assert::IsTrue(document == rewrittenDocument);
+                    Assert::AreEqual(replacementData.size(), rewrittenDocument.bufferViews[1].byteLength);
+
+                    for (const auto& bufferView : rewrittenDocument.bufferViews.Elements())
+                    {
+                        Assert::AreEqual<size_t>(0U, bufferView.byteOffset % GLB_BUFFER_OFFSET_ALIGNMENT);
+                    }
+
+                    AreEqual(bufferView0Data, rewrittenReader.ReadBinaryData<uint8_t>(rewrittenDocument, rewrittenDocument.bufferViews[0]));
+                    AreEqual(replacementData, rewrittenReader.ReadBinaryData<uint8_t>(rewrittenDocument, rewrittenDocument.bufferViews[1]));
+                    AreEqual(bufferView2Data, rewrittenReader.ReadBinaryData<uint8_t>(rewrittenDocument, rewrittenDocument.bufferViews[2]));
+                }
+
+                GLTFSDK_TEST_METHOD(GLBRewriterTests, GLBRewriter_UpdateWithBufferViewOrder)
+                {
+                    auto readerWriter = std::make_shared<StreamReaderWriter>();
+                    auto glbReader = CreateGLB(readerWriter, "source.glb");
+                    auto document = Deserialize(glbReader->GetJson());
+                    auto expectedDocument = document;
+
+                    const std::vector<uint8_t> replacementData = { 30U, 31U, 32U, 33U, 34U, 35U, 36U, 37U, 38U, 39U, 40U };
+
+                    GLBRewriter rewriter(glbReader, readerWriter);
+                    rewriter.SetBufferViewData(document.bufferViews[1].id, replacementData);
+
+                    Assert::ExpectException<GLTFException>([&]()
+                    {
+                        rewriter.Update(document, { 1U, 0U, 2U });
+                    });
+
+                    Assert::ExpectException<GLTFException>([&]()
+                    {
+                        rewriter.Update(document, { 0U, 2U });
+                    });
+
+                    Assert::ExpectException<GLTFException>([&]()
+                    {
+                        rewriter.Update(document, { 0U, 1U, 1U, 2U });
+                    });
+
+                    rewriter.Update(document, { 0U, 1U, 2U });
+
+                    GLBRewriter expectedRewriter(glbReader, readerWriter);
+                    expectedRewriter.SetBufferViewData(expectedDocument.bufferViews[1].id, replacementData);
+                    expectedRewriter.Update(expectedDocument);
+
+                    Assert::IsTrue(expectedDocument == document);
+
+                    rewriter.Flush(Serialize(document), "rewritten.glb");
+
+                    GLBResourceReader rewrittenReader(readerWriter, readerWriter->GetInputStream("rewritten.glb"));
+                    auto rewrittenDocument = Deserialize(rewrittenReader.GetJson());
+
+                    AreEqual(bufferView0Data, rewrittenReader.ReadBinaryData<uint8_t>(rewrittenDocument, rewrittenDocument.bufferViews[0]));
+                    AreEqual(replacementData, rewrittenReader.ReadBinaryData<uint8_t>(rewrittenDocument, rewrittenDocument.bufferViews[1]));
+                    AreEqual(bufferView2Data, rewrittenReader.ReadBinaryData<uint8_t>(rewrittenDocument, rewrittenDocument.bufferViews[2]));
+                }
+
+                GLTFSDK_TEST_METHOD(GLBRewriterTests, GLBRewriter_FlushToFile)
+                {
+                    const std::string sourcePath = "GLBRewriter_FlushToFile_source.glb";
+                    const std::string path = "GLBRewriter_FlushToFile_rewritten.glb";
+
+                    auto readerWriter = std::make_shared<StreamReaderWriter>();
+                    CreateGLB(readerWriter, "source.glb");
+                    WriteFile(sourcePath, *readerWriter->GetInputStream("source.glb"));
+
+                    auto glbReader = std::make_shared<GLBResourceReader>(readerWriter, std::make_shared<std::ifstream>(sourcePath, std::ios_base::binary));
+                    auto document = Deserialize(glbReader->GetJson());
+
+                    const std::vector<uint8_t> replacementData = { 30U, 31U, 32U, 33U, 34U, 35U, 36U, 37U, 38U, 39U, 40U };
+
+                    GLBRewriter rewriter(glbReader, readerWriter);
+                    rewriter.SetBufferViewData(document.bufferViews[1].id, replacementData);
+                    rewriter.Update(document);
+
+                    Assert::ExpectException<GLTFException>([&]()
+                    {
+                        rewriter.FlushToFile(Serialize(document), sourcePath, sourcePath);
+                    });
+
+                    rewriter.FlushToFile(Serialize(document), sourcePath, path);
+
+                    // The file written by the kernel copy must match the one written through the stream writer
+                    rewriter.Flush(Serialize(document), "rewritten.glb");
+
+                    std::ifstream file(path, std::ios_base::binary);
+                    std::stringstream fileData;
+                    fileData << file.rdbuf();
+
+                    std::stringstream streamData;
+                    streamData << readerWriter->GetInputStream("rewritten.glb")->rdbuf();
+
+                    Assert::IsTrue(fileData.str() == streamData.str());
+
+                    file.close();
+                    std::remove(sourcePath.c_str());
+                    std::remove(path.c_str());
+                }
+
+                GLTFSDK_TEST_METHOD(GLBRewriterTests, GLBRewriter_ReplaceOverlappingBufferView)
+                {
+                    auto readerWriter = std::make_shared<StreamReaderWriter>();
+                    auto glbReader = CreateGLB(readerWriter, "source.glb");
+                    auto document = Deserialize(glbReader->GetJson());
+
+                    // Make buffer view 2 alias the second half of buffer view 1
+                    BufferView bufferView = document.bufferViews[2];
+                    bufferView.byteOffset = document.bufferViews[1].byteOffset + 4U;
+                    bufferView.byteLength = 4U;
+                    document.bufferViews.Replace(bufferView);
+
+                    GLBRewriter rewriter(glbReader, readerWriter);
+                    rewriter.SetBufferViewData(document.bufferViews[1].id, { 1U, 2U, 3U, 4U });
+
+                    Assert::ExpectException<GLTFException>([&]()
+                    {
+                        rewriter.Update(document);
+                    });
+                }
+
+                GLTFSDK_TEST_METHOD(GLBRewriterTests, GLBRewriter_RemoveBufferView)
+                {
+                    auto readerWriter = std::make_shared<StreamReaderWriter>();
+                    auto glbReader = CreateGLB(readerWriter, "source.glb");
+                    auto document = Deserialize(glbReader->GetJson());
+
+                    const auto bufferViewId = document.bufferViews[1].id;
+
+                    GLBRewriter rewriter(glbReader, readerWriter);
+                    rewriter.RemoveBufferView(bufferViewId);
+                    rewriter.Update(document);
+                    rewriter.Flush(Serialize(document), "rewritten.glb");
+
+                    GLBResourceReader rewrittenReader(readerWriter, readerWriter->GetInputStream("rewritten.glb"));
+                    auto rewrittenDocument = Deserialize(rewrittenReader.GetJson());
+
+                    Assert::IsFalse(document.bufferViews.Has(bufferViewId));
+                    Assert::AreEqual<size_t>(2U, rewrittenDocument.bufferViews.Size());
+                    Assert::AreEqual<size_t>(13U, rewrittenDocument.buffers[0].byteLength);
+
+                    AreEqual(bufferView0Data, rewrittenReader.ReadBinaryData<uint8_t>(rewrittenDocument, rewrittenDocument.bufferViews[0]));
+                    AreEqual(bufferView2Data, rewrittenReader.ReadBinaryData<uint8_t>(rewrittenDocument, rewrittenDocument.bufferViews[1]));
+                }
+
+                GLTFSDK_TEST_METHOD(GLBRewriterTests, GLBRewriter_RemoveReferencedBufferView)
+                {
+                    auto readerWriter = std::make_shared<StreamReaderWriter>();
+                    auto glbReader = CreateGLB(readerWriter, "source.glb");
+                    auto document = Deserialize(glbReader->GetJson());
+
+                    Image image;
+                    image.id = "0";
+                    image.bufferViewId = document.bufferViews[1].id;
+                    image.mimeType = "image/png";
+                    document.images.Append(std::move(image));
+
+                    GLBRewriter rewriter(glbReader, readerWriter);
+                    rewriter.RemoveBufferView(document.bufferViews[1].id);
+
+                    Assert::ExpectException<GLTFException>([&]()
+                    {
+                        rewriter.Update(document);
+                    });
+                }
+
+                GLTFSDK_TEST_METHOD(GLBRewriterTests, RewriteGLBManifest_InPlace)
+                {
+                    auto readerWriter = std::make_shared<StreamReaderWriter>();
+                    auto glbReader = CreateGLB(readerWriter, "source.glb");
+                    auto document = Deserialize(glbReader->GetJson());
+
+                    // Removing the asset's generator shrinks the manifest so it fits in the existing JSON chunk
+                    document.asset.generator.clear();
+
+                    auto stream = std::dynamic_pointer_cast<std::iostream>(readerWriter->GetInputStream("source.glb"));
+                    const auto streamLength = stream->seekg(0, std::ios::end).tellg();
+
+                    Assert::IsTrue(RewriteGLBManifest(*stream, Serialize(document)));
+                    Assert::IsTrue(streamLength == stream->seekg(0, std::ios::end).tellg());
+
+                    stream->seekg(0);
+
+                    GLBResourceReader patchedReader(readerWriter, stream);
+                    auto patchedDocument = Deserialize(patchedReader.GetJson());
+
+                    Assert::IsTrue(document == patchedDocument);
+
+                    AreEqual(bufferView0Data, patchedReader.ReadBinaryData<uint8_t>(patchedDocument, patchedDocument.bufferViews[0]));
+                    AreEqual(bufferView1Data, patchedReader.ReadBinaryData<uint8_t>(patchedDocument, patchedDocument.bufferViews[1]));
+                    AreEqual(bufferView2Data, patchedReader.ReadBinaryData<uint8_t>(patchedDocument, patchedDocument.bufferViews[2]));
+                }
+
+                GLTFSDK_TEST_METHOD(GLBRewriterTests, RewriteGLBManifest_MoveBinaryChunk)
+                {
+                    auto readerWriter = std::make_shared<StreamReaderWriter>();
+                    auto glbReader = CreateGLB(readerWriter, "source.glb");
+                    auto document = Deserialize(glbReader->GetJson());
+
+                    Node node;
+                    node.id = "0";
+                    node.name = std::string(1000U, 'n');
+                    document.nodes.Append(std::move(node));
+
+                    auto stream = std::dynamic_pointer_cast<std::iostream>(readerWriter->GetInputStream("source.glb"));
+
+                    Assert::IsFalse(RewriteGLBManifest(*stream, Serialize(document)));
+
+                    stream->seekg(0);
+
+                    GLBResourceReader patchedReader(readerWriter, stream);
+                    auto patchedDocument = Deserialize(patchedReader.GetJson());
+
+                    Assert::IsTrue(document == patchedDocument);
+
+                    AreEqual(bufferView0Data, patchedReader.ReadBinaryData<uint8_t>(patchedDocument, patchedDocument.bufferViews[0]));
+                    AreEqual(bufferView1Data, patchedReader.ReadBinaryData<uint8_t>(patchedDocument, patchedDocument.bufferViews[1]));
+                    AreEqual(bufferView2Data, patchedReader.ReadBinaryData<uint8_t>(patchedDocument, patchedDocument.bufferViews[2]));
+                }
+
+                GLTFSDK_TEST_METHOD(GLBRewriterTests, RewriteGLBManifest_File)
+                {
+                    const std::string path = "RewriteGLBManifest_File.glb";
+
+                    auto readerWriter = std::make_shared<StreamReaderWriter>();
+                    auto glbReader = CreateGLB(readerWriter, "source.glb");
+                    auto document = Deserialize(glbReader->GetJson());
+
+                    WriteFile(path, *readerWriter->GetInputStream("source.glb"));
+
+                    // Patch the file twice: first with a manifest that needs the BIN chunk to move, then in place
+                    Node node;
+                    node.id = "0";
+                    node.name = std::string(1000U, 'n');
+                    document.nodes.Append(std::move(node));
+
+                    Assert::IsFalse(RewriteGLBManifest(path, Serialize(document)));
+
+                    document.asset.generator.clear();
+
+                    Assert::IsTrue(RewriteGLBManifest(path, Serialize(document)));
+
+                    auto stream = std::make_shared<std::ifstream>(path, std::ios_base::binary);
+
+                    {
+                        GLBResourceReader patchedReader(readerWriter, stream);
+                        auto patchedDocument = Deserialize(patchedReader.GetJson());
+
+                        Assert::IsTrue(document == patchedDocument);
+
+                        AreEqual(bufferView0Data, patchedReader.ReadBinaryData<uint8_t>(patchedDocument, patchedDocument.bufferViews[0]));
+                        AreEqual(bufferView1Data, patchedReader.ReadBinaryData<uint8_t>(patchedDocument, patchedDocument.bufferViews[1]));
+                        AreEqual(bufferView2Data, patchedReader.ReadBinaryData<uint8_t>(patchedDocument, patchedDocument.bufferViews[2]));
+                    }
+
+                    stream->close();
+                    std::remove(path.c_str());
+                }
+            };
+        }
+    }
+}
@@ -7,6 +7,8 @@
 #include <GLTFSDK/Extension.h>
 #include <GLTFSDK/ExtensionHandlers.h>
 #include <GLTFSDK/ExtensionsKHR.h>
+#include <GLTFSDK/ExtensionsMOZ.h>
+#include <GLTFSDK/ExtensionsMSFT.h>
 #include <GLTFSDK/RapidJsonUtils.h>
 #include <GLTFSDK/Serialize.h>
 #include <GLTFSDK/SchemaValidation.h>
@@ -287,6 +289,71 @@ R"({
     }
   ]
 })";
+
+    constexpr const char extensionKHRTextureBasisU[] =
+R"({
+    "asset": {
+        "version": "2.0"
+    },
+    "extensionsUsed": [
+        "KHR_texture_basisu",
+        "MOZ_HUBS_texture_basis"
+    ],
+    "textures": [
+        {
+            "source": 0,
+            "extensions": {
+                "KHR_texture_basisu": {
+                    "source": 1
+                }
+            }
+        },
+        {
+            "extensions": {
+                "MOZ_HUBS_texture_basis": {
+                    "source": 2
+                }
+            }
+        }
+    ],
+    "images": [
+        {
+            "uri": "fallback.png"
+        },
+        {
+            "uri": "texture.ktx2"
+        },
+        {
+            "uri": "texture.basis"
+        }
+    ]
+})";
+
+    constexpr const char extensionMSFTLod[] =
+R"({
+    "asset": {
+        "version": "2.0"
+    },
+    "extensionsUsed": [
+        "MSFT_lod"
+    ],
+    "nodes": [
+        {
+            "name": "high",
+            "extensions": {
+                "MSFT_lod": {
+                    "ids": [ 1, 2 ]
+                }
+            }
+        },
+        {
+            "name": "medium"
+        },
+        {
+            "name": "low"
+        }
+    ]
+})";
 }
 
 namespace Microsoft
@@ -555,6 +622,76 @@ namespace Microsoft
                     Assert::IsTrue(doc == roundTrippedDoc, L"Input gltf and output gltf are not equal");
                 }
 
+                GLTFSDK_TEST_METHOD(ExtensionsTests, Extensions_Test_TextureBasisU)
+                {
+                    const auto extensionDeserializer = MOZ::GetMOZExtensionDeserializer(KHR::GetKHRExtensionDeserializer());
+                    auto doc = Deserialize(extensionKHRTextureBasisU, extensionDeserializer);
+
+                    Assert::IsTrue(doc.textures.Size() == 2);
+
+                    Assert::IsTrue(doc.textures[0].HasExtension<KHR::Textures::TextureBasisU>());
+                    Assert::AreEqual<std::string>(doc.textures[0].imageId, "0");
+                    Assert::AreEqual<std::string>(doc.textures[0].GetExtension<KHR::Textures::TextureBasisU>().imageId, "1");
+
+                    Assert::IsTrue(doc.textures[1].HasExtension<MOZ::Textures::HubsTextureBasis>());
+                    Assert::IsTrue(doc.textures[1].imageId.empty());
+                    Assert::AreEqual<std::string>(doc.textures[1].GetExtension<MOZ::Textures::HubsTextureBasis>().imageId, "2");
+
+                    const auto extensionSerializer = MOZ::GetMOZExtensionSerializer(KHR::GetKHRExtensionSerializer());
+                    auto outputJson = Serialize(doc, extensionSerializer);
+
+                    auto roundTrippedDoc = Deserialize(outputJson, extensionDeserializer);
+                    Assert::IsTrue(doc == roundTrippedDoc, L"Input gltf and output gltf are not equal");
+                }
+
+                GLTFSDK_TEST_METHOD(ExtensionsTests, Extensions_Test_TextureBasisU_MissingSource)
+                {
+                    const auto extensionDeserializer = KHR::GetKHRExtensionDeserializer();
+
+                    Assert::ExpectException<GLTFException>([&extensionDeserializer]()
+                    {
+                        KHR::Textures::DeserializeTextureBasisU("{}", extensionDeserializer);
+                    });
+                }
+
+                GLTFSDK_TEST_METHOD(ExtensionsTests, Extensions_Test_HubsTextureBasis_KHROnly)
+                {
+                    // MOZ_HUBS_texture_basis is left as an unregistered extension unless the MOZ handlers are added
+                    auto doc = Deserialize(extensionKHRTextureBasisU, KHR::GetKHRExtensionDeserializer());
+
+                    Assert::IsTrue(doc.textures[0].HasExtension<KHR::Textures::TextureBasisU>());
+                    Assert::IsFalse(doc.textures[1].HasExtension<MOZ::Textures::HubsTextureBasis>());
+                    Assert::IsTrue(doc.textures[1].HasUnregisteredExtension(MOZ::Textures::HUBSTEXTUREBASIS_NAME));
+                }
+
+                GLTFSDK_TEST_METHOD(ExtensionsTests, Extensions_Test_Lod)
+                {
+                    const auto extensionDeserializer = MSFT::GetMSFTExtensionDeserializer();
+                    auto doc = Deserialize(extensionMSFTLod, extensionDeserializer);
+
+                    Assert::IsTrue(doc.nodes[0].HasExtension<MSFT::Nodes::Lod>());
+                    Assert::IsFalse(doc.nodes[1].HasExtension<MSFT::Nodes::Lod>());
+
+                    const std::vector<std::string> expectedIds = { "1", "2" };
+                    Assert::IsTrue(expectedIds == doc.nodes[0].GetExtension<MSFT::Nodes::Lod>().ids);
+
+                    const auto extensionSerializer = MSFT::GetMSFTExtensionSerializer();
+                    auto outputJson = Serialize(doc, extensionSerializer);
+
+                    auto roundTrippedDoc = Deserialize(outputJson, extensionDeserializer);
+                    Assert::IsTrue(doc == roundTrippedDoc, L"Input gltf and output gltf are not equal");
+                }
+
+                GLTFSDK_TEST_METHOD(ExtensionsTests, Extensions_Test_Lod_InvalidIds)
+                {
+                    const auto extensionDeserializer = MSFT::GetMSFTExtensionDeserializer();
+
+                    Assert::ExpectException<GLTFException>([&extensionDeserializer]()
+                    {
+                        MSFT::Nodes::DeserializeLod(R"({ "ids": [ "1" ] })", extensionDeserializer);
+                    });
+                }
+
                 GLTFSDK_TEST_METHOD(ExtensionsTests, Extensions_Test_RoundTrip_And_Equality_TextureTransform)
                 {
                     const auto inputJson = ReadLocalJson(c_textureTransformTestJson);
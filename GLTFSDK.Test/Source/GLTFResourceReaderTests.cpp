@@ -798,6 +798,29 @@ namespace Microsoft
                     Assert::AreEqual<float>(data[5], -1.f);
                 }
 
+                GLTFSDK_TEST_METHOD(GLTFResourceReaderTests, TestReadFloatData_InvalidCount)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    std::vector<uint8_t> values = { 0, 1, 254, 255 };
+                    auto accessor = bufferBuilder.AddAccessor(values, { TYPE_VEC4, COMPONENT_UNSIGNED_BYTE });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    // The accessor is validated against its buffer view before any output is allocated for its count
+                    accessor.count = size_t(1) << 40;
+
+                    GLTFResourceReader reader(readerWriter);
+                    Assert::ExpectException<GLTFException>([&]()
+                    {
+                        reader.ReadFloatData(doc, accessor);
+                    });
+                }
             };
         }
     }
@@ -0,0 +1,193 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/ImageUtils.h>
+
+#include "TestUtils.h"
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            namespace
+            {
+                // 300x200 RGBA, 8 bits per channel (signature and IHDR chunk only)
+                const std::vector<uint8_t> PNGHeader =
+                {
+                    0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n',
+                    0x00, 0x00, 0x00, 0x0D, 'I', 'H', 'D', 'R',
+                    0x00, 0x00, 0x01, 0x2C, 0x00, 0x00, 0x00, 0xC8,
+                    0x08, 0x06, 0x00, 0x00, 0x00
+                };
+
+                // 256x128 RGB (3 components) baseline JPEG preceded by an APPn segment of the specified length
+                std::vector<uint8_t> MakeJPEGHeader(uint16_t appSegmentLength)
+                {
+                    std::vector<uint8_t> data = { 0xFF, 0xD8, 0xFF, 0xE1, static_cast<uint8_t>(appSegmentLength >> 8), static_cast<uint8_t>(appSegmentLength & 0xFF) };
+                    data.resize(data.size() + appSegmentLength - 2U, 0x00);
+
+                    const std::vector<uint8_t> sof0 = { 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x80, 0x01, 0x00, 0x03 };
+                    data.insert(data.end(), sof0.begin(), sof0.end());
+
+                    return data;
+                }
+
+                // 64x32 ETC1S (Basis Universal) KTX2 with an RGB and an alpha slice
+                std::vector<uint8_t> MakeKTX2Header()
+                {
+                    std::vector<uint8_t> data(80U + 60U, 0x00);
+
+                    const uint8_t identifier[] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+                    std::copy(std::begin(identifier), std::end(identifier), data.begin());
+
+                    auto write32 = [&data](size_t offset, uint32_t value)
+                    {
+                        for (size_t i = 0; i < 4U; i++)
+                        {
+                            data[offset + i] = static_cast<uint8_t>(value >> (i * 8U));
+                        }
+                    };
+
+                    write32(12U, 0U);   // vkFormat (VK_FORMAT_UNDEFINED)
+                    write32(16U, 1U);   // typeSize
+                    write32(20U, 64U);  // pixelWidth
+                    write32(24U, 32U);  // pixelHeight
+                    write32(48U, 80U);  // dfdByteOffset
+                    write32(52U, 60U);  // dfdByteLength
+
+                    write32(80U, 60U);                 // dfdTotalSize
+                    write32(88U, 2U | (56U << 16U));   // versionNumber, descriptorBlockSize
+                    data[92U] = 163U;                  // KHR_DF_MODEL_ETC1S
+                    data[108U + 3U] = 0U;              // Sample 0 - RGB
+                    data[124U + 3U] = 15U;             // Sample 1 - AAA
+
+                    return data;
+                }
+            }
+
+            GLTFSDK_TEST_CLASS(ImageUtilsTests)
+            {
+                GLTFSDK_TEST_METHOD(ImageUtilsTests, ParseImageInfo_PNG)
+                {
+                    auto info = ImageUtils::ParseImageInfo(PNGHeader);
+
+                    Assert::IsTrue(info.format == ImageFormat::PNG);
+                    Assert::AreEqual(300U, info.width);
+                    Assert::AreEqual(200U, info.height);
+                    Assert::AreEqual(8U, info.bitDepth);
+                    Assert::AreEqual(4U, info.channelCount);
+                    Assert::IsFalse(info.IsPowerOfTwo());
+                }
+
+                GLTFSDK_TEST_METHOD(ImageUtilsTests, ParseImageInfo_PNG_Truncated)
+                {
+                    Assert::ExpectException<GLTFException>([]()
+                    {
+                        ImageUtils::ParseImageInfo(PNGHeader.data(), 20U);
+                    });
+                }
+
+                GLTFSDK_TEST_METHOD(ImageUtilsTests, ParseImageInfo_JPEG)
+                {
+                    auto info = ImageUtils::ParseImageInfo(MakeJPEGHeader(16U));
+
+                    Assert::IsTrue(info.format == ImageFormat::JPEG);
+                    Assert::AreEqual(256U, info.width);
+                    Assert::AreEqual(128U, info.height);
+                    Assert::AreEqual(8U, info.bitDepth);
+                    Assert::AreEqual(3U, info.channelCount);
+                    Assert::IsTrue(info.IsPowerOfTwo());
+                }
+
+                GLTFSDK_TEST_METHOD(ImageUtilsTests, ParseImageInfo_KTX2)
+                {
+                    auto info = ImageUtils::ParseImageInfo(MakeKTX2Header());
+
+                    Assert::IsTrue(info.format == ImageFormat::KTX2);
+                    Assert::AreEqual(64U, info.width);
+                    Assert::AreEqual(32U, info.height);
+                    Assert::AreEqual(4U, info.channelCount);
+                    Assert::IsTrue(info.IsPowerOfTwo());
+                }
+
+                GLTFSDK_TEST_METHOD(ImageUtilsTests, ParseImageInfo_WebP)
+                {
+                    // 400x301 lossless image with alpha
+                    const uint32_t bits = (400U - 1U) | ((301U - 1U) << 14U) | (1U << 28U);
+                    const std::vector<uint8_t> vp8l =
+                    {
+                        'R', 'I', 'F', 'F', 0x00, 0x00, 0x00, 0x00, 'W', 'E', 'B', 'P',
+                        'V', 'P', '8', 'L', 0x00, 0x00, 0x00, 0x00, 0x2F,
+                        static_cast<uint8_t>(bits), static_cast<uint8_t>(bits >> 8U), static_cast<uint8_t>(bits >> 16U), static_cast<uint8_t>(bits >> 24U),
+                        0x00, 0x00, 0x00, 0x00, 0x00
+                    };
+
+                    auto info = ImageUtils::ParseImageInfo(vp8l);
+
+                    Assert::IsTrue(info.format == ImageFormat::WebP);
+                    Assert::AreEqual(400U, info.width);
+                    Assert::AreEqual(301U, info.height);
+                    Assert::AreEqual(4U, info.channelCount);
+
+                    // 1024x512 lossy image
+                    const std::vector<uint8_t> vp8 =
+                    {
+                        'R', 'I', 'F', 'F', 0x00, 0x00, 0x00, 0x00, 'W', 'E', 'B', 'P',
+                        'V', 'P', '8', ' ', 0x00, 0x00, 0x00, 0x00,
+                        0x00, 0x00, 0x00, 0x9D, 0x01, 0x2A, 0x00, 0x04, 0x00, 0x02
+                    };
+
+                    info = ImageUtils::ParseImageInfo(vp8);
+
+                    Assert::IsTrue(info.format == ImageFormat::WebP);
+                    Assert::AreEqual(1024U, info.width);
+                    Assert::AreEqual(512U, info.height);
+                    Assert::AreEqual(3U, info.channelCount);
+                }
+
+                GLTFSDK_TEST_METHOD(ImageUtilsTests, ParseImageInfo_Unknown)
+                {
+                    const std::vector<uint8_t> data = { 'G', 'I', 'F', '8', '9', 'a' };
+
+                    auto info = ImageUtils::ParseImageInfo(data);
+
+                    Assert::IsTrue(info.format == ImageFormat::Unknown);
+                }
+
+                GLTFSDK_TEST_METHOD(ImageUtilsTests, ReadImageInfo_BufferView)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    // The large metadata segment means the frame header isn't within the first few KB of the image
+                    const auto jpeg = MakeJPEGHeader(20000U);
+
+                    bufferBuilder.AddBuffer();
+                    auto bufferView = bufferBuilder.AddBufferView(jpeg);
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    Image image;
+                    image.id = "0";
+                    image.bufferViewId = bufferView.id;
+                    image.mimeType = "image/jpeg";
+
+                    GLTFResourceReader reader(readerWriter);
+                    auto info = ImageUtils::ReadImageInfo(doc, reader, image);
+
+                    Assert::IsTrue(info.format == ImageFormat::JPEG);
+                    Assert::AreEqual(256U, info.width);
+                    Assert::AreEqual(128U, info.height);
+                }
+            };
+        }
+    }
+}
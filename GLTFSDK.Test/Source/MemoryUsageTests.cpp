@@ -0,0 +1,153 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Deserialize.h>
+#include <GLTFSDK/ExtensionsKHR.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/MemoryUsage.h>
+#include <GLTFSDK/Serialize.h>
+
+#include "TestUtils.h"
+#include <TestUtilsCommon/AllocationCounter.h>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            namespace
+            {
+                std::string CreateManifest(size_t nodeCount)
+                {
+                    Document doc;
+
+                    Scene scene;
+                    scene.id = "0";
+
+                    for (size_t i = 0U; i < nodeCount; i++)
+                    {
+                        Node node;
+                        node.id = std::to_string(i);
+                        node.name = "Node" + std::to_string(i);
+                        node.translation = { 1.0f, 2.0f, 3.0f };
+
+                        scene.nodes.push_back(node.id);
+                        doc.nodes.Append(std::move(node));
+                    }
+
+                    doc.SetDefaultScene(std::move(scene));
+
+                    return Serialize(doc);
+                }
+
+                // Returns the number of allocations made by ReadBinaryData for a float accessor with 'count' elements
+                size_t CountReadBinaryDataAllocations(size_t count)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+
+                    BufferBuilder bufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView();
+                    bufferBuilder.AddAccessor(std::vector<float>(count, 1.0f), { TYPE_SCALAR, COMPONENT_FLOAT });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    // Read once first so the buffer's stream is cached and isn't part of the count
+                    reader.ReadBinaryData<float>(doc, doc.accessors.Front());
+
+                    AllocationCounter counter;
+                    reader.ReadBinaryData<float>(doc, doc.accessors.Front());
+
+                    return counter.GetCount();
+                }
+            }
+
+            GLTFSDK_TEST_CLASS(MemoryUsageTests)
+            {
+                GLTFSDK_TEST_METHOD(MemoryUsageTests, EstimateMemoryUsage_Empty)
+                {
+                    Document doc;
+
+                    Assert::IsTrue(doc.EstimateMemoryUsage() >= sizeof(Document));
+                }
+
+                GLTFSDK_TEST_METHOD(MemoryUsageTests, EstimateMemoryUsage_Strings)
+                {
+                    Document doc;
+                    const auto sizeEmpty = doc.EstimateMemoryUsage();
+
+                    Node node;
+                    node.id = "0";
+                    node.name = std::string(1000U, 'n');
+                    node.extras = std::string(500U, 'e');
+                    doc.nodes.Append(std::move(node));
+
+                    Assert::IsTrue(doc.EstimateMemoryUsage() >= sizeEmpty + sizeof(Node) + 1500U);
+                }
+
+                GLTFSDK_TEST_METHOD(MemoryUsageTests, EstimateMemoryUsage_RegisteredExtensions)
+                {
+                    Material material;
+                    material.id = "0";
+
+                    const auto sizeWithoutExtension = MemoryUsage::EstimateHeapSize(material);
+
+                    KHR::Materials::PBRSpecularGlossiness specGloss;
+                    specGloss.diffuseTexture.textureId = std::string(100U, 't');
+                    material.SetExtension<KHR::Materials::PBRSpecularGlossiness>(specGloss);
+
+                    Assert::IsTrue(MemoryUsage::EstimateHeapSize(material) >= sizeWithoutExtension + sizeof(KHR::Materials::PBRSpecularGlossiness) + 100U);
+                }
+
+                GLTFSDK_TEST_METHOD(MemoryUsageTests, EstimateMemoryUsage_Deserialize)
+                {
+                    const auto doc100 = Deserialize(CreateManifest(100U));
+                    const auto doc200 = Deserialize(CreateManifest(200U));
+
+                    const auto size100 = doc100.EstimateMemoryUsage();
+                    const auto size200 = doc200.EstimateMemoryUsage();
+
+                    Assert::IsTrue(size100 > 100U * sizeof(Node));
+                    Assert::IsTrue(size200 > size100 + 100U * sizeof(Node));
+                }
+
+                GLTFSDK_TEST_METHOD(MemoryUsageTests, Deserialize_Allocations)
+                {
+                    const auto manifest100 = CreateManifest(100U);
+                    const auto manifest200 = CreateManifest(200U);
+
+                    AllocationCounter counter100;
+                    Deserialize(manifest100);
+                    const auto allocations100 = counter100.GetCount();
+
+                    AllocationCounter counter200;
+                    Deserialize(manifest200);
+                    const auto allocations200 = counter200.GetCount();
+
+                    Assert::IsTrue(allocations200 > allocations100);
+
+                    // Guards the allocations made per deserialized node. This is currently around 10 (the node's
+                    // strings, its entry in the id -> index map etc.) but is generous enough for debug builds
+                    // where the standard library allocates additional bookkeeping for each container.
+                    const auto allocationsPerNode = (allocations200 - allocations100) / 100U;
+
+                    Assert::IsTrue(allocationsPerNode <= 32U);
+                }
+
+                GLTFSDK_TEST_METHOD(MemoryUsageTests, ReadBinaryData_Allocations)
+                {
+                    // Reading an accessor should only allocate the returned vector, no matter how many elements it has
+                    Assert::AreEqual<size_t>(CountReadBinaryDataAllocations(16U), CountReadBinaryDataAllocations(4096U));
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,552 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/MeshOptimizer.h>
+#include <GLTFSDK/MeshPrimitiveUtils.h>
+
+#include "TestUtils.h"
+
+#include <TestUtilsCommon/MeshTestUtils.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <numeric>
+
+using namespace glTF::UnitTest;
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            namespace
+            {
+                typedef std::array<uint32_t, 3> Triangle;
+
+                std::vector<Triangle> GetTriangles(const std::vector<uint32_t>& indices)
+                {
+                    std::vector<Triangle> triangles(indices.size() / 3U);
+
+                    for (size_t i = 0U; i < triangles.size(); i++)
+                    {
+                        triangles[i] = { indices[i * 3U], indices[i * 3U + 1U], indices[i * 3U + 2U] };
+                    }
+
+                    return triangles;
+                }
+
+                // The triangles of a grid of 'size' x 'size' vertices, shuffled so that they make poor use of the cache
+                std::vector<uint32_t> MakeShuffledGrid(uint32_t size)
+                {
+                    auto triangles = GetTriangles(MakeGridIndices(size - 1U));
+
+                    uint32_t state = 12345U;
+
+                    for (size_t i = triangles.size() - 1U; i > 0U; i--)
+                    {
+                        state = state * 1664525U + 1013904223U;
+                        std::swap(triangles[i], triangles[state % (i + 1U)]);
+                    }
+
+                    std::vector<uint32_t> indices;
+
+                    for (const auto& triangle : triangles)
+                    {
+                        indices.insert(indices.end(), triangle.begin(), triangle.end());
+                    }
+
+                    return indices;
+                }
+
+                // Each triangle's vertex attributes, in order, so that primitives can be compared regardless of how
+                // their vertices and triangles are ordered
+                std::vector<std::vector<float>> GetTriangleAttributes(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
+                {
+                    const auto indices = MeshPrimitiveUtils::GetIndices32(doc, reader, meshPrimitive);
+                    const auto positions = MeshPrimitiveUtils::GetPositions(doc, reader, meshPrimitive);
+                    const auto colors = reader.ReadBinaryData<uint8_t>(doc, doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_COLOR_0)));
+                    const auto targetPositions = MeshPrimitiveUtils::GetPositions(doc, reader, meshPrimitive.targets.at(0));
+
+                    std::vector<std::vector<float>> triangles;
+
+                    for (size_t i = 0U; i < indices.size(); i += 3U)
+                    {
+                        std::vector<float> triangle;
+
+                        for (size_t j = i; j < i + 3U; j++)
+                        {
+                            triangle.insert(triangle.end(), positions.begin() + indices[j] * 3U, positions.begin() + indices[j] * 3U + 3U);
+                            triangle.insert(triangle.end(), colors.begin() + indices[j] * 3U, colors.begin() + indices[j] * 3U + 3U);
+                            triangle.insert(triangle.end(), targetPositions.begin() + indices[j] * 3U, targetPositions.begin() + indices[j] * 3U + 3U);
+                        }
+
+                        triangles.push_back(std::move(triangle));
+                    }
+
+                    std::sort(triangles.begin(), triangles.end());
+
+                    return triangles;
+                }
+            }
+
+            GLTFSDK_TEST_CLASS(MeshOptimizerTests)
+            {
+                GLTFSDK_TEST_METHOD(MeshOptimizerTests, MeshOptimizer_Test_AnalyzeVertexCache)
+                {
+                    const std::vector<uint32_t> indices = { 0, 1, 2, 0, 1, 2, 2, 1, 3 };
+
+                    auto statistics = MeshOptimizer::AnalyzeVertexCache(indices, 4U);
+
+                    Assert::AreEqual<size_t>(4U, statistics.transformedVertexCount);
+                    Assert::AreEqual(4.0f / 3.0f, statistics.acmr);
+                    Assert::AreEqual(1.0f, statistics.atvr);
+
+                    // With room for only two vertices the repeated triangle misses on each of its vertices
+                    statistics = MeshOptimizer::AnalyzeVertexCache(indices, 4U, 2U);
+
+                    Assert::AreEqual<size_t>(7U, statistics.transformedVertexCount);
+                    Assert::AreEqual(7.0f / 3.0f, statistics.acmr);
+                    Assert::AreEqual(7.0f / 4.0f, statistics.atvr);
+                }
+
+                GLTFSDK_TEST_METHOD(MeshOptimizerTests, MeshOptimizer_Test_OptimizeVertexCache)
+                {
+                    const uint32_t size = 40U;
+                    const auto indices = MakeShuffledGrid(size);
+
+                    const auto optimized = MeshOptimizer::OptimizeVertexCache(indices, size * size);
+
+                    // Triangles are reordered but not otherwise changed
+                    auto expectedTriangles = GetTriangles(indices);
+                    auto actualTriangles = GetTriangles(optimized);
+
+                    std::sort(expectedTriangles.begin(), expectedTriangles.end());
+                    std::sort(actualTriangles.begin(), actualTriangles.end());
+
+                    Assert::IsTrue(expectedTriangles == actualTriangles);
+
+                    const auto before = MeshOptimizer::AnalyzeVertexCache(indices, size * size);
+                    const auto after = MeshOptimizer::AnalyzeVertexCache(optimized, size * size);
+
+                    Assert::IsTrue(before.acmr > 2.0f);
+                    Assert::IsTrue(after.acmr < 0.8f);
+                    Assert::IsTrue(after.atvr < 1.6f);
+                }
+
+                GLTFSDK_TEST_METHOD(MeshOptimizerTests, MeshOptimizer_Test_OptimizeVertexCache_InvalidIndex)
+                {
+                    Assert::ExpectException<GLTFException>([]() { MeshOptimizer::OptimizeVertexCache({ 0, 1, 2, 1, 2, 3 }, 3U); });
+                    Assert::ExpectException<GLTFException>([]() { MeshOptimizer::OptimizeVertexCache({ 0, 1, 2, 1 }, 3U); });
+                }
+
+                GLTFSDK_TEST_METHOD(MeshOptimizerTests, MeshOptimizer_Test_OptimizeVertexFetch)
+                {
+                    size_t vertexCount = 6U;
+                    const auto remap = MeshOptimizer::OptimizeVertexFetch({ 3, 1, 3, 4, 1, 0 }, vertexCount);
+
+                    const std::vector<uint32_t> expected = { 3, 1, MeshOptimizer::InvalidIndex, 0, 2, MeshOptimizer::InvalidIndex };
+                    AreEqual(expected, remap);
+                    Assert::AreEqual<size_t>(4U, vertexCount);
+                }
+
+                GLTFSDK_TEST_METHOD(MeshOptimizerTests, MeshOptimizer_Test_RemapVertices)
+                {
+                    MeshOptimizer::MeshData meshData;
+                    meshData.indices = { 0, 2, 3 };
+                    meshData.vertexCount = 4U;
+
+                    MeshOptimizer::VertexStream stream;
+                    stream.semantic = ACCESSOR_TEXCOORD_0;
+                    stream.accessorType = TYPE_SCALAR;
+                    stream.componentType = COMPONENT_UNSIGNED_SHORT;
+                    stream.data = { 0, 1, 2, 3, 4, 5, 6, 7 };
+                    meshData.attributes.push_back(stream);
+
+                    MeshOptimizer::RemapVertices(meshData, { 2, MeshOptimizer::InvalidIndex, 0, 1 }, 3U);
+
+                    const std::vector<uint32_t> expectedIndices = { 2, 0, 1 };
+                    const std::vector<uint8_t> expectedData = { 4, 5, 6, 7, 0, 1 };
+                    AreEqual(expectedIndices, meshData.indices);
+                    AreEqual(expectedData, meshData.attributes[0].data);
+                    Assert::AreEqual<size_t>(3U, meshData.vertexCount);
+
+                    // The remapping can't remove a vertex that is still referenced
+                    Assert::ExpectException<GLTFException>([&meshData]() { MeshOptimizer::RemapVertices(meshData, { 0, 1, MeshOptimizer::InvalidIndex }, 2U); });
+                }
+
+                GLTFSDK_TEST_METHOD(MeshOptimizerTests, MeshOptimizer_Test_OptimizeVertexOrder)
+                {
+                    const uint32_t size = 24U;
+                    const uint32_t vertexCount = size * size + 1U; // The last vertex is unreferenced
+
+                    std::vector<float> positions;
+                    std::vector<uint8_t> colors;
+                    std::vector<float> targetPositions;
+
+                    for (uint32_t i = 0U; i < vertexCount; i++)
+                    {
+                        positions.insert(positions.end(), { static_cast<float>(i % size), static_cast<float>(i / size), 0.0f });
+                        colors.insert(colors.end(), { static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8U), 0xFF });
+                        targetPositions.insert(targetPositions.end(), { 0.0f, 0.0f, static_cast<float>(i) });
+                    }
+
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+
+                    MeshPrimitive meshPrimitive;
+                    MorphTarget target;
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ELEMENT_ARRAY_BUFFER);
+                    meshPrimitive.indicesAccessorId = bufferBuilder.AddAccessor(MakeShuffledGrid(size), { TYPE_SCALAR, COMPONENT_UNSIGNED_INT }).id;
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    meshPrimitive.attributes[ACCESSOR_POSITION] = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT }).id;
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    meshPrimitive.attributes[ACCESSOR_COLOR_0] = bufferBuilder.AddAccessor(colors, { TYPE_VEC3, COMPONENT_UNSIGNED_BYTE, true }).id;
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    target.positionsAccessorId = bufferBuilder.AddAccessor(targetPositions, { TYPE_VEC3, COMPONENT_FLOAT }).id;
+                    meshPrimitive.targets.push_back(target);
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    auto optimizedBuilder = MakeRewriteBufferBuilder(readerWriter, "optimized");
+
+                    MeshOptimizer::VertexOrderStatistics statistics;
+                    const auto optimizedPrimitive = MeshOptimizer::OptimizeVertexOrder(doc, reader, meshPrimitive, optimizedBuilder, &statistics);
+
+                    optimizedBuilder.Output(doc);
+
+                    Assert::IsTrue(statistics.after.acmr < statistics.before.acmr);
+                    Assert::IsTrue(statistics.after.atvr < statistics.before.atvr);
+
+                    const auto& indicesAccessor = doc.accessors.Get(optimizedPrimitive.indicesAccessorId);
+                    const auto& positionsAccessor = doc.accessors.Get(optimizedPrimitive.GetAttributeAccessorId(ACCESSOR_POSITION));
+                    const auto& colorsAccessor = doc.accessors.Get(optimizedPrimitive.GetAttributeAccessorId(ACCESSOR_COLOR_0));
+
+                    Assert::IsTrue(COMPONENT_UNSIGNED_SHORT == indicesAccessor.componentType);
+                    Assert::AreEqual<size_t>(size * size, positionsAccessor.count);
+                    Assert::IsTrue(colorsAccessor.normalized);
+                    Assert::AreEqual<size_t>(4U, doc.bufferViews.Get(colorsAccessor.bufferViewId).byteStride.Get());
+
+                    const std::vector<float> expectedMin = { 0.0f, 0.0f, 0.0f };
+                    const std::vector<float> expectedMax = { size - 1.0f, size - 1.0f, 0.0f };
+                    AreEqual(expectedMin, positionsAccessor.min);
+                    AreEqual(expectedMax, positionsAccessor.max);
+
+                    // Each vertex is first used in order
+                    const auto indices = MeshPrimitiveUtils::GetIndices32(doc, reader, optimizedPrimitive);
+                    uint32_t nextVertex = 0U;
+
+                    for (uint32_t index : indices)
+                    {
+                        Assert::IsTrue(index <= nextVertex);
+                        nextVertex = std::max(nextVertex, index + 1U);
+                    }
+
+                    Assert::IsTrue(GetTriangleAttributes(doc, reader, meshPrimitive) == GetTriangleAttributes(doc, reader, optimizedPrimitive));
+                }
+
+                GLTFSDK_TEST_METHOD(MeshOptimizerTests, MeshOptimizer_Test_WeldVertices)
+                {
+                    // The two triangles of a quad, without any shared vertices
+                    const std::vector<float> positions = {
+                        0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+                        1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f
+                    };
+                    const std::vector<float> texCoords = {
+                        0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f,
+                        1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f
+                    };
+
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+
+                    MeshPrimitive meshPrimitive;
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    meshPrimitive.attributes[ACCESSOR_POSITION] = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT }).id;
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    meshPrimitive.attributes[ACCESSOR_TEXCOORD_0] = bufferBuilder.AddAccessor(texCoords, { TYPE_VEC2, COMPONENT_FLOAT }).id;
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    auto weldedBuilder = MakeRewriteBufferBuilder(readerWriter, "welded");
+
+                    const auto weldedPrimitive = MeshOptimizer::WeldVertices(doc, reader, meshPrimitive, weldedBuilder);
+
+                    weldedBuilder.Output(doc);
+
+                    const std::vector<uint32_t> expectedIndices = { 0, 1, 2, 1, 3, 2 };
+                    const std::vector<float> expectedPositions = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f };
+                    const std::vector<float> expectedTexCoords = { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+
+                    AreEqual(expectedIndices, MeshPrimitiveUtils::GetIndices32(doc, reader, weldedPrimitive));
+                    AreEqual(expectedPositions, MeshPrimitiveUtils::GetPositions(doc, reader, weldedPrimitive));
+                    AreEqual(expectedTexCoords, MeshPrimitiveUtils::GetTexCoords_0(doc, reader, weldedPrimitive));
+                }
+
+                GLTFSDK_TEST_METHOD(MeshOptimizerTests, MeshOptimizer_Test_WeldVertices_Epsilon)
+                {
+                    MeshOptimizer::MeshData meshData;
+                    meshData.indices = { 0, 1, 2, 3, 4, 5 };
+                    meshData.vertexCount = 6U;
+                    meshData.attributes.push_back(MakeFloatStream(ACCESSOR_POSITION, TYPE_VEC3, {
+                        0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+                        1.00001f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, -0.00001f, 1.0f, 0.0f
+                    }));
+                    meshData.attributes.push_back(MakeFloatStream(ACCESSOR_NORMAL, TYPE_VEC3, {
+                        0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f,
+                        0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.00001f, 0.99999f
+                    }));
+
+                    MeshOptimizer::WeldOptions options;
+                    size_t vertexCount;
+
+                    // Vertices must be bit-identical by default
+                    MeshOptimizer::GenerateWeldRemap(meshData, vertexCount, options);
+                    Assert::AreEqual<size_t>(6U, vertexCount);
+
+                    // The last vertex's normal still differs
+                    options.positionEpsilon = 0.001f;
+                    MeshOptimizer::GenerateWeldRemap(meshData, vertexCount, options);
+                    Assert::AreEqual<size_t>(5U, vertexCount);
+
+                    options.normalEpsilon = 0.001f;
+                    MeshOptimizer::WeldVertices(meshData, options);
+
+                    const std::vector<uint32_t> expectedIndices = { 0, 1, 2, 1, 3, 2 };
+                    AreEqual(expectedIndices, meshData.indices);
+                    Assert::AreEqual<size_t>(4U, meshData.vertexCount);
+
+                    // The first of the merged vertices is kept
+                    float position[3];
+                    std::memcpy(position, meshData.attributes[0].data.data() + 2U * sizeof(position), sizeof(position));
+                    Assert::AreEqual(0.0f, position[0]);
+                }
+
+                GLTFSDK_TEST_METHOD(MeshOptimizerTests, MeshOptimizer_Test_WeldVertices_MorphTargets)
+                {
+                    MeshOptimizer::MeshData meshData;
+                    meshData.indices = { 0, 1, 2 };
+                    meshData.vertexCount = 3U;
+                    meshData.attributes.push_back(MakeFloatStream(ACCESSOR_POSITION, TYPE_VEC3, { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f }));
+                    meshData.targets.push_back({ MakeFloatStream(ACCESSOR_POSITION, TYPE_VEC3, { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 2.0f, 0.0f, 0.0f, 1.0f }) });
+
+                    // Vertices are only merged if they're also displaced identically by every morph target
+                    size_t vertexCount;
+                    const auto remap = MeshOptimizer::GenerateWeldRemap(meshData, vertexCount);
+
+                    const std::vector<uint32_t> expected = { 0, 1, 0 };
+                    AreEqual(expected, remap);
+                    Assert::AreEqual<size_t>(2U, vertexCount);
+                }
+
+                GLTFSDK_TEST_METHOD(MeshOptimizerTests, MeshOptimizer_Test_WeldVertices_Parallel)
+                {
+                    // A grid's triangles with their vertices duplicated for every triangle
+                    const uint32_t size = 120U;
+                    const auto gridIndices = MakeShuffledGrid(size);
+
+                    std::vector<float> positions;
+
+                    for (uint32_t index : gridIndices)
+                    {
+                        positions.insert(positions.end(), { static_cast<float>(index % size), static_cast<float>(index / size), 0.0f });
+                    }
+
+                    MeshOptimizer::MeshData meshData;
+                    meshData.indices.resize(gridIndices.size());
+                    meshData.vertexCount = gridIndices.size();
+                    meshData.attributes.push_back(MakeFloatStream(ACCESSOR_POSITION, TYPE_VEC3, positions));
+
+                    std::iota(meshData.indices.begin(), meshData.indices.end(), 0U);
+
+                    MeshOptimizer::WeldOptions options;
+                    options.minParallelVertexCount = 0U;
+                    options.threadCount = 1U;
+
+                    size_t serialVertexCount;
+                    const auto serialRemap = MeshOptimizer::GenerateWeldRemap(meshData, serialVertexCount, options);
+
+                    options.threadCount = 4U;
+
+                    size_t parallelVertexCount;
+                    const auto parallelRemap = MeshOptimizer::GenerateWeldRemap(meshData, parallelVertexCount, options);
+
+                    Assert::AreEqual<size_t>(size * size, serialVertexCount);
+                    Assert::AreEqual(serialVertexCount, parallelVertexCount);
+                    AreEqual(serialRemap, parallelRemap);
+                }
+
+                GLTFSDK_TEST_METHOD(MeshOptimizerTests, MeshOptimizer_Test_GetIndexComponentType)
+                {
+                    Assert::IsTrue(COMPONENT_UNSIGNED_BYTE == MeshOptimizer::GetIndexComponentType(255U));
+                    Assert::IsTrue(COMPONENT_UNSIGNED_SHORT == MeshOptimizer::GetIndexComponentType(255U, false));
+                    Assert::IsTrue(COMPONENT_UNSIGNED_SHORT == MeshOptimizer::GetIndexComponentType(256U));
+                    Assert::IsTrue(COMPONENT_UNSIGNED_SHORT == MeshOptimizer::GetIndexComponentType(65535U));
+                    Assert::IsTrue(COMPONENT_UNSIGNED_INT == MeshOptimizer::GetIndexComponentType(65536U));
+                }
+
+                GLTFSDK_TEST_METHOD(MeshOptimizerTests, MeshOptimizer_Test_CompactIndices)
+                {
+                    std::vector<float> positions;
+
+                    for (uint32_t i = 0U; i < 1000U; i++)
+                    {
+                        positions.insert(positions.end(), { static_cast<float>(i), 0.0f, 0.0f });
+                    }
+
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    // Two primitives that each use a few vertices of a shared accessor and a third that uses all of them
+                    Mesh mesh;
+                    mesh.id = "mesh";
+                    mesh.primitives.resize(3U);
+
+                    for (auto& meshPrimitive : mesh.primitives)
+                    {
+                        meshPrimitive.attributes[ACCESSOR_POSITION] = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT }).id;
+                    }
+
+                    const std::vector<uint32_t> indices0 = { 500, 501, 502, 502, 501, 503 };
+                    const std::vector<uint32_t> indices1 = { 10, 900, 20 };
+                    std::vector<uint32_t> indices2(999U);
+                    std::iota(indices2.begin(), indices2.end(), 1U);
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ELEMENT_ARRAY_BUFFER);
+                    mesh.primitives[0].indicesAccessorId = bufferBuilder.AddAccessor(indices0, { TYPE_SCALAR, COMPONENT_UNSIGNED_INT }).id;
+                    mesh.primitives[1].indicesAccessorId = bufferBuilder.AddAccessor(indices1, { TYPE_SCALAR, COMPONENT_UNSIGNED_INT }).id;
+                    mesh.primitives[2].indicesAccessorId = bufferBuilder.AddAccessor(indices2, { TYPE_SCALAR, COMPONENT_UNSIGNED_INT }).id;
+
+                    Document doc;
+                    doc.meshes.Append(mesh, AppendIdPolicy::ThrowOnEmpty);
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    auto compactedBuilder = MakeRewriteBufferBuilder(readerWriter, "compacted");
+
+                    MeshOptimizer::CompactIndices(doc, reader, compactedBuilder);
+
+                    compactedBuilder.Output(doc);
+
+                    const auto& compactedMesh = doc.meshes.Get("mesh");
+
+                    const std::vector<uint32_t> expectedIndices0 = { 0, 1, 2, 2, 1, 3 };
+                    const std::vector<float> expectedPositions0 = { 500.0f, 0.0f, 0.0f, 501.0f, 0.0f, 0.0f, 502.0f, 0.0f, 0.0f, 503.0f, 0.0f, 0.0f };
+                    AreEqual(expectedIndices0, MeshPrimitiveUtils::GetIndices32(doc, reader, compactedMesh.primitives[0]));
+                    AreEqual(expectedPositions0, MeshPrimitiveUtils::GetPositions(doc, reader, compactedMesh.primitives[0]));
+
+                    const std::vector<uint32_t> expectedIndices1 = { 0, 2, 1 };
+                    const std::vector<float> expectedPositions1 = { 10.0f, 0.0f, 0.0f, 20.0f, 0.0f, 0.0f, 900.0f, 0.0f, 0.0f };
+                    AreEqual(expectedIndices1, MeshPrimitiveUtils::GetIndices32(doc, reader, compactedMesh.primitives[1]));
+                    AreEqual(expectedPositions1, MeshPrimitiveUtils::GetPositions(doc, reader, compactedMesh.primitives[1]));
+
+                    Assert::IsTrue(COMPONENT_UNSIGNED_BYTE == doc.accessors.Get(compactedMesh.primitives[0].indicesAccessorId).componentType);
+                    Assert::IsTrue(COMPONENT_UNSIGNED_BYTE == doc.accessors.Get(compactedMesh.primitives[1].indicesAccessorId).componentType);
+
+                    // The third primitive's indices are narrowed but it continues to use the shared accessor
+                    Assert::AreEqual(mesh.primitives[2].GetAttributeAccessorId(ACCESSOR_POSITION), compactedMesh.primitives[2].GetAttributeAccessorId(ACCESSOR_POSITION));
+                    Assert::IsTrue(COMPONENT_UNSIGNED_SHORT == doc.accessors.Get(compactedMesh.primitives[2].indicesAccessorId).componentType);
+                    AreEqual(indices2, MeshPrimitiveUtils::GetIndices32(doc, reader, compactedMesh.primitives[2]));
+
+                    // Compacting again doesn't change anything
+                    auto recompactedBuilder = MakeRewriteBufferBuilder(readerWriter, "recompacted");
+
+                    for (const auto& meshPrimitive : compactedMesh.primitives)
+                    {
+                        Assert::IsTrue(meshPrimitive == MeshOptimizer::CompactIndices(doc, reader, meshPrimitive, recompactedBuilder));
+                    }
+
+                    Assert::AreEqual<size_t>(0U, recompactedBuilder.GetAccessorCount());
+                }
+
+                GLTFSDK_TEST_METHOD(MeshOptimizerTests, MeshOptimizer_Test_CompactIndices_PrimitiveRestart)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.mode = MESH_TRIANGLE_STRIP;
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    meshPrimitive.attributes[ACCESSOR_POSITION] = bufferBuilder.AddAccessor(std::vector<float>(18U), { TYPE_VEC3, COMPONENT_FLOAT }).id;
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ELEMENT_ARRAY_BUFFER);
+                    meshPrimitive.indicesAccessorId = bufferBuilder.AddAccessor(std::vector<uint16_t>{ 0, 1, 2, 3, UINT16_MAX, 3, 4, 5 }, { TYPE_SCALAR, COMPONENT_UNSIGNED_SHORT }).id;
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    auto compactedBuilder = MakeRewriteBufferBuilder(readerWriter, "compacted");
+
+                    const auto compactedPrimitive = MeshOptimizer::CompactIndices(doc, reader, meshPrimitive, compactedBuilder);
+
+                    compactedBuilder.Output(doc);
+
+                    const std::vector<uint32_t> expectedIndices = { 0, 1, 2, 3, UINT8_MAX, 3, 4, 5 };
+                    AreEqual(expectedIndices, MeshPrimitiveUtils::GetIndices32(doc, reader, compactedPrimitive));
+                    AreEqual(MeshPrimitiveUtils::GetTriangulatedIndices32(doc, reader, meshPrimitive), MeshPrimitiveUtils::GetTriangulatedIndices32(doc, reader, compactedPrimitive));
+
+                    Assert::IsTrue(MESH_TRIANGLE_STRIP == compactedPrimitive.mode);
+                    Assert::AreEqual(meshPrimitive.GetAttributeAccessorId(ACCESSOR_POSITION), compactedPrimitive.GetAttributeAccessorId(ACCESSOR_POSITION));
+
+                    // Without unsigned bytes the indices are already as narrow as they can be
+                    MeshOptimizer::CompactOptions options;
+                    options.allowUnsignedByteIndices = false;
+
+                    Assert::IsTrue(meshPrimitive == MeshOptimizer::CompactIndices(doc, reader, meshPrimitive, compactedBuilder, options));
+                }
+
+                GLTFSDK_TEST_METHOD(MeshOptimizerTests, MeshOptimizer_Test_ReadMeshData_Points)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.mode = MESH_POINTS;
+                    meshPrimitive.attributes[ACCESSOR_POSITION] = bufferBuilder.AddAccessor(std::vector<float>(9U), { TYPE_VEC3, COMPONENT_FLOAT }).id;
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    Assert::ExpectException<GLTFException>([&]() { MeshOptimizer::ReadMeshData(doc, reader, meshPrimitive); });
+                }
+            }
+        }
+    }
+}
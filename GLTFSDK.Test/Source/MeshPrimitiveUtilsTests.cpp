@@ -11,6 +11,9 @@
 #include <GLTFSDK/MeshPrimitiveUtils.h>
 
 #include "TestUtils.h"
+#include <TestUtilsCommon/AllocationCounter.h>
+
+#include <numeric>
 
 using namespace glTF::UnitTest;
 
@@ -1709,6 +1712,368 @@ namespace Microsoft
 
                     AreEqual(outputIndices, indices);
                 }
+
+                GLTFSDK_TEST_METHOD(MeshPrimitiveUtilsTests, MeshPrimitiveUtils_Test_GetIndices32_OutputBuffer_UnsignedShort)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    std::vector<uint16_t> indices = { 0, 1, 2, 3, 4, 5, UINT8_MAX, UINT16_MAX };
+                    auto accessor = bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_SHORT });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    // The values beyond the accessor's count must be left untouched
+                    std::vector<uint32_t> output(indices.size() + 2U, UINT32_MAX);
+                    const auto count = MeshPrimitiveUtils::GetIndices32(doc, reader, accessor, output.data(), output.size());
+
+                    Assert::AreEqual(indices.size(), count);
+
+                    std::vector<uint32_t> expected = { 0, 1, 2, 3, 4, 5, UINT8_MAX, UINT16_MAX, UINT32_MAX, UINT32_MAX };
+                    AreEqual(expected, output);
+                }
+
+                GLTFSDK_TEST_METHOD(MeshPrimitiveUtilsTests, MeshPrimitiveUtils_Test_GetPositions_OutputBuffer_TooSmall)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    std::vector<float> positions = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+                    auto accessor = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    std::vector<float> output(positions.size() - 1U);
+
+                    Assert::ExpectException<GLTFException>([&]()
+                    {
+                        MeshPrimitiveUtils::GetPositions(doc, reader, accessor, output.data(), output.size());
+                    });
+                }
+
+                GLTFSDK_TEST_METHOD(MeshPrimitiveUtilsTests, MeshPrimitiveUtils_Test_GetJointIndices64_OutputBuffer_Vec4_Unsigned_Byte)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    std::vector<uint8_t> indices = {
+                        0, 15, 0, 0,
+                        15, 0, 20, 0,
+                        1, 2, 3, 4
+                    };
+                    auto accessor = bufferBuilder.AddAccessor(indices, { TYPE_VEC4, COMPONENT_UNSIGNED_BYTE });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    std::vector<uint64_t> output(3U);
+                    const auto count = MeshPrimitiveUtils::GetJointIndices64(doc, reader, accessor, output.data(), output.size());
+
+                    Assert::AreEqual<size_t>(3U, count);
+                    AreEqual(MeshPrimitiveUtils::GetJointIndices64(doc, reader, accessor), output);
+                }
+
+                GLTFSDK_TEST_METHOD(MeshPrimitiveUtilsTests, MeshPrimitiveUtils_Test_GetColors_OutputBuffer_Vec3_Unsigned_Byte)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    std::vector<uint8_t> colors = {
+                        255, 0, 0,
+                        0, 255, 0,
+                        0, 0, 255,
+                        10, 20, 30
+                    };
+                    auto accessor = bufferBuilder.AddAccessor(colors, { TYPE_VEC3, COMPONENT_UNSIGNED_BYTE });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    std::vector<uint32_t> output(4U);
+                    const auto count = MeshPrimitiveUtils::GetColors(doc, reader, accessor, output.data(), output.size());
+
+                    Assert::AreEqual<size_t>(4U, count);
+
+                    std::vector<uint32_t> expected = { 0xFF0000FF, 0xFF00FF00, 0xFFFF0000, 0xFF1E140A };
+                    AreEqual(expected, output);
+                }
+
+                GLTFSDK_TEST_METHOD(MeshPrimitiveUtilsTests, MeshPrimitiveUtils_Test_GetTriangulatedIndices16_OutputBuffer_TriangleStrip)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    std::vector<uint8_t> indices = { 0, 1, 2, 3, 4, 5 };
+                    auto indicesAccessor = bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_BYTE });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.indicesAccessorId = indicesAccessor.id;
+                    meshPrimitive.mode = MESH_TRIANGLE_STRIP;
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    const auto indexCount = MeshPrimitiveUtils::GetTriangulatedIndexCount(doc, meshPrimitive);
+                    Assert::AreEqual<size_t>(12U, indexCount);
+
+                    std::vector<uint16_t> output(indexCount);
+                    const auto count = MeshPrimitiveUtils::GetTriangulatedIndices16(doc, reader, meshPrimitive, output.data(), output.size());
+
+                    Assert::AreEqual(indexCount, count);
+
+                    std::vector<uint16_t> expected = {
+                        0, 1, 2,
+                        1, 3, 2,
+                        2, 3, 4,
+                        3, 5, 4
+                    };
+                    AreEqual(expected, output);
+                }
+
+                GLTFSDK_TEST_METHOD(MeshPrimitiveUtilsTests, MeshPrimitiveUtils_Test_GetSegmentedIndices32_OutputBuffer_LineLoop)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    std::vector<uint16_t> indices = { 4, 3, 2, 1 };
+                    auto indicesAccessor = bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_SHORT });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.indicesAccessorId = indicesAccessor.id;
+                    meshPrimitive.mode = MESH_LINE_LOOP;
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    std::vector<uint32_t> output(MeshPrimitiveUtils::GetSegmentedIndexCount(doc, meshPrimitive));
+                    MeshPrimitiveUtils::GetSegmentedIndices32(doc, reader, meshPrimitive, output.data(), output.size());
+
+                    std::vector<uint32_t> expected = {
+                        4, 3,
+                        3, 2,
+                        2, 1,
+                        1, 4
+                    };
+                    AreEqual(expected, output);
+                }
+
+                GLTFSDK_TEST_METHOD(MeshPrimitiveUtilsTests, MeshPrimitiveUtils_Test_GetTriangulatedIndices16_TriangleStrip_PrimitiveRestart)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    // The two index strip between the second and third restarts is too short to form a triangle
+                    std::vector<uint16_t> indices = { 0, 1, 2, 3, 0xFFFF, 4, 5, 6, 0xFFFF, 7, 8, 0xFFFF, 9, 10, 11, 12, 13 };
+                    auto indicesAccessor = bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_SHORT });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.indicesAccessorId = indicesAccessor.id;
+                    meshPrimitive.mode = MESH_TRIANGLE_STRIP;
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    Assert::AreEqual<size_t>(45U, MeshPrimitiveUtils::GetTriangulatedIndexCount(doc, meshPrimitive));
+
+                    std::vector<uint16_t> expected = {
+                        0, 1, 2,
+                        1, 3, 2,
+                        4, 5, 6,
+                        9, 10, 11,
+                        10, 12, 11,
+                        11, 12, 13
+                    };
+                    AreEqual(expected, MeshPrimitiveUtils::GetTriangulatedIndices16(doc, reader, meshPrimitive));
+                }
+
+                GLTFSDK_TEST_METHOD(MeshPrimitiveUtilsTests, MeshPrimitiveUtils_Test_GetTriangulatedIndices32_OutputBuffer_TriangleFan_PrimitiveRestart)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    std::vector<uint8_t> indices = { 0, 1, 2, 3, 0xFF, 4, 5, 6 };
+                    auto indicesAccessor = bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_BYTE });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.indicesAccessorId = indicesAccessor.id;
+                    meshPrimitive.mode = MESH_TRIANGLE_FAN;
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    std::vector<uint32_t> output(MeshPrimitiveUtils::GetTriangulatedIndexCount(doc, meshPrimitive));
+                    const auto count = MeshPrimitiveUtils::GetTriangulatedIndices32(doc, reader, meshPrimitive, output.data(), output.size());
+
+                    Assert::AreEqual<size_t>(9U, count);
+                    output.resize(count);
+
+                    std::vector<uint32_t> expected = {
+                        0, 1, 2,
+                        0, 2, 3,
+                        4, 5, 6
+                    };
+                    AreEqual(expected, output);
+                }
+
+                GLTFSDK_TEST_METHOD(MeshPrimitiveUtilsTests, MeshPrimitiveUtils_Test_GetSegmentedIndices32_LineLoop_PrimitiveRestart)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    std::vector<uint16_t> indices = { 0, 1, 2, 0xFFFF, 3, 4, 0xFFFF, 5 };
+                    auto indicesAccessor = bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_SHORT });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.indicesAccessorId = indicesAccessor.id;
+                    meshPrimitive.mode = MESH_LINE_LOOP;
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    std::vector<uint32_t> expected = {
+                        0, 1,
+                        1, 2,
+                        2, 0,
+                        3, 4,
+                        4, 3
+                    };
+                    AreEqual(expected, MeshPrimitiveUtils::GetSegmentedIndices32(doc, reader, meshPrimitive));
+                }
+
+                // Long enough for the expansion kernels to process several whole blocks in place, with and without restarts
+                GLTFSDK_TEST_METHOD(MeshPrimitiveUtilsTests, MeshPrimitiveUtils_Test_GetTriangulatedIndices_TriangleStrip_Long)
+                {
+                    for (size_t restartInterval : { 0U, 5U, 37U })
+                    {
+                        auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                        auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                        bufferBuilder.AddBuffer();
+                        bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                        std::vector<uint16_t> indices(203U);
+
+                        for (size_t i = 0U; i < indices.size(); i++)
+                        {
+                            const bool isRestart = restartInterval != 0U && i % restartInterval == restartInterval - 1U;
+                            indices[i] = isRestart ? 0xFFFF : static_cast<uint16_t>(i * 7U % 1000U);
+                        }
+
+                        auto indicesAccessor = bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_SHORT });
+
+                        Document doc;
+                        bufferBuilder.Output(doc);
+
+                        MeshPrimitive meshPrimitive;
+                        meshPrimitive.indicesAccessorId = indicesAccessor.id;
+                        meshPrimitive.mode = MESH_TRIANGLE_STRIP;
+
+                        GLTFResourceReader reader(readerWriter);
+
+                        std::vector<uint32_t> expected;
+                        size_t runStart = 0U;
+
+                        for (size_t i = 0U; i <= indices.size(); i++)
+                        {
+                            if (i == indices.size() || indices[i] == 0xFFFF)
+                            {
+                                for (size_t j = runStart; j + 2U < i; j++)
+                                {
+                                    const bool isOdd = (j - runStart) % 2U == 1U;
+
+                                    expected.push_back(indices[j]);
+                                    expected.push_back(indices[isOdd ? j + 2U : j + 1U]);
+                                    expected.push_back(indices[isOdd ? j + 1U : j + 2U]);
+                                }
+
+                                runStart = i + 1U;
+                            }
+                        }
+
+                        const auto indices16 = MeshPrimitiveUtils::GetTriangulatedIndices16(doc, reader, meshPrimitive);
+                        AreEqual(expected, std::vector<uint32_t>(indices16.begin(), indices16.end()));
+                        AreEqual(expected, MeshPrimitiveUtils::GetTriangulatedIndices32(doc, reader, meshPrimitive));
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(MeshPrimitiveUtilsTests, MeshPrimitiveUtils_Test_OutputBuffer_Allocations)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    std::vector<uint16_t> indices(300U);
+                    std::iota(indices.begin(), indices.end(), static_cast<uint16_t>(0U));
+
+                    auto indicesAccessor = bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_SHORT });
+                    auto positionsAccessor = bufferBuilder.AddAccessor(std::vector<float>(indices.size() * 3U, 1.0f), { TYPE_VEC3, COMPONENT_FLOAT });
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    std::vector<uint32_t> outputIndices(indices.size());
+                    std::vector<float> outputPositions(indices.size() * 3U);
+
+                    // Read once first so the buffer's stream is cached and isn't part of the count
+                    MeshPrimitiveUtils::GetPositions(doc, reader, positionsAccessor, outputPositions.data(), outputPositions.size());
+
+                    AllocationCounter counter;
+                    MeshPrimitiveUtils::GetIndices32(doc, reader, indicesAccessor, outputIndices.data(), outputIndices.size());
+                    MeshPrimitiveUtils::GetPositions(doc, reader, positionsAccessor, outputPositions.data(), outputPositions.size());
+
+                    Assert::AreEqual<size_t>(0U, counter.GetCount());
+                }
             };
         }
     }
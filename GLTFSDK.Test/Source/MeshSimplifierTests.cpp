@@ -0,0 +1,375 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Deserialize.h>
+#include <GLTFSDK/ExtensionsMSFT.h>
+#include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/MeshPrimitiveUtils.h>
+#include <GLTFSDK/MeshSimplifier.h>
+#include <GLTFSDK/Serialize.h>
+
+#include "TestUtils.h"
+
+#include <TestUtilsCommon/MeshTestUtils.h>
+
+#include <cmath>
+#include <cstring>
+#include <unordered_set>
+
+using namespace glTF::UnitTest;
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            namespace
+            {
+                // A grid of 'size' x 'size' vertices in the XY plane, with heights from 'getHeight'
+                template<typename Fn>
+                MeshOptimizer::MeshData MakeGrid(uint32_t size, Fn getHeight)
+                {
+                    MeshOptimizer::MeshData meshData;
+                    meshData.vertexCount = size * size;
+                    meshData.indices = MakeGridIndices(size - 1U);
+                    meshData.attributes.push_back(MakeFloatStream(ACCESSOR_POSITION, TYPE_VEC3, MakeGridPositions(size - 1U, getHeight)));
+
+                    return meshData;
+                }
+
+                MeshOptimizer::MeshData MakeFlatGrid(uint32_t size)
+                {
+                    return MakeGrid(size, [](uint32_t, uint32_t) { return 0.0f; });
+                }
+
+                // A UV sphere of unit radius with 'segmentCount' x 'ringCount' quads, with normals and texture coordinates. The
+                // vertices of the first and last segments, and those of each pole, share positions but not texture coordinates.
+                MeshOptimizer::MeshData MakeSphere(uint32_t segmentCount, uint32_t ringCount)
+                {
+                    MeshOptimizer::MeshData meshData;
+                    meshData.vertexCount = (segmentCount + 1U) * (ringCount + 1U);
+
+                    std::vector<float> positions;
+                    std::vector<float> texcoords;
+
+                    for (uint32_t ring = 0U; ring <= ringCount; ring++)
+                    {
+                        const float theta = 3.14159265f * ring / ringCount;
+
+                        for (uint32_t segment = 0U; segment <= segmentCount; segment++)
+                        {
+                            const float phi = 2.0f * 3.14159265f * segment / segmentCount;
+
+                            positions.insert(positions.end(), { std::sin(theta) * std::cos(phi), std::cos(theta), -std::sin(theta) * std::sin(phi) });
+                            texcoords.insert(texcoords.end(), { static_cast<float>(segment) / segmentCount, static_cast<float>(ring) / ringCount });
+                        }
+                    }
+
+                    for (uint32_t ring = 0U; ring < ringCount; ring++)
+                    {
+                        for (uint32_t segment = 0U; segment < segmentCount; segment++)
+                        {
+                            const uint32_t vertex = ring * (segmentCount + 1U) + segment;
+                            const uint32_t below = vertex + segmentCount + 1U;
+
+                            // Skip the triangles that would be degenerate at the poles
+                            if (ring + 1U < ringCount)
+                            {
+                                meshData.indices.insert(meshData.indices.end(), { vertex, below, below + 1U });
+                            }
+
+                            if (ring > 0U)
+                            {
+                                meshData.indices.insert(meshData.indices.end(), { vertex, below + 1U, vertex + 1U });
+                            }
+                        }
+                    }
+
+                    meshData.attributes.push_back(MakeFloatStream(ACCESSOR_POSITION, TYPE_VEC3, positions));
+                    meshData.attributes.push_back(MakeFloatStream(ACCESSOR_NORMAL, TYPE_VEC3, positions));
+                    meshData.attributes.push_back(MakeFloatStream(ACCESSOR_TEXCOORD_0, TYPE_VEC2, texcoords));
+
+                    return meshData;
+                }
+
+                // Writes 'meshData' as the only primitive of the mesh of a node in the default scene and generates the node's
+                // levels of detail, which are written to buffers of their own
+                Document GenerateLods(const MeshOptimizer::MeshData& meshData, const std::string& meshName, const std::shared_ptr<const StreamReaderWriter>& readerWriter, const MeshSimplifier::LodOptions& options)
+                {
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+
+                    Mesh mesh;
+                    mesh.id = "mesh";
+                    mesh.name = meshName;
+                    mesh.primitives.push_back(MeshOptimizer::WriteMeshData(meshData, MeshPrimitive(), bufferBuilder));
+
+                    Node node;
+                    node.id = "node";
+                    node.meshId = mesh.id;
+                    node.translation = Vector3(1.0f, 2.0f, 3.0f);
+
+                    Scene scene;
+                    scene.id = "scene";
+                    scene.nodes.push_back(node.id);
+
+                    Document doc;
+                    doc.meshes.Append(std::move(mesh), AppendIdPolicy::ThrowOnEmpty);
+                    doc.nodes.Append(std::move(node), AppendIdPolicy::ThrowOnEmpty);
+                    doc.SetDefaultScene(std::move(scene), AppendIdPolicy::ThrowOnEmpty);
+                    bufferBuilder.Output(doc);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    auto lodBuilder = MakeRewriteBufferBuilder(readerWriter, "lod");
+
+                    MeshSimplifier::GenerateLods(doc, reader, lodBuilder, options);
+
+                    lodBuilder.Output(doc);
+
+                    return doc;
+                }
+
+                // The total area of the triangles' projections onto the XY plane, which is negative for flipped triangles
+                float GetSignedArea(const MeshOptimizer::MeshData& meshData)
+                {
+                    const float* positions = reinterpret_cast<const float*>(meshData.attributes[0].data.data());
+
+                    float area = 0.0f;
+
+                    for (size_t i = 0U; i < meshData.indices.size(); i += 3U)
+                    {
+                        const float* a = positions + meshData.indices[i] * 3U;
+                        const float* b = positions + meshData.indices[i + 1U] * 3U;
+                        const float* c = positions + meshData.indices[i + 2U] * 3U;
+
+                        area += 0.5f * ((b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]));
+                    }
+
+                    return area;
+                }
+            }
+
+            GLTFSDK_TEST_CLASS(MeshSimplifierTests)
+            {
+                GLTFSDK_TEST_METHOD(MeshSimplifierTests, MeshSimplifier_Test_Simplify)
+                {
+                    const uint32_t size = 17U;
+
+                    auto meshData = MakeFlatGrid(size);
+                    const size_t triangleCount = meshData.indices.size() / 3U;
+
+                    MeshSimplifier::SimplifyOptions options;
+                    options.targetRatio = 0.25f;
+
+                    const float error = MeshSimplifier::Simplify(meshData, options);
+
+                    // A plane can be simplified without error and without changing its outline
+                    Assert::AreEqual(0.0f, error);
+                    Assert::IsTrue(meshData.indices.size() / 3U <= triangleCount / 4U);
+                    Assert::AreEqual((size - 1.0f) * (size - 1.0f), GetSignedArea(meshData));
+
+                    const std::unordered_set<uint32_t> vertices(meshData.indices.begin(), meshData.indices.end());
+
+                    for (uint32_t corner : { 0U, size - 1U, size * (size - 1U), size * size - 1U })
+                    {
+                        Assert::IsTrue(vertices.count(corner) == 1U);
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(MeshSimplifierTests, MeshSimplifier_Test_Simplify_MaxError)
+                {
+                    const uint32_t size = 17U;
+
+                    auto getHeight = [](uint32_t x, uint32_t y) { return std::sin(x * 0.7f) * std::cos(y * 0.5f) * 2.0f; };
+
+                    auto meshDataLimited = MakeGrid(size, getHeight);
+                    auto meshDataUnlimited = MakeGrid(size, getHeight);
+
+                    MeshSimplifier::SimplifyOptions options;
+                    options.targetRatio = 0.1f;
+                    options.maxError = 0.01f;
+
+                    const float errorLimited = MeshSimplifier::Simplify(meshDataLimited, options);
+
+                    options.maxError = 1.0f;
+
+                    const float errorUnlimited = MeshSimplifier::Simplify(meshDataUnlimited, options);
+
+                    Assert::IsTrue(errorLimited <= 0.01f);
+                    Assert::IsTrue(errorUnlimited > errorLimited);
+                    Assert::IsTrue(meshDataUnlimited.indices.size() < meshDataLimited.indices.size());
+                }
+
+                GLTFSDK_TEST_METHOD(MeshSimplifierTests, MeshSimplifier_Test_Simplify_Seam)
+                {
+                    const uint32_t size = 9U;
+
+                    // The grid's middle column is split into two vertices with different texture coordinates
+                    auto meshData = MakeFlatGrid(size);
+
+                    std::vector<float> positions(meshData.vertexCount * 3U);
+                    std::memcpy(positions.data(), meshData.attributes[0].data.data(), positions.size() * sizeof(float));
+
+                    std::vector<float> texCoords;
+
+                    for (uint32_t i = 0U; i < meshData.vertexCount; i++)
+                    {
+                        texCoords.insert(texCoords.end(), { (i % size) / (size - 1.0f), 0.0f });
+                    }
+
+                    std::vector<uint32_t> seamVertices;
+
+                    for (uint32_t y = 0U; y < size; y++)
+                    {
+                        const uint32_t vertex = y * size + size / 2U;
+                        const uint32_t seamVertex = static_cast<uint32_t>(positions.size() / 3U);
+
+                        positions.insert(positions.end(), positions.begin() + vertex * 3U, positions.begin() + vertex * 3U + 3U);
+                        texCoords.insert(texCoords.end(), { 1.0f, 1.0f });
+
+                        // Triangles to the right of the seam use the new vertex
+                        for (size_t i = 0U; i < meshData.indices.size(); i += 3U)
+                        {
+                            const uint32_t* triangle = meshData.indices.data() + i;
+
+                            if (triangle[0] % size > size / 2U || triangle[1] % size > size / 2U || triangle[2] % size > size / 2U)
+                            {
+                                for (size_t j = i; j < i + 3U; j++)
+                                {
+                                    if (meshData.indices[j] == vertex)
+                                    {
+                                        meshData.indices[j] = seamVertex;
+                                    }
+                                }
+                            }
+                        }
+
+                        seamVertices.push_back(vertex);
+                        seamVertices.push_back(seamVertex);
+                    }
+
+                    meshData.vertexCount = positions.size() / 3U;
+                    meshData.attributes[0] = MakeFloatStream(ACCESSOR_POSITION, TYPE_VEC3, positions);
+                    meshData.attributes.push_back(MakeFloatStream(ACCESSOR_TEXCOORD_0, TYPE_VEC2, texCoords));
+
+                    MeshSimplifier::SimplifyOptions options;
+                    options.targetRatio = 0.1f;
+
+                    MeshSimplifier::Simplify(meshData, options);
+
+                    const std::unordered_set<uint32_t> vertices(meshData.indices.begin(), meshData.indices.end());
+
+                    for (uint32_t vertex : seamVertices)
+                    {
+                        Assert::IsTrue(vertices.count(vertex) == 1U);
+                    }
+
+                    Assert::AreEqual((size - 1.0f) * (size - 1.0f), GetSignedArea(meshData));
+                }
+
+                GLTFSDK_TEST_METHOD(MeshSimplifierTests, MeshSimplifier_Test_Simplify_InvalidPositions)
+                {
+                    MeshOptimizer::MeshData meshData;
+                    meshData.indices = { 0, 1, 2 };
+                    meshData.vertexCount = 3U;
+                    meshData.attributes.push_back(MakeFloatStream(ACCESSOR_POSITION, TYPE_VEC2, { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f }));
+
+                    Assert::ExpectException<GLTFException>([&meshData]()
+                    {
+                        MeshSimplifier::Simplify(meshData);
+                    });
+                }
+
+                GLTFSDK_TEST_METHOD(MeshSimplifierTests, MeshSimplifier_Test_GenerateLods)
+                {
+                    const auto meshData = MakeFlatGrid(33U);
+
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+
+                    MeshSimplifier::LodOptions options;
+                    options.levelRatios = { 0.5f, 0.25f };
+                    options.threadCount = 2U;
+
+                    auto doc = GenerateLods(meshData, "grid", readerWriter, options);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    Assert::IsTrue(doc.extensionsUsed.count(MSFT::Nodes::LOD_NAME) == 1U);
+
+                    const auto& lod = doc.nodes.Get("node").GetExtension<MSFT::Nodes::Lod>();
+                    Assert::AreEqual<size_t>(2U, lod.ids.size());
+
+                    size_t previousTriangleCount = meshData.indices.size() / 3U;
+
+                    for (const auto& id : lod.ids)
+                    {
+                        const auto& lodNode = doc.nodes.Get(id);
+                        const auto& lodMesh = doc.meshes.Get(lodNode.meshId);
+
+                        Assert::IsTrue(lodNode.translation == Vector3(1.0f, 2.0f, 3.0f));
+                        Assert::AreEqual<size_t>(1U, lodMesh.primitives.size());
+
+                        const size_t triangleCount = MeshPrimitiveUtils::GetIndices32(doc, reader, lodMesh.primitives[0]).size() / 3U;
+
+                        Assert::IsTrue(triangleCount < previousTriangleCount);
+                        previousTriangleCount = triangleCount;
+                    }
+
+                    Assert::AreEqual<std::string>("grid_LOD1", doc.meshes.Get(doc.nodes.Get(lod.ids[0]).meshId).name);
+
+                    // The LOD nodes aren't part of the scene
+                    Assert::AreEqual<size_t>(1U, doc.GetDefaultScene().nodes.size());
+
+                    const auto outputJson = Serialize(doc, MSFT::GetMSFTExtensionSerializer());
+                    const auto roundTrippedDoc = Deserialize(outputJson, MSFT::GetMSFTExtensionDeserializer());
+
+                    Assert::IsTrue(roundTrippedDoc.nodes[0].HasExtension<MSFT::Nodes::Lod>());
+                    Assert::AreEqual<size_t>(2U, roundTrippedDoc.nodes[0].GetExtension<MSFT::Nodes::Lod>().ids.size());
+                }
+
+                GLTFSDK_TEST_METHOD(MeshSimplifierTests, MeshSimplifier_Test_GenerateLods_Attributes)
+                {
+                    const auto meshData = MakeSphere(64U, 32U);
+                    const size_t triangleCount = meshData.indices.size() / 3U;
+
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+
+                    MeshSimplifier::LodOptions options;
+                    options.threadCount = 2U;
+
+                    auto doc = GenerateLods(meshData, "sphere", readerWriter, options);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    // Smoothly varying normals and texture coordinates don't stop a finely tessellated sphere from being
+                    // simplified to every level
+                    const auto& lod = doc.nodes.Get("node").GetExtension<MSFT::Nodes::Lod>();
+                    Assert::AreEqual(options.levelRatios.size(), lod.ids.size());
+
+                    for (size_t i = 0U; i < lod.ids.size(); i++)
+                    {
+                        const auto& lodMesh = doc.meshes.Get(doc.nodes.Get(lod.ids[i]).meshId);
+                        const size_t lodTriangleCount = MeshPrimitiveUtils::GetIndices32(doc, reader, lodMesh.primitives[0]).size() / 3U;
+
+                        Assert::IsTrue(lodTriangleCount <= triangleCount * options.levelRatios[i] * 1.1f);
+
+                        // Triangles removed where vertices share a position (the texture coordinate seam and the poles) are
+                        // counted, so a level doesn't end up with fewer triangles than requested. A collapse removes two
+                        // triangles, so the count can only fall short by one
+                        Assert::IsTrue(lodTriangleCount + 1U >= static_cast<size_t>(triangleCount * options.levelRatios[i]));
+                        Assert::IsTrue(lodMesh.primitives[0].HasAttribute(ACCESSOR_NORMAL));
+                        Assert::IsTrue(lodMesh.primitives[0].HasAttribute(ACCESSOR_TEXCOORD_0));
+                    }
+                }
+            }
+        }
+    }
+}
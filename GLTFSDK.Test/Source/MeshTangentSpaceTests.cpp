@@ -0,0 +1,379 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/MeshTangentSpace.h>
+
+#include "TestUtils.h"
+
+#include <TestUtilsCommon/MeshTestUtils.h>
+
+#include <cmath>
+
+using namespace glTF::UnitTest;
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            namespace
+            {
+                const float Epsilon = 1e-5f;
+
+                // A cube from -1 to 1 with four vertices per face, so that each face can have its own normal
+                void MakeCube(std::vector<float>& positions, std::vector<uint32_t>& indices)
+                {
+                    positions.clear();
+                    indices.clear();
+
+                    for (size_t axis = 0U; axis < 3U; axis++)
+                    {
+                        for (float side : { -1.0f, 1.0f })
+                        {
+                            const auto base = static_cast<uint32_t>(positions.size() / 3U);
+
+                            // The face's corners, counter-clockwise seen from outside the cube
+                            const float corners[4][2] = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f }, { -1.0f, 1.0f } };
+
+                            for (const auto& corner : corners)
+                            {
+                                float position[3];
+                                position[axis] = side;
+                                position[(axis + 1U) % 3U] = corner[0] * side;
+                                position[(axis + 2U) % 3U] = corner[1];
+
+                                positions.insert(positions.end(), position, position + 3);
+                            }
+
+                            indices.insert(indices.end(), { base, base + 1U, base + 2U, base, base + 2U, base + 3U });
+                        }
+                    }
+                }
+
+                // A grid of unit quads in the XY plane, displaced along Z, with texture coordinates that map the texture's
+                // top-left corner to the grid's top-left (minimum x, maximum y) corner
+                void MakeGrid(uint32_t size, std::vector<float>& positions, std::vector<float>& texcoords, std::vector<uint32_t>& indices)
+                {
+                    positions = MakeGridPositions(size, [](uint32_t x, uint32_t y) { return std::sin(x * 0.3f) * std::cos(y * 0.2f); });
+                    indices = MakeGridIndices(size);
+
+                    for (size_t i = 0U; i < positions.size(); i += 3U)
+                    {
+                        texcoords.insert(texcoords.end(), { positions[i] / size, 1.0f - positions[i + 1U] / size });
+                    }
+                }
+
+                // A document with a 2x2 grid that has positions and texture coordinates, used by three meshes: "textured"
+                // has a normal texture, "plain" doesn't and "stale" has tangents but no normals
+                Document MakeGridDocument(std::shared_ptr<const StreamReaderWriter> readerWriter)
+                {
+                    std::vector<float> positions;
+                    std::vector<float> texcoords;
+                    std::vector<uint32_t> indices;
+
+                    MakeGrid(2U, positions, texcoords, indices);
+
+                    // Flatten the grid so that every normal is +Z
+                    for (size_t i = 2U; i < positions.size(); i += 3U)
+                    {
+                        positions[i] = 0.0f;
+                    }
+
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+
+                    MeshPrimitive meshPrimitive;
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ELEMENT_ARRAY_BUFFER);
+                    meshPrimitive.indicesAccessorId = bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_INT }).id;
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    meshPrimitive.attributes[ACCESSOR_POSITION] = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT, false, { 0.0f, 0.0f, 0.0f }, { 2.0f, 2.0f, 0.0f } }).id;
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    meshPrimitive.attributes[ACCESSOR_TEXCOORD_0] = bufferBuilder.AddAccessor(texcoords, { TYPE_VEC2, COMPONENT_FLOAT }).id;
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    const auto staleTangentsId = bufferBuilder.AddAccessor(std::vector<float>(texcoords.size() * 2U, 0.0f), { TYPE_VEC4, COMPONENT_FLOAT }).id;
+
+                    Material material;
+                    material.id = "normalMapped";
+                    material.normalTexture.textureId = "normalMap";
+
+                    Mesh textured;
+                    textured.id = "textured";
+                    textured.primitives.push_back(meshPrimitive);
+                    textured.primitives.back().materialId = "normalMapped";
+
+                    Mesh plain;
+                    plain.id = "plain";
+                    plain.primitives.push_back(meshPrimitive);
+
+                    Mesh stale;
+                    stale.id = "stale";
+                    stale.primitives.push_back(meshPrimitive);
+                    stale.primitives.back().attributes[ACCESSOR_TANGENT] = staleTangentsId;
+
+                    Document doc;
+                    doc.materials.Append(std::move(material), AppendIdPolicy::ThrowOnEmpty);
+                    doc.meshes.Append(std::move(textured), AppendIdPolicy::ThrowOnEmpty);
+                    doc.meshes.Append(std::move(plain), AppendIdPolicy::ThrowOnEmpty);
+                    doc.meshes.Append(std::move(stale), AppendIdPolicy::ThrowOnEmpty);
+                    bufferBuilder.Output(doc);
+
+                    return doc;
+                }
+            }
+
+            GLTFSDK_TEST_CLASS(MeshTangentSpaceTests)
+            {
+                GLTFSDK_TEST_METHOD(MeshTangentSpaceTests, MeshTangentSpace_Test_GenerateNormals_Cube)
+                {
+                    std::vector<float> positions;
+                    std::vector<uint32_t> indices;
+
+                    MakeCube(positions, indices);
+
+                    // An unreferenced vertex
+                    positions.insert(positions.end(), { 5.0f, 5.0f, 5.0f });
+
+                    MeshTangentSpace::TangentSpaceOptions options;
+                    options.smoothSeams = false;
+
+                    auto normals = MeshTangentSpace::GenerateNormals(indices, positions, options);
+
+                    Assert::AreEqual(positions.size(), normals.size());
+
+                    // Each face's vertices have the face's normal
+                    for (size_t i = 0U; i < 24U; i++)
+                    {
+                        const size_t axis = i / 8U;
+                        const float side = (i / 4U) % 2U == 0U ? -1.0f : 1.0f;
+
+                        std::vector<float> expected(3U, 0.0f);
+                        expected[axis] = side;
+
+                        AreNear(expected, normals.data() + i * 3U);
+                    }
+
+                    AreNear({ 0.0f, 0.0f, 1.0f }, normals.data() + 24U * 3U);
+
+                    // With seams smoothed, each corner's three faces each contribute a right angle
+                    normals = MeshTangentSpace::GenerateNormals(indices, positions);
+
+                    const float inverseSqrt3 = 1.0f / std::sqrt(3.0f);
+
+                    for (size_t i = 0U; i < 24U; i++)
+                    {
+                        std::vector<float> expected(positions.begin() + i * 3U, positions.begin() + i * 3U + 3U);
+
+                        for (auto& value : expected)
+                        {
+                            value *= inverseSqrt3;
+                        }
+
+                        AreNear(expected, normals.data() + i * 3U);
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(MeshTangentSpaceTests, MeshTangentSpace_Test_GenerateNormals_Weighting)
+                {
+                    // Vertex 0 is the right-angled corner of a large triangle facing +Z and a small one facing +X
+                    const std::vector<float> positions = {
+                        0.0f, 0.0f, 0.0f,
+                        4.0f, 0.0f, 0.0f,
+                        0.0f, 4.0f, 0.0f,
+                        0.0f, 1.0f, 0.0f,
+                        0.0f, 0.0f, 1.0f
+                    };
+
+                    const std::vector<uint32_t> indices = { 0U, 1U, 2U, 0U, 3U, 4U };
+
+                    MeshTangentSpace::TangentSpaceOptions options;
+
+                    const float halfSqrt2 = std::sqrt(0.5f);
+                    AreNear({ halfSqrt2, 0.0f, halfSqrt2 }, MeshTangentSpace::GenerateNormals(indices, positions, options).data());
+
+                    // The triangles' areas are 8 and 0.5
+                    const float length = std::sqrt(1.0f + 16.0f * 16.0f);
+
+                    for (auto weighting : { MeshTangentSpace::NormalWeighting::Area, MeshTangentSpace::NormalWeighting::AreaAndAngle })
+                    {
+                        options.normalWeighting = weighting;
+                        AreNear({ 1.0f / length, 0.0f, 16.0f / length }, MeshTangentSpace::GenerateNormals(indices, positions, options).data());
+                    }
+
+                    Assert::ExpectException<GLTFException>([&positions]() { MeshTangentSpace::GenerateNormals({ 0U, 1U, 5U }, positions); });
+                    Assert::ExpectException<GLTFException>([&positions]() { MeshTangentSpace::GenerateNormals({ 0U, 1U }, positions); });
+                }
+
+                GLTFSDK_TEST_METHOD(MeshTangentSpaceTests, MeshTangentSpace_Test_GenerateTangents)
+                {
+                    // A unit square facing +Z, with its texture's top-left corner at the square's top-left corner
+                    const std::vector<float> positions = {
+                        0.0f, 0.0f, 0.0f,
+                        1.0f, 0.0f, 0.0f,
+                        1.0f, 1.0f, 0.0f,
+                        0.0f, 1.0f, 0.0f
+                    };
+
+                    const std::vector<uint32_t> indices = { 0U, 1U, 2U, 0U, 2U, 3U };
+                    const std::vector<float> normals = { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f };
+
+                    std::vector<float> texcoords = { 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f };
+
+                    auto tangents = MeshTangentSpace::GenerateTangents(indices, positions, normals, texcoords);
+
+                    Assert::AreEqual<size_t>(16U, tangents.size());
+
+                    for (size_t i = 0U; i < 4U; i++)
+                    {
+                        AreNear({ 1.0f, 0.0f, 0.0f, 1.0f }, tangents.data() + i * 4U);
+                    }
+
+                    // Mirroring the texture horizontally reverses the tangent and flips the handedness, so that the
+                    // bitangent (cross(normal, tangent) * w) still points up the texture
+                    for (size_t i = 0U; i < texcoords.size(); i += 2U)
+                    {
+                        texcoords[i] = 1.0f - texcoords[i];
+                    }
+
+                    tangents = MeshTangentSpace::GenerateTangents(indices, positions, normals, texcoords);
+
+                    for (size_t i = 0U; i < 4U; i++)
+                    {
+                        AreNear({ -1.0f, 0.0f, 0.0f, -1.0f }, tangents.data() + i * 4U);
+                    }
+
+                    // Without usable texture coordinates, tangents are perpendicular to the normals
+                    tangents = MeshTangentSpace::GenerateTangents(indices, positions, normals, std::vector<float>(8U, 0.5f));
+
+                    for (size_t i = 0U; i < 4U; i++)
+                    {
+                        AreNear({ 1.0f, 0.0f, 0.0f, 1.0f }, tangents.data() + i * 4U);
+                    }
+
+                    Assert::ExpectException<GLTFException>([&]() { MeshTangentSpace::GenerateTangents(indices, positions, normals, { 0.0f, 0.0f }); });
+                }
+
+                GLTFSDK_TEST_METHOD(MeshTangentSpaceTests, MeshTangentSpace_Test_Parallel)
+                {
+                    std::vector<float> positions;
+                    std::vector<float> texcoords;
+                    std::vector<uint32_t> indices;
+
+                    MakeGrid(100U, positions, texcoords, indices);
+
+                    MeshTangentSpace::TangentSpaceOptions options;
+                    options.threadCount = 1U;
+
+                    const auto normals = MeshTangentSpace::GenerateNormals(indices, positions, options);
+                    const auto tangents = MeshTangentSpace::GenerateTangents(indices, positions, normals, texcoords, options);
+
+                    // The results don't depend on how the work is divided between threads
+                    options.minParallelTriangleCount = 0U;
+                    options.threadCount = 4U;
+
+                    AreEqual(normals, MeshTangentSpace::GenerateNormals(indices, positions, options));
+                    AreEqual(tangents, MeshTangentSpace::GenerateTangents(indices, positions, normals, texcoords, options));
+
+                    for (size_t i = 0U; i < positions.size() / 3U; i++)
+                    {
+                        const float* n = normals.data() + i * 3U;
+                        const float* t = tangents.data() + i * 4U;
+
+                        // Unit length, perpendicular and right-handed, as the texture isn't mirrored
+                        Assert::IsTrue(std::abs(n[0] * n[0] + n[1] * n[1] + n[2] * n[2] - 1.0f) < Epsilon);
+                        Assert::IsTrue(std::abs(t[0] * t[0] + t[1] * t[1] + t[2] * t[2] - 1.0f) < Epsilon);
+                        Assert::IsTrue(std::abs(n[0] * t[0] + n[1] * t[1] + n[2] * t[2]) < Epsilon);
+                        Assert::AreEqual(1.0f, t[3]);
+                        Assert::IsTrue(n[2] > 0.0f && t[0] > 0.0f);
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(MeshTangentSpaceTests, MeshTangentSpace_Test_RewritePrimitive)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto doc = MakeGridDocument(readerWriter);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    auto bufferBuilder = MakeRewriteBufferBuilder(readerWriter, "generated");
+
+                    const auto& textured = doc.meshes.Get("textured").primitives[0];
+                    const auto& plain = doc.meshes.Get("plain").primitives[0];
+                    const auto& stale = doc.meshes.Get("stale").primitives[0];
+
+                    const auto texturedResult = MeshTangentSpace::GenerateTangentSpace(doc, reader, textured, bufferBuilder);
+                    const auto plainResult = MeshTangentSpace::GenerateTangentSpace(doc, reader, plain, bufferBuilder);
+                    const auto staleResult = MeshTangentSpace::GenerateTangentSpace(doc, reader, stale, bufferBuilder);
+
+                    // Already complete, so unchanged
+                    const auto completeResult = MeshTangentSpace::GenerateTangentSpace(doc, reader, texturedResult, bufferBuilder);
+
+                    bufferBuilder.Output(doc);
+
+                    Assert::IsTrue(texturedResult.HasAttribute(ACCESSOR_NORMAL));
+                    Assert::IsTrue(texturedResult.HasAttribute(ACCESSOR_TANGENT));
+                    Assert::IsTrue(plainResult.HasAttribute(ACCESSOR_NORMAL));
+                    Assert::IsFalse(plainResult.HasAttribute(ACCESSOR_TANGENT));
+                    Assert::IsTrue(staleResult.HasAttribute(ACCESSOR_NORMAL));
+                    Assert::IsFalse(staleResult.HasAttribute(ACCESSOR_TANGENT));
+                    Assert::IsTrue(completeResult == texturedResult);
+
+                    const auto normals = reader.ReadFloatData(doc, doc.accessors.Get(texturedResult.GetAttributeAccessorId(ACCESSOR_NORMAL)));
+                    const auto tangents = reader.ReadFloatData(doc, doc.accessors.Get(texturedResult.GetAttributeAccessorId(ACCESSOR_TANGENT)));
+
+                    Assert::AreEqual<size_t>(9U * 3U, normals.size());
+                    Assert::AreEqual<size_t>(9U * 4U, tangents.size());
+
+                    for (size_t i = 0U; i < 9U; i++)
+                    {
+                        AreNear({ 0.0f, 0.0f, 1.0f }, normals.data() + i * 3U);
+                        AreNear({ 1.0f, 0.0f, 0.0f, 1.0f }, tangents.data() + i * 4U);
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(MeshTangentSpaceTests, MeshTangentSpace_Test_RewriteDocument)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto doc = MakeGridDocument(readerWriter);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    auto bufferBuilder = MakeRewriteBufferBuilder(readerWriter, "generated");
+
+                    MeshTangentSpace::TangentSpaceOptions options;
+                    options.threadCount = 2U;
+
+                    MeshTangentSpace::GenerateTangentSpace(doc, reader, bufferBuilder, options);
+
+                    // Normals and tangents for "textured", normals for the other two
+                    Assert::AreEqual<size_t>(4U, bufferBuilder.GetAccessorCount());
+
+                    bufferBuilder.Output(doc);
+
+                    for (const auto& mesh : doc.meshes.Elements())
+                    {
+                        Assert::IsTrue(mesh.primitives[0].HasAttribute(ACCESSOR_NORMAL));
+                        Assert::AreEqual(mesh.id == "textured", mesh.primitives[0].HasAttribute(ACCESSOR_TANGENT));
+                    }
+
+                    const auto& tangentsAccessor = doc.accessors.Get(doc.meshes.Get("textured").primitives[0].GetAttributeAccessorId(ACCESSOR_TANGENT));
+
+                    Assert::IsTrue(tangentsAccessor.type == TYPE_VEC4);
+                    Assert::IsTrue(tangentsAccessor.componentType == COMPONENT_FLOAT);
+                    Assert::AreEqual<size_t>(9U, tangentsAccessor.count);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,421 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/SceneBVH.h>
+
+#include "TestUtils.h"
+
+#include <TestUtilsCommon/MeshTestUtils.h>
+
+#include <cmath>
+#include <sstream>
+
+using namespace glTF::UnitTest;
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            namespace
+            {
+                const float Epsilon = 1e-4f;
+
+                const uint32_t GridSize = 4U;
+
+                // A document with a grid of GridSize x GridSize unit quads in the XY plane, from the origin, placed by
+                // node "a" at the origin and by node "b" (in a second scene) translated 5 along Z. Each quad's first
+                // triangle is below its diagonal and its second above.
+                Document MakeGridDocument(std::shared_ptr<const StreamReaderWriter> readerWriter)
+                {
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    const auto positions = MakeGridPositions(GridSize, [](uint32_t, uint32_t) { return 0.0f; });
+                    const auto indices = MakeGridIndices(GridSize);
+
+                    bufferBuilder.AddBuffer();
+
+                    MeshPrimitive meshPrimitive;
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ELEMENT_ARRAY_BUFFER);
+                    meshPrimitive.indicesAccessorId = bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, COMPONENT_UNSIGNED_INT }).id;
+
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    meshPrimitive.attributes[ACCESSOR_POSITION] = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT }).id;
+
+                    Mesh mesh;
+                    mesh.id = "grid";
+                    mesh.primitives.push_back(meshPrimitive);
+
+                    Node a;
+                    a.id = "a";
+                    a.meshId = "grid";
+
+                    Node b;
+                    b.id = "b";
+                    b.meshId = "grid";
+                    b.translation = Vector3(0.0f, 0.0f, 5.0f);
+
+                    Scene sceneA;
+                    sceneA.id = "sceneA";
+                    sceneA.nodes = { "a" };
+
+                    Scene sceneB;
+                    sceneB.id = "sceneB";
+                    sceneB.nodes = { "b" };
+
+                    Document doc;
+                    doc.meshes.Append(std::move(mesh), AppendIdPolicy::ThrowOnEmpty);
+                    doc.nodes.Append(std::move(a), AppendIdPolicy::ThrowOnEmpty);
+                    doc.nodes.Append(std::move(b), AppendIdPolicy::ThrowOnEmpty);
+                    doc.scenes.Append(std::move(sceneA), AppendIdPolicy::ThrowOnEmpty);
+                    doc.scenes.Append(std::move(sceneB), AppendIdPolicy::ThrowOnEmpty);
+                    bufferBuilder.Output(doc);
+
+                    return doc;
+                }
+
+                // A document with a single unindexed mesh of small triangles scattered through a 100 unit cube
+                Document MakeSoupDocument(std::shared_ptr<const StreamReaderWriter> readerWriter, size_t triangleCount, std::vector<float>& positions)
+                {
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    uint32_t seed = 12345U;
+
+                    auto random = [&seed]()
+                    {
+                        seed = seed * 1664525U + 1013904223U;
+                        return static_cast<float>(seed >> 8) / static_cast<float>(1U << 24);
+                    };
+
+                    positions.clear();
+
+                    for (size_t i = 0U; i < triangleCount; i++)
+                    {
+                        const float center[3] = { random() * 100.0f, random() * 100.0f, random() * 100.0f };
+
+                        for (size_t j = 0U; j < 9U; j++)
+                        {
+                            positions.push_back(center[j % 3U] + (random() - 0.5f) * 4.0f);
+                        }
+                    }
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    MeshPrimitive meshPrimitive;
+                    meshPrimitive.attributes[ACCESSOR_POSITION] = bufferBuilder.AddAccessor(positions, { TYPE_VEC3, COMPONENT_FLOAT }).id;
+
+                    Mesh mesh;
+                    mesh.id = "soup";
+                    mesh.primitives.push_back(meshPrimitive);
+
+                    Node node;
+                    node.id = "soup";
+                    node.meshId = "soup";
+
+                    Document doc;
+                    doc.meshes.Append(std::move(mesh), AppendIdPolicy::ThrowOnEmpty);
+                    doc.nodes.Append(std::move(node), AppendIdPolicy::ThrowOnEmpty);
+                    bufferBuilder.Output(doc);
+
+                    return doc;
+                }
+
+                Ray MakeRay(const Vector3& origin, const Vector3& direction)
+                {
+                    Ray ray;
+                    ray.origin = origin;
+                    ray.direction = direction;
+                    return ray;
+                }
+
+                // Intersects a ray with every triangle (Möller-Trumbore) as a reference for SceneBVH::Intersect
+                bool IntersectBruteForce(const std::vector<float>& positions, const Ray& ray, size_t& triangle, float& t)
+                {
+                    bool isHit = false;
+
+                    t = ray.tMax;
+
+                    for (size_t i = 0U; i < positions.size() / 9U; i++)
+                    {
+                        const float* v = positions.data() + i * 9U;
+
+                        const float e1[3] = { v[3] - v[0], v[4] - v[1], v[5] - v[2] };
+                        const float e2[3] = { v[6] - v[0], v[7] - v[1], v[8] - v[2] };
+                        const float d[3] = { ray.direction.x, ray.direction.y, ray.direction.z };
+                        const float s[3] = { ray.origin.x - v[0], ray.origin.y - v[1], ray.origin.z - v[2] };
+
+                        const float p[3] = { d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0] };
+                        const float q[3] = { s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0] };
+
+                        const float determinant = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+
+                        if (determinant == 0.0f)
+                        {
+                            continue;
+                        }
+
+                        const float inverseDeterminant = 1.0f / determinant;
+
+                        const float u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * inverseDeterminant;
+                        const float w = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) * inverseDeterminant;
+                        const float tHit = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * inverseDeterminant;
+
+                        if (u >= 0.0f && w >= 0.0f && u + w <= 1.0f && tHit >= ray.tMin && tHit < t)
+                        {
+                            t = tHit;
+                            triangle = i;
+                            isHit = true;
+                        }
+                    }
+
+                    return isHit;
+                }
+            }
+
+            GLTFSDK_TEST_CLASS(SceneBVHTests)
+            {
+                GLTFSDK_TEST_METHOD(SceneBVHTests, SceneBVH_Test_Intersect)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    const auto doc = MakeGridDocument(readerWriter);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    const auto bvh = SceneBVH::Build(doc, reader);
+
+                    Assert::AreEqual<size_t>(GridSize * GridSize * 4U, bvh.GetTriangleCount());
+                    Assert::IsTrue(bvh.GetBounds() == SceneBounds::BoundingBox(Vector3(0.0f, 0.0f, 0.0f), Vector3(4.0f, 4.0f, 5.0f)));
+
+                    // Down onto node "b", above the first triangle of the quad at (1, 2)
+                    RayHit hit;
+                    Assert::IsTrue(bvh.Intersect(MakeRay(Vector3(1.75f, 2.25f, 10.0f), Vector3(0.0f, 0.0f, -2.0f)), hit));
+
+                    Assert::IsTrue(TriangleRef{ 1U, 0U, 0U, (2U * GridSize + 1U) * 2U } == hit.triangle);
+                    Assert::AreEqual(2.5f, hit.t);
+                    Assert::IsTrue(std::abs(hit.u - 0.5f) < Epsilon);
+                    Assert::IsTrue(std::abs(hit.v - 0.25f) < Epsilon);
+
+                    // Up from below, through node "a"'s back face
+                    Assert::IsTrue(bvh.Intersect(MakeRay(Vector3(1.75f, 2.25f, -1.0f), Vector3(0.0f, 0.0f, 1.0f)), hit));
+                    Assert::AreEqual<size_t>(0U, hit.triangle.nodeIndex);
+                    Assert::AreEqual(1.0f, hit.t);
+
+                    // Stopping short of node "b"
+                    auto ray = MakeRay(Vector3(1.75f, 2.25f, 10.0f), Vector3(0.0f, 0.0f, -1.0f));
+                    ray.tMax = 4.0f;
+                    Assert::IsFalse(bvh.Intersect(ray, hit));
+
+                    // Starting beyond node "b"
+                    ray.tMin = 6.0f;
+                    ray.tMax = 20.0f;
+                    Assert::IsTrue(bvh.Intersect(ray, hit));
+                    Assert::AreEqual<size_t>(0U, hit.triangle.nodeIndex);
+
+                    Assert::IsFalse(bvh.Intersect(MakeRay(Vector3(1.75f, 2.25f, 10.0f), Vector3(0.0f, 0.0f, 1.0f)), hit));
+                    Assert::IsFalse(bvh.Intersect(MakeRay(Vector3(5.0f, 2.25f, 10.0f), Vector3(0.0f, 0.0f, -1.0f)), hit));
+
+                    // Only node "a" is in its scene
+                    BVHOptions options;
+                    options.sceneId = "sceneA";
+
+                    const auto sceneBvh = SceneBVH::Build(doc, reader, options);
+
+                    Assert::AreEqual<size_t>(GridSize * GridSize * 2U, sceneBvh.GetTriangleCount());
+                    Assert::IsTrue(sceneBvh.Intersect(MakeRay(Vector3(1.75f, 2.25f, 10.0f), Vector3(0.0f, 0.0f, -1.0f)), hit));
+                    Assert::AreEqual<size_t>(0U, hit.triangle.nodeIndex);
+                    Assert::AreEqual(10.0f, hit.t);
+                }
+
+                GLTFSDK_TEST_METHOD(SceneBVHTests, SceneBVH_Test_Query_FindNearest)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    const auto doc = MakeGridDocument(readerWriter);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    const auto bvh = SceneBVH::Build(doc, reader);
+
+                    // Below the diagonal of node "a"'s first quad, so only its first triangle overlaps
+                    auto triangles = bvh.Query(SceneBounds::BoundingBox(Vector3(0.5f, 0.1f, -0.1f), Vector3(0.6f, 0.2f, 0.1f)));
+
+                    Assert::AreEqual<size_t>(1U, triangles.size());
+                    Assert::IsTrue(TriangleRef{ 0U, 0U, 0U, 0U } == triangles[0]);
+
+                    // The box overlaps both triangles' bounding boxes, but not the second triangle itself
+                    triangles = bvh.Query(SceneBounds::BoundingBox(Vector3(0.8f, 0.0f, -0.1f), Vector3(0.9f, 0.05f, 0.1f)));
+                    Assert::AreEqual<size_t>(1U, triangles.size());
+
+                    // Every triangle of both nodes
+                    triangles = bvh.Query(SceneBounds::BoundingBox(Vector3(-1.0f, -1.0f, -1.0f), Vector3(5.0f, 5.0f, 6.0f)));
+                    Assert::AreEqual(bvh.GetTriangleCount(), triangles.size());
+
+                    Assert::IsTrue(bvh.Query(SceneBounds::BoundingBox(Vector3(0.0f, 0.0f, 1.0f), Vector3(4.0f, 4.0f, 4.0f))).empty());
+
+                    // Above the second triangle of node "a"'s first quad, nearer to it than to node "b"
+                    NearestPoint nearest;
+                    Assert::IsTrue(bvh.FindNearest(Vector3(0.2f, 0.8f, 1.0f), nearest));
+
+                    Assert::IsTrue(TriangleRef{ 0U, 0U, 0U, 1U } == nearest.triangle);
+                    AreNear(Vector3(0.2f, 0.8f, 0.0f), nearest.point, Epsilon);
+                    Assert::AreEqual(1.0f, nearest.distance);
+
+                    // Beyond the corner of the grid, the closest point is the corner itself
+                    Assert::IsTrue(bvh.FindNearest(Vector3(6.0f, 7.0f, 5.0f), nearest));
+                    AreNear(Vector3(4.0f, 4.0f, 5.0f), nearest.point, Epsilon);
+                    Assert::AreEqual(std::sqrt(13.0f), nearest.distance);
+
+                    Assert::IsFalse(bvh.FindNearest(Vector3(0.2f, 0.8f, 1.0f), nearest, 0.5f));
+                }
+
+                GLTFSDK_TEST_METHOD(SceneBVHTests, SceneBVH_Test_MatchesBruteForce)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+
+                    std::vector<float> positions;
+                    const auto doc = MakeSoupDocument(readerWriter, 10000U, positions);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    // Enough triangles that the top of the hierarchy is split with parallel binning
+                    BVHOptions options;
+                    options.maxLeafSize = 2U;
+                    options.binCount = 8U;
+                    options.threadCount = 4U;
+
+                    const auto bvh = SceneBVH::Build(doc, reader, options);
+
+                    Assert::AreEqual<size_t>(10000U, bvh.GetTriangleCount());
+
+                    for (size_t i = 0U; i < 200U; i++)
+                    {
+                        const float f = static_cast<float>(i);
+                        const auto ray = MakeRay(Vector3(-10.0f, f * 0.5f, 50.0f), Vector3(1.0f, 0.01f * (100.0f - f), std::sin(f)));
+
+                        RayHit hit;
+                        size_t expectedTriangle = 0U;
+                        float expectedT = 0.0f;
+
+                        const bool isHit = bvh.Intersect(ray, hit);
+
+                        Assert::AreEqual(IntersectBruteForce(positions, ray, expectedTriangle, expectedT), isHit);
+
+                        if (isHit)
+                        {
+                            Assert::AreEqual(expectedTriangle, hit.triangle.triangleIndex);
+                            Assert::AreEqual(expectedT, hit.t);
+                        }
+                    }
+
+                    // Every leaf is within the size limit and inside its ancestors' bounds
+                    const auto& nodes = bvh.GetNodes();
+
+                    for (size_t i = 0U; i < nodes.size(); i++)
+                    {
+                        if (nodes[i].count == 0U)
+                        {
+                            for (size_t child : { i + 1U, static_cast<size_t>(nodes[i].index) })
+                            {
+                                for (size_t axis = 0U; axis < 3U; axis++)
+                                {
+                                    Assert::IsTrue(nodes[i].min[axis] <= nodes[child].min[axis]);
+                                    Assert::IsTrue(nodes[i].max[axis] >= nodes[child].max[axis]);
+                                }
+                            }
+                        }
+                        else
+                        {
+                            Assert::IsTrue(nodes[i].count <= options.maxLeafSize);
+                        }
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(SceneBVHTests, SceneBVH_Test_Refit)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto doc = MakeGridDocument(readerWriter);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    auto bvh = SceneBVH::Build(doc, reader);
+
+                    Node b = doc.nodes.Get("b");
+                    b.translation = Vector3(10.0f, 0.0f, 5.0f);
+                    doc.nodes.Replace(b);
+
+                    bvh.Refit(doc);
+
+                    Assert::IsTrue(bvh.GetBounds() == SceneBounds::BoundingBox(Vector3(0.0f, 0.0f, 0.0f), Vector3(14.0f, 4.0f, 5.0f)));
+                    Assert::IsTrue(bvh.GetBounds() == SceneBVH::Build(doc, reader).GetBounds());
+
+                    RayHit hit;
+                    Assert::IsTrue(bvh.Intersect(MakeRay(Vector3(11.75f, 2.25f, 10.0f), Vector3(0.0f, 0.0f, -1.0f)), hit));
+                    Assert::IsTrue(TriangleRef{ 1U, 0U, 0U, (2U * GridSize + 1U) * 2U } == hit.triangle);
+                    Assert::AreEqual(5.0f, hit.t);
+
+                    // Node "b" has moved away from above node "a"
+                    Assert::IsTrue(bvh.Intersect(MakeRay(Vector3(1.75f, 2.25f, 10.0f), Vector3(0.0f, 0.0f, -1.0f)), hit));
+                    Assert::AreEqual<size_t>(0U, hit.triangle.nodeIndex);
+
+                    Assert::ExpectException<GLTFException>([&bvh]() { bvh.Refit(std::vector<Matrix4>(1U)); });
+                }
+
+                GLTFSDK_TEST_METHOD(SceneBVHTests, SceneBVH_Test_Serialize)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto doc = MakeGridDocument(readerWriter);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    const auto bvh = SceneBVH::Build(doc, reader);
+
+                    std::stringstream stream;
+                    bvh.Serialize(stream);
+
+                    const std::string data = stream.str();
+
+                    auto deserialized = SceneBVH::Deserialize(stream);
+
+                    Assert::AreEqual(bvh.GetTriangleCount(), deserialized.GetTriangleCount());
+                    Assert::AreEqual(bvh.GetNodes().size(), deserialized.GetNodes().size());
+                    Assert::IsTrue(bvh.GetBounds() == deserialized.GetBounds());
+
+                    RayHit hit;
+                    Assert::IsTrue(deserialized.Intersect(MakeRay(Vector3(1.75f, 2.25f, 10.0f), Vector3(0.0f, 0.0f, -1.0f)), hit));
+                    Assert::IsTrue(TriangleRef{ 1U, 0U, 0U, (2U * GridSize + 1U) * 2U } == hit.triangle);
+
+                    // The local positions are kept, so a deserialized hierarchy can be refit
+                    Node b = doc.nodes.Get("b");
+                    b.translation = Vector3(0.0f, 0.0f, 7.0f);
+                    doc.nodes.Replace(b);
+
+                    deserialized.Refit(doc);
+
+                    Assert::IsTrue(deserialized.Intersect(MakeRay(Vector3(1.75f, 2.25f, 10.0f), Vector3(0.0f, 0.0f, -1.0f)), hit));
+                    Assert::AreEqual(3.0f, hit.t);
+
+                    std::stringstream truncated(data.substr(0U, data.size() - 1U));
+                    Assert::ExpectException<GLTFException>([&truncated]() { SceneBVH::Deserialize(truncated); });
+
+                    std::stringstream invalid("Not a BVH");
+                    Assert::ExpectException<GLTFException>([&invalid]() { SceneBVH::Deserialize(invalid); });
+
+                    // A leaf referring to triangles beyond the end
+                    std::string corrupt = data;
+                    corrupt[corrupt.size() - 8U] = '\x7F';
+
+                    std::stringstream corrupted(corrupt);
+                    Assert::ExpectException<GLTFException>([&corrupted]() { SceneBVH::Deserialize(corrupted); });
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,293 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/SceneBounds.h>
+
+#include "TestUtils.h"
+
+#include <TestUtilsCommon/MeshTestUtils.h>
+
+#include <cmath>
+
+using namespace glTF::UnitTest;
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            namespace
+            {
+                // The corners of the cube from -1 to 1
+                const std::vector<float> CubePositions = {
+                    -1.0f, -1.0f, -1.0f,  1.0f, -1.0f, -1.0f, -1.0f,  1.0f, -1.0f,  1.0f,  1.0f, -1.0f,
+                    -1.0f, -1.0f,  1.0f,  1.0f, -1.0f,  1.0f, -1.0f,  1.0f,  1.0f,  1.0f,  1.0f,  1.0f
+                };
+
+                const float Epsilon = 1e-5f;
+
+                using Test::AreNear;
+
+                void AreNear(const SceneBounds::BoundingBox& expected, const SceneBounds::BoundingBox& actual)
+                {
+                    AreNear(expected.min, actual.min);
+                    AreNear(expected.max, actual.max);
+                }
+
+                // A document with a cube mesh (without a min and max for its positions unless 'hasMinMax' is set) and a
+                // morph target that displaces the cube's top up by 3
+                Document MakeCubeDocument(std::shared_ptr<const StreamReaderWriter> readerWriter, bool hasMinMax)
+                {
+                    auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(readerWriter));
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+                    std::vector<float> displacements(CubePositions.size());
+
+                    for (size_t i = 1U; i < displacements.size(); i += 3U)
+                    {
+                        displacements[i] = CubePositions[i] > 0.0f ? 3.0f : 0.0f;
+                    }
+
+                    MeshPrimitive meshPrimitive;
+                    MorphTarget target;
+
+                    if (hasMinMax)
+                    {
+                        meshPrimitive.attributes[ACCESSOR_POSITION] = bufferBuilder.AddAccessor(CubePositions, { TYPE_VEC3, COMPONENT_FLOAT, false, { -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f } }).id;
+                        target.positionsAccessorId = bufferBuilder.AddAccessor(displacements, { TYPE_VEC3, COMPONENT_FLOAT, false, { 0.0f, 0.0f, 0.0f }, { 0.0f, 3.0f, 0.0f } }).id;
+                    }
+                    else
+                    {
+                        meshPrimitive.attributes[ACCESSOR_POSITION] = bufferBuilder.AddAccessor(CubePositions, { TYPE_VEC3, COMPONENT_FLOAT }).id;
+                        target.positionsAccessorId = bufferBuilder.AddAccessor(displacements, { TYPE_VEC3, COMPONENT_FLOAT }).id;
+                    }
+
+                    meshPrimitive.targets.push_back(target);
+
+                    Mesh mesh;
+                    mesh.id = "cube";
+                    mesh.primitives.push_back(meshPrimitive);
+
+                    Document doc;
+                    doc.meshes.Append(std::move(mesh), AppendIdPolicy::ThrowOnEmpty);
+                    bufferBuilder.Output(doc);
+
+                    return doc;
+                }
+            }
+
+            GLTFSDK_TEST_CLASS(SceneBoundsTests)
+            {
+                GLTFSDK_TEST_METHOD(SceneBoundsTests, SceneBounds_Test_BoundingBox_Transform)
+                {
+                    const SceneBounds::BoundingBox box(Vector3(0.0f, 0.0f, 0.0f), Vector3(2.0f, 1.0f, 1.0f));
+
+                    // A quarter turn about Z, then a translation
+                    const float halfSqrt2 = std::sqrt(0.5f);
+                    const auto matrix = Math::ToMatrix(Vector3(10.0f, 0.0f, 0.0f), Quaternion(0.0f, 0.0f, halfSqrt2, halfSqrt2), Vector3::ONE);
+
+                    AreNear(Vector3(10.0f, 2.0f, 0.0f), Math::TransformPoint(matrix, Vector3(2.0f, 0.0f, 0.0f)));
+                    AreNear(SceneBounds::BoundingBox(Vector3(9.0f, 0.0f, 0.0f), Vector3(10.0f, 2.0f, 1.0f)), box.Transform(matrix));
+
+                    Assert::IsTrue(SceneBounds::BoundingBox().IsEmpty());
+                    Assert::IsTrue(SceneBounds::BoundingBox().Transform(matrix).IsEmpty());
+                }
+
+                GLTFSDK_TEST_METHOD(SceneBoundsTests, SceneBounds_Test_BoundingSphere_Merge)
+                {
+                    SceneBounds::BoundingSphere sphere(Vector3(0.0f, 0.0f, 0.0f), 1.0f);
+
+                    sphere.Merge(SceneBounds::BoundingSphere());
+                    sphere.Merge(SceneBounds::BoundingSphere(Vector3(0.5f, 0.0f, 0.0f), 0.25f));
+
+                    AreNear(Vector3(0.0f, 0.0f, 0.0f), sphere.center);
+                    Assert::AreEqual(1.0f, sphere.radius);
+
+                    sphere.Merge(SceneBounds::BoundingSphere(Vector3(4.0f, 0.0f, 0.0f), 1.0f));
+
+                    AreNear(Vector3(2.0f, 0.0f, 0.0f), sphere.center);
+                    Assert::AreEqual(3.0f, sphere.radius);
+                }
+
+                GLTFSDK_TEST_METHOD(SceneBoundsTests, SceneBounds_Test_ComputeMeshBounds)
+                {
+                    for (bool hasMinMax : { false, true })
+                    {
+                        auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                        const auto doc = MakeCubeDocument(readerWriter, hasMinMax);
+
+                        GLTFResourceReader reader(readerWriter);
+
+                        const auto bounds = SceneBounds::ComputeMeshBounds(doc, reader, doc.meshes.Get("cube"));
+
+                        // The morph target can raise the top of the cube by up to 3
+                        AreNear(SceneBounds::BoundingBox(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 4.0f, 1.0f)), bounds.box);
+                        Assert::IsTrue(bounds.sphere.IsEmpty());
+
+                        SceneBounds::BoundsOptions options;
+                        options.computeSpheres = true;
+
+                        const auto sphereBounds = SceneBounds::ComputeMeshBounds(doc, reader, doc.meshes.Get("cube"), options);
+
+                        AreNear(Vector3(0.0f, 0.0f, 0.0f), sphereBounds.sphere.center);
+                        Assert::IsTrue(std::abs(std::sqrt(3.0f) + 3.0f - sphereBounds.sphere.radius) < Epsilon);
+                    }
+                }
+
+                GLTFSDK_TEST_METHOD(SceneBoundsTests, SceneBounds_Test_ComputeBounds)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto doc = MakeCubeDocument(readerWriter, true);
+
+                    // A parent that translates and scales its children, one with the cube moved up by 5 and one without a mesh
+                    Node parent;
+                    parent.id = "parent";
+                    parent.translation = Vector3(10.0f, 0.0f, 0.0f);
+                    parent.scale = Vector3(2.0f, 2.0f, 2.0f);
+                    parent.children = { "child", "empty" };
+
+                    Node child;
+                    child.id = "child";
+                    child.meshId = "cube";
+                    child.translation = Vector3(0.0f, 5.0f, 0.0f);
+
+                    Node empty;
+                    empty.id = "empty";
+
+                    // A separate hierarchy with an untransformed cube, in a second scene
+                    Node other;
+                    other.id = "other";
+                    other.meshId = "cube";
+
+                    doc.nodes.Append(std::move(parent), AppendIdPolicy::ThrowOnEmpty);
+                    doc.nodes.Append(std::move(child), AppendIdPolicy::ThrowOnEmpty);
+                    doc.nodes.Append(std::move(empty), AppendIdPolicy::ThrowOnEmpty);
+                    doc.nodes.Append(std::move(other), AppendIdPolicy::ThrowOnEmpty);
+
+                    Scene scene;
+                    scene.id = "scene";
+                    scene.nodes = { "parent" };
+
+                    Scene otherScene;
+                    otherScene.id = "otherScene";
+                    otherScene.nodes = { "parent", "other" };
+
+                    doc.scenes.Append(std::move(scene), AppendIdPolicy::ThrowOnEmpty);
+                    doc.scenes.Append(std::move(otherScene), AppendIdPolicy::ThrowOnEmpty);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    SceneBounds::BoundsOptions options;
+                    options.threadCount = 2U;
+
+                    const auto bounds = SceneBounds::ComputeBounds(doc, reader, options);
+
+                    Assert::AreEqual<size_t>(1U, bounds.meshes.size());
+                    Assert::AreEqual<size_t>(4U, bounds.nodes.size());
+                    Assert::AreEqual<size_t>(2U, bounds.scenes.size());
+
+                    AreNear(Vector3(10.0f, 10.0f, 0.0f), Math::TransformPoint(bounds.worldTransforms[1], Vector3::ZERO));
+
+                    const SceneBounds::BoundingBox childBox(Vector3(8.0f, 8.0f, -2.0f), Vector3(12.0f, 18.0f, 2.0f));
+                    const SceneBounds::BoundingBox otherBox(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 4.0f, 1.0f));
+
+                    AreNear(childBox, bounds.nodes[0].box);
+                    AreNear(childBox, bounds.nodes[1].box);
+                    Assert::IsTrue(bounds.nodes[2].box.IsEmpty());
+                    AreNear(otherBox, bounds.nodes[3].box);
+
+                    AreNear(childBox, bounds.scenes[0].box);
+                    AreNear(SceneBounds::BoundingBox(Vector3(-1.0f, -1.0f, -2.0f), Vector3(12.0f, 18.0f, 2.0f)), bounds.scenes[1].box);
+
+                    // Reading and scanning the positions gives the same bounds
+                    options.useAccessorMinMax = false;
+
+                    const auto scannedBounds = SceneBounds::ComputeBounds(doc, reader, options);
+
+                    Assert::IsTrue(bounds.scenes[1].box == scannedBounds.scenes[1].box);
+                }
+
+                GLTFSDK_TEST_METHOD(SceneBoundsTests, SceneBounds_Test_ComputeBounds_Skin)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto doc = MakeCubeDocument(readerWriter, true);
+
+                    Node skinned;
+                    skinned.id = "skinned";
+                    skinned.meshId = "cube";
+                    skinned.skinId = "skin";
+                    skinned.translation = Vector3(100.0f, 0.0f, 0.0f); // Ignored, as the joints position the mesh
+
+                    Node joint0;
+                    joint0.id = "joint0";
+                    joint0.translation = Vector3(-5.0f, 0.0f, 0.0f);
+
+                    Node joint1;
+                    joint1.id = "joint1";
+                    joint1.translation = Vector3(5.0f, 0.0f, 0.0f);
+
+                    doc.nodes.Append(std::move(skinned), AppendIdPolicy::ThrowOnEmpty);
+                    doc.nodes.Append(std::move(joint0), AppendIdPolicy::ThrowOnEmpty);
+                    doc.nodes.Append(std::move(joint1), AppendIdPolicy::ThrowOnEmpty);
+
+                    Skin skin;
+                    skin.id = "skin";
+                    skin.jointIds = { "joint0", "joint1" };
+
+                    doc.skins.Append(std::move(skin), AppendIdPolicy::ThrowOnEmpty);
+
+                    GLTFResourceReader reader(readerWriter);
+
+                    const auto bounds = SceneBounds::ComputeBounds(doc, reader);
+
+                    AreNear(SceneBounds::BoundingBox(Vector3(-6.0f, -1.0f, -1.0f), Vector3(6.0f, 4.0f, 1.0f)), bounds.nodes[0].box);
+                }
+
+                GLTFSDK_TEST_METHOD(SceneBoundsTests, SceneBounds_Test_ComputeWorldTransforms_InvalidHierarchy)
+                {
+                    Node a;
+                    a.id = "a";
+                    a.children = { "b" };
+
+                    Node b;
+                    b.id = "b";
+                    b.children = { "a" };
+
+                    Document cycle;
+                    cycle.nodes.Append(a, AppendIdPolicy::ThrowOnEmpty);
+                    cycle.nodes.Append(b, AppendIdPolicy::ThrowOnEmpty);
+
+                    Assert::ExpectException<GLTFException>([&cycle]()
+                    {
+                        SceneBounds::ComputeWorldTransforms(cycle);
+                    });
+
+                    Node c;
+                    c.id = "c";
+                    c.children = { "b" };
+
+                    b.children.clear();
+
+                    Document multipleParents;
+                    multipleParents.nodes.Append(std::move(a), AppendIdPolicy::ThrowOnEmpty);
+                    multipleParents.nodes.Append(std::move(b), AppendIdPolicy::ThrowOnEmpty);
+                    multipleParents.nodes.Append(std::move(c), AppendIdPolicy::ThrowOnEmpty);
+
+                    Assert::ExpectException<GLTFException>([&multipleParents]()
+                    {
+                        SceneBounds::ComputeWorldTransforms(multipleParents);
+                    });
+                }
+            }
+        }
+    }
+}
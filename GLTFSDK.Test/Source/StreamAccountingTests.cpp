@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/StreamAccounting.h>
+
+#include "TestUtils.h"
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            namespace
+            {
+                // Writes 'vertexCount' interleaved positions and normals to a single buffer view
+                Document CreateInterleavedDocument(std::shared_ptr<const IStreamWriter> streamWriter, size_t vertexCount)
+                {
+                    BufferBuilder bufferBuilder(std::make_unique<GLTFResourceWriter>(std::move(streamWriter)));
+
+                    const std::vector<float> vertices(vertexCount * 6U, 1.0f);
+
+                    const AccessorDesc descs[2] =
+                    {
+                        { TYPE_VEC3, COMPONENT_FLOAT, false, {}, {}, 0 },
+                        { TYPE_VEC3, COMPONENT_FLOAT, false, {}, {}, 12 },
+                    };
+
+                    bufferBuilder.AddBuffer();
+                    bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+                    bufferBuilder.AddAccessors(vertices.data(), vertexCount, 24U, descs, 2U, nullptr);
+
+                    Document doc;
+                    bufferBuilder.Output(doc);
+
+                    return doc;
+                }
+            }
+
+            GLTFSDK_TEST_CLASS(StreamAccountingTests)
+            {
+                GLTFSDK_TEST_METHOD(StreamAccountingTests, GetReadSizeBucket)
+                {
+                    Assert::AreEqual<size_t>(0U, StreamStats::GetReadSizeBucket(0U));
+                    Assert::AreEqual<size_t>(0U, StreamStats::GetReadSizeBucket(1U));
+                    Assert::AreEqual<size_t>(1U, StreamStats::GetReadSizeBucket(3U));
+                    Assert::AreEqual<size_t>(4U, StreamStats::GetReadSizeBucket(16U));
+                    Assert::AreEqual<size_t>(StreamStats::ReadSizeBucketCount - 1U, StreamStats::GetReadSizeBucket(std::numeric_limits<size_t>::max()));
+                }
+
+                GLTFSDK_TEST_METHOD(StreamAccountingTests, Writer)
+                {
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto writer = std::make_shared<const AccountingStreamWriter>(readerWriter);
+
+                    auto doc = CreateInterleavedDocument(writer, 10U);
+                    auto stats = writer->GetAccounting()->GetStats(doc.buffers.Front().uri);
+
+                    Assert::AreEqual<uint64_t>(1U, stats.opens);
+                    Assert::AreEqual<uint64_t>(1U, stats.writes);
+                    Assert::AreEqual<uint64_t>(240U, stats.bytesWritten);
+                    Assert::AreEqual<uint64_t>(0U, stats.reads);
+                }
+
+                GLTFSDK_TEST_METHOD(StreamAccountingTests, Reader_Interleaved)
+                {
+                    const size_t vertexCount = 100U;
+
+                    auto readerWriter = std::make_shared<const StreamReaderWriter>();
+                    auto doc = CreateInterleavedDocument(readerWriter, vertexCount);
+
+                    auto accounting = std::make_shared<StreamAccounting>();
+                    auto reader = std::make_shared<const AccountingStreamReader>(readerWriter, accounting);
+
+                    GLTFResourceReader resourceReader(std::make_unique<AccountingStreamReaderCache>(MakeStreamReaderCache<StreamReaderCacheLRU>(reader), accounting));
+
+                    auto positions = resourceReader.ReadBinaryData<float>(doc, doc.accessors[0]);
+                    auto normals = resourceReader.ReadBinaryData<float>(doc, doc.accessors[1]);
+
+                    Assert::AreEqual<size_t>(vertexCount * 3U, positions.size());
+                    Assert::AreEqual<size_t>(vertexCount * 3U, normals.size());
+
+                    auto stats = accounting->GetStats(doc.buffers.Front().uri);
+
+                    // The buffer's stream is opened once and then served from the cache for the second accessor
+                    Assert::AreEqual<uint64_t>(1U, stats.opens);
+                    Assert::AreEqual<uint64_t>(2U, stats.cacheLookups);
+
+                    // Each element of an interleaved accessor is read with its own seek and 12 byte read
+                    Assert::AreEqual<uint64_t>(2U * vertexCount, stats.reads);
+                    Assert::AreEqual<uint64_t>(2U * vertexCount, stats.seeks);
+                    Assert::AreEqual<uint64_t>(2U * vertexCount * 12U, stats.bytesRead);
+                    Assert::AreEqual<uint64_t>(2U * vertexCount, stats.readSizeHistogram[StreamStats::GetReadSizeBucket(12U)]);
+
+                    std::stringstream report;
+                    accounting->WriteReport(report);
+
+                    Assert::IsTrue(report.str().find("seeks=200") != std::string::npos);
+
+                    accounting->Reset();
+
+                    Assert::AreEqual<uint64_t>(0U, accounting->GetTotalStats().reads);
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "stdafx.h"
+
+#include <GLTFSDK/Deserialize.h>
+#include <GLTFSDK/RapidJsonUtils.h>
+#include <GLTFSDK/Serialize.h>
+#include <GLTFSDK/Tracing.h>
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+using namespace glTF::UnitTest;
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            namespace
+            {
+                class RecordingTracer : public ITracer
+                {
+                public:
+                    void BeginSpan(const char* name) override
+                    {
+                        events.push_back(std::string("B:") + name);
+                    }
+
+                    void EndSpan(const char* name) override
+                    {
+                        events.push_back(std::string("E:") + name);
+                    }
+
+                    void Count(const char* name, int64_t delta) override
+                    {
+                        counters[name] += delta;
+                    }
+
+                    std::vector<std::string> events;
+                    std::map<std::string, int64_t> counters;
+                };
+
+                // Registers a tracer for the lifetime of the test, restoring the previous one afterwards
+                class ScopedTracer
+                {
+                public:
+                    explicit ScopedTracer(ITracer* tracer) : m_previous(Tracing::GetTracer())
+                    {
+                        Tracing::SetTracer(tracer);
+                    }
+
+                    ~ScopedTracer()
+                    {
+                        Tracing::SetTracer(m_previous);
+                    }
+
+                private:
+                    ITracer* m_previous;
+                };
+            }
+
+            GLTFSDK_TEST_CLASS(TracingTests)
+            {
+                GLTFSDK_TEST_METHOD(TracingTests, ScopedSpan_Nested)
+                {
+                    RecordingTracer tracer;
+                    ScopedTracer scopedTracer(&tracer);
+
+                    {
+                        Tracing::ScopedSpan outer("Outer");
+                        {
+                            Tracing::ScopedSpan inner("Inner");
+                            Tracing::Count("Items", 2);
+                        }
+                        Tracing::Count("Items", 3);
+                    }
+
+                    const std::vector<std::string> expected = { "B:Outer", "B:Inner", "E:Inner", "E:Outer" };
+
+                    Assert::IsTrue(expected == tracer.events);
+                    Assert::AreEqual<int64_t>(5, tracer.counters["Items"]);
+                }
+
+                GLTFSDK_TEST_METHOD(TracingTests, ScopedSpan_NoTracer)
+                {
+                    ScopedTracer scopedTracer(nullptr);
+
+                    Tracing::ScopedSpan span("Span");
+                    Tracing::Count("Items", 1);
+
+                    Assert::IsNull(Tracing::GetTracer());
+                }
+
+                GLTFSDK_TEST_METHOD(TracingTests, ChromeTracer_Write)
+                {
+                    ChromeTracer tracer;
+
+                    tracer.BeginSpan("Load");
+                    tracer.Count("BytesRead", 16);
+                    tracer.Count("BytesRead", 32);
+                    tracer.EndSpan("Load");
+
+                    std::stringstream stream;
+                    tracer.Write(stream);
+
+                    auto json = RapidJsonUtils::CreateDocumentFromString(stream.str());
+                    const auto& events = json["traceEvents"];
+
+                    Assert::AreEqual(4U, events.Size());
+
+                    Assert::AreEqual<std::string>("Load", events[0]["name"].GetString());
+                    Assert::AreEqual<std::string>("B", events[0]["ph"].GetString());
+                    Assert::AreEqual<std::string>("E", events[3]["ph"].GetString());
+                    Assert::IsTrue(events[3]["ts"].GetInt64() >= events[0]["ts"].GetInt64());
+                    Assert::AreEqual(events[0]["tid"].GetUint(), events[3]["tid"].GetUint());
+
+                    // Counter events report the running total rather than the delta
+                    Assert::AreEqual<std::string>("C", events[1]["ph"].GetString());
+                    Assert::AreEqual<int64_t>(16, events[1]["args"]["value"].GetInt64());
+                    Assert::AreEqual<int64_t>(48, events[2]["args"]["value"].GetInt64());
+                }
+
+#ifdef GLTFSDK_ENABLE_TRACING
+                GLTFSDK_TEST_METHOD(TracingTests, Deserialize_Serialize_Spans)
+                {
+                    RecordingTracer tracer;
+                    ScopedTracer scopedTracer(&tracer);
+
+                    auto doc = Deserialize(R"({"asset":{"version":"2.0"}})");
+                    Serialize(doc);
+
+                    auto hasEvent = [&tracer](const std::string& event)
+                    {
+                        return std::find(tracer.events.begin(), tracer.events.end(), event) != tracer.events.end();
+                    };
+
+                    Assert::IsTrue(hasEvent("B:Deserialize"));
+                    Assert::IsTrue(hasEvent("E:ValidateDocumentAgainstSchema"));
+                    Assert::IsTrue(hasEvent("E:Serialize"));
+                    Assert::AreEqual<std::string>("E:Serialize", tracer.events.back());
+                }
+#endif
+            };
+        }
+    }
+}
@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <TestUtilsCommon/AllocationCounter.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace Microsoft::glTF::Test;
+
+namespace
+{
+    std::atomic<size_t> g_allocationCount(0U);
+}
+
+// Replacing the global operator new is the only portable way to observe every allocation the SDK
+// makes. The array and nothrow forms all forward to this one by default.
+void* operator new(size_t size)
+{
+    g_allocationCount.fetch_add(1U, std::memory_order_relaxed);
+
+    if (void* ptr = std::malloc(size == 0U ? 1U : size))
+    {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+AllocationCounter::AllocationCounter() : m_start(g_allocationCount.load(std::memory_order_relaxed))
+{
+}
+
+size_t AllocationCounter::GetCount() const
+{
+    return g_allocationCount.load(std::memory_order_relaxed) - m_start;
+}
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            // Counts the calls made to the global operator new (on any thread) since construction, so tests and
+            // benchmarks can guard against allocations creeping back into code paths that have been optimized.
+            // RapidJSON's default allocator calls malloc directly so the memory it uses isn't included
+            class AllocationCounter
+            {
+            public:
+                AllocationCounter();
+
+                size_t GetCount() const;
+
+            private:
+                size_t m_start;
+            };
+        }
+    }
+}
@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/GLTFResourceWriter.h>
+#include <GLTFSDK/IStreamWriter.h>
+#include <GLTFSDK/Math.h>
+#include <GLTFSDK/MeshOptimizer.h>
+
+#include <TestUtilsCommon/UnitTestBridge.h>
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Test
+        {
+            // A builder for a rewrite step's output, whose ids don't collide with those already in the document
+            inline BufferBuilder MakeRewriteBufferBuilder(std::shared_ptr<const IStreamWriter> streamWriter, const std::string& prefix)
+            {
+                auto bufferBuilder = BufferBuilder(std::make_unique<GLTFResourceWriter>(std::move(streamWriter)),
+                    [prefix](const BufferBuilder& builder) { return prefix + "Buffer" + std::to_string(builder.GetBufferCount()); },
+                    [prefix](const BufferBuilder& builder) { return prefix + "BufferView" + std::to_string(builder.GetBufferViewCount()); },
+                    [prefix](const BufferBuilder& builder) { return prefix + "Accessor" + std::to_string(builder.GetAccessorCount()); });
+
+                bufferBuilder.AddBuffer();
+
+                return bufferBuilder;
+            }
+
+            inline MeshOptimizer::VertexStream MakeFloatStream(const std::string& semantic, AccessorType accessorType, const std::vector<float>& values)
+            {
+                MeshOptimizer::VertexStream stream;
+                stream.semantic = semantic;
+                stream.accessorType = accessorType;
+                stream.componentType = COMPONENT_FLOAT;
+                stream.data.resize(values.size() * sizeof(float));
+
+                std::memcpy(stream.data.data(), values.data(), stream.data.size());
+
+                return stream;
+            }
+
+            // The positions of a grid of 'size' x 'size' unit quads in the XY plane, from the origin, with heights from 'getHeight'
+            template<typename Fn>
+            std::vector<float> MakeGridPositions(uint32_t size, Fn getHeight)
+            {
+                std::vector<float> positions;
+
+                for (uint32_t y = 0U; y <= size; y++)
+                {
+                    for (uint32_t x = 0U; x <= size; x++)
+                    {
+                        positions.insert(positions.end(), { static_cast<float>(x), static_cast<float>(y), getHeight(x, y) });
+                    }
+                }
+
+                return positions;
+            }
+
+            // The indices of a grid made by MakeGridPositions. Each quad's first triangle is below its diagonal and its second above.
+            inline std::vector<uint32_t> MakeGridIndices(uint32_t size)
+            {
+                std::vector<uint32_t> indices;
+
+                for (uint32_t y = 0U; y < size; y++)
+                {
+                    for (uint32_t x = 0U; x < size; x++)
+                    {
+                        const uint32_t v00 = y * (size + 1U) + x;
+                        const uint32_t v01 = v00 + size + 1U;
+
+                        indices.insert(indices.end(), { v00, v00 + 1U, v01 + 1U, v00, v01 + 1U, v01 });
+                    }
+                }
+
+                return indices;
+            }
+
+            inline void AreNear(const Vector3& expected, const Vector3& actual, float epsilon = 1e-5f)
+            {
+                ::glTF::UnitTest::Assert::IsTrue(std::abs(expected.x - actual.x) < epsilon);
+                ::glTF::UnitTest::Assert::IsTrue(std::abs(expected.y - actual.y) < epsilon);
+                ::glTF::UnitTest::Assert::IsTrue(std::abs(expected.z - actual.z) < epsilon);
+            }
+
+            inline void AreNear(const std::vector<float>& expected, const float* actual, float epsilon = 1e-5f)
+            {
+                for (size_t i = 0U; i < expected.size(); i++)
+                {
+                    ::glTF::UnitTest::Assert::IsTrue(std::abs(expected[i] - actual[i]) < epsilon);
+                }
+            }
+        }
+    }
+}
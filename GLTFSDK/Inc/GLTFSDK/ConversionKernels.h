@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        // Vectorized conversions used to decode vertex data. The implementation is selected at runtime from the
+        // instruction sets that the CPU supports, falling back to portable scalar code on other architectures.
+        //
+        // Unless noted otherwise, each kernel processes 'count' elements and 'dst' may alias 'src' provided both start at
+        // the same address, which allows accessor data read into the front of an output buffer to be converted in place.
+        namespace ConversionKernels
+        {
+            enum class InstructionSet
+            {
+                Scalar,
+                SSE2,
+                AVX2
+            };
+
+            bool IsSupported(InstructionSet instructionSet);
+
+            // The instruction set used by the kernels, initially the best one that is supported
+            InstructionSet GetInstructionSet();
+
+            // Overrides the instruction set used by the kernels (process-wide), e.g. to compare implementations.
+            // Throws a GLTFException if the instruction set isn't supported.
+            void SetInstructionSet(InstructionSet instructionSet);
+
+            void WidenU8ToU16(const uint8_t* src, uint16_t* dst, size_t count);
+            void WidenU8ToU32(const uint8_t* src, uint32_t* dst, size_t count);
+            void WidenU16ToU32(const uint16_t* src, uint32_t* dst, size_t count);
+
+            // When 'normalized' is true the values are mapped to [0,1] or [-1,1] exactly as ComponentToFloat does
+            void ToFloat(const int8_t* src, float* dst, size_t count, bool normalized);
+            void ToFloat(const uint8_t* src, float* dst, size_t count, bool normalized);
+            void ToFloat(const int16_t* src, float* dst, size_t count, bool normalized);
+            void ToFloat(const uint16_t* src, float* dst, size_t count, bool normalized);
+
+            // Packs 'count' groups of four (or three, with an alpha of 255) floats into RGBA8 values as Math::FloatToByte
+            // does for values in [0,1]. Values outside of that range (and NaNs) are saturated rather than undefined.
+            void PackUnorm8x4(const float* src, uint32_t* dst, size_t count);
+            void PackUnorm8x3(const float* src, uint32_t* dst, size_t count);
+
+            // Expands 'count' RGB8 values to RGBA8 with an alpha of 255
+            void ExpandRGB8ToRGBA8(const uint8_t* src, uint32_t* dst, size_t count);
+
+            // Expand strip or fan indices to 'count' triangles (or line strip indices to 'count' segments) in list form.
+            // These expand front to back so, rather than sharing its start, 'src' may instead lie within 'dst' at least
+            // 2 * count - 2 (for triangles) or count - 1 (for segments) elements beyond it. This allows indices read into
+            // the back of an output buffer to be expanded in place.
+            void TriangleStripToList(const uint16_t* src, uint16_t* dst, size_t count);
+            void TriangleStripToList(const uint32_t* src, uint32_t* dst, size_t count);
+
+            void TriangleFanToList(const uint16_t* src, uint16_t* dst, size_t count);
+            void TriangleFanToList(const uint32_t* src, uint32_t* dst, size_t count);
+
+            void LineStripToList(const uint16_t* src, uint16_t* dst, size_t count);
+            void LineStripToList(const uint32_t* src, uint32_t* dst, size_t count);
+
+            // Extends the component-wise bounds 'min' and 'max' (three floats each, initialized by the caller) to include
+            // 'count' groups of three floats, e.g. positions. NaN components are ignored.
+            void MinMaxFloat3(const float* src, size_t count, float* min, float* max);
+
+            // Scales 'count' groups of three floats (e.g. normals) to unit length. Vectors whose squared length is zero
+            // (or NaN) become zero so that callers can detect and replace them.
+            void NormalizeFloat3(const float* src, float* dst, size_t count);
+        }
+    }
+}
@@ -27,6 +27,10 @@ namespace Microsoft
             const Scene& GetDefaultScene() const;
             const Scene& SetDefaultScene(Scene&& scene, AppendIdPolicy policy = AppendIdPolicy::ThrowOnEmpty);
 
+            // Approximate number of bytes occupied by the document, including all the glTF objects,
+            // strings and extensions it owns (see MemoryUsage.h)
+            size_t EstimateMemoryUsage() const;
+
             Asset asset;
 
             IndexedContainer<const Accessor> accessors;
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
 namespace Microsoft
@@ -17,6 +18,10 @@ namespace Microsoft
             virtual std::unique_ptr<Extension> Clone() const = 0;
             virtual bool IsEqual(const Extension& other) const = 0;
 
+            // Approximate number of bytes occupied by the extension, including any memory it owns. The default
+            // implementation only knows about the Extension base class so derived types should override it.
+            virtual size_t EstimateMemoryUsage() const;
+
             bool operator==(const Extension& rhs) const;
             bool operator!=(const Extension& rhs) const;
 
@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace Microsoft
 {
@@ -35,6 +36,7 @@ namespace Microsoft
 
                     std::unique_ptr<Extension> Clone() const override;
                     bool IsEqual(const Extension& rhs) const override;
+                    size_t EstimateMemoryUsage() const override;
                 };
 
                 std::string SerializePBRSpecGloss(const PBRSpecularGlossiness& specGloss, const Document& gltfDocument, const ExtensionSerializer& extensionSerializer);
@@ -47,6 +49,7 @@ namespace Microsoft
                 {
                     std::unique_ptr<Extension> Clone() const override;
                     bool IsEqual(const Extension& rhs) const override;
+                    size_t EstimateMemoryUsage() const override;
                 };
 
                 std::string SerializeUnlit(const Unlit& unlit, const Document& gltfDocument, const ExtensionSerializer& extensionSerializer);
@@ -66,12 +69,32 @@ namespace Microsoft
 
                     std::unique_ptr<Extension> Clone() const override;
                     bool IsEqual(const Extension& rhs) const override;
+                    size_t EstimateMemoryUsage() const override;
                 };
 
                 std::string SerializeDracoMeshCompression(const DracoMeshCompression& dracoMeshCompression, const Document& gltfDocument, const ExtensionSerializer& extensionSerializer);
                 std::unique_ptr<Extension> DeserializeDracoMeshCompression(const std::string& json, const ExtensionDeserializer& extensionDeserializer);
             }
 
+            namespace Textures
+            {
+                constexpr const char* TEXTUREBASISU_NAME = "KHR_texture_basisu";
+
+                // KHR_texture_basisu
+                struct TextureBasisU : Extension, glTFProperty
+                {
+                    std::string imageId;
+
+                    std::unique_ptr<Extension> Clone() const override;
+                    bool IsEqual(const Extension& rhs) const override;
+                    size_t EstimateMemoryUsage() const override;
+                };
+
+                std::string SerializeTextureBasisU(const TextureBasisU& textureBasisU, const Document& gltfDocument, const ExtensionSerializer& extensionSerializer);
+                std::unique_ptr<Extension> DeserializeTextureBasisU(const std::string& json, const ExtensionDeserializer& extensionDeserializer);
+
+            }
+
             namespace TextureInfos
             {
                 constexpr const char* TEXTURETRANSFORM_NAME = "KHR_texture_transform";
@@ -89,6 +112,7 @@ namespace Microsoft
 
                     std::unique_ptr<Extension> Clone() const override;
                     bool IsEqual(const Extension& rhs) const override;
+                    size_t EstimateMemoryUsage() const override;
                 };
 
                 std::string SerializeTextureTransform(const TextureTransform& textureTransform, const Document& gltfDocument, const ExtensionSerializer& extensionSerializer);
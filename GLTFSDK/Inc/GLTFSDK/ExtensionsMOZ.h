@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/ExtensionHandlers.h>
+
+#include <memory>
+#include <string>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace MOZ
+        {
+            // Adds the handlers for Mozilla's vendor extensions to 'extensionSerializer', e.g. the one returned by
+            // KHR::GetKHRExtensionSerializer, so documents that use both kinds of extension can be serialized
+            ExtensionSerializer   GetMOZExtensionSerializer(ExtensionSerializer extensionSerializer = {});
+            ExtensionDeserializer GetMOZExtensionDeserializer(ExtensionDeserializer extensionDeserializer = {});
+
+            namespace Textures
+            {
+                constexpr const char* HUBSTEXTUREBASIS_NAME = "MOZ_HUBS_texture_basis";
+
+                // MOZ_HUBS_texture_basis - the extension for .basis images that preceded KHR_texture_basisu
+                struct HubsTextureBasis : Extension, glTFProperty
+                {
+                    std::string imageId;
+
+                    std::unique_ptr<Extension> Clone() const override;
+                    bool IsEqual(const Extension& rhs) const override;
+                    size_t EstimateMemoryUsage() const override;
+                };
+
+                std::string SerializeHubsTextureBasis(const HubsTextureBasis& hubsTextureBasis, const Document& gltfDocument, const ExtensionSerializer& extensionSerializer);
+                std::unique_ptr<Extension> DeserializeHubsTextureBasis(const std::string& json, const ExtensionDeserializer& extensionDeserializer);
+            }
+        }
+    }
+}
@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/ExtensionHandlers.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace MSFT
+        {
+            // Adds the handlers for Microsoft's vendor extensions to 'extensionSerializer', e.g. the one returned by
+            // KHR::GetKHRExtensionSerializer, so documents that use both kinds of extension can be serialized
+            ExtensionSerializer   GetMSFTExtensionSerializer(ExtensionSerializer extensionSerializer = {});
+            ExtensionDeserializer GetMSFTExtensionDeserializer(ExtensionDeserializer extensionDeserializer = {});
+
+            namespace Nodes
+            {
+                constexpr const char* LOD_NAME = "MSFT_lod";
+
+                // MSFT_lod - lists a node's levels of detail
+                struct Lod : Extension, glTFProperty
+                {
+                    // The nodes to use in place of this one, from the highest level of detail to the lowest
+                    std::vector<std::string> ids;
+
+                    std::unique_ptr<Extension> Clone() const override;
+                    bool IsEqual(const Extension& rhs) const override;
+                    size_t EstimateMemoryUsage() const override;
+                };
+
+                std::string SerializeLod(const Lod& lod, const Document& gltfDocument, const ExtensionSerializer& extensionSerializer);
+                std::unique_ptr<Extension> DeserializeLod(const std::string& json, const ExtensionDeserializer& extensionDeserializer);
+            }
+        }
+    }
+}
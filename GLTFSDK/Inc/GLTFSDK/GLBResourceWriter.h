@@ -28,5 +28,10 @@ namespace Microsoft
         private:
             std::shared_ptr<std::iostream> m_stream;
         };
+
+        // Writes the GLB header, the JSON chunk containing 'manifest' and the header of a BIN chunk whose contents are
+        // 'binaryByteLength' bytes long. The caller writes the BIN chunk's contents followed by its zero padding.
+        // Returns the length of the whole GLB, as recorded in its header.
+        uint32_t WriteGLBHeader(std::ostream& stream, const std::string& manifest, size_t binaryByteLength);
     }
 }
@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/GLBResourceReader.h>
+#include <GLTFSDK/IStreamCache.h>
+#include <GLTFSDK/IStreamWriter.h>
+
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        // Writes a new GLB based on an existing one where only the data of some buffer views has
+        // changed. Buffer views that have not been replaced are copied straight from the source GLB
+        // stream, coalesced into contiguous ranges, rather than being read into intermediate buffers.
+        class GLBRewriter
+        {
+        public:
+            GLBRewriter(std::shared_ptr<const GLBResourceReader> glbReader, std::shared_ptr<const IStreamWriter> streamWriter);
+            GLBRewriter(std::shared_ptr<const GLBResourceReader> glbReader, std::unique_ptr<IStreamWriterCache> streamCache);
+
+            void SetBufferViewData(const std::string& bufferViewId, std::vector<uint8_t> data);
+            bool HasBufferViewData(const std::string& bufferViewId) const;
+
+            // Drops a buffer view (and its data) from the GLB buffer. Update throws if any accessor or
+            // image still refers to it; references from extensions are the caller's responsibility.
+            void RemoveBufferView(const std::string& bufferViewId);
+
+            // Recalculates the offset and length of every buffer view stored in the GLB buffer (and
+            // the length of the GLB buffer itself) so the document describes the rewritten binary chunk
+            void Update(Document& document);
+
+            // As above, where 'bufferViewOrder' lists the indices of every buffer view stored in the GLB buffer in
+            // order of their offset, e.g. from a layout the caller has already worked out, so they aren't sorted again
+            void Update(Document& document, const std::vector<size_t>& bufferViewOrder);
+
+            void Flush(const std::string& manifest, const std::string& uri);
+
+            // Writes the GLB to the file at 'path', where 'sourcePath' is the file that the GLBResourceReader's stream
+            // reads from its start. On Linux unchanged ranges are copied by the kernel (with copy_file_range, or sendfile
+            // where that isn't supported) so only the replaced buffer views pass through this process; elsewhere, or if
+            // neither is supported, they are copied through a buffer as Flush does.
+            void FlushToFile(const std::string& manifest, const std::string& sourcePath, const std::string& path);
+
+        private:
+            struct Segment
+            {
+                size_t padding;                      // Number of zero bytes written before the segment's data
+                size_t byteLength;
+                size_t sourceOffset;                 // Offset into the source GLB's binary chunk, only used when data is null
+                const std::vector<uint8_t>* data;
+            };
+
+            void UpdateLayout(Document& document, const std::vector<size_t>* bufferViewOrder);
+            void AddSegment(size_t padding, size_t byteLength, size_t sourceOffset, const std::vector<uint8_t>* data);
+
+            // Writes the GLB header and JSON chunk to 'stream', then copies the BIN chunk from the source GLB stream
+            void WriteGLB(std::ostream& stream, const std::string& manifest) const;
+
+            // Writes the BIN chunk's contents and padding - 'fnWrite' is called for data held in memory and 'fnCopy'
+            // for ranges of the source GLB, given their offset from the start of the source stream
+            void WriteBinaryChunk(const std::function<void(const char*, size_t)>& fnWrite, const std::function<void(std::streamoff, size_t)>& fnCopy) const;
+
+            std::shared_ptr<const GLBResourceReader> m_glbReader;
+            std::unique_ptr<IStreamWriterCache> m_streamWriterCache;
+
+            std::unordered_map<std::string, std::vector<uint8_t>> m_bufferViewData;
+            std::unordered_set<std::string> m_removedBufferViews;
+
+            std::shared_ptr<std::istream> m_sourceStream;
+            std::streampos m_sourceStreamPos;
+
+            std::vector<Segment> m_segments;
+            size_t m_binaryChunkLength;
+            bool m_isUpdated;
+        };
+
+        // Replaces the JSON chunk of an existing GLB without touching the contents of its BIN chunk. If
+        // the new manifest fits in the existing (padded) JSON chunk it is overwritten in place, otherwise
+        // the BIN chunk is moved towards the end of the stream to make room. Returns true if the GLB was
+        // patched in place, i.e. its length is unchanged. A generic stream's BIN chunk can only be moved
+        // by copying it through a buffer in this process; use the overload below for files.
+        bool RewriteGLBManifest(std::iostream& glbStream, const std::string& manifest);
+
+        // As above, for the GLB in the file at 'path'. On Linux a BIN chunk that has to move is moved by
+        // the kernel: a range is inserted in front of it with fallocate where the file system supports
+        // that, which moves no data, or else it is copied with copy_file_range. It moves by a whole number
+        // of blocks, with the JSON chunk padded to fill the gap. Elsewhere this uses a file stream.
+        bool RewriteGLBManifest(const std::string& path, const std::string& manifest);
+    }
+}
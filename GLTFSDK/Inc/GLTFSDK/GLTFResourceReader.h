@@ -8,8 +8,10 @@
 #include <GLTFSDK/ResourceReaderUtils.h>
 #include <GLTFSDK/StreamCacheLRU.h>
 #include <GLTFSDK/StreamUtils.h>
+#include <GLTFSDK/Tracing.h>
 #include <GLTFSDK/Validation.h>
 
+#include <algorithm>
 #include <cassert>
 
 namespace Microsoft
@@ -36,6 +38,8 @@ namespace Microsoft
             // TODO: return mimeType of image
             std::vector<uint8_t> ReadBinaryData(const Document& document, const Image& image) const
             {
+                GLTFSDK_TRACE_SPAN("GLTFResourceReader::ReadImage");
+
                 std::vector<uint8_t> data;
 
                 std::string::const_iterator itBegin;
@@ -57,6 +61,7 @@ namespace Microsoft
                 else if (auto stream = m_streamReaderCache->Get(image.uri))
                 {
                     data = StreamUtils::ReadBinaryFull<uint8_t>(*stream);
+                    GLTFSDK_TRACE_COUNT("BytesRead", data.size());
                 }
                 else
                 {
@@ -69,50 +74,55 @@ namespace Microsoft
             template<typename T>
             std::vector<T> ReadBinaryData(const Document& gltfDocument, const Accessor& accessor) const
             {
-                bool isValid;
+                GLTFSDK_TRACE_SPAN("GLTFResourceReader::ReadAccessor");
 
-                switch (accessor.componentType)
-                {
-                case COMPONENT_BYTE:
-                    isValid = std::is_same<T, int8_t>::value;
-                    break;
-                case COMPONENT_UNSIGNED_BYTE:
-                    isValid = std::is_same<T, uint8_t>::value;
-                    break;
-                case COMPONENT_SHORT:
-                    isValid = std::is_same<T, int16_t>::value;
-                    break;
-                case COMPONENT_UNSIGNED_SHORT:
-                    isValid = std::is_same<T, uint16_t>::value;
-                    break;
-                case COMPONENT_UNSIGNED_INT:
-                    isValid = std::is_same<T, uint32_t>::value;
-                    break;
-                case COMPONENT_FLOAT:
-                    isValid = std::is_same<T, float>::value;
-                    break;
-                default:
-                    throw GLTFException("Unsupported accessor ComponentType");
-                }
+                ValidateComponentType<T>(accessor);
 
-                if (!isValid)
+                Validation::ValidateAccessor(gltfDocument, accessor);
+
+                if (accessor.sparse.count > 0U)
                 {
-                    throw GLTFException("ReadAccessorData: Template type T does not match accessor ComponentType");
+                    return ReadSparseAccessor<T>(gltfDocument, accessor);
                 }
 
+                return ReadAccessor<T>(gltfDocument, accessor);
+            }
+
+            // Reads the accessor's data into caller owned memory rather than a new vector. The destination must have space
+            // for accessor.count * Accessor::GetTypeCount(accessor.type) values, which is the number of values returned.
+            template<typename T>
+            size_t ReadBinaryData(const Document& gltfDocument, const Accessor& accessor, T* data, size_t dataCount) const
+            {
+                GLTFSDK_TRACE_SPAN("GLTFResourceReader::ReadAccessor");
+
+                ValidateComponentType<T>(accessor);
+
                 Validation::ValidateAccessor(gltfDocument, accessor);
 
+                const size_t componentCount = accessor.count * Accessor::GetTypeCount(accessor.type);
+
+                if (dataCount < componentCount)
+                {
+                    throw GLTFException("ReadAccessorData: Output buffer has space for " + std::to_string(dataCount) + " values but accessor " + accessor.id + " requires " + std::to_string(componentCount));
+                }
+
                 if (accessor.sparse.count > 0U)
                 {
-                    return ReadSparseAccessor<T>(gltfDocument, accessor);
+                    ReadSparseAccessor<T>(gltfDocument, accessor, data);
+                }
+                else
+                {
+                    ReadAccessor<T>(gltfDocument, accessor, data);
                 }
 
-                return ReadAccessor<T>(gltfDocument, accessor);
+                return componentCount;
             }
 
             template<typename T>
             std::vector<T> ReadBinaryData(const Document& document, const BufferView& bufferView) const
             {
+                GLTFSDK_TRACE_SPAN("GLTFResourceReader::ReadBufferView");
+
                 const Buffer& buffer = document.buffers.Get(bufferView.bufferId);
 
                 Validation::ValidateBufferView(bufferView, buffer);
@@ -125,15 +135,24 @@ namespace Microsoft
 
             std::vector<float> ReadFloatData(const Document& gltfDocument, const Accessor& accessor) const;
 
+            // As above but decodes into caller owned memory, see ReadBinaryData(const Document&, const Accessor&, T*, size_t)
+            size_t ReadFloatData(const Document& gltfDocument, const Accessor& accessor, float* data, size_t dataCount) const;
+
         protected:
             template<typename T>
             std::vector<T> ReadAccessor(const Document& gltfDocument, const Accessor& accessor) const
+            {
+                std::vector<T> data(accessor.count * Accessor::GetTypeCount(accessor.type));
+                ReadAccessor<T>(gltfDocument, accessor, data.data());
+                return data;
+            }
+
+            template<typename T>
+            void ReadAccessor(const Document& gltfDocument, const Accessor& accessor, T* data) const
             {
                 const auto typeCount = Accessor::GetTypeCount(accessor.type);
                 const auto elementSize = sizeof(T) * typeCount;
 
-                std::vector<T> data;
-
                 const BufferView& bufferView = gltfDocument.bufferViews.Get(accessor.bufferViewId);
                 const Buffer& buffer = gltfDocument.buffers.Get(bufferView.bufferId);
 
@@ -141,61 +160,48 @@ namespace Microsoft
 
                 if (!bufferView.byteStride || bufferView.byteStride.Get() == elementSize)
                 {
-                    data = ReadBinaryData<T>(buffer, offset, accessor.count * typeCount);
+                    ReadBinaryData<T>(buffer, offset, accessor.count * typeCount, data);
                 }
                 else
                 {
-                    data = ReadBinaryDataInterleaved<T>(buffer, offset, accessor.count, typeCount, bufferView.byteStride.Get());
+                    ReadBinaryDataInterleaved<T>(buffer, offset, accessor.count, typeCount, bufferView.byteStride.Get(), data);
                 }
-
-                return data;
             }
 
             template<typename T>
             std::vector<T> ReadSparseAccessor(const Document& gltfDocument, const Accessor& accessor) const
             {
-                const auto typeCount = Accessor::GetTypeCount(accessor.type);
-                const auto elementSize = sizeof(T) * typeCount;
-
-                std::vector<T> baseData;
+                std::vector<T> data(accessor.count * Accessor::GetTypeCount(accessor.type));
+                ReadSparseAccessor<T>(gltfDocument, accessor, data.data());
+                return data;
+            }
 
+            template<typename T>
+            void ReadSparseAccessor(const Document& gltfDocument, const Accessor& accessor, T* data) const
+            {
                 if (accessor.bufferViewId.empty())
                 {
-                    baseData.resize(typeCount * accessor.count, T());
+                    std::fill_n(data, accessor.count * Accessor::GetTypeCount(accessor.type), T());
                 }
                 else
                 {
-                    const BufferView& bufferView = gltfDocument.bufferViews.Get(accessor.bufferViewId);
-                    const Buffer& buffer = gltfDocument.buffers.Get(bufferView.bufferId);
-
-                    const size_t offset = accessor.byteOffset + bufferView.byteOffset;
-
-                    if (!bufferView.byteStride || bufferView.byteStride.Get() == elementSize)
-                    {
-                        baseData = ReadBinaryData<T>(buffer, offset, accessor.count * typeCount);
-                    }
-                    else
-                    {
-                        baseData = ReadBinaryDataInterleaved<T>(buffer, offset, accessor.count, typeCount, bufferView.byteStride.Get());
-                    }
+                    ReadAccessor<T>(gltfDocument, accessor, data);
                 }
 
                 switch (accessor.sparse.indicesComponentType)
                 {
                 case COMPONENT_UNSIGNED_BYTE:
-                    ReadSparseBinaryData<T, uint8_t>(gltfDocument, baseData, accessor);
+                    ReadSparseBinaryData<T, uint8_t>(gltfDocument, data, accessor);
                     break;
                 case COMPONENT_UNSIGNED_SHORT:
-                    ReadSparseBinaryData<T, uint16_t>(gltfDocument, baseData, accessor);
+                    ReadSparseBinaryData<T, uint16_t>(gltfDocument, data, accessor);
                     break;
                 case COMPONENT_UNSIGNED_INT:
-                    ReadSparseBinaryData<T, uint32_t>(gltfDocument, baseData, accessor);
+                    ReadSparseBinaryData<T, uint32_t>(gltfDocument, data, accessor);
                     break;
                 default:
                     throw GLTFException("Unsupported sparse indices ComponentType");
                 }
-
-                return baseData;
             }
 
             virtual std::shared_ptr<std::istream> GetBinaryStream(const Buffer& buffer) const
@@ -214,6 +220,41 @@ namespace Microsoft
             }
 
         private:
+            template<typename T>
+            static void ValidateComponentType(const Accessor& accessor)
+            {
+                bool isValid;
+
+                switch (accessor.componentType)
+                {
+                case COMPONENT_BYTE:
+                    isValid = std::is_same<T, int8_t>::value;
+                    break;
+                case COMPONENT_UNSIGNED_BYTE:
+                    isValid = std::is_same<T, uint8_t>::value;
+                    break;
+                case COMPONENT_SHORT:
+                    isValid = std::is_same<T, int16_t>::value;
+                    break;
+                case COMPONENT_UNSIGNED_SHORT:
+                    isValid = std::is_same<T, uint16_t>::value;
+                    break;
+                case COMPONENT_UNSIGNED_INT:
+                    isValid = std::is_same<T, uint32_t>::value;
+                    break;
+                case COMPONENT_FLOAT:
+                    isValid = std::is_same<T, float>::value;
+                    break;
+                default:
+                    throw GLTFException("Unsupported accessor ComponentType");
+                }
+
+                if (!isValid)
+                {
+                    throw GLTFException("ReadAccessorData: Template type T does not match accessor ComponentType");
+                }
+            }
+
             void ReadBinaryDataUri(Base64StringView encodedData, Base64BufferView decodedData, const std::streamoff* offsetOverride = nullptr) const
             {
                 // The number of unwanted extra bytes that must be decoded for the specified byte offset
@@ -287,39 +328,49 @@ namespace Microsoft
             template<typename T>
             std::vector<T> ReadBinaryData(const Buffer& buffer, std::streamoff offset, size_t componentCount) const
             {
-                std::vector<T> data;
+                std::vector<T> data(componentCount);
+                ReadBinaryData<T>(buffer, offset, componentCount, data.data());
+                return data;
+            }
 
+            template<typename T>
+            void ReadBinaryData(const Buffer& buffer, std::streamoff offset, size_t componentCount, T* data) const
+            {
                 std::string::const_iterator itBegin;
                 std::string::const_iterator itEnd;
 
                 if (IsUriBase64(buffer.uri, itBegin, itEnd))
                 {
-                    data = ReadBinaryDataUri<T>({ itBegin, itEnd }, &offset, &componentCount);
+                    ReadBinaryDataUri({ itBegin, itEnd }, Base64BufferView(data, componentCount * sizeof(T)), &offset);
                 }
                 else
                 {
-                    data.resize(componentCount);
-
                     auto bufferStream = GetBinaryStream(buffer);
                     auto bufferStreamPos = GetBinaryStreamPos(buffer);
 
                     bufferStream->seekg(bufferStreamPos);
                     bufferStream->seekg(offset, std::ios_base::cur);
 
-                    StreamUtils::ReadBinary(*bufferStream, reinterpret_cast<char*>(data.data()), componentCount * sizeof(T));
+                    StreamUtils::ReadBinary(*bufferStream, reinterpret_cast<char*>(data), componentCount * sizeof(T));
                 }
 
-                return data;
+                GLTFSDK_TRACE_COUNT("BytesRead", componentCount * sizeof(T));
             }
 
             template<typename T>
             std::vector<T> ReadBinaryDataInterleaved(const Buffer& buffer, std::streamoff offset, size_t elementCount, uint8_t typeCount, size_t stride) const
+            {
+                std::vector<T> data(elementCount * typeCount);
+                ReadBinaryDataInterleaved<T>(buffer, offset, elementCount, typeCount, stride, data.data());
+                return data;
+            }
+
+            template<typename T>
+            void ReadBinaryDataInterleaved(const Buffer& buffer, std::streamoff offset, size_t elementCount, uint8_t typeCount, size_t stride, T* data) const
             {
                 const size_t elementSize = sizeof(T) * typeCount;
                 const size_t componentCount = elementCount * typeCount;
 
-                std::vector<T> data(componentCount);
-
                 std::string::const_iterator itBegin;
                 std::string::const_iterator itEnd;
 
@@ -329,7 +380,7 @@ namespace Microsoft
 
                     for (size_t componentsRead = 0U; componentsRead < componentCount; componentsRead += typeCount, offset += stride)
                     {
-                        ReadBinaryDataUri(encodedData, Base64BufferView(data.data() + componentsRead, elementSize), &offset);
+                        ReadBinaryDataUri(encodedData, Base64BufferView(data + componentsRead, elementSize), &offset);
                     }
                 }
                 else
@@ -342,15 +393,15 @@ namespace Microsoft
                         bufferStream->seekg(bufferStreamPos);
                         bufferStreamPos += stride;
 
-                        StreamUtils::ReadBinary(*bufferStream, reinterpret_cast<char*>(data.data() + componentsRead), elementSize);
+                        StreamUtils::ReadBinary(*bufferStream, reinterpret_cast<char*>(data + componentsRead), elementSize);
                     }
                 }
 
-                return data;
+                GLTFSDK_TRACE_COUNT("BytesRead", componentCount * sizeof(T));
             }
 
             template<typename T, typename I>
-            void ReadSparseBinaryData(const Document& gltfDocument, std::vector<T>& baseData, const Accessor& accessor) const
+            void ReadSparseBinaryData(const Document& gltfDocument, T* baseData, const Accessor& accessor) const
             {
                 const auto typeCount = Accessor::GetTypeCount(accessor.type);
                 const auto elementSize = sizeof(T) * typeCount;
@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/GLTF.h>
+
+#include <cstdint>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class Document;
+        class GLTFResourceReader;
+
+        enum class ImageFormat
+        {
+            Unknown,
+            PNG,
+            JPEG,
+            KTX2,
+            WebP
+        };
+
+        struct ImageInfo
+        {
+            ImageInfo() :
+                format(ImageFormat::Unknown),
+                width(0U),
+                height(0U),
+                bitDepth(0U),
+                channelCount(0U)
+            {
+            }
+
+            bool IsPowerOfTwo() const
+            {
+                return width != 0U && height != 0U && (width & (width - 1U)) == 0U && (height & (height - 1U)) == 0U;
+            }
+
+            ImageFormat format;
+            uint32_t width;
+            uint32_t height;
+            uint32_t bitDepth;     // Bits per channel
+            uint32_t channelCount; // Zero if the header doesn't describe the channels (e.g. KTX2 with an unrecognized data format descriptor)
+        };
+
+        namespace ImageUtils
+        {
+            // Parses just the header of a PNG, JPEG, KTX2 or WebP image - no pixel data is decoded. Returns an
+            // ImageInfo with an unknown format if the signature isn't recognized and throws if a recognized
+            // header is truncated or malformed.
+            ImageInfo ParseImageInfo(const uint8_t* data, size_t size);
+            ImageInfo ParseImageInfo(const std::vector<uint8_t>& data);
+
+            // Reads the image's header from its buffer view, only reading the whole buffer view if the header
+            // isn't contained within the first few KB (e.g. JPEGs with large metadata segments)
+            ImageInfo ReadImageInfo(const Document& doc, const GLTFResourceReader& reader, const Image& image);
+        }
+    }
+}
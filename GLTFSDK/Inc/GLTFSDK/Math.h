@@ -108,6 +108,14 @@ namespace Microsoft
             {
                 return static_cast<uint8_t>(value * 255.0f + 0.5f);
             }
+
+            // Matrices are column-major, as in glTF, so 'lhs * rhs' applies 'rhs' first
+            Matrix4 Multiply(const Matrix4& lhs, const Matrix4& rhs);
+
+            // The matrix that scales, then rotates and then translates, as a node's TRS properties do
+            Matrix4 ToMatrix(const Vector3& translation, const Quaternion& rotation, const Vector3& scale);
+
+            Vector3 TransformPoint(const Matrix4& matrix, const Vector3& point);
         }
     }
 }
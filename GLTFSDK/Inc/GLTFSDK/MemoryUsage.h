@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/IndexedContainer.h>
+
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class Document;
+
+        // Estimates of the heap memory owned by glTF objects, i.e. excluding sizeof(value) itself. The
+        // standard library's allocation strategy isn't observable so container node and bucket overheads
+        // are approximations, but the totals are proportional to what is actually allocated.
+        namespace MemoryUsage
+        {
+            size_t EstimateHeapSize(const std::string& value);
+
+            size_t EstimateHeapSize(const glTFProperty& property);
+            size_t EstimateHeapSize(const glTFChildOfRootProperty& property);
+
+            size_t EstimateHeapSize(const Accessor& accessor);
+            size_t EstimateHeapSize(const Animation& animation);
+            size_t EstimateHeapSize(const AnimationChannel& channel);
+            size_t EstimateHeapSize(const AnimationSampler& sampler);
+            size_t EstimateHeapSize(const Asset& asset);
+            size_t EstimateHeapSize(const Buffer& buffer);
+            size_t EstimateHeapSize(const BufferView& bufferView);
+            size_t EstimateHeapSize(const Camera& camera);
+            size_t EstimateHeapSize(const Image& image);
+            size_t EstimateHeapSize(const Material& material);
+            size_t EstimateHeapSize(const Mesh& mesh);
+            size_t EstimateHeapSize(const MeshPrimitive& meshPrimitive);
+            size_t EstimateHeapSize(const MorphTarget& morphTarget);
+            size_t EstimateHeapSize(const Node& node);
+            size_t EstimateHeapSize(const Sampler& sampler);
+            size_t EstimateHeapSize(const Scene& scene);
+            size_t EstimateHeapSize(const Skin& skin);
+            size_t EstimateHeapSize(const Texture& texture);
+            size_t EstimateHeapSize(const TextureInfo& textureInfo);
+
+            size_t EstimateHeapSize(const Document& document);
+
+            // Scalars and other types that don't own any memory
+            template<typename T>
+            std::enable_if_t<std::is_arithmetic<T>::value || std::is_enum<T>::value, size_t> EstimateHeapSize(const T&)
+            {
+                return 0U;
+            }
+
+            template<typename T>
+            size_t EstimateHeapSize(const std::vector<T>& values);
+
+            template<typename TKey, typename TValue, typename THash>
+            size_t EstimateHeapSize(const std::unordered_map<TKey, TValue, THash>& values);
+
+            template<typename TKey>
+            size_t EstimateHeapSize(const std::unordered_set<TKey>& values);
+
+            template<typename T>
+            size_t EstimateHeapSize(const IndexedContainer<T>& container);
+
+            // Per-node overhead of the unordered containers: the 'next' pointer and cached hash code
+            constexpr size_t HashNodeOverhead = sizeof(void*) + sizeof(size_t);
+
+            template<typename T>
+            size_t EstimateHeapSize(const std::vector<T>& values)
+            {
+                size_t size = values.capacity() * sizeof(T);
+
+                for (const auto& value : values)
+                {
+                    size += EstimateHeapSize(value);
+                }
+
+                return size;
+            }
+
+            template<typename TKey, typename TValue, typename THash>
+            size_t EstimateHeapSize(const std::unordered_map<TKey, TValue, THash>& values)
+            {
+                size_t size = values.bucket_count() * sizeof(void*);
+
+                for (const auto& value : values)
+                {
+                    size += sizeof(value) + HashNodeOverhead + EstimateHeapSize(value.first) + EstimateHeapSize(value.second);
+                }
+
+                return size;
+            }
+
+            template<typename TKey>
+            size_t EstimateHeapSize(const std::unordered_set<TKey>& values)
+            {
+                size_t size = values.bucket_count() * sizeof(void*);
+
+                for (const auto& value : values)
+                {
+                    size += sizeof(value) + HashNodeOverhead + EstimateHeapSize(value);
+                }
+
+                return size;
+            }
+
+            template<typename T>
+            size_t EstimateHeapSize(const IndexedContainer<T>& container)
+            {
+                const auto& elements = container.Elements();
+
+                size_t size = EstimateHeapSize(elements);
+
+                // The id -> index map isn't accessible so it is estimated assuming one bucket per
+                // element, with each key a copy of the corresponding element's id
+                for (const auto& element : elements)
+                {
+                    size += sizeof(void*) + sizeof(std::pair<const std::string, size_t>) + HashNodeOverhead + EstimateHeapSize(element.id);
+                }
+
+                return size;
+            }
+        }
+    }
+}
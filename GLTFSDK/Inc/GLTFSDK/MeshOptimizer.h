@@ -0,0 +1,142 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/GLTF.h>
+
+#include <limits>
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class BufferBuilder;
+        class Document;
+        class GLTFResourceReader;
+
+        namespace MeshOptimizer
+        {
+            // A vertex attribute's elements, tightly packed in the accessor's original format
+            struct VertexStream
+            {
+                std::string semantic;
+                AccessorType accessorType = TYPE_UNKNOWN;
+                ComponentType componentType = COMPONENT_UNKNOWN;
+                bool normalized = false;
+                std::vector<uint8_t> data;
+
+                size_t GetElementSize() const;
+            };
+
+            // A triangle list mesh primitive's indices and vertex data, decoupled from the document so that passes can
+            // rewrite it before it's written back with BufferBuilder. Morph targets have a stream per attribute too.
+            struct MeshData
+            {
+                std::vector<uint32_t> indices;
+                size_t vertexCount = 0U;
+                std::vector<VertexStream> attributes;
+                std::vector<std::vector<VertexStream>> targets;
+            };
+
+            // Reads a primitive's triangulated indices (generating them if the primitive is unindexed) and every
+            // attribute and morph target accessor. Throws a GLTFException if the primitive isn't made of triangles.
+            MeshData ReadMeshData(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive);
+
+            // Writes the mesh data as new accessors, each in its own buffer view of the builder's current buffer, and
+            // returns a copy of 'meshPrimitive' that refers to them. Indices are written as unsigned shorts when every
+            // vertex can be addressed by one (see CompactIndices for unsigned bytes) and POSITION accessors are given the
+            // min and max that glTF requires.
+            MeshPrimitive WriteMeshData(const MeshData& meshData, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder);
+
+            // Marks a vertex that RemapVertices removes
+            const uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+            // Reorders every stream's vertices so that the vertex previously at index 'i' moves to 'remap[i]', leaving
+            // 'vertexCount' vertices. Indices are remapped as well. When several vertices move to the same index, the first
+            // of them is kept.
+            void RemapVertices(MeshData& meshData, const std::vector<uint32_t>& remap, size_t vertexCount);
+
+            // Post-transform vertex cache efficiency, as measured by simulating a FIFO cache of the given size
+            struct VertexCacheStatistics
+            {
+                size_t transformedVertexCount = 0U;
+                float acmr = 0.0f; // Average cache miss ratio: vertices transformed per triangle, 3 at worst
+                float atvr = 0.0f; // Average transformed vertex ratio: vertices transformed per vertex, ideally 1
+            };
+
+            const size_t DefaultCacheSize = 16U;
+
+            VertexCacheStatistics AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize = DefaultCacheSize);
+
+            // Reorders triangles to reduce post-transform vertex cache misses, using Tom Forsyth's linear-speed
+            // algorithm. This performs well with any cache size and replacement policy.
+            std::vector<uint32_t> OptimizeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount);
+
+            // Returns a remapping (see RemapVertices) that orders vertices by their first use in 'indices' so that they're
+            // fetched sequentially. Unreferenced vertices are removed; 'vertexCount' is updated to the number remaining.
+            std::vector<uint32_t> OptimizeVertexFetch(const std::vector<uint32_t>& indices, size_t& vertexCount);
+
+            struct VertexOrderStatistics
+            {
+                VertexCacheStatistics before;
+                VertexCacheStatistics after;
+            };
+
+            // Optimizes a primitive's triangle order for the vertex cache and then its vertex order for fetching
+            void OptimizeVertexOrder(MeshData& meshData, VertexOrderStatistics* statistics = nullptr);
+
+            MeshData OptimizeVertexOrder(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, VertexOrderStatistics* statistics = nullptr);
+
+            // Rewrite step: writes the optimized primitive with 'bufferBuilder' and returns the primitive that replaces it
+            MeshPrimitive OptimizeVertexOrder(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder, VertexOrderStatistics* statistics = nullptr);
+
+            struct WeldOptions
+            {
+                // Float POSITION and NORMAL components are snapped to multiples of these values before vertices are
+                // compared, so that nearly coincident vertices are merged too. Zero requires them to be bit-identical.
+                float positionEpsilon = 0.0f;
+                float normalEpsilon = 0.0f;
+
+                // Meshes with fewer vertices are welded on the calling thread
+                size_t minParallelVertexCount = 65536U;
+                size_t threadCount = 0U; // Zero uses every hardware thread
+            };
+
+            // Returns a remapping (see RemapVertices) that merges each set of vertices whose data is identical in every
+            // attribute and morph target into the first of them, keeping the order of the vertices that remain.
+            // 'vertexCount' is updated to the number of unique vertices.
+            std::vector<uint32_t> GenerateWeldRemap(const MeshData& meshData, size_t& vertexCount, const WeldOptions& options = {});
+
+            void WeldVertices(MeshData& meshData, const WeldOptions& options = {});
+
+            MeshData WeldVertices(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, const WeldOptions& options = {});
+
+            // Rewrite step: writes the welded primitive with 'bufferBuilder' and returns the primitive that replaces it
+            MeshPrimitive WeldVertices(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder, const WeldOptions& options = {});
+
+            // The narrowest index component type that can address 'vertexCount' vertices while leaving its largest value
+            // free for primitive restart. Unsigned byte indices are valid glTF but not every graphics API supports them.
+            ComponentType GetIndexComponentType(size_t vertexCount, bool allowUnsignedByte = true);
+
+            struct CompactOptions
+            {
+                // A primitive is rebased onto copies of just the vertices it references when they're at most this
+                // fraction of its attribute accessors' vertices, e.g. when it's one of many sharing the same accessors
+                float maxReferencedVertexRatio = 0.5f;
+
+                bool allowUnsignedByteIndices = true;
+            };
+
+            // Rewrite step for an indexed primitive of any mode: rebases it (see CompactOptions) and writes its indices
+            // with the narrowest component type that can address its vertices. Primitive restart values are preserved.
+            // Returns 'meshPrimitive' unchanged if neither would make it smaller.
+            MeshPrimitive CompactIndices(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder, const CompactOptions& options = {});
+
+            // Compacts every mesh primitive in the document, replacing its meshes. Accessors that are no longer referenced
+            // are left in place; the new accessors are added when 'bufferBuilder' is output to the document.
+            void CompactIndices(Document& doc, const GLTFResourceReader& reader, BufferBuilder& bufferBuilder, const CompactOptions& options = {});
+        }
+    }
+}
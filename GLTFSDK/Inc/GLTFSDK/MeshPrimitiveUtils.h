@@ -57,6 +57,57 @@ namespace Microsoft
             std::vector<uint32_t> GetJointWeights32(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor);
             std::vector<uint32_t> GetJointWeights32_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive);
 
+            // Output buffer variants of the getters above, for callers that manage their own (e.g. pooled or mapped) memory.
+            // Each writes the same values the equivalent getter returns to 'output', returning the number of values written
+            // and throwing a GLTFException if that is more than 'outputCount'. Conversions are done in place so nothing is
+            // allocated, except when packing float or 16-bit colors and weights or applying a sparse accessor's values.
+            size_t GetIndices16(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, uint16_t* output, size_t outputCount);
+            size_t GetIndices16(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint16_t* output, size_t outputCount);
+
+            size_t GetIndices32(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, uint32_t* output, size_t outputCount);
+            size_t GetIndices32(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint32_t* output, size_t outputCount);
+
+            // The output space required by GetTriangulatedIndices16/32 and GetSegmentedIndices16/32 respectively. Strips, fans
+            // and loops are split wherever their indices contain the largest value of the accessor's component type (i.e. a
+            // primitive restart value) in which case fewer indices are written, otherwise this is the number written.
+            size_t GetTriangulatedIndexCount(const Document& doc, const MeshPrimitive& meshPrimitive);
+            size_t GetSegmentedIndexCount(const Document& doc, const MeshPrimitive& meshPrimitive);
+
+            size_t GetTriangulatedIndices16(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint16_t* output, size_t outputCount);
+            size_t GetTriangulatedIndices32(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint32_t* output, size_t outputCount);
+
+            size_t GetSegmentedIndices16(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint16_t* output, size_t outputCount);
+            size_t GetSegmentedIndices32(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint32_t* output, size_t outputCount);
+
+            size_t GetPositions(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, float* output, size_t outputCount);
+            size_t GetPositions(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, float* output, size_t outputCount);
+            size_t GetPositions(const Document& doc, const GLTFResourceReader& reader, const MorphTarget& morphTarget, float* output, size_t outputCount);
+
+            size_t GetNormals(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, float* output, size_t outputCount);
+            size_t GetNormals(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, float* output, size_t outputCount);
+            size_t GetNormals(const Document& doc, const GLTFResourceReader& reader, const MorphTarget& morphTarget, float* output, size_t outputCount);
+
+            size_t GetTangents(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, float* output, size_t outputCount);
+            size_t GetTangents(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, float* output, size_t outputCount);
+            size_t GetTangents(const Document& doc, const GLTFResourceReader& reader, const MorphTarget& morphTarget, float* output, size_t outputCount);
+            size_t GetMorphTangents(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, float* output, size_t outputCount);
+
+            size_t GetTexCoords(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, float* output, size_t outputCount);
+            size_t GetTexCoords_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, float* output, size_t outputCount);
+            size_t GetTexCoords_1(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, float* output, size_t outputCount);
+
+            size_t GetColors(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, uint32_t* output, size_t outputCount);
+            size_t GetColors_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint32_t* output, size_t outputCount);
+
+            size_t GetJointIndices32(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, uint32_t* output, size_t outputCount);
+            size_t GetJointIndices32_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint32_t* output, size_t outputCount);
+
+            size_t GetJointIndices64(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, uint64_t* output, size_t outputCount);
+            size_t GetJointIndices64_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint64_t* output, size_t outputCount);
+
+            size_t GetJointWeights32(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, uint32_t* output, size_t outputCount);
+            size_t GetJointWeights32_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint32_t* output, size_t outputCount);
+
             std::vector<uint16_t> ReverseTriangulateIndices16(const uint16_t* indices, size_t indexCount, MeshMode mode);
             std::vector<uint32_t> ReverseTriangulateIndices32(const uint32_t* indices, size_t indexCount, MeshMode mode);
 
@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/MeshOptimizer.h>
+
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace MeshSimplifier
+        {
+            struct SimplifyOptions
+            {
+                // The fraction of the primitive's triangles to keep
+                float targetRatio = 0.5f;
+
+                // Edges aren't collapsed if doing so would introduce an error greater than this, relative to the extent of
+                // the primitive's positions. The target ratio isn't reached if there aren't enough edges within the limit.
+                float maxError = 0.01f;
+
+                // Scales the contribution of the difference between collapsed vertices' other attributes (and morph target
+                // displacements) to a collapse's error, so that detail in e.g. normals or texture coordinates is preserved.
+                // Differences in attributes other than displacements are weighted by the squared length of the collapsed
+                // edge, relative to the extent of the positions, with unit normals and tangents counting half.
+                float attributeWeight = 1.0f;
+
+                // Threads used to find the vertices that share a position (see MeshOptimizer::WeldOptions)
+                size_t threadCount = 0U; // Zero uses every hardware thread
+            };
+
+            // Simplifies a triangle list by collapsing edges in order of their quadric error (Garland and Heckbert). Each
+            // collapse moves a vertex onto one of its neighbours, so no vertices are created or modified: only 'indices'
+            // change and the vertices that are no longer referenced can be removed with OptimizeVertexFetch.
+            //
+            // POSITION must be a float VEC3 stream. Vertices on attribute seams (those whose position is shared by other
+            // vertices) are never moved and those on open borders only move along the border, so the mesh's outline
+            // and UV layout are preserved. Returns the largest relative error of any collapse that was made.
+            float Simplify(MeshOptimizer::MeshData& meshData, const SimplifyOptions& options = {});
+
+            struct LodOptions
+            {
+                // The fraction of each mesh's triangles to keep at each level of detail below the original
+                std::vector<float> levelRatios = { 0.5f, 0.25f, 0.125f };
+
+                float maxError = 0.05f;
+                float attributeWeight = 1.0f;
+
+                size_t threadCount = 0U; // Zero uses every hardware thread
+            };
+
+            // Generates a chain of simplified meshes for every node that has a mesh. Each level is written with
+            // 'bufferBuilder' as a new mesh, used by a new node that isn't part of any scene, and the original node lists
+            // these nodes with the MSFT_lod extension (see MSFT::Nodes::Lod). Levels that wouldn't have fewer triangles
+            // than the previous one are omitted. Meshes are simplified in parallel, with each level of each mesh on a
+            // single thread.
+            //
+            // The new accessors are added to the document when 'bufferBuilder' is output to it, which the caller does
+            // once this returns. MSFT_lod is added to the document's extensionsUsed.
+            void GenerateLods(Document& doc, const GLTFResourceReader& reader, BufferBuilder& bufferBuilder, const LodOptions& options = {});
+        }
+    }
+}
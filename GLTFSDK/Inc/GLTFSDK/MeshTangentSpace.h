@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/GLTF.h>
+
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class BufferBuilder;
+        class Document;
+        class GLTFResourceReader;
+
+        namespace MeshTangentSpace
+        {
+            // How much each triangle around a vertex contributes to its normal
+            enum class NormalWeighting
+            {
+                Area,        // In proportion to the triangle's area
+                Angle,       // In proportion to the triangle's angle at the vertex, so the result doesn't depend on tessellation
+                AreaAndAngle
+            };
+
+            struct TangentSpaceOptions
+            {
+                NormalWeighting normalWeighting = NormalWeighting::Angle;
+
+                // Vertices with identical positions (e.g. on either side of a UV seam) are given the same normal, so that
+                // seams aren't shaded as hard edges
+                bool smoothSeams = true;
+
+                // Normals and tangents are generated even for primitives that already have them
+                bool replaceExisting = false;
+
+                // Primitives with fewer triangles are processed on a single thread
+                size_t minParallelTriangleCount = 65536U;
+                size_t threadCount = 0U; // Zero uses every hardware thread
+            };
+
+            // Generates smooth, unit length normals (three floats per vertex) for a triangle list. Vertices that aren't
+            // part of any triangle with a non-zero area are given the normal (0, 0, 1).
+            std::vector<float> GenerateNormals(const std::vector<uint32_t>& indices, const std::vector<float>& positions, const TangentSpaceOptions& options = {});
+
+            // Generates unit length tangents, with the bitangent's sign in w as glTF's TANGENT attribute requires, for a
+            // triangle list with unit length 'normals' and 'texcoords' (two floats per vertex, with glTF's top-left
+            // origin). This follows MikkTSpace: each triangle's tangent is projected onto the plane of each of its
+            // vertices' normals and weighted by its angle at the vertex in that plane. Unlike MikkTSpace, vertices aren't
+            // split where triangles with mirrored texture coordinates meet; they take the handedness of the majority.
+            // Vertices without a usable tangent are given one perpendicular to their normal.
+            std::vector<float> GenerateTangents(const std::vector<uint32_t>& indices, const std::vector<float>& positions, const std::vector<float>& normals, const std::vector<float>& texcoords, const TangentSpaceOptions& options = {});
+
+            // Rewrite step for a primitive made of triangles: generates NORMAL if it has none, and TANGENT if it has none
+            // and its material has a normal texture (using that texture's coordinates). Each is written as a new float
+            // accessor, in its own buffer view of the builder's current buffer, and a copy of 'meshPrimitive' that refers
+            // to them is returned. Returns 'meshPrimitive' unchanged if it needs neither.
+            //
+            // glTF renders primitives without normals flat shaded, which generated normals replace with smooth shading.
+            // As glTF ignores the tangents of primitives without normals, those tangents are removed or regenerated.
+            MeshPrimitive GenerateTangentSpace(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder, const TangentSpaceOptions& options = {});
+
+            // Generates the tangent space of every mesh primitive in the document that needs it, replacing its meshes.
+            // Accessors are read on the calling thread and small primitives are processed in parallel with each other;
+            // the new accessors are added when 'bufferBuilder' is output to the document.
+            void GenerateTangentSpace(Document& doc, const GLTFResourceReader& reader, BufferBuilder& bufferBuilder, const TangentSpaceOptions& options = {});
+        }
+    }
+}
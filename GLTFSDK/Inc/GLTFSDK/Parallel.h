@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        namespace Parallel
+        {
+            // Resolves a requested thread count, where zero means one thread per hardware thread
+            inline size_t GetThreadCount(size_t threadCount = 0U)
+            {
+                return threadCount == 0U ? std::max(1U, std::thread::hardware_concurrency()) : threadCount;
+            }
+
+            // Calls fn(i) for every i in [0, count) using at most 'threadCount' threads (including the calling thread).
+            // Once every call has returned, the exception thrown by the call with the lowest index (if any) is rethrown on
+            // the calling thread so that failures are reported deterministically.
+            template<typename Fn>
+            void For(size_t count, size_t threadCount, Fn fn)
+            {
+                std::vector<std::exception_ptr> errors(count);
+                std::atomic<size_t> next(0U);
+
+                auto worker = [&]()
+                {
+                    for (size_t i = next++; i < count; i = next++)
+                    {
+                        try
+                        {
+                            fn(i);
+                        }
+                        catch (...)
+                        {
+                            errors[i] = std::current_exception();
+                        }
+                    }
+                };
+
+                threadCount = std::min(GetThreadCount(threadCount), count);
+
+                if (threadCount > 1U)
+                {
+                    std::vector<std::thread> threads;
+                    threads.reserve(threadCount - 1U);
+
+                    for (size_t i = 1U; i < threadCount; i++)
+                    {
+                        try
+                        {
+                            threads.emplace_back(worker);
+                        }
+                        catch (const std::system_error&)
+                        {
+                            break; // Continue with the threads that could be started
+                        }
+                    }
+
+                    worker();
+
+                    for (auto& thread : threads)
+                    {
+                        thread.join();
+                    }
+                }
+                else
+                {
+                    worker();
+                }
+
+                for (auto& error : errors)
+                {
+                    if (error)
+                    {
+                        std::rethrow_exception(error);
+                    }
+                }
+            }
+        }
+    }
+}
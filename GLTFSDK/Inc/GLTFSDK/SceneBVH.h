@@ -0,0 +1,151 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/Math.h>
+#include <GLTFSDK/SceneBounds.h>
+
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class Document;
+        class GLTFResourceReader;
+
+        struct BVHOptions
+        {
+            // Only the nodes in this scene's hierarchies are included. When empty, every node with a mesh is included.
+            std::string sceneId;
+
+            size_t maxLeafSize = 4U; // Triangles
+            size_t binCount = 16U;   // Surface area heuristic bins per axis
+
+            size_t threadCount = 0U; // Zero uses every hardware thread
+        };
+
+        // Identifies a triangle by the indices (in the document's containers) of the node, mesh and primitive it came from
+        // and its index in the primitive's triangulated indices, see MeshPrimitiveUtils::GetTriangulatedIndices32
+        struct TriangleRef
+        {
+            size_t nodeIndex;
+            size_t meshIndex;
+            size_t primitiveIndex;
+            size_t triangleIndex;
+
+            bool operator==(const TriangleRef& other) const;
+            bool operator!=(const TriangleRef& other) const;
+        };
+
+        struct Ray
+        {
+            Vector3 origin;
+            Vector3 direction; // Needn't be unit length, distances along the ray are in multiples of it
+            float tMin = 0.0f;
+            float tMax = std::numeric_limits<float>::infinity();
+        };
+
+        struct RayHit
+        {
+            TriangleRef triangle;
+            float t;    // The distance along the ray
+            float u, v; // Barycentric coordinates of the hit, weighting the triangle's second and third vertices
+        };
+
+        struct NearestPoint
+        {
+            TriangleRef triangle;
+            Vector3 point;
+            float distance;
+        };
+
+        // A bounding volume hierarchy over the world space triangles of a document's meshes, for picking and other
+        // spatial queries. It's built with binned surface area heuristic splits: the top of the hierarchy is split on the
+        // calling thread (binning in parallel) and the subtrees below it are built in parallel.
+        //
+        // Primitives are triangulated and placed with their node's world transform; skins and morph targets aren't
+        // applied. Points, lines and primitives without positions are ignored.
+        class SceneBVH
+        {
+        public:
+            // A node of the flattened hierarchy, in depth-first order so that an interior node's first child follows it
+            struct Node
+            {
+                float min[3];
+                float max[3];
+                uint32_t index; // The second child of an interior node, or the first triangle of a leaf
+                uint32_t count; // Zero for an interior node, otherwise the number of triangles in the leaf
+            };
+
+            SceneBVH();
+
+            static SceneBVH Build(const Document& doc, const GLTFResourceReader& reader, const BVHOptions& options = {});
+
+            size_t GetTriangleCount() const;
+            const std::vector<Node>& GetNodes() const;
+
+            SceneBounds::BoundingBox GetBounds() const;
+
+            // Finds the closest triangle that the ray hits (from either side) within [tMin, tMax]
+            bool Intersect(const Ray& ray, RayHit& hit) const;
+
+            // Returns every triangle that overlaps the box
+            std::vector<TriangleRef> Query(const SceneBounds::BoundingBox& box) const;
+
+            // Finds the closest point on any triangle within 'maxDistance' of 'point'
+            bool FindNearest(const Vector3& point, NearestPoint& nearest, float maxDistance = std::numeric_limits<float>::infinity()) const;
+
+            // Moves the triangles to new node world transforms (indexed as the document's nodes, see
+            // SceneBounds::ComputeWorldTransforms) and updates the bounds of the hierarchy without rebuilding it. Queries
+            // become less efficient as the triangles move further from where they were when the hierarchy was built.
+            void Refit(const std::vector<Matrix4>& worldTransforms, size_t threadCount = 0U);
+            void Refit(const Document& doc, size_t threadCount = 0U);
+
+            // Writes the hierarchy, and the local positions needed to refit it, in a binary format with the native byte
+            // order. Deserialize throws a GLTFException if the data is truncated, from another version or inconsistent.
+            void Serialize(std::ostream& stream) const;
+            static SceneBVH Deserialize(std::istream& stream);
+
+        private:
+            // A mesh primitive placed by a node
+            struct Instance
+            {
+                uint32_t nodeIndex;
+                uint32_t meshIndex;
+                uint32_t primitiveIndex;
+                uint32_t dataIndex;
+            };
+
+            // A mesh primitive's local positions and triangulated indices, shared by every node that uses its mesh
+            struct PrimitiveData
+            {
+                std::vector<float> positions;
+                std::vector<uint32_t> indices;
+            };
+
+            struct Triangle
+            {
+                uint32_t instance;
+                uint32_t index;
+            };
+
+            TriangleRef GetTriangleRef(size_t triangle) const;
+            const float* GetVertices(size_t triangle) const;
+
+            void TransformTriangles(const std::vector<Matrix4>& worldTransforms, size_t threadCount);
+            void Validate() const;
+
+            std::vector<Instance> m_instances;
+            std::vector<PrimitiveData> m_primitiveData;
+            std::vector<Triangle> m_triangles;
+            std::vector<float> m_vertices; // Each triangle's world space vertices, in the same order as m_triangles
+            std::vector<Node> m_nodes;
+        };
+    }
+}
@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/GLTF.h>
+#include <GLTFSDK/Math.h>
+
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        class Document;
+        class GLTFResourceReader;
+
+        namespace SceneBounds
+        {
+            // An axis-aligned bounding box, initially empty (its minimum is greater than its maximum)
+            struct BoundingBox
+            {
+                BoundingBox();
+                BoundingBox(const Vector3& min, const Vector3& max);
+
+                bool IsEmpty() const;
+
+                void Merge(const Vector3& point);
+                void Merge(const BoundingBox& other);
+
+                // The box that bounds this box once transformed by 'matrix'
+                BoundingBox Transform(const Matrix4& matrix) const;
+
+                bool operator==(const BoundingBox& other) const;
+                bool operator!=(const BoundingBox& other) const;
+
+                Vector3 min;
+                Vector3 max;
+            };
+
+            // A bounding sphere, initially empty (its radius is negative)
+            struct BoundingSphere
+            {
+                BoundingSphere();
+                BoundingSphere(const Vector3& center, float radius);
+
+                bool IsEmpty() const;
+
+                // The smallest sphere that contains both spheres
+                void Merge(const BoundingSphere& other);
+
+                // The sphere that bounds this sphere once transformed by 'matrix', whose radius is scaled by the matrix's
+                // largest axis scale
+                BoundingSphere Transform(const Matrix4& matrix) const;
+
+                Vector3 center;
+                float radius;
+            };
+
+            struct Bounds
+            {
+                BoundingBox box;
+                BoundingSphere sphere; // Empty unless BoundsOptions::computeSpheres is set
+            };
+
+            struct BoundsOptions
+            {
+                // Spheres are centered on their primitive's box, with the radius of the farthest vertex. This requires every
+                // primitive's positions to be read, even when their accessors have a min and max.
+                bool computeSpheres = false;
+
+                // Positions accessors with a min and max are trusted rather than read and scanned
+                bool useAccessorMinMax = true;
+
+                size_t threadCount = 0U; // Zero uses every hardware thread
+            };
+
+            // The bounds of every mesh, node and scene in a document, indexed in the same order as the document's
+            struct DocumentBounds
+            {
+                // Each node's transform relative to the root of its hierarchy
+                std::vector<Matrix4> worldTransforms;
+
+                // In each mesh's own space, covering every primitive with positions. Morph targets are included
+                // conservatively, assuming each weight is in [0, 1], so the bounds hold for any animation of the weights.
+                std::vector<Bounds> meshes;
+
+                // In world space, covering each node's mesh and those of its descendants. A skinned mesh is bounded by
+                // its bind pose transformed by each of its joints' current transforms, which (as each vertex's joint
+                // weights sum to 1) contains the skinned mesh for any weights.
+                std::vector<Bounds> nodes;
+
+                // In world space, covering each scene's root nodes
+                std::vector<Bounds> scenes;
+            };
+
+            // The matrix for a node's 'matrix' or TRS properties
+            Matrix4 GetLocalTransform(const Node& node);
+
+            // Computes every node's world transform, processing each node hierarchy in parallel. Throws a GLTFException
+            // if a node has more than one parent or is part of a cycle.
+            std::vector<Matrix4> ComputeWorldTransforms(const Document& doc, size_t threadCount = 0U);
+
+            // Computes a mesh's bounds in its own space, reading and scanning (with ConversionKernels::MinMaxFloat3) any
+            // positions accessors without a min and max
+            Bounds ComputeMeshBounds(const Document& doc, const GLTFResourceReader& reader, const Mesh& mesh, const BoundsOptions& options = {});
+
+            // Computes the bounds of every mesh, node and scene. Accessors are read on the calling thread; scanning their
+            // data and computing the bounds of each node hierarchy are done in parallel.
+            DocumentBounds ComputeBounds(const Document& doc, const GLTFResourceReader& reader, const BoundsOptions& options = {});
+        }
+    }
+}
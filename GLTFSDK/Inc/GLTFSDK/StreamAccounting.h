@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <GLTFSDK/IStreamCache.h>
+#include <GLTFSDK/IStreamReader.h>
+#include <GLTFSDK/IStreamWriter.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        struct StreamStats
+        {
+            // Bucket i counts the reads of between 2^i and 2^(i+1)-1 bytes (bucket 0 also counts zero byte reads)
+            static const size_t ReadSizeBucketCount = 32U;
+
+            static size_t GetReadSizeBucket(size_t byteCount);
+
+            StreamStats& operator+=(const StreamStats& other);
+
+            uint64_t opens = 0U;        // Number of streams created by the decorated IStreamReader/IStreamWriter
+            uint64_t cacheLookups = 0U; // Number of IStreamCache::Get calls (compare against 'opens' to find cache misses)
+
+            uint64_t reads = 0U;
+            uint64_t writes = 0U;
+            uint64_t seeks = 0U;
+
+            uint64_t bytesRead = 0U;
+            uint64_t bytesWritten = 0U;
+
+            std::array<uint64_t, ReadSizeBucketCount> readSizeHistogram = {};
+
+            // Total time spent waiting on the decorated streams (including opening them)
+            std::chrono::nanoseconds timeBlocked = std::chrono::nanoseconds::zero();
+        };
+
+        // Collects per-uri StreamStats from the Accounting* stream decorators below. A single instance can be
+        // shared between a reader, a writer and their caches so that all I/O for a load or save is reported together.
+        class StreamAccounting
+        {
+        public:
+            StreamStats GetStats(const std::string& uri) const;
+            std::map<std::string, StreamStats> GetAllStats() const;
+            StreamStats GetTotalStats() const;
+
+            // Zeroes all statistics, streams that are still open continue to be accounted for
+            void Reset();
+
+            // Writes a human readable summary, one line per uri
+            void WriteReport(std::ostream& stream) const;
+
+            // Runs fn(StreamStats&) with exclusive access to the statistics for 'uri'
+            template<typename Fn>
+            void Update(const std::string& uri, Fn fn)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                fn(m_stats[uri]);
+            }
+
+            template<typename Fn>
+            void Update(StreamStats& stats, Fn fn)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                fn(stats);
+            }
+
+            // The returned reference remains valid for the lifetime of the StreamAccounting instance
+            StreamStats& GetStatsEntry(const std::string& uri);
+
+        private:
+            mutable std::mutex m_mutex;
+            std::map<std::string, StreamStats> m_stats;
+        };
+
+        // Decorates an IStreamReader so that every stream it returns records reads, seeks and blocking time
+        class AccountingStreamReader : public IStreamReader
+        {
+        public:
+            AccountingStreamReader(std::shared_ptr<const IStreamReader> streamReader, std::shared_ptr<StreamAccounting> accounting = std::make_shared<StreamAccounting>());
+
+            std::shared_ptr<std::istream> GetInputStream(const std::string& uri) const override;
+
+            const std::shared_ptr<StreamAccounting>& GetAccounting() const;
+
+        private:
+            std::shared_ptr<const IStreamReader> m_streamReader;
+            std::shared_ptr<StreamAccounting> m_accounting;
+        };
+
+        // Decorates an IStreamWriter so that every stream it returns records writes, seeks and blocking time
+        class AccountingStreamWriter : public IStreamWriter
+        {
+        public:
+            AccountingStreamWriter(std::shared_ptr<const IStreamWriter> streamWriter, std::shared_ptr<StreamAccounting> accounting = std::make_shared<StreamAccounting>());
+
+            std::shared_ptr<std::ostream> GetOutputStream(const std::string& uri) const override;
+
+            const std::shared_ptr<StreamAccounting>& GetAccounting() const;
+
+        private:
+            std::shared_ptr<const IStreamWriter> m_streamWriter;
+            std::shared_ptr<StreamAccounting> m_accounting;
+        };
+
+        // Decorates an IStreamCache to count lookups per uri. Streams are only wrapped for I/O accounting when the
+        // decorated cache creates them via an AccountingStreamReader/AccountingStreamWriter.
+        template<typename TStream>
+        class AccountingStreamCache : public IStreamCache<TStream>
+        {
+        public:
+            AccountingStreamCache(std::unique_ptr<IStreamCache<TStream>> streamCache, std::shared_ptr<StreamAccounting> accounting) :
+                m_streamCache(std::move(streamCache)),
+                m_accounting(std::move(accounting))
+            {
+            }
+
+            TStream Get(const std::string& uri) override
+            {
+                m_accounting->Update(uri, [](StreamStats& stats) { stats.cacheLookups++; });
+
+                return m_streamCache->Get(uri);
+            }
+
+            TStream Set(const std::string& uri, TStream stream) override
+            {
+                return m_streamCache->Set(uri, std::move(stream));
+            }
+
+        private:
+            std::unique_ptr<IStreamCache<TStream>> m_streamCache;
+            std::shared_ptr<StreamAccounting> m_accounting;
+        };
+
+        typedef AccountingStreamCache<std::shared_ptr<std::istream>> AccountingStreamReaderCache;
+        typedef AccountingStreamCache<std::shared_ptr<std::ostream>> AccountingStreamWriterCache;
+    }
+}
@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Microsoft
+{
+    namespace glTF
+    {
+        // Receives timing spans and counters from the SDK's load and save paths. Calls can be made
+        // concurrently from any thread that is using the SDK so implementations must be thread safe.
+        class ITracer
+        {
+        public:
+            virtual ~ITracer() = default;
+
+            // Span names are string literals and spans on the same thread are always properly nested
+            virtual void BeginSpan(const char* name) = 0;
+            virtual void EndSpan(const char* name) = 0;
+
+            // Adds 'delta' to a running total, e.g. the number of bytes read
+            virtual void Count(const char* name, int64_t delta) = 0;
+        };
+
+        namespace Tracing
+        {
+            // Sets the process-wide tracer. The tracer isn't owned and must remain valid until it has been
+            // replaced (or reset to nullptr) and all SDK calls that started before then have returned.
+            void SetTracer(ITracer* tracer);
+            ITracer* GetTracer();
+
+            class ScopedSpan
+            {
+            public:
+                explicit ScopedSpan(const char* name);
+                ~ScopedSpan();
+
+                ScopedSpan(const ScopedSpan&) = delete;
+                ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+            private:
+                ITracer* m_tracer;
+                const char* m_name;
+            };
+
+            void Count(const char* name, int64_t delta);
+        }
+
+        // Records spans and counters as Chrome trace events, the JSON format loaded by chrome://tracing and Perfetto
+        class ChromeTracer : public ITracer
+        {
+        public:
+            ChromeTracer();
+
+            void BeginSpan(const char* name) override;
+            void EndSpan(const char* name) override;
+            void Count(const char* name, int64_t delta) override;
+
+            void Write(std::ostream& stream) const;
+
+        private:
+            struct Event
+            {
+                const char* name;
+                char phase;
+                int64_t timestamp;  // Microseconds since the tracer was created
+                uint32_t threadId;
+                int64_t value;      // Running total (counter events only)
+            };
+
+            void AddEvent(const char* name, char phase, int64_t value);
+
+            const std::chrono::steady_clock::time_point m_start;
+
+            mutable std::mutex m_mutex;
+            std::vector<Event> m_events;
+            std::unordered_map<std::thread::id, uint32_t> m_threadIds;
+            std::unordered_map<std::string, int64_t> m_counters;
+        };
+    }
+}
+
+// Instrumentation points in the SDK use these macros so they compile to nothing unless the SDK (and
+// any code including its headers) is built with GLTFSDK_ENABLE_TRACING defined
+#ifdef GLTFSDK_ENABLE_TRACING
+#define GLTFSDK_TRACE_CONCAT_IMPL(a, b) a##b
+#define GLTFSDK_TRACE_CONCAT(a, b) GLTFSDK_TRACE_CONCAT_IMPL(a, b)
+#define GLTFSDK_TRACE_SPAN(name) ::Microsoft::glTF::Tracing::ScopedSpan GLTFSDK_TRACE_CONCAT(gltfsdkTraceSpan, __LINE__)(name)
+#define GLTFSDK_TRACE_COUNT(name, delta) ::Microsoft::glTF::Tracing::Count((name), static_cast<int64_t>(delta))
+#else
+#define GLTFSDK_TRACE_SPAN(name) static_cast<void>(0)
+#define GLTFSDK_TRACE_COUNT(name, delta) static_cast<void>(0)
+#endif
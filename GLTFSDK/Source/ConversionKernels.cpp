@@ -0,0 +1,1234 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/ConversionKernels.h>
+
+#include <GLTFSDK/Exceptions.h>
+#include <GLTFSDK/ResourceReaderUtils.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#if (defined(_M_X64) && !defined(_M_ARM64EC)) || defined(__x86_64__)
+#define GLTFSDK_KERNELS_X64
+
+#include <immintrin.h>
+
+// Unlike MSVC, GCC and Clang only allow intrinsics for instruction sets beyond the compilation target
+// (SSE2 for x64) to be used in functions that are explicitly compiled for them
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define GLTFSDK_TARGET_AVX2
+#else
+#define GLTFSDK_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::ConversionKernels;
+
+namespace
+{
+    struct KernelTable
+    {
+        void (*widenU8ToU16)(const uint8_t*, uint16_t*, size_t);
+        void (*widenU8ToU32)(const uint8_t*, uint32_t*, size_t);
+        void (*widenU16ToU32)(const uint16_t*, uint32_t*, size_t);
+
+        void (*toFloatS8)(const int8_t*, float*, size_t, bool);
+        void (*toFloatU8)(const uint8_t*, float*, size_t, bool);
+        void (*toFloatS16)(const int16_t*, float*, size_t, bool);
+        void (*toFloatU16)(const uint16_t*, float*, size_t, bool);
+
+        void (*packUnorm8x4)(const float*, uint32_t*, size_t);
+        void (*packUnorm8x3)(const float*, uint32_t*, size_t);
+
+        void (*expandRGB8ToRGBA8)(const uint8_t*, uint32_t*, size_t);
+
+        void (*triangleStripToList16)(const uint16_t*, uint16_t*, size_t);
+        void (*triangleStripToList32)(const uint32_t*, uint32_t*, size_t);
+        void (*triangleFanToList16)(const uint16_t*, uint16_t*, size_t);
+        void (*triangleFanToList32)(const uint32_t*, uint32_t*, size_t);
+        void (*lineStripToList16)(const uint16_t*, uint16_t*, size_t);
+        void (*lineStripToList32)(const uint32_t*, uint32_t*, size_t);
+
+        void (*minMaxFloat3)(const float*, size_t, float*, float*);
+        void (*normalizeFloat3)(const float*, float*, size_t);
+    };
+
+    // The divisor and lower bound that ComponentToFloat normalizes each component type with
+    template<typename T>
+    struct Normalization;
+
+    template<>
+    struct Normalization<int8_t>
+    {
+        static constexpr float divisor = 127.0f;
+        static constexpr float minimum = -1.0f;
+    };
+
+    template<>
+    struct Normalization<uint8_t>
+    {
+        static constexpr float divisor = 255.0f;
+        static constexpr float minimum = 0.0f;
+    };
+
+    template<>
+    struct Normalization<int16_t>
+    {
+        static constexpr float divisor = 32767.0f;
+        static constexpr float minimum = -1.0f;
+    };
+
+    template<>
+    struct Normalization<uint16_t>
+    {
+        static constexpr float divisor = 65535.0f;
+        static constexpr float minimum = 0.0f;
+    };
+
+    const uint32_t AlphaMask = 0xFF000000U;
+
+    // Scalar kernels - used as the fallback on other architectures and for the elements left over by the vectorized
+    // kernels. Kernels that widen their input run back to front (and those that narrow it front to back) so that, when
+    // converting in place, no element is overwritten before it has been read.
+
+    // When converting in place the memory is typed as the destination rather than the source, so reads go via memcpy
+    template<typename T>
+    T Load(const T* src)
+    {
+        T value;
+        std::memcpy(&value, src, sizeof(T));
+        return value;
+    }
+
+    template<typename TIn, typename TOut>
+    void Widen_Scalar(const TIn* src, TOut* dst, size_t count)
+    {
+        for (size_t i = count; i-- > 0U;)
+        {
+            dst[i] = Load(src + i);
+        }
+    }
+
+    template<typename T>
+    void ToFloat_Scalar(const T* src, float* dst, size_t count, bool normalized)
+    {
+        for (size_t i = count; i-- > 0U;)
+        {
+            const T value = Load(src + i);
+
+            dst[i] = normalized ? ComponentToFloat(value) : static_cast<float>(value);
+        }
+    }
+
+    // Math::FloatToByte with the result saturated. The comparisons are ordered to match the SSE min/max
+    // instructions (which return their second operand for NaNs) so all implementations agree exactly.
+    uint32_t PackUnorm8(float value)
+    {
+        value = value * 255.0f + 0.5f;
+        value = value > 0.0f ? value : 0.0f;
+        value = value < 255.0f ? value : 255.0f;
+
+        return static_cast<uint32_t>(value);
+    }
+
+    void PackUnorm8x4_Scalar(const float* src, uint32_t* dst, size_t count)
+    {
+        for (size_t i = 0U; i < count; i++)
+        {
+            const float* rgba = src + i * 4U;
+
+            dst[i] =
+                PackUnorm8(Load(rgba + 3)) << 24U |
+                PackUnorm8(Load(rgba + 2)) << 16U |
+                PackUnorm8(Load(rgba + 1)) <<  8U |
+                PackUnorm8(Load(rgba));
+        }
+    }
+
+    void PackUnorm8x3_Scalar(const float* src, uint32_t* dst, size_t count)
+    {
+        for (size_t i = 0U; i < count; i++)
+        {
+            const float* rgb = src + i * 3U;
+
+            dst[i] =
+                AlphaMask |
+                PackUnorm8(Load(rgb + 2)) << 16U |
+                PackUnorm8(Load(rgb + 1)) <<  8U |
+                PackUnorm8(Load(rgb));
+        }
+    }
+
+    void ExpandRGB8ToRGBA8_Scalar(const uint8_t* src, uint32_t* dst, size_t count)
+    {
+        for (size_t i = count; i-- > 0U;)
+        {
+            const uint8_t* rgb = src + i * 3U;
+
+            dst[i] =
+                AlphaMask |
+                static_cast<uint32_t>(rgb[2]) << 16U |
+                static_cast<uint32_t>(rgb[1]) <<  8U |
+                static_cast<uint32_t>(rgb[0]);
+        }
+    }
+
+    // Odd triangles swap their last two indices so that the whole strip has the same winding. Expanding the
+    // triangles in pairs avoids branching on which triangle of the pair is being written.
+    template<typename T>
+    void TriangleStripToList_Scalar(const T* src, T* dst, size_t count)
+    {
+        size_t i = 0U;
+
+        for (; i + 1U < count; i += 2U)
+        {
+            const T index0 = src[i];
+            const T index1 = src[i + 1U];
+            const T index2 = src[i + 2U];
+            const T index3 = src[i + 3U];
+
+            T* triangles = dst + i * 3U;
+
+            triangles[0] = index0;
+            triangles[1] = index1;
+            triangles[2] = index2;
+            triangles[3] = index1;
+            triangles[4] = index3;
+            triangles[5] = index2;
+        }
+
+        if (i < count)
+        {
+            const T index0 = src[i];
+            const T index1 = src[i + 1U];
+            const T index2 = src[i + 2U];
+
+            T* triangle = dst + i * 3U;
+
+            triangle[0] = index0;
+            triangle[1] = index1;
+            triangle[2] = index2;
+        }
+    }
+
+    // Fans are expanded from their center index and the indices around their rim so that the vectorized kernels
+    // can hand their remaining triangles on
+    template<typename T>
+    void TriangleFanToList_Scalar(T center, const T* rim, T* dst, size_t count)
+    {
+        for (size_t i = 0U; i < count; i++)
+        {
+            const T index1 = rim[i];
+            const T index2 = rim[i + 1U];
+
+            T* triangle = dst + i * 3U;
+
+            triangle[0] = center;
+            triangle[1] = index1;
+            triangle[2] = index2;
+        }
+    }
+
+    template<typename T>
+    void TriangleFanToList_Scalar(const T* src, T* dst, size_t count)
+    {
+        if (count > 0U)
+        {
+            TriangleFanToList_Scalar(src[0], src + 1, dst, count);
+        }
+    }
+
+    template<typename T>
+    void LineStripToList_Scalar(const T* src, T* dst, size_t count)
+    {
+        for (size_t i = 0U; i < count; i++)
+        {
+            const T index0 = src[i];
+            const T index1 = src[i + 1U];
+
+            dst[i * 2U] = index0;
+            dst[i * 2U + 1U] = index1;
+        }
+    }
+
+    void MinMaxFloat3_Scalar(const float* src, size_t count, float* min, float* max)
+    {
+        for (size_t i = 0U; i < count * 3U; i += 3U)
+        {
+            for (size_t j = 0U; j < 3U; j++)
+            {
+                const float value = src[i + j];
+
+                // Comparisons with NaN are false so, like the SIMD min and max instructions, NaNs leave the bounds as they are
+                min[j] = value < min[j] ? value : min[j];
+                max[j] = value > max[j] ? value : max[j];
+            }
+        }
+    }
+
+    // Merges the bounds accumulated in the lanes of SIMD registers, where lane 'i' holds component 'i % 3'
+    void MergeMinMaxFloat3(const float* laneMin, const float* laneMax, size_t laneCount, float* min, float* max)
+    {
+        for (size_t i = 0U; i < laneCount; i++)
+        {
+            min[i % 3U] = laneMin[i] < min[i % 3U] ? laneMin[i] : min[i % 3U];
+            max[i % 3U] = laneMax[i] > max[i % 3U] ? laneMax[i] : max[i % 3U];
+        }
+    }
+
+    void NormalizeFloat3_Scalar(const float* src, float* dst, size_t count)
+    {
+        for (size_t i = 0U; i < count * 3U; i += 3U)
+        {
+            const float x = src[i];
+            const float y = src[i + 1U];
+            const float z = src[i + 2U];
+
+            const float lengthSquared = x * x + y * y + z * z;
+
+            // Comparisons with NaN are false so, like the SIMD kernels' masks, NaN lengths give a scale of zero
+            const float scale = lengthSquared > 0.0f ? 1.0f / std::sqrt(lengthSquared) : 0.0f;
+
+            dst[i] = x * scale;
+            dst[i + 1U] = y * scale;
+            dst[i + 2U] = z * scale;
+        }
+    }
+
+    // The SIMD kernels load and store each vector as four floats, so a block of vectors must be followed by at least
+    // one more float. Returns the number of vectors that can be processed in blocks of 'blockSize'.
+    size_t GetNormalizeBlockEnd(size_t count, size_t blockSize)
+    {
+        return count > 0U ? (count - 1U) - (count - 1U) % blockSize : 0U;
+    }
+
+    const KernelTable ScalarKernels = {
+        &Widen_Scalar<uint8_t, uint16_t>,
+        &Widen_Scalar<uint8_t, uint32_t>,
+        &Widen_Scalar<uint16_t, uint32_t>,
+        &ToFloat_Scalar<int8_t>,
+        &ToFloat_Scalar<uint8_t>,
+        &ToFloat_Scalar<int16_t>,
+        &ToFloat_Scalar<uint16_t>,
+        &PackUnorm8x4_Scalar,
+        &PackUnorm8x3_Scalar,
+        &ExpandRGB8ToRGBA8_Scalar,
+        &TriangleStripToList_Scalar<uint16_t>,
+        &TriangleStripToList_Scalar<uint32_t>,
+        &TriangleFanToList_Scalar<uint16_t>,
+        &TriangleFanToList_Scalar<uint32_t>,
+        &LineStripToList_Scalar<uint16_t>,
+        &LineStripToList_Scalar<uint32_t>,
+        &MinMaxFloat3_Scalar,
+        &NormalizeFloat3_Scalar
+    };
+
+#ifdef GLTFSDK_KERNELS_X64
+
+    // SSE2 kernels - always available on x64
+
+    void WidenU8ToU16_SSE2(const uint8_t* src, uint16_t* dst, size_t count)
+    {
+        const size_t blockEnd = count - count % 16U;
+
+        Widen_Scalar(src + blockEnd, dst + blockEnd, count - blockEnd);
+
+        const __m128i zero = _mm_setzero_si128();
+
+        for (size_t i = blockEnd; i > 0U;)
+        {
+            i -= 16U;
+
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi8(bytes, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8U), _mm_unpackhi_epi8(bytes, zero));
+        }
+    }
+
+    void WidenU8ToU32_SSE2(const uint8_t* src, uint32_t* dst, size_t count)
+    {
+        const size_t blockEnd = count - count % 16U;
+
+        Widen_Scalar(src + blockEnd, dst + blockEnd, count - blockEnd);
+
+        const __m128i zero = _mm_setzero_si128();
+
+        for (size_t i = blockEnd; i > 0U;)
+        {
+            i -= 16U;
+
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            const __m128i wordsLo = _mm_unpacklo_epi8(bytes, zero);
+            const __m128i wordsHi = _mm_unpackhi_epi8(bytes, zero);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi16(wordsLo, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4U), _mm_unpackhi_epi16(wordsLo, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8U), _mm_unpacklo_epi16(wordsHi, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 12U), _mm_unpackhi_epi16(wordsHi, zero));
+        }
+    }
+
+    void WidenU16ToU32_SSE2(const uint16_t* src, uint32_t* dst, size_t count)
+    {
+        const size_t blockEnd = count - count % 8U;
+
+        Widen_Scalar(src + blockEnd, dst + blockEnd, count - blockEnd);
+
+        const __m128i zero = _mm_setzero_si128();
+
+        for (size_t i = blockEnd; i > 0U;)
+        {
+            i -= 8U;
+
+            const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi16(words, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4U), _mm_unpackhi_epi16(words, zero));
+        }
+    }
+
+    // Sign or zero extends the low or high half of a vector's lanes to the next lane size
+    template<bool IsSigned>
+    __m128i UnpackLo8_SSE2(__m128i value)
+    {
+        return IsSigned ? _mm_srai_epi16(_mm_unpacklo_epi8(value, value), 8) : _mm_unpacklo_epi8(value, _mm_setzero_si128());
+    }
+
+    template<bool IsSigned>
+    __m128i UnpackHi8_SSE2(__m128i value)
+    {
+        return IsSigned ? _mm_srai_epi16(_mm_unpackhi_epi8(value, value), 8) : _mm_unpackhi_epi8(value, _mm_setzero_si128());
+    }
+
+    template<bool IsSigned>
+    __m128i UnpackLo16_SSE2(__m128i value)
+    {
+        return IsSigned ? _mm_srai_epi32(_mm_unpacklo_epi16(value, value), 16) : _mm_unpacklo_epi16(value, _mm_setzero_si128());
+    }
+
+    template<bool IsSigned>
+    __m128i UnpackHi16_SSE2(__m128i value)
+    {
+        return IsSigned ? _mm_srai_epi32(_mm_unpackhi_epi16(value, value), 16) : _mm_unpackhi_epi16(value, _mm_setzero_si128());
+    }
+
+    template<typename T>
+    void StoreFloats_SSE2(float* dst, __m128i value, bool normalized)
+    {
+        __m128 floats = _mm_cvtepi32_ps(value);
+
+        if (normalized)
+        {
+            floats = _mm_max_ps(_mm_div_ps(floats, _mm_set1_ps(Normalization<T>::divisor)), _mm_set1_ps(Normalization<T>::minimum));
+        }
+
+        _mm_storeu_ps(dst, floats);
+    }
+
+    template<typename T>
+    void ToFloat8_SSE2(const T* src, float* dst, size_t count, bool normalized)
+    {
+        const bool isSigned = std::is_signed<T>::value;
+        const size_t blockEnd = count - count % 16U;
+
+        ToFloat_Scalar(src + blockEnd, dst + blockEnd, count - blockEnd, normalized);
+
+        for (size_t i = blockEnd; i > 0U;)
+        {
+            i -= 16U;
+
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            const __m128i wordsLo = UnpackLo8_SSE2<isSigned>(bytes);
+            const __m128i wordsHi = UnpackHi8_SSE2<isSigned>(bytes);
+
+            StoreFloats_SSE2<T>(dst + i, UnpackLo16_SSE2<isSigned>(wordsLo), normalized);
+            StoreFloats_SSE2<T>(dst + i + 4U, UnpackHi16_SSE2<isSigned>(wordsLo), normalized);
+            StoreFloats_SSE2<T>(dst + i + 8U, UnpackLo16_SSE2<isSigned>(wordsHi), normalized);
+            StoreFloats_SSE2<T>(dst + i + 12U, UnpackHi16_SSE2<isSigned>(wordsHi), normalized);
+        }
+    }
+
+    template<typename T>
+    void ToFloat16_SSE2(const T* src, float* dst, size_t count, bool normalized)
+    {
+        const bool isSigned = std::is_signed<T>::value;
+        const size_t blockEnd = count - count % 8U;
+
+        ToFloat_Scalar(src + blockEnd, dst + blockEnd, count - blockEnd, normalized);
+
+        for (size_t i = blockEnd; i > 0U;)
+        {
+            i -= 8U;
+
+            const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+            StoreFloats_SSE2<T>(dst + i, UnpackLo16_SSE2<isSigned>(words), normalized);
+            StoreFloats_SSE2<T>(dst + i + 4U, UnpackHi16_SSE2<isSigned>(words), normalized);
+        }
+    }
+
+    // Vectorized PackUnorm8, the result is one int32 lane per float
+    __m128i Quantize_SSE2(__m128 value)
+    {
+        const __m128 scaled = _mm_add_ps(_mm_mul_ps(value, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f));
+
+        return _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(scaled, _mm_setzero_ps()), _mm_set1_ps(255.0f)));
+    }
+
+    // Packs four vectors of [0,255] int32 lanes, each holding one RGBA value, into four RGBA8 values
+    __m128i PackRGBA_SSE2(__m128i rgba0, __m128i rgba1, __m128i rgba2, __m128i rgba3)
+    {
+        return _mm_packus_epi16(_mm_packs_epi32(rgba0, rgba1), _mm_packs_epi32(rgba2, rgba3));
+    }
+
+    void PackUnorm8x4_SSE2(const float* src, uint32_t* dst, size_t count)
+    {
+        const size_t blockEnd = count - count % 4U;
+
+        for (size_t i = 0U; i < blockEnd; i += 4U)
+        {
+            const float* rgba = src + i * 4U;
+
+            const __m128i packed = PackRGBA_SSE2(
+                Quantize_SSE2(_mm_loadu_ps(rgba)),
+                Quantize_SSE2(_mm_loadu_ps(rgba + 4U)),
+                Quantize_SSE2(_mm_loadu_ps(rgba + 8U)),
+                Quantize_SSE2(_mm_loadu_ps(rgba + 12U)));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+        }
+
+        PackUnorm8x4_Scalar(src + blockEnd * 4U, dst + blockEnd, count - blockEnd);
+    }
+
+    void PackUnorm8x3_SSE2(const float* src, uint32_t* dst, size_t count)
+    {
+        const size_t blockEnd = count - count % 4U;
+        const __m128i alpha = _mm_set1_epi32(static_cast<int>(AlphaMask));
+
+        for (size_t i = 0U; i < blockEnd; i += 4U)
+        {
+            const float* rgb = src + i * 3U;
+
+            const __m128 a = _mm_loadu_ps(rgb);       // r0 g0 b0 r1
+            const __m128 b = _mm_loadu_ps(rgb + 4U);  // g1 b1 r2 g2
+            const __m128 c = _mm_loadu_ps(rgb + 8U);  // b2 r3 g3 b3
+
+            // Gather each value's components into the first three lanes, the fourth is replaced by the alpha mask
+            const __m128 rgb0 = a;
+            const __m128 rgb1 = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 3, 3)), b, _MM_SHUFFLE(1, 1, 2, 0));
+            const __m128 rgb2 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 0, 3, 2));
+            const __m128 rgb3 = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 2, 1));
+
+            const __m128i packed = PackRGBA_SSE2(Quantize_SSE2(rgb0), Quantize_SSE2(rgb1), Quantize_SSE2(rgb2), Quantize_SSE2(rgb3));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_or_si128(packed, alpha));
+        }
+
+        PackUnorm8x3_Scalar(src + blockEnd * 3U, dst + blockEnd, count - blockEnd);
+    }
+
+    // Each block of four triangles uses six indices, i.e. the triangles (0 1 2) (1 3 2) (2 3 4) (3 5 4)
+    void TriangleStripToList32_SSE2(const uint32_t* src, uint32_t* dst, size_t count)
+    {
+        const size_t blockEnd = count - count % 4U;
+
+        for (size_t i = 0U; i < blockEnd; i += 4U)
+        {
+            const __m128i indices0123 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            const __m128i indices45 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i + 4U));
+            const __m128i indices345 = _mm_or_si128(_mm_srli_si128(indices0123, 12), _mm_slli_si128(indices45, 4));
+
+            __m128i* triangles = reinterpret_cast<__m128i*>(dst + i * 3U);
+
+            _mm_storeu_si128(triangles, _mm_shuffle_epi32(indices0123, _MM_SHUFFLE(1, 2, 1, 0)));
+            _mm_storeu_si128(triangles + 1, _mm_shuffle_epi32(indices0123, _MM_SHUFFLE(3, 2, 2, 3)));
+            _mm_storeu_si128(triangles + 2, _mm_shuffle_epi32(indices345, _MM_SHUFFLE(1, 2, 0, 1)));
+        }
+
+        TriangleStripToList_Scalar(src + blockEnd, dst + blockEnd * 3U, count - blockEnd);
+    }
+
+    // Each block of four triangles uses the center index and five rim indices, i.e. the triangles
+    // (c 1 2) (c 2 3) (c 3 4) (c 4 5)
+    void TriangleFanToList32_SSE2(const uint32_t* src, uint32_t* dst, size_t count)
+    {
+        if (count == 0U)
+        {
+            return;
+        }
+
+        const uint32_t center = src[0];
+        const uint32_t* rim = src + 1;
+
+        const size_t blockEnd = count - count % 4U;
+        const __m128 centers = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(center)));
+
+        for (size_t i = 0U; i < blockEnd; i += 4U)
+        {
+            const __m128 indices1234 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rim + i)));
+            const __m128 indices2345 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rim + i + 1U)));
+
+            const __m128 indicesCC12 = _mm_shuffle_ps(centers, indices1234, _MM_SHUFFLE(1, 0, 0, 0));
+            const __m128 indices23CC = _mm_shuffle_ps(indices1234, centers, _MM_SHUFFLE(0, 0, 2, 1));
+            const __m128 indices45CC = _mm_shuffle_ps(indices2345, centers, _MM_SHUFFLE(0, 0, 3, 2));
+
+            __m128i* triangles = reinterpret_cast<__m128i*>(dst + i * 3U);
+
+            _mm_storeu_si128(triangles, _mm_shuffle_epi32(_mm_castps_si128(indicesCC12), _MM_SHUFFLE(0, 3, 2, 0)));
+            _mm_storeu_si128(triangles + 1, _mm_shuffle_epi32(_mm_castps_si128(indices23CC), _MM_SHUFFLE(1, 2, 1, 0)));
+            _mm_storeu_si128(triangles + 2, _mm_shuffle_epi32(_mm_castps_si128(indices45CC), _MM_SHUFFLE(1, 0, 2, 0)));
+        }
+
+        TriangleFanToList_Scalar(center, rim + blockEnd, dst + blockEnd * 3U, count - blockEnd);
+    }
+
+    // Interleaving the indices with themselves offset by one gives the segments' indices
+    void LineStripToList16_SSE2(const uint16_t* src, uint16_t* dst, size_t count)
+    {
+        const size_t blockEnd = count - count % 8U;
+
+        for (size_t i = 0U; i < blockEnd; i += 8U)
+        {
+            const __m128i indices0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            const __m128i indices1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 1U));
+
+            __m128i* segments = reinterpret_cast<__m128i*>(dst + i * 2U);
+
+            _mm_storeu_si128(segments, _mm_unpacklo_epi16(indices0, indices1));
+            _mm_storeu_si128(segments + 1, _mm_unpackhi_epi16(indices0, indices1));
+        }
+
+        LineStripToList_Scalar(src + blockEnd, dst + blockEnd * 2U, count - blockEnd);
+    }
+
+    void LineStripToList32_SSE2(const uint32_t* src, uint32_t* dst, size_t count)
+    {
+        const size_t blockEnd = count - count % 4U;
+
+        for (size_t i = 0U; i < blockEnd; i += 4U)
+        {
+            const __m128i indices0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            const __m128i indices1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 1U));
+
+            __m128i* segments = reinterpret_cast<__m128i*>(dst + i * 2U);
+
+            _mm_storeu_si128(segments, _mm_unpacklo_epi32(indices0, indices1));
+            _mm_storeu_si128(segments + 1, _mm_unpackhi_epi32(indices0, indices1));
+        }
+
+        LineStripToList_Scalar(src + blockEnd, dst + blockEnd * 2U, count - blockEnd);
+    }
+
+    // Each block of four values spans three vectors whose lanes hold the components x y z x, y z x y and z x y z
+    void MinMaxFloat3_SSE2(const float* src, size_t count, float* min, float* max)
+    {
+        const size_t blockEnd = count - count % 4U;
+
+        float laneMin[12];
+        float laneMax[12];
+
+        for (size_t i = 0U; i < 12U; i++)
+        {
+            laneMin[i] = min[i % 3U];
+            laneMax[i] = max[i % 3U];
+        }
+
+        __m128 min0 = _mm_loadu_ps(laneMin);
+        __m128 min1 = _mm_loadu_ps(laneMin + 4U);
+        __m128 min2 = _mm_loadu_ps(laneMin + 8U);
+        __m128 max0 = _mm_loadu_ps(laneMax);
+        __m128 max1 = _mm_loadu_ps(laneMax + 4U);
+        __m128 max2 = _mm_loadu_ps(laneMax + 8U);
+
+        for (size_t i = 0U; i < blockEnd; i += 4U)
+        {
+            const float* xyz = src + i * 3U;
+
+            const __m128 a = _mm_loadu_ps(xyz);
+            const __m128 b = _mm_loadu_ps(xyz + 4U);
+            const __m128 c = _mm_loadu_ps(xyz + 8U);
+
+            // The accumulator is the second operand, which MINPS and MAXPS return when either operand is NaN
+            min0 = _mm_min_ps(a, min0);
+            min1 = _mm_min_ps(b, min1);
+            min2 = _mm_min_ps(c, min2);
+            max0 = _mm_max_ps(a, max0);
+            max1 = _mm_max_ps(b, max1);
+            max2 = _mm_max_ps(c, max2);
+        }
+
+        _mm_storeu_ps(laneMin, min0);
+        _mm_storeu_ps(laneMin + 4U, min1);
+        _mm_storeu_ps(laneMin + 8U, min2);
+        _mm_storeu_ps(laneMax, max0);
+        _mm_storeu_ps(laneMax + 4U, max1);
+        _mm_storeu_ps(laneMax + 8U, max2);
+
+        MergeMinMaxFloat3(laneMin, laneMax, 12U, min, max);
+        MinMaxFloat3_Scalar(src + blockEnd * 3U, count - blockEnd, min, max);
+    }
+
+    void NormalizeFloat3_SSE2(const float* src, float* dst, size_t count)
+    {
+        const size_t blockEnd = GetNormalizeBlockEnd(count, 4U);
+
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 zero = _mm_setzero_ps();
+
+        for (size_t i = 0U; i < blockEnd; i += 4U)
+        {
+            const float* xyz = src + i * 3U;
+
+            // Each row is a vector followed by the next vector's x, which is transposed back unchanged
+            __m128 x = _mm_loadu_ps(xyz);
+            __m128 y = _mm_loadu_ps(xyz + 3U);
+            __m128 z = _mm_loadu_ps(xyz + 6U);
+            __m128 w = _mm_loadu_ps(xyz + 9U);
+
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+
+            const __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+            const __m128 scale = _mm_and_ps(_mm_cmpgt_ps(lengthSquared, zero), _mm_div_ps(one, _mm_sqrt_ps(lengthSquared)));
+
+            x = _mm_mul_ps(x, scale);
+            y = _mm_mul_ps(y, scale);
+            z = _mm_mul_ps(z, scale);
+
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+
+            // In order, so that each store's fourth float is overwritten by the next (or is the unchanged value after the
+            // block) and in-place normalization reads every vector before it's written
+            float* out = dst + i * 3U;
+
+            _mm_storeu_ps(out, x);
+            _mm_storeu_ps(out + 3U, y);
+            _mm_storeu_ps(out + 6U, z);
+            _mm_storeu_ps(out + 9U, w);
+        }
+
+        NormalizeFloat3_Scalar(src + blockEnd * 3U, dst + blockEnd * 3U, count - blockEnd);
+    }
+
+    const KernelTable SSE2Kernels = {
+        &WidenU8ToU16_SSE2,
+        &WidenU8ToU32_SSE2,
+        &WidenU16ToU32_SSE2,
+        &ToFloat8_SSE2<int8_t>,
+        &ToFloat8_SSE2<uint8_t>,
+        &ToFloat16_SSE2<int16_t>,
+        &ToFloat16_SSE2<uint16_t>,
+        &PackUnorm8x4_SSE2,
+        &PackUnorm8x3_SSE2,
+        &ExpandRGB8ToRGBA8_Scalar, // Byte shuffles require SSSE3
+        &TriangleStripToList_Scalar<uint16_t>,
+        &TriangleStripToList32_SSE2,
+        &TriangleFanToList_Scalar<uint16_t>,
+        &TriangleFanToList32_SSE2,
+        &LineStripToList16_SSE2,
+        &LineStripToList32_SSE2,
+        &MinMaxFloat3_SSE2,
+        &NormalizeFloat3_SSE2
+    };
+
+    // AVX2 kernels - selected at runtime when supported by the CPU and OS
+
+    GLTFSDK_TARGET_AVX2 void WidenU8ToU16_AVX2(const uint8_t* src, uint16_t* dst, size_t count)
+    {
+        const size_t blockEnd = count - count % 16U;
+
+        Widen_Scalar(src + blockEnd, dst + blockEnd, count - blockEnd);
+
+        for (size_t i = blockEnd; i > 0U;)
+        {
+            i -= 16U;
+
+            const __m256i words = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), words);
+        }
+    }
+
+    GLTFSDK_TARGET_AVX2 void WidenU8ToU32_AVX2(const uint8_t* src, uint32_t* dst, size_t count)
+    {
+        const size_t blockEnd = count - count % 8U;
+
+        Widen_Scalar(src + blockEnd, dst + blockEnd, count - blockEnd);
+
+        for (size_t i = blockEnd; i > 0U;)
+        {
+            i -= 8U;
+
+            const __m256i dwords = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), dwords);
+        }
+    }
+
+    GLTFSDK_TARGET_AVX2 void WidenU16ToU32_AVX2(const uint16_t* src, uint32_t* dst, size_t count)
+    {
+        const size_t blockEnd = count - count % 8U;
+
+        Widen_Scalar(src + blockEnd, dst + blockEnd, count - blockEnd);
+
+        for (size_t i = blockEnd; i > 0U;)
+        {
+            i -= 8U;
+
+            const __m256i dwords = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), dwords);
+        }
+    }
+
+    // Loads eight components, sign or zero extended to int32 lanes
+    GLTFSDK_TARGET_AVX2 __m256i Load8_AVX2(const int8_t* src)
+    {
+        return _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));
+    }
+
+    GLTFSDK_TARGET_AVX2 __m256i Load8_AVX2(const uint8_t* src)
+    {
+        return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));
+    }
+
+    GLTFSDK_TARGET_AVX2 __m256i Load8_AVX2(const int16_t* src)
+    {
+        return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+    }
+
+    GLTFSDK_TARGET_AVX2 __m256i Load8_AVX2(const uint16_t* src)
+    {
+        return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+    }
+
+    template<typename T>
+    GLTFSDK_TARGET_AVX2 void ToFloat_AVX2(const T* src, float* dst, size_t count, bool normalized)
+    {
+        const size_t blockEnd = count - count % 8U;
+
+        ToFloat_Scalar(src + blockEnd, dst + blockEnd, count - blockEnd, normalized);
+
+        const __m256 divisor = _mm256_set1_ps(Normalization<T>::divisor);
+        const __m256 minimum = _mm256_set1_ps(Normalization<T>::minimum);
+
+        for (size_t i = blockEnd; i > 0U;)
+        {
+            i -= 8U;
+
+            __m256 floats = _mm256_cvtepi32_ps(Load8_AVX2(src + i));
+
+            if (normalized)
+            {
+                floats = _mm256_max_ps(_mm256_div_ps(floats, divisor), minimum);
+            }
+
+            _mm256_storeu_ps(dst + i, floats);
+        }
+    }
+
+    GLTFSDK_TARGET_AVX2 __m256i Quantize_AVX2(__m256 value)
+    {
+        const __m256 scaled = _mm256_add_ps(_mm256_mul_ps(value, _mm256_set1_ps(255.0f)), _mm256_set1_ps(0.5f));
+
+        return _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(scaled, _mm256_setzero_ps()), _mm256_set1_ps(255.0f)));
+    }
+
+    GLTFSDK_TARGET_AVX2 void PackUnorm8x4_AVX2(const float* src, uint32_t* dst, size_t count)
+    {
+        const size_t blockEnd = count - count % 8U;
+
+        // The 256-bit packs operate on each 128-bit half independently, leaving the values in the order 0 2 4 6 1 3 5 7
+        const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+        for (size_t i = 0U; i < blockEnd; i += 8U)
+        {
+            const float* rgba = src + i * 4U;
+
+            const __m256i rgba01 = Quantize_AVX2(_mm256_loadu_ps(rgba));
+            const __m256i rgba23 = Quantize_AVX2(_mm256_loadu_ps(rgba + 8U));
+            const __m256i rgba45 = Quantize_AVX2(_mm256_loadu_ps(rgba + 16U));
+            const __m256i rgba67 = Quantize_AVX2(_mm256_loadu_ps(rgba + 24U));
+
+            const __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(rgba01, rgba23), _mm256_packs_epi32(rgba45, rgba67));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permutevar8x32_epi32(packed, order));
+        }
+
+        PackUnorm8x4_Scalar(src + blockEnd * 4U, dst + blockEnd, count - blockEnd);
+    }
+
+    GLTFSDK_TARGET_AVX2 void ExpandRGB8ToRGBA8_AVX2(const uint8_t* src, uint32_t* dst, size_t count)
+    {
+        // Each block loads 16 bytes for its 12 bytes of RGB data, so the blocks stop short of the end of 'src'
+        const size_t blockEnd = count >= 2U ? ((count - 2U) & ~size_t(3U)) : 0U;
+
+        ExpandRGB8ToRGBA8_Scalar(src + blockEnd * 3U, dst + blockEnd, count - blockEnd);
+
+        const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const __m128i alpha = _mm_set1_epi32(static_cast<int>(AlphaMask));
+
+        for (size_t i = blockEnd; i > 0U;)
+        {
+            i -= 4U;
+
+            const __m128i rgb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3U));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha));
+        }
+    }
+
+    // Each block of eight triangles uses ten indices, the first 16 of the 24 indices written come from indices 0-7
+    // and the remainder from indices 2-9
+    GLTFSDK_TARGET_AVX2 void TriangleStripToList16_AVX2(const uint16_t* src, uint16_t* dst, size_t count)
+    {
+        const size_t blockEnd = count - count % 8U;
+
+        const __m128i shuffle0 = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 2, 3, 6, 7, 4, 5, 4, 5, 6, 7);        // 0 1 2 1 3 2 2 3
+        const __m128i shuffle1 = _mm_setr_epi8(8, 9, 6, 7, 10, 11, 8, 9, 8, 9, 10, 11, 12, 13, 10, 11); // 4 3 5 4 4 5 6 5
+        const __m128i shuffle2 = _mm_setr_epi8(10, 11, 8, 9, 8, 9, 10, 11, 12, 13, 10, 11, 14, 15, 12, 13); // 7 6 6 7 8 7 9 8
+
+        for (size_t i = 0U; i < blockEnd; i += 8U)
+        {
+            const __m128i indices0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            const __m128i indices2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 2U));
+
+            __m128i* triangles = reinterpret_cast<__m128i*>(dst + i * 3U);
+
+            _mm_storeu_si128(triangles, _mm_shuffle_epi8(indices0, shuffle0));
+            _mm_storeu_si128(triangles + 1, _mm_shuffle_epi8(indices0, shuffle1));
+            _mm_storeu_si128(triangles + 2, _mm_shuffle_epi8(indices2, shuffle2));
+        }
+
+        TriangleStripToList_Scalar(src + blockEnd, dst + blockEnd * 3U, count - blockEnd);
+    }
+
+    // As MinMaxFloat3_SSE2, with blocks of eight values
+    GLTFSDK_TARGET_AVX2 void MinMaxFloat3_AVX2(const float* src, size_t count, float* min, float* max)
+    {
+        const size_t blockEnd = count - count % 8U;
+
+        float laneMin[24];
+        float laneMax[24];
+
+        for (size_t i = 0U; i < 24U; i++)
+        {
+            laneMin[i] = min[i % 3U];
+            laneMax[i] = max[i % 3U];
+        }
+
+        __m256 min0 = _mm256_loadu_ps(laneMin);
+        __m256 min1 = _mm256_loadu_ps(laneMin + 8U);
+        __m256 min2 = _mm256_loadu_ps(laneMin + 16U);
+        __m256 max0 = _mm256_loadu_ps(laneMax);
+        __m256 max1 = _mm256_loadu_ps(laneMax + 8U);
+        __m256 max2 = _mm256_loadu_ps(laneMax + 16U);
+
+        for (size_t i = 0U; i < blockEnd; i += 8U)
+        {
+            const float* xyz = src + i * 3U;
+
+            const __m256 a = _mm256_loadu_ps(xyz);
+            const __m256 b = _mm256_loadu_ps(xyz + 8U);
+            const __m256 c = _mm256_loadu_ps(xyz + 16U);
+
+            min0 = _mm256_min_ps(a, min0);
+            min1 = _mm256_min_ps(b, min1);
+            min2 = _mm256_min_ps(c, min2);
+            max0 = _mm256_max_ps(a, max0);
+            max1 = _mm256_max_ps(b, max1);
+            max2 = _mm256_max_ps(c, max2);
+        }
+
+        _mm256_storeu_ps(laneMin, min0);
+        _mm256_storeu_ps(laneMin + 8U, min1);
+        _mm256_storeu_ps(laneMin + 16U, min2);
+        _mm256_storeu_ps(laneMax, max0);
+        _mm256_storeu_ps(laneMax + 8U, max1);
+        _mm256_storeu_ps(laneMax + 16U, max2);
+
+        MergeMinMaxFloat3(laneMin, laneMax, 24U, min, max);
+        MinMaxFloat3_Scalar(src + blockEnd * 3U, count - blockEnd, min, max);
+    }
+
+    // As NormalizeFloat3_SSE2, with vectors 'j' and 'j + 4' of each block of eight in the low and high lanes of a row
+    GLTFSDK_TARGET_AVX2 void NormalizeFloat3_AVX2(const float* src, float* dst, size_t count)
+    {
+        const size_t blockEnd = GetNormalizeBlockEnd(count, 8U);
+
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 zero = _mm256_setzero_ps();
+
+        for (size_t i = 0U; i < blockEnd; i += 8U)
+        {
+            const float* xyz = src + i * 3U;
+
+            const __m256 r0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(xyz)), _mm_loadu_ps(xyz + 12U), 1);
+            const __m256 r1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(xyz + 3U)), _mm_loadu_ps(xyz + 15U), 1);
+            const __m256 r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(xyz + 6U)), _mm_loadu_ps(xyz + 18U), 1);
+            const __m256 r3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(xyz + 9U)), _mm_loadu_ps(xyz + 21U), 1);
+
+            const __m256 xy01 = _mm256_unpacklo_ps(r0, r1);
+            const __m256 zw01 = _mm256_unpackhi_ps(r0, r1);
+            const __m256 xy23 = _mm256_unpacklo_ps(r2, r3);
+            const __m256 zw23 = _mm256_unpackhi_ps(r2, r3);
+
+            __m256 x = _mm256_shuffle_ps(xy01, xy23, _MM_SHUFFLE(1, 0, 1, 0));
+            __m256 y = _mm256_shuffle_ps(xy01, xy23, _MM_SHUFFLE(3, 2, 3, 2));
+            __m256 z = _mm256_shuffle_ps(zw01, zw23, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 w = _mm256_shuffle_ps(zw01, zw23, _MM_SHUFFLE(3, 2, 3, 2));
+
+            const __m256 lengthSquared = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+            const __m256 scale = _mm256_and_ps(_mm256_cmp_ps(lengthSquared, zero, _CMP_GT_OQ), _mm256_div_ps(one, _mm256_sqrt_ps(lengthSquared)));
+
+            x = _mm256_mul_ps(x, scale);
+            y = _mm256_mul_ps(y, scale);
+            z = _mm256_mul_ps(z, scale);
+
+            const __m256 xyLo = _mm256_unpacklo_ps(x, y);
+            const __m256 xyHi = _mm256_unpackhi_ps(x, y);
+            const __m256 zwLo = _mm256_unpacklo_ps(z, w);
+            const __m256 zwHi = _mm256_unpackhi_ps(z, w);
+
+            const __m256 v0 = _mm256_shuffle_ps(xyLo, zwLo, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 v1 = _mm256_shuffle_ps(xyLo, zwLo, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 v2 = _mm256_shuffle_ps(xyHi, zwHi, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 v3 = _mm256_shuffle_ps(xyHi, zwHi, _MM_SHUFFLE(3, 2, 3, 2));
+
+            // In order of address, as in NormalizeFloat3_SSE2
+            float* out = dst + i * 3U;
+
+            _mm_storeu_ps(out, _mm256_castps256_ps128(v0));
+            _mm_storeu_ps(out + 3U, _mm256_castps256_ps128(v1));
+            _mm_storeu_ps(out + 6U, _mm256_castps256_ps128(v2));
+            _mm_storeu_ps(out + 9U, _mm256_castps256_ps128(v3));
+            _mm_storeu_ps(out + 12U, _mm256_extractf128_ps(v0, 1));
+            _mm_storeu_ps(out + 15U, _mm256_extractf128_ps(v1, 1));
+            _mm_storeu_ps(out + 18U, _mm256_extractf128_ps(v2, 1));
+            _mm_storeu_ps(out + 21U, _mm256_extractf128_ps(v3, 1));
+        }
+
+        NormalizeFloat3_Scalar(src + blockEnd * 3U, dst + blockEnd * 3U, count - blockEnd);
+    }
+
+    const KernelTable AVX2Kernels = {
+        &WidenU8ToU16_AVX2,
+        &WidenU8ToU32_AVX2,
+        &WidenU16ToU32_AVX2,
+        &ToFloat_AVX2<int8_t>,
+        &ToFloat_AVX2<uint8_t>,
+        &ToFloat_AVX2<int16_t>,
+        &ToFloat_AVX2<uint16_t>,
+        &PackUnorm8x4_AVX2,
+        &PackUnorm8x3_SSE2,
+        &ExpandRGB8ToRGBA8_AVX2,
+        &TriangleStripToList16_AVX2,
+        &TriangleStripToList32_SSE2,
+        &TriangleFanToList_Scalar<uint16_t>,
+        &TriangleFanToList32_SSE2,
+        &LineStripToList16_SSE2,
+        &LineStripToList32_SSE2,
+        &MinMaxFloat3_AVX2,
+        &NormalizeFloat3_AVX2
+    };
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    bool CpuSupportsAVX2()
+    {
+        int info[4];
+
+        __cpuid(info, 0);
+
+        if (info[0] < 7)
+        {
+            return false;
+        }
+
+        // The OS must also save the AVX registers on context switches (OSXSAVE and the XCR0 YMM state bits)
+        __cpuid(info, 1);
+
+        if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 0x6) != 0x6)
+        {
+            return false;
+        }
+
+        __cpuidex(info, 7, 0);
+
+        return (info[1] & (1 << 5)) != 0;
+    }
+#else
+    bool CpuSupportsAVX2()
+    {
+        return __builtin_cpu_supports("avx2") != 0;
+    }
+#endif
+
+#endif // GLTFSDK_KERNELS_X64
+
+    InstructionSet GetBestInstructionSet()
+    {
+        if (IsSupported(InstructionSet::AVX2))
+        {
+            return InstructionSet::AVX2;
+        }
+
+        if (IsSupported(InstructionSet::SSE2))
+        {
+            return InstructionSet::SSE2;
+        }
+
+        return InstructionSet::Scalar;
+    }
+
+    std::atomic<InstructionSet>& GetCurrentInstructionSet()
+    {
+        static std::atomic<InstructionSet> instructionSet(GetBestInstructionSet());
+        return instructionSet;
+    }
+
+    const KernelTable& GetKernels()
+    {
+        switch (GetCurrentInstructionSet().load(std::memory_order_relaxed))
+        {
+#ifdef GLTFSDK_KERNELS_X64
+        case InstructionSet::SSE2:
+            return SSE2Kernels;
+        case InstructionSet::AVX2:
+            return AVX2Kernels;
+#endif
+        default:
+            return ScalarKernels;
+        }
+    }
+}
+
+bool ConversionKernels::IsSupported(InstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+    case InstructionSet::Scalar:
+        return true;
+#ifdef GLTFSDK_KERNELS_X64
+    case InstructionSet::SSE2:
+        return true;
+    case InstructionSet::AVX2:
+    {
+        static const bool isSupported = CpuSupportsAVX2();
+        return isSupported;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+InstructionSet ConversionKernels::GetInstructionSet()
+{
+    return GetCurrentInstructionSet().load();
+}
+
+void ConversionKernels::SetInstructionSet(InstructionSet instructionSet)
+{
+    if (!IsSupported(instructionSet))
+    {
+        throw GLTFException("The instruction set isn't supported on this CPU");
+    }
+
+    GetCurrentInstructionSet().store(instructionSet);
+}
+
+void ConversionKernels::WidenU8ToU16(const uint8_t* src, uint16_t* dst, size_t count)
+{
+    GetKernels().widenU8ToU16(src, dst, count);
+}
+
+void ConversionKernels::WidenU8ToU32(const uint8_t* src, uint32_t* dst, size_t count)
+{
+    GetKernels().widenU8ToU32(src, dst, count);
+}
+
+void ConversionKernels::WidenU16ToU32(const uint16_t* src, uint32_t* dst, size_t count)
+{
+    GetKernels().widenU16ToU32(src, dst, count);
+}
+
+void ConversionKernels::ToFloat(const int8_t* src, float* dst, size_t count, bool normalized)
+{
+    GetKernels().toFloatS8(src, dst, count, normalized);
+}
+
+void ConversionKernels::ToFloat(const uint8_t* src, float* dst, size_t count, bool normalized)
+{
+    GetKernels().toFloatU8(src, dst, count, normalized);
+}
+
+void ConversionKernels::ToFloat(const int16_t* src, float* dst, size_t count, bool normalized)
+{
+    GetKernels().toFloatS16(src, dst, count, normalized);
+}
+
+void ConversionKernels::ToFloat(const uint16_t* src, float* dst, size_t count, bool normalized)
+{
+    GetKernels().toFloatU16(src, dst, count, normalized);
+}
+
+void ConversionKernels::PackUnorm8x4(const float* src, uint32_t* dst, size_t count)
+{
+    GetKernels().packUnorm8x4(src, dst, count);
+}
+
+void ConversionKernels::PackUnorm8x3(const float* src, uint32_t* dst, size_t count)
+{
+    GetKernels().packUnorm8x3(src, dst, count);
+}
+
+void ConversionKernels::ExpandRGB8ToRGBA8(const uint8_t* src, uint32_t* dst, size_t count)
+{
+    GetKernels().expandRGB8ToRGBA8(src, dst, count);
+}
+
+void ConversionKernels::TriangleStripToList(const uint16_t* src, uint16_t* dst, size_t count)
+{
+    GetKernels().triangleStripToList16(src, dst, count);
+}
+
+void ConversionKernels::TriangleStripToList(const uint32_t* src, uint32_t* dst, size_t count)
+{
+    GetKernels().triangleStripToList32(src, dst, count);
+}
+
+void ConversionKernels::TriangleFanToList(const uint16_t* src, uint16_t* dst, size_t count)
+{
+    GetKernels().triangleFanToList16(src, dst, count);
+}
+
+void ConversionKernels::TriangleFanToList(const uint32_t* src, uint32_t* dst, size_t count)
+{
+    GetKernels().triangleFanToList32(src, dst, count);
+}
+
+void ConversionKernels::LineStripToList(const uint16_t* src, uint16_t* dst, size_t count)
+{
+    GetKernels().lineStripToList16(src, dst, count);
+}
+
+void ConversionKernels::LineStripToList(const uint32_t* src, uint32_t* dst, size_t count)
+{
+    GetKernels().lineStripToList32(src, dst, count);
+}
+
+void ConversionKernels::MinMaxFloat3(const float* src, size_t count, float* min, float* max)
+{
+    GetKernels().minMaxFloat3(src, count, min, max);
+}
+
+void ConversionKernels::NormalizeFloat3(const float* src, float* dst, size_t count)
+{
+    GetKernels().normalizeFloat3(src, dst, count);
+}
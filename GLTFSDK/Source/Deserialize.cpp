@@ -9,6 +9,7 @@
 #include <GLTFSDK/RapidJsonUtils.h>
 #include <GLTFSDK/Serialize.h>
 #include <GLTFSDK/SchemaValidation.h>
+#include <GLTFSDK/Tracing.h>
 
 #include <iostream>
 
@@ -793,6 +794,8 @@ namespace
     {
         ValidateDocumentAgainstSchema(document, SCHEMA_URI_GLTF, GetDefaultSchemaLocator(schemaFlags));
 
+        GLTFSDK_TRACE_SPAN("Deserialize::BuildDocument");
+
         Document gltfDocument;
 
         rapidjson::Value::ConstMemberIterator it;
@@ -832,6 +835,25 @@ namespace
     {
         return ((flags & flag) == flag);
     }
+
+    rapidjson::Document ParseJson(const std::string& json, DeserializeFlags flags)
+    {
+        GLTFSDK_TRACE_SPAN("Deserialize::ParseJson");
+        GLTFSDK_TRACE_COUNT("JsonBytesParsed", json.size());
+
+        return HasFlag(flags, DeserializeFlags::IgnoreByteOrderMark) ?
+            RapidJsonUtils::CreateDocumentFromEncodedString(json) :
+            RapidJsonUtils::CreateDocumentFromString(json);
+    }
+
+    rapidjson::Document ParseJson(std::istream& jsonStream, DeserializeFlags flags)
+    {
+        GLTFSDK_TRACE_SPAN("Deserialize::ParseJson");
+
+        return HasFlag(flags, DeserializeFlags::IgnoreByteOrderMark) ?
+            RapidJsonUtils::CreateDocumentFromEncodedStream(jsonStream) :
+            RapidJsonUtils::CreateDocumentFromStream(jsonStream);
+    }
 }
 
 Document Microsoft::glTF::Deserialize(const std::string& json, DeserializeFlags flags, SchemaFlags schemaFlags)
@@ -841,9 +863,9 @@ Document Microsoft::glTF::Deserialize(const std::string& json, DeserializeFlags
 
 Document Microsoft::glTF::Deserialize(const std::string& json, const ExtensionDeserializer& extensionDeserializer, DeserializeFlags flags, SchemaFlags schemaFlags)
 {
-    const auto document = HasFlag(flags, DeserializeFlags::IgnoreByteOrderMark) ?
-        RapidJsonUtils::CreateDocumentFromEncodedString(json) :
-        RapidJsonUtils::CreateDocumentFromString(json);
+    GLTFSDK_TRACE_SPAN("Deserialize");
+
+    const auto document = ParseJson(json, flags);
 
     return DeserializeInternal(document, extensionDeserializer, schemaFlags);
 }
@@ -855,9 +877,9 @@ Document Microsoft::glTF::Deserialize(std::istream& jsonStream, DeserializeFlags
 
 Document Microsoft::glTF::Deserialize(std::istream& jsonStream, const ExtensionDeserializer& extensionDeserializer, DeserializeFlags flags, SchemaFlags schemaFlags)
 {
-    const auto document = HasFlag(flags, DeserializeFlags::IgnoreByteOrderMark) ?
-        RapidJsonUtils::CreateDocumentFromEncodedStream(jsonStream) :
-        RapidJsonUtils::CreateDocumentFromStream(jsonStream);
+    GLTFSDK_TRACE_SPAN("Deserialize");
+
+    const auto document = ParseJson(jsonStream, flags);
 
     return DeserializeInternal(document, extensionDeserializer, schemaFlags);
 }
@@ -3,6 +3,8 @@
 
 #include <GLTFSDK/Document.h>
 
+#include <GLTFSDK/MemoryUsage.h>
+
 using namespace Microsoft::glTF;
 
 Document::Document() = default;
@@ -73,3 +75,8 @@ bool Document::operator==(const Document& rhs) const
         && this->defaultSceneId == rhs.defaultSceneId
         && glTFProperty::Equals(*this, rhs);
 }
+
+size_t Document::EstimateMemoryUsage() const
+{
+    return sizeof(Document) + MemoryUsage::EstimateHeapSize(*this);
+}
@@ -14,3 +14,8 @@ bool Extension::operator!=(const Extension& rhs) const
 {
     return !operator==(rhs);
 }
+
+size_t Extension::EstimateMemoryUsage() const
+{
+    return sizeof(Extension);
+}
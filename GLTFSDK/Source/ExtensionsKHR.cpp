@@ -4,6 +4,7 @@
 #include <GLTFSDK/ExtensionsKHR.h>
 
 #include <GLTFSDK/Document.h>
+#include <GLTFSDK/MemoryUsage.h>
 #include <GLTFSDK/RapidJsonUtils.h>
 
 using namespace Microsoft::glTF;
@@ -129,12 +130,14 @@ ExtensionSerializer KHR::GetKHRExtensionSerializer()
 {
     using namespace Materials;
     using namespace MeshPrimitives;
+    using namespace Textures;
     using namespace TextureInfos;
 
     ExtensionSerializer extensionSerializer;
     extensionSerializer.AddHandler<PBRSpecularGlossiness, Material>(PBRSPECULARGLOSSINESS_NAME, SerializePBRSpecGloss);
     extensionSerializer.AddHandler<Unlit, Material>(UNLIT_NAME, SerializeUnlit);
     extensionSerializer.AddHandler<DracoMeshCompression, MeshPrimitive>(DRACOMESHCOMPRESSION_NAME, SerializeDracoMeshCompression);
+    extensionSerializer.AddHandler<TextureBasisU, Texture>(TEXTUREBASISU_NAME, SerializeTextureBasisU);
     extensionSerializer.AddHandler<TextureTransform, TextureInfo>(TEXTURETRANSFORM_NAME, SerializeTextureTransform);
     extensionSerializer.AddHandler<TextureTransform, Material::NormalTextureInfo>(TEXTURETRANSFORM_NAME, SerializeTextureTransform);
     extensionSerializer.AddHandler<TextureTransform, Material::OcclusionTextureInfo>(TEXTURETRANSFORM_NAME, SerializeTextureTransform);
@@ -145,12 +148,14 @@ ExtensionDeserializer KHR::GetKHRExtensionDeserializer()
 {
     using namespace Materials;
     using namespace MeshPrimitives;
+    using namespace Textures;
     using namespace TextureInfos;
 
     ExtensionDeserializer extensionDeserializer;
     extensionDeserializer.AddHandler<PBRSpecularGlossiness, Material>(PBRSPECULARGLOSSINESS_NAME, DeserializePBRSpecGloss);
     extensionDeserializer.AddHandler<Unlit, Material>(UNLIT_NAME, DeserializeUnlit);
     extensionDeserializer.AddHandler<DracoMeshCompression, MeshPrimitive>(DRACOMESHCOMPRESSION_NAME, DeserializeDracoMeshCompression);
+    extensionDeserializer.AddHandler<TextureBasisU, Texture>(TEXTUREBASISU_NAME, DeserializeTextureBasisU);
     extensionDeserializer.AddHandler<TextureTransform, TextureInfo>(TEXTURETRANSFORM_NAME, DeserializeTextureTransform);
     extensionDeserializer.AddHandler<TextureTransform, Material::NormalTextureInfo>(TEXTURETRANSFORM_NAME, DeserializeTextureTransform);
     extensionDeserializer.AddHandler<TextureTransform, Material::OcclusionTextureInfo>(TEXTURETRANSFORM_NAME, DeserializeTextureTransform);
@@ -184,6 +189,14 @@ bool KHR::Materials::PBRSpecularGlossiness::IsEqual(const Extension& rhs) const
         && this->specularGlossinessTexture == other->specularGlossinessTexture;
 }
 
+size_t KHR::Materials::PBRSpecularGlossiness::EstimateMemoryUsage() const
+{
+    return sizeof(PBRSpecularGlossiness)
+        + MemoryUsage::EstimateHeapSize(static_cast<const glTFProperty&>(*this))
+        + MemoryUsage::EstimateHeapSize(diffuseTexture)
+        + MemoryUsage::EstimateHeapSize(specularGlossinessTexture);
+}
+
 std::string KHR::Materials::SerializePBRSpecGloss(const Materials::PBRSpecularGlossiness& specGloss, const Document& gltfDocument, const ExtensionSerializer& extensionSerializer)
 {
     rapidjson::Document doc;
@@ -294,6 +307,11 @@ bool KHR::Materials::Unlit::IsEqual(const Extension& rhs) const
     return dynamic_cast<const Unlit*>(&rhs) != nullptr;
 }
 
+size_t KHR::Materials::Unlit::EstimateMemoryUsage() const
+{
+    return sizeof(Unlit) + MemoryUsage::EstimateHeapSize(static_cast<const glTFProperty&>(*this));
+}
+
 std::string KHR::Materials::SerializeUnlit(const Materials::Unlit& extension, const Document& gltfDocument, const ExtensionSerializer& extensionSerializer)
 {
     rapidjson::Document doc;
@@ -338,6 +356,14 @@ bool KHR::MeshPrimitives::DracoMeshCompression::IsEqual(const Extension& rhs) co
         && this->attributes == other->attributes;
 }
 
+size_t KHR::MeshPrimitives::DracoMeshCompression::EstimateMemoryUsage() const
+{
+    return sizeof(DracoMeshCompression)
+        + MemoryUsage::EstimateHeapSize(static_cast<const glTFProperty&>(*this))
+        + MemoryUsage::EstimateHeapSize(bufferViewId)
+        + MemoryUsage::EstimateHeapSize(attributes);
+}
+
 std::string KHR::MeshPrimitives::SerializeDracoMeshCompression(const MeshPrimitives::DracoMeshCompression& dracoMeshCompression, const Document& glTFdoc, const ExtensionSerializer& extensionSerializer)
 {
     rapidjson::Document doc;
@@ -405,6 +431,64 @@ std::unique_ptr<Extension> KHR::MeshPrimitives::DeserializeDracoMeshCompression(
     return extension;
 }
 
+// KHR::Textures::TextureBasisU
+
+std::unique_ptr<Extension> KHR::Textures::TextureBasisU::Clone() const
+{
+    return std::make_unique<TextureBasisU>(*this);
+}
+
+bool KHR::Textures::TextureBasisU::IsEqual(const Extension& rhs) const
+{
+    const auto other = dynamic_cast<const TextureBasisU*>(&rhs);
+
+    return other != nullptr
+        && glTFProperty::Equals(*this, *other)
+        && this->imageId == other->imageId;
+}
+
+size_t KHR::Textures::TextureBasisU::EstimateMemoryUsage() const
+{
+    return sizeof(TextureBasisU) + MemoryUsage::EstimateHeapSize(static_cast<const glTFProperty&>(*this)) + MemoryUsage::EstimateHeapSize(imageId);
+}
+
+std::string KHR::Textures::SerializeTextureBasisU(const TextureBasisU& textureBasisU, const Document& gltfDocument, const ExtensionSerializer& extensionSerializer)
+{
+    rapidjson::Document doc;
+    auto& a = doc.GetAllocator();
+    rapidjson::Value KHR_texture_basisu(rapidjson::kObjectType);
+    {
+        RapidJsonUtils::AddOptionalMemberIndex("source", KHR_texture_basisu, textureBasisU.imageId, gltfDocument.images, a);
+
+        SerializeProperty(gltfDocument, textureBasisU, KHR_texture_basisu, a, extensionSerializer);
+    }
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    KHR_texture_basisu.Accept(writer);
+
+    return buffer.GetString();
+}
+
+std::unique_ptr<Extension> KHR::Textures::DeserializeTextureBasisU(const std::string& json, const ExtensionDeserializer& extensionDeserializer)
+{
+    auto extension = std::make_unique<TextureBasisU>();
+
+    auto doc = RapidJsonUtils::CreateDocumentFromString(json);
+    const rapidjson::Value v = doc.GetObject();
+
+    auto sourceIt = v.FindMember("source");
+    if (sourceIt == v.MemberEnd() || !sourceIt->value.IsUint())
+    {
+        throw GLTFException("Member source of " + std::string(TEXTUREBASISU_NAME) + " must be an image index.");
+    }
+    extension->imageId = std::to_string(sourceIt->value.GetUint());
+
+    ParseProperty(v, *extension, extensionDeserializer);
+
+    return extension;
+}
+
 // KHR::TextureInfos::TextureTransform
 
 KHR::TextureInfos::TextureTransform::TextureTransform() :
@@ -440,6 +524,11 @@ bool KHR::TextureInfos::TextureTransform::IsEqual(const Extension& rhs) const
         && this->texCoord == other->texCoord;
 }
 
+size_t KHR::TextureInfos::TextureTransform::EstimateMemoryUsage() const
+{
+    return sizeof(TextureTransform) + MemoryUsage::EstimateHeapSize(static_cast<const glTFProperty&>(*this));
+}
+
 std::string KHR::TextureInfos::SerializeTextureTransform(const TextureTransform& textureTransform, const Document& gltfDocument, const ExtensionSerializer& extensionSerializer)
 {
     rapidjson::Document doc;
@@ -0,0 +1,183 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/ExtensionsMOZ.h>
+
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/MemoryUsage.h>
+#include <GLTFSDK/RapidJsonUtils.h>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    void ParseExtensions(const rapidjson::Value& v, glTFProperty& node, const ExtensionDeserializer& extensionDeserializer)
+    {
+        const auto& extensionsIt = v.FindMember("extensions");
+        if (extensionsIt != v.MemberEnd())
+        {
+            const rapidjson::Value& extensionsObject = extensionsIt->value;
+            for (const auto& entry : extensionsObject.GetObject())
+            {
+                ExtensionPair extensionPair = { entry.name.GetString(), Serialize(entry.value) };
+
+                if (extensionDeserializer.HasHandler(extensionPair.name, node) ||
+                    extensionDeserializer.HasHandler(extensionPair.name))
+                {
+                    node.SetExtension(extensionDeserializer.Deserialize(extensionPair, node));
+                }
+                else
+                {
+                    node.extensions.emplace(std::move(extensionPair.name), std::move(extensionPair.value));
+                }
+            }
+        }
+    }
+
+    void ParseExtras(const rapidjson::Value& v, glTFProperty& node)
+    {
+        rapidjson::Value::ConstMemberIterator it;
+        if (TryFindMember("extras", v, it))
+        {
+            const rapidjson::Value& a = it->value;
+            node.extras = Serialize(a);
+        }
+    }
+
+    void ParseProperty(const rapidjson::Value& v, glTFProperty& node, const ExtensionDeserializer& extensionDeserializer)
+    {
+        ParseExtensions(v, node, extensionDeserializer);
+        ParseExtras(v, node);
+    }
+
+    void SerializePropertyExtensions(const Document& gltfDocument, const glTFProperty& property, rapidjson::Value& propertyValue, rapidjson::Document::AllocatorType& a, const ExtensionSerializer& extensionSerializer)
+    {
+        auto registeredExtensions = property.GetExtensions();
+
+        if (!property.extensions.empty() || !registeredExtensions.empty())
+        {
+            rapidjson::Value& extensions = RapidJsonUtils::FindOrAddMember(propertyValue, "extensions", a);
+
+            // Add registered extensions
+            for (const auto& extension : registeredExtensions)
+            {
+                const auto extensionPair = extensionSerializer.Serialize(extension, property, gltfDocument);
+
+                if (property.HasUnregisteredExtension(extensionPair.name))
+                {
+                    throw GLTFException("Registered extension '" + extensionPair.name + "' is also present as an unregistered extension.");
+                }
+
+                if (gltfDocument.extensionsUsed.find(extensionPair.name) == gltfDocument.extensionsUsed.end())
+                {
+                    throw GLTFException("Registered extension '" + extensionPair.name + "' is not present in extensionsUsed");
+                }
+
+                const auto d = RapidJsonUtils::CreateDocumentFromString(extensionPair.value);//TODO: validate the returned document against the extension schema!
+                rapidjson::Value v(rapidjson::kObjectType);
+                v.CopyFrom(d, a);
+                extensions.AddMember(RapidJsonUtils::ToStringValue(extensionPair.name, a), v, a);
+            }
+
+            // Add unregistered extensions
+            for (const auto& extension : property.extensions)
+            {
+                const auto d = RapidJsonUtils::CreateDocumentFromString(extension.second);
+                rapidjson::Value v(rapidjson::kObjectType);
+                v.CopyFrom(d, a);
+                extensions.AddMember(RapidJsonUtils::ToStringValue(extension.first, a), v, a);
+            }
+        }
+    }
+
+    void SerializePropertyExtras(const glTFProperty& property, rapidjson::Value& propertyValue, rapidjson::Document::AllocatorType& a)
+    {
+        if (!property.extras.empty())
+        {
+            auto d = RapidJsonUtils::CreateDocumentFromString(property.extras);
+            rapidjson::Value v(rapidjson::kObjectType);
+            v.CopyFrom(d, a);
+            propertyValue.AddMember("extras", v, a);
+        }
+    }
+
+    void SerializeProperty(const Document& gltfDocument, const glTFProperty& property, rapidjson::Value& propertyValue, rapidjson::Document::AllocatorType& a, const ExtensionSerializer& extensionSerializer)
+    {
+        SerializePropertyExtensions(gltfDocument, property, propertyValue, a, extensionSerializer);
+        SerializePropertyExtras(property, propertyValue, a);
+    }
+}
+
+ExtensionSerializer MOZ::GetMOZExtensionSerializer(ExtensionSerializer extensionSerializer)
+{
+    using namespace Textures;
+
+    extensionSerializer.AddHandler<HubsTextureBasis, Texture>(HUBSTEXTUREBASIS_NAME, SerializeHubsTextureBasis);
+    return extensionSerializer;
+}
+
+ExtensionDeserializer MOZ::GetMOZExtensionDeserializer(ExtensionDeserializer extensionDeserializer)
+{
+    using namespace Textures;
+
+    extensionDeserializer.AddHandler<HubsTextureBasis, Texture>(HUBSTEXTUREBASIS_NAME, DeserializeHubsTextureBasis);
+    return extensionDeserializer;
+}
+
+// MOZ::Textures::HubsTextureBasis
+
+std::unique_ptr<Extension> MOZ::Textures::HubsTextureBasis::Clone() const
+{
+    return std::make_unique<HubsTextureBasis>(*this);
+}
+
+bool MOZ::Textures::HubsTextureBasis::IsEqual(const Extension& rhs) const
+{
+    const auto other = dynamic_cast<const HubsTextureBasis*>(&rhs);
+
+    return other != nullptr
+        && glTFProperty::Equals(*this, *other)
+        && this->imageId == other->imageId;
+}
+
+size_t MOZ::Textures::HubsTextureBasis::EstimateMemoryUsage() const
+{
+    return sizeof(HubsTextureBasis) + MemoryUsage::EstimateHeapSize(static_cast<const glTFProperty&>(*this)) + MemoryUsage::EstimateHeapSize(imageId);
+}
+
+std::string MOZ::Textures::SerializeHubsTextureBasis(const HubsTextureBasis& hubsTextureBasis, const Document& gltfDocument, const ExtensionSerializer& extensionSerializer)
+{
+    rapidjson::Document doc;
+    auto& a = doc.GetAllocator();
+    rapidjson::Value MOZ_HUBS_texture_basis(rapidjson::kObjectType);
+    {
+        RapidJsonUtils::AddOptionalMemberIndex("source", MOZ_HUBS_texture_basis, hubsTextureBasis.imageId, gltfDocument.images, a);
+
+        SerializeProperty(gltfDocument, hubsTextureBasis, MOZ_HUBS_texture_basis, a, extensionSerializer);
+    }
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    MOZ_HUBS_texture_basis.Accept(writer);
+
+    return buffer.GetString();
+}
+
+std::unique_ptr<Extension> MOZ::Textures::DeserializeHubsTextureBasis(const std::string& json, const ExtensionDeserializer& extensionDeserializer)
+{
+    auto extension = std::make_unique<HubsTextureBasis>();
+
+    auto doc = RapidJsonUtils::CreateDocumentFromString(json);
+    const rapidjson::Value v = doc.GetObject();
+
+    auto sourceIt = v.FindMember("source");
+    if (sourceIt == v.MemberEnd() || !sourceIt->value.IsUint())
+    {
+        throw GLTFException("Member source of " + std::string(HUBSTEXTUREBASIS_NAME) + " must be an image index.");
+    }
+    extension->imageId = std::to_string(sourceIt->value.GetUint());
+
+    ParseProperty(v, *extension, extensionDeserializer);
+
+    return extension;
+}
@@ -0,0 +1,202 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/ExtensionsMSFT.h>
+
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/MemoryUsage.h>
+#include <GLTFSDK/RapidJsonUtils.h>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    void ParseExtensions(const rapidjson::Value& v, glTFProperty& node, const ExtensionDeserializer& extensionDeserializer)
+    {
+        const auto& extensionsIt = v.FindMember("extensions");
+        if (extensionsIt != v.MemberEnd())
+        {
+            const rapidjson::Value& extensionsObject = extensionsIt->value;
+            for (const auto& entry : extensionsObject.GetObject())
+            {
+                ExtensionPair extensionPair = { entry.name.GetString(), Serialize(entry.value) };
+
+                if (extensionDeserializer.HasHandler(extensionPair.name, node) ||
+                    extensionDeserializer.HasHandler(extensionPair.name))
+                {
+                    node.SetExtension(extensionDeserializer.Deserialize(extensionPair, node));
+                }
+                else
+                {
+                    node.extensions.emplace(std::move(extensionPair.name), std::move(extensionPair.value));
+                }
+            }
+        }
+    }
+
+    void ParseExtras(const rapidjson::Value& v, glTFProperty& node)
+    {
+        rapidjson::Value::ConstMemberIterator it;
+        if (TryFindMember("extras", v, it))
+        {
+            const rapidjson::Value& a = it->value;
+            node.extras = Serialize(a);
+        }
+    }
+
+    void ParseProperty(const rapidjson::Value& v, glTFProperty& node, const ExtensionDeserializer& extensionDeserializer)
+    {
+        ParseExtensions(v, node, extensionDeserializer);
+        ParseExtras(v, node);
+    }
+
+    void SerializePropertyExtensions(const Document& gltfDocument, const glTFProperty& property, rapidjson::Value& propertyValue, rapidjson::Document::AllocatorType& a, const ExtensionSerializer& extensionSerializer)
+    {
+        auto registeredExtensions = property.GetExtensions();
+
+        if (!property.extensions.empty() || !registeredExtensions.empty())
+        {
+            rapidjson::Value& extensions = RapidJsonUtils::FindOrAddMember(propertyValue, "extensions", a);
+
+            // Add registered extensions
+            for (const auto& extension : registeredExtensions)
+            {
+                const auto extensionPair = extensionSerializer.Serialize(extension, property, gltfDocument);
+
+                if (property.HasUnregisteredExtension(extensionPair.name))
+                {
+                    throw GLTFException("Registered extension '" + extensionPair.name + "' is also present as an unregistered extension.");
+                }
+
+                if (gltfDocument.extensionsUsed.find(extensionPair.name) == gltfDocument.extensionsUsed.end())
+                {
+                    throw GLTFException("Registered extension '" + extensionPair.name + "' is not present in extensionsUsed");
+                }
+
+                const auto d = RapidJsonUtils::CreateDocumentFromString(extensionPair.value);//TODO: validate the returned document against the extension schema!
+                rapidjson::Value v(rapidjson::kObjectType);
+                v.CopyFrom(d, a);
+                extensions.AddMember(RapidJsonUtils::ToStringValue(extensionPair.name, a), v, a);
+            }
+
+            // Add unregistered extensions
+            for (const auto& extension : property.extensions)
+            {
+                const auto d = RapidJsonUtils::CreateDocumentFromString(extension.second);
+                rapidjson::Value v(rapidjson::kObjectType);
+                v.CopyFrom(d, a);
+                extensions.AddMember(RapidJsonUtils::ToStringValue(extension.first, a), v, a);
+            }
+        }
+    }
+
+    void SerializePropertyExtras(const glTFProperty& property, rapidjson::Value& propertyValue, rapidjson::Document::AllocatorType& a)
+    {
+        if (!property.extras.empty())
+        {
+            auto d = RapidJsonUtils::CreateDocumentFromString(property.extras);
+            rapidjson::Value v(rapidjson::kObjectType);
+            v.CopyFrom(d, a);
+            propertyValue.AddMember("extras", v, a);
+        }
+    }
+
+    void SerializeProperty(const Document& gltfDocument, const glTFProperty& property, rapidjson::Value& propertyValue, rapidjson::Document::AllocatorType& a, const ExtensionSerializer& extensionSerializer)
+    {
+        SerializePropertyExtensions(gltfDocument, property, propertyValue, a, extensionSerializer);
+        SerializePropertyExtras(property, propertyValue, a);
+    }
+}
+
+ExtensionSerializer MSFT::GetMSFTExtensionSerializer(ExtensionSerializer extensionSerializer)
+{
+    using namespace Nodes;
+
+    extensionSerializer.AddHandler<Lod, Node>(LOD_NAME, SerializeLod);
+    return extensionSerializer;
+}
+
+ExtensionDeserializer MSFT::GetMSFTExtensionDeserializer(ExtensionDeserializer extensionDeserializer)
+{
+    using namespace Nodes;
+
+    extensionDeserializer.AddHandler<Lod, Node>(LOD_NAME, DeserializeLod);
+    return extensionDeserializer;
+}
+
+// MSFT::Nodes::Lod
+
+std::unique_ptr<Extension> MSFT::Nodes::Lod::Clone() const
+{
+    return std::make_unique<Lod>(*this);
+}
+
+bool MSFT::Nodes::Lod::IsEqual(const Extension& rhs) const
+{
+    const auto other = dynamic_cast<const Lod*>(&rhs);
+
+    return other != nullptr
+        && glTFProperty::Equals(*this, *other)
+        && this->ids == other->ids;
+}
+
+size_t MSFT::Nodes::Lod::EstimateMemoryUsage() const
+{
+    return sizeof(Lod) + MemoryUsage::EstimateHeapSize(static_cast<const glTFProperty&>(*this)) + MemoryUsage::EstimateHeapSize(ids);
+}
+
+std::string MSFT::Nodes::SerializeLod(const Lod& lod, const Document& gltfDocument, const ExtensionSerializer& extensionSerializer)
+{
+    rapidjson::Document doc;
+    auto& a = doc.GetAllocator();
+    rapidjson::Value MSFT_lod(rapidjson::kObjectType);
+    {
+        rapidjson::Value ids(rapidjson::kArrayType);
+
+        for (const auto& id : lod.ids)
+        {
+            ids.PushBack(ToKnownSizeType(gltfDocument.nodes.GetIndex(id)), a);
+        }
+
+        MSFT_lod.AddMember("ids", ids, a);
+
+        SerializeProperty(gltfDocument, lod, MSFT_lod, a, extensionSerializer);
+    }
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    MSFT_lod.Accept(writer);
+
+    return buffer.GetString();
+}
+
+std::unique_ptr<Extension> MSFT::Nodes::DeserializeLod(const std::string& json, const ExtensionDeserializer& extensionDeserializer)
+{
+    auto extension = std::make_unique<Lod>();
+
+    auto doc = RapidJsonUtils::CreateDocumentFromString(json);
+    const rapidjson::Value v = doc.GetObject();
+
+    auto idsIt = v.FindMember("ids");
+    if (idsIt != v.MemberEnd())
+    {
+        if (!idsIt->value.IsArray())
+        {
+            throw GLTFException("Member ids of " + std::string(LOD_NAME) + " is not an array.");
+        }
+
+        for (const auto& id : idsIt->value.GetArray())
+        {
+            if (!id.IsUint())
+            {
+                throw GLTFException("Member ids of " + std::string(LOD_NAME) + " must only contain node indices.");
+            }
+
+            extension->ids.push_back(std::to_string(id.GetUint()));
+        }
+    }
+
+    ParseProperty(v, *extension, extensionDeserializer);
+
+    return extension;
+}
@@ -4,6 +4,7 @@
 #include <GLTFSDK/GLBResourceReader.h>
 
 #include <GLTFSDK/Constants.h>
+#include <GLTFSDK/Tracing.h>
 
 #include <memory>
 #include <string.h>
@@ -94,6 +95,8 @@ const std::string& GLBResourceReader::GetJson() const
 
 void GLBResourceReader::Init()
 {
+    GLTFSDK_TRACE_SPAN("GLBResourceReader::Init");
+
     // Get the length of the stream before reading anything, to validate against later
     // NOTE: The approach used below with seekg to the end and then tellg may be problematic since
     // seekg is not guaranteed to give the number of bytes from the start of the file:
@@ -146,6 +149,7 @@ void GLBResourceReader::Init()
     }
 
     m_json = ReadJson(*m_buffer, jsonChunkLength);
+    GLTFSDK_TRACE_COUNT("BytesRead", jsonChunkLength);
 
     // If length is exactly equal to the json chunk length, plus the header, it means there is no binary buffer chunk
     if (length == (GLB_HEADER_BYTE_SIZE + jsonChunkLength))
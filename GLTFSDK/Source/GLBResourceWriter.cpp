@@ -3,6 +3,8 @@
 
 #include <GLTFSDK/GLBResourceWriter.h>
 
+#include <GLTFSDK/Tracing.h>
+
 #include <sstream>
 
 using namespace Microsoft::glTF;
@@ -43,13 +45,40 @@ GLBResourceWriter::GLBResourceWriter(std::unique_ptr<IStreamWriterCache> streamC
 }
 
 void GLBResourceWriter::Flush(const std::string& manifest, const std::string& uri)
+{
+    GLTFSDK_TRACE_SPAN("GLBResourceWriter::Flush");
+
+    const uint32_t binaryByteLength = static_cast<uint32_t>(GetBufferOffset(GLB_BUFFER_ID));
+    const uint32_t binaryPaddingLength = ::CalculatePadding(binaryByteLength);
+
+    auto stream = m_streamWriterCache->Get(uri);
+
+    WriteGLBHeader(*stream, manifest, binaryByteLength);
+
+    // Write BIN contents (indeterminate length) - copy the temporary buffer's contents to the output stream
+    if (binaryByteLength > 0)
+    {
+        *stream << m_stream->rdbuf();
+    }
+
+    if (binaryPaddingLength > 0)
+    {
+        // GLB spec requires the BIN chunk to be padded with trailing zeros (0x00) to satisfy alignment requirements
+        StreamUtils::WriteBinary(*stream, std::vector<uint8_t>(binaryPaddingLength, 0));
+    }
+
+    // The BIN chunk's contents were already counted as they were written to the temporary buffer stream
+    GLTFSDK_TRACE_COUNT("BytesWritten", binaryPaddingLength);
+}
+
+uint32_t Microsoft::glTF::WriteGLBHeader(std::ostream& stream, const std::string& manifest, size_t binaryByteLength)
 {
     uint32_t jsonChunkLength = static_cast<uint32_t>(manifest.length());
     const uint32_t jsonPaddingLength = ::CalculatePadding(jsonChunkLength);
 
     jsonChunkLength += jsonPaddingLength;
 
-    uint32_t binaryChunkLength = static_cast<uint32_t>(GetBufferOffset(GLB_BUFFER_ID));
+    uint32_t binaryChunkLength = static_cast<uint32_t>(binaryByteLength);
     const uint32_t binaryPaddingLength = ::CalculatePadding(binaryChunkLength);
 
     binaryChunkLength += binaryPaddingLength;
@@ -59,41 +88,31 @@ void GLBResourceWriter::Flush(const std::string& manifest, const std::string& ur
         + sizeof(binaryChunkLength) + GLB_CHUNK_TYPE_SIZE // 8 bytes (BIN header)
         + binaryChunkLength;
 
-    auto stream = m_streamWriterCache->Get(uri);
-
     // Write GLB header (12 bytes)
-    StreamUtils::WriteBinary(*stream, GLB_HEADER_MAGIC_STRING, GLB_HEADER_MAGIC_STRING_SIZE);
-    StreamUtils::WriteBinary(*stream, GLB_HEADER_VERSION_2);
-    StreamUtils::WriteBinary(*stream, length);
+    StreamUtils::WriteBinary(stream, GLB_HEADER_MAGIC_STRING, GLB_HEADER_MAGIC_STRING_SIZE);
+    StreamUtils::WriteBinary(stream, GLB_HEADER_VERSION_2);
+    StreamUtils::WriteBinary(stream, length);
 
     // Write JSON header (8 bytes)
-    StreamUtils::WriteBinary(*stream, jsonChunkLength);
-    StreamUtils::WriteBinary(*stream, GLB_CHUNK_TYPE_JSON, GLB_CHUNK_TYPE_SIZE);
+    StreamUtils::WriteBinary(stream, jsonChunkLength);
+    StreamUtils::WriteBinary(stream, GLB_CHUNK_TYPE_JSON, GLB_CHUNK_TYPE_SIZE);
 
     // Write JSON (indeterminate length)
-    StreamUtils::WriteBinary(*stream, manifest);
+    StreamUtils::WriteBinary(stream, manifest);
 
     if (jsonPaddingLength > 0)
     {
         // GLB spec requires the JSON chunk to be padded with trailing space characters (0x20) to satisfy alignment requirements
-        StreamUtils::WriteBinary(*stream, std::string(jsonPaddingLength, ' '));
+        StreamUtils::WriteBinary(stream, std::string(jsonPaddingLength, ' '));
     }
 
     // Write BIN header (8 bytes)
-    StreamUtils::WriteBinary(*stream, binaryChunkLength);
-    StreamUtils::WriteBinary(*stream, GLB_CHUNK_TYPE_BIN, GLB_CHUNK_TYPE_SIZE);
+    StreamUtils::WriteBinary(stream, binaryChunkLength);
+    StreamUtils::WriteBinary(stream, GLB_CHUNK_TYPE_BIN, GLB_CHUNK_TYPE_SIZE);
 
-    // Write BIN contents (indeterminate length) - copy the temporary buffer's contents to the output stream
-    if (binaryChunkLength > 0)
-    {
-        *stream << m_stream->rdbuf();
-    }
+    GLTFSDK_TRACE_COUNT("BytesWritten", length - binaryChunkLength);
 
-    if (binaryPaddingLength > 0)
-    {
-        // GLB spec requires the BIN chunk to be padded with trailing zeros (0x00) to satisfy alignment requirements
-        StreamUtils::WriteBinary(*stream, std::vector<uint8_t>(binaryPaddingLength, 0));
-    }
+    return length;
 }
 
 std::string GLBResourceWriter::GenerateBufferUri(const std::string& bufferId) const
@@ -0,0 +1,961 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/GLBRewriter.h>
+
+#include <GLTFSDK/GLBResourceWriter.h>
+#include <GLTFSDK/StreamCacheLRU.h>
+#include <GLTFSDK/StreamUtils.h>
+#include <GLTFSDK/Validation.h>
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#include <string.h>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/falloc.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    // Size of the scratch buffer used when unchanged ranges of the source GLB can't be copied by the kernel
+    const size_t CopyBufferSize = 1024U * 1024U;
+
+    // When a file's BIN chunk is moved by copying it in pieces, the distance it moves is rounded up so that it takes at
+    // most about this many pieces (the kernel can't copy between overlapping ranges of a file, so no piece can be longer
+    // than the distance). This pads the JSON chunk by up to 1/MaxMovePieceCount of the BIN chunk's length.
+    const size_t MaxMovePieceCount = 1024U;
+
+    size_t CalculatePadding(size_t byteLength)
+    {
+        const size_t alignmentSize = GLB_CHUNK_ALIGNMENT_SIZE;
+
+        const auto padAlign = byteLength % alignmentSize;
+        const auto pad = padAlign ? alignmentSize - padAlign : 0U;
+
+        return pad;
+    }
+
+    bool IsGLBBuffer(const Buffer& buffer)
+    {
+        // We allow "uri": "data:," to refer to a GLB buffer
+        return buffer.uri.empty() || buffer.uri == EMPTY_URI;
+    }
+
+    // A contiguous range of the source binary chunk referenced by one or more (overlapping) buffer views
+    struct Span
+    {
+        size_t byteOffset;
+        size_t byteLength;
+        std::vector<size_t> bufferViewIndices;
+    };
+
+    // The indices of the buffer views stored in the buffer, in order of their offset
+    std::vector<size_t> GetBufferViewOrder(const Document& document, const Buffer& buffer)
+    {
+        std::vector<size_t> bufferViewIndices;
+        bufferViewIndices.reserve(document.bufferViews.Size());
+
+        for (size_t i = 0; i < document.bufferViews.Size(); i++)
+        {
+            if (document.bufferViews[i].bufferId == buffer.id)
+            {
+                bufferViewIndices.push_back(i);
+            }
+        }
+
+        std::sort(bufferViewIndices.begin(), bufferViewIndices.end(), [&document](size_t lhs, size_t rhs)
+        {
+            return document.bufferViews[lhs].byteOffset < document.bufferViews[rhs].byteOffset;
+        });
+
+        return bufferViewIndices;
+    }
+
+    // Checks that an order supplied by the caller lists each of the buffer's buffer views once, in order of their offset
+    void ValidateBufferViewOrder(const Document& document, const Buffer& buffer, const std::vector<size_t>& bufferViewOrder)
+    {
+        std::vector<bool> isListed(document.bufferViews.Size(), false);
+
+        for (size_t i = 0; i < bufferViewOrder.size(); i++)
+        {
+            const auto index = bufferViewOrder[i];
+
+            if (index >= document.bufferViews.Size() || isListed[index] || document.bufferViews[index].bufferId != buffer.id)
+            {
+                throw GLTFException("The buffer view order must list each of the GLB buffer's buffer views once");
+            }
+
+            if (i > 0 && document.bufferViews[index].byteOffset < document.bufferViews[bufferViewOrder[i - 1]].byteOffset)
+            {
+                throw GLTFException("The buffer view order must be sorted by offset");
+            }
+
+            isListed[index] = true;
+        }
+
+        for (size_t i = 0; i < document.bufferViews.Size(); i++)
+        {
+            if (!isListed[i] && document.bufferViews[i].bufferId == buffer.id)
+            {
+                throw GLTFException("The buffer view order must list each of the GLB buffer's buffer views once");
+            }
+        }
+    }
+
+    std::vector<Span> GetSpans(const Document& document, const Buffer& buffer, const std::vector<size_t>& bufferViewOrder, const std::unordered_set<std::string>& removedBufferViews)
+    {
+        std::vector<Span> spans;
+
+        for (auto index : bufferViewOrder)
+        {
+            const auto& bufferView = document.bufferViews[index];
+
+            if (removedBufferViews.find(bufferView.id) != removedBufferViews.end())
+            {
+                continue;
+            }
+
+            Validation::ValidateBufferView(bufferView, buffer);
+
+            if (!spans.empty() && bufferView.byteOffset < spans.back().byteOffset + spans.back().byteLength)
+            {
+                auto& span = spans.back();
+
+                span.byteLength = std::max(span.byteLength, bufferView.byteOffset + bufferView.byteLength - span.byteOffset);
+                span.bufferViewIndices.push_back(index);
+            }
+            else
+            {
+                spans.push_back({ bufferView.byteOffset, bufferView.byteLength, { index } });
+            }
+        }
+
+        return spans;
+    }
+
+    bool IsBufferViewReferenced(const Document& document, const std::string& bufferViewId)
+    {
+        for (const auto& accessor : document.accessors.Elements())
+        {
+            if (accessor.bufferViewId == bufferViewId
+                || accessor.sparse.indicesBufferViewId == bufferViewId
+                || accessor.sparse.valuesBufferViewId == bufferViewId)
+            {
+                return true;
+            }
+        }
+
+        for (const auto& image : document.images.Elements())
+        {
+            if (image.bufferViewId == bufferViewId)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void CopyRange(std::istream& source, std::streamoff sourceOffset, std::ostream& destination, size_t byteLength, std::vector<char>& copyBuffer)
+    {
+        if (copyBuffer.size() < std::min(CopyBufferSize, byteLength))
+        {
+            copyBuffer.resize(std::min(CopyBufferSize, byteLength));
+        }
+
+        source.seekg(sourceOffset);
+
+        for (size_t bytesCopied = 0U; bytesCopied < byteLength;)
+        {
+            const size_t byteCount = std::min(copyBuffer.size(), byteLength - bytesCopied);
+
+            StreamUtils::ReadBinary(source, copyBuffer.data(), byteCount);
+            StreamUtils::WriteBinary(destination, copyBuffer.data(), byteCount);
+
+            bytesCopied += byteCount;
+        }
+    }
+
+#if defined(__linux__)
+    class FileDescriptor
+    {
+    public:
+        FileDescriptor(const std::string& path, int flags) : m_fd(open(path.c_str(), flags | O_CLOEXEC, 0666))
+        {
+            if (m_fd < 0)
+            {
+                throw GLTFException("Unable to open " + path + ": " + strerror(errno));
+            }
+        }
+
+        ~FileDescriptor()
+        {
+            close(m_fd);
+        }
+
+        FileDescriptor(const FileDescriptor&) = delete;
+        FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+        int Get() const
+        {
+            return m_fd;
+        }
+
+    private:
+        int m_fd;
+    };
+
+    bool IsSameFile(int lhs, int rhs)
+    {
+        struct stat lhsStat;
+        struct stat rhsStat;
+
+        return fstat(lhs, &lhsStat) == 0 && fstat(rhs, &rhsStat) == 0 && lhsStat.st_dev == rhsStat.st_dev && lhsStat.st_ino == rhsStat.st_ino;
+    }
+
+    // Errors returned by copy_file_range and sendfile when the kernel or the file system can't copy between the files
+    bool IsCopyUnsupported(int error)
+    {
+        return error == ENOSYS || error == EXDEV || error == EINVAL || error == EOPNOTSUPP;
+    }
+
+    void WriteAll(int fd, const char* data, size_t byteLength)
+    {
+        while (byteLength > 0U)
+        {
+            const ssize_t byteCount = write(fd, data, byteLength);
+
+            if (byteCount < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                throw GLTFException(std::string("Unable to write the GLB: ") + strerror(errno));
+            }
+
+            data += byteCount;
+            byteLength -= static_cast<size_t>(byteCount);
+        }
+    }
+
+    // Copies byteLength bytes starting at sourceOffset in one file to the current position of another. The data is
+    // copied by the kernel with copy_file_range (which can share extents on file systems that support reflinks) or,
+    // where that isn't supported (e.g. between file systems before Linux 5.3), sendfile. Only if neither is supported
+    // is it copied through copyBuffer.
+    void CopyRange(int sourceFd, off_t sourceOffset, int destinationFd, size_t byteLength, std::vector<char>& copyBuffer)
+    {
+        bool useCopyFileRange = true;
+        bool useSendFile = true;
+
+        while (byteLength > 0U)
+        {
+            ssize_t byteCount;
+
+            if (useCopyFileRange)
+            {
+                byteCount = copy_file_range(sourceFd, &sourceOffset, destinationFd, nullptr, byteLength, 0U);
+
+                if (byteCount < 0 && IsCopyUnsupported(errno))
+                {
+                    useCopyFileRange = false;
+                    continue;
+                }
+            }
+            else if (useSendFile)
+            {
+                byteCount = sendfile(destinationFd, sourceFd, &sourceOffset, byteLength);
+
+                if (byteCount < 0 && IsCopyUnsupported(errno))
+                {
+                    useSendFile = false;
+                    continue;
+                }
+            }
+            else
+            {
+                if (copyBuffer.size() < std::min(CopyBufferSize, byteLength))
+                {
+                    copyBuffer.resize(std::min(CopyBufferSize, byteLength));
+                }
+
+                byteCount = pread(sourceFd, copyBuffer.data(), std::min(copyBuffer.size(), byteLength), sourceOffset);
+
+                if (byteCount > 0)
+                {
+                    WriteAll(destinationFd, copyBuffer.data(), static_cast<size_t>(byteCount));
+                    sourceOffset += byteCount;
+                }
+            }
+
+            if (byteCount < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                throw GLTFException(std::string("Unable to copy from the source GLB: ") + strerror(errno));
+            }
+
+            if (byteCount == 0)
+            {
+                throw GLTFException("Unexpected end of the source GLB");
+            }
+
+            byteLength -= static_cast<size_t>(byteCount);
+        }
+    }
+#endif
+
+    struct GLBHeader
+    {
+        uint32_t length;
+        uint32_t jsonChunkLength;
+    };
+
+    // Reads the GLB header and JSON chunk header
+    GLBHeader ReadGLBHeader(std::istream& stream)
+    {
+        char magic[GLB_HEADER_MAGIC_STRING_SIZE];
+        StreamUtils::ReadBinary(stream, magic, sizeof(magic));
+
+        if (strncmp(magic, GLB_HEADER_MAGIC_STRING, GLB_HEADER_MAGIC_STRING_SIZE) != 0)
+        {
+            throw InvalidGLTFException("Cannot find GLB magic bytes");
+        }
+
+        const uint32_t version = StreamUtils::ReadBinary<uint32_t>(stream);
+
+        if (version != GLB_HEADER_VERSION_2)
+        {
+            throw InvalidGLTFException("Unsupported GLB Version: " + std::to_string(version));
+        }
+
+        GLBHeader header;
+        header.length = StreamUtils::ReadBinary<uint32_t>(stream);
+        header.jsonChunkLength = StreamUtils::ReadBinary<uint32_t>(stream);
+
+        char chunkType[GLB_CHUNK_TYPE_SIZE];
+        StreamUtils::ReadBinary(stream, chunkType, sizeof(chunkType));
+
+        if (memcmp(chunkType, GLB_CHUNK_TYPE_JSON, GLB_CHUNK_TYPE_SIZE) != 0)
+        {
+            throw InvalidGLTFException("JSON chunk should appear first");
+        }
+
+        if (header.length < (GLB_HEADER_BYTE_SIZE + header.jsonChunkLength))
+        {
+            throw InvalidGLTFException("File length " + std::to_string(header.length) + " less than content length " + std::to_string(header.jsonChunkLength) +
+                " plus header length " + std::to_string(GLB_HEADER_BYTE_SIZE));
+        }
+
+        return header;
+    }
+
+    // Writes the GLB's length, followed by a JSON chunk of jsonChunkLength bytes that holds the manifest
+    void WriteManifest(std::ostream& stream, size_t length, const std::string& manifest, size_t jsonChunkLength)
+    {
+        StreamUtils::WriteBinary(stream, static_cast<uint32_t>(length));
+        StreamUtils::WriteBinary(stream, static_cast<uint32_t>(jsonChunkLength));
+        StreamUtils::WriteBinary(stream, GLB_CHUNK_TYPE_JSON, GLB_CHUNK_TYPE_SIZE);
+        StreamUtils::WriteBinary(stream, manifest);
+
+        if (jsonChunkLength > manifest.length())
+        {
+            // GLB spec requires the JSON chunk to be padded with trailing space characters (0x20) to satisfy alignment requirements
+            StreamUtils::WriteBinary(stream, std::string(jsonChunkLength - manifest.length(), ' '));
+        }
+    }
+
+#if defined(__linux__)
+    void ReadAll(int fd, char* data, size_t byteLength, off_t offset)
+    {
+        while (byteLength > 0U)
+        {
+            const ssize_t byteCount = pread(fd, data, byteLength, offset);
+
+            if (byteCount < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (byteCount <= 0)
+            {
+                throw GLTFException("Unable to read the GLB");
+            }
+
+            data += byteCount;
+            offset += byteCount;
+            byteLength -= static_cast<size_t>(byteCount);
+        }
+    }
+
+    void WriteAll(int fd, const char* data, size_t byteLength, off_t offset)
+    {
+        while (byteLength > 0U)
+        {
+            const ssize_t byteCount = pwrite(fd, data, byteLength, offset);
+
+            if (byteCount < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                throw GLTFException(std::string("Unable to write the GLB: ") + strerror(errno));
+            }
+
+            data += byteCount;
+            offset += byteCount;
+            byteLength -= static_cast<size_t>(byteCount);
+        }
+    }
+
+    // Moves byteLength bytes of a file from srcOffset to dstOffset, where dstOffset is greater than srcOffset by at
+    // least pieceLength, in pieces that are copied by the kernel with copy_file_range. Only if that isn't supported are
+    // they copied through a buffer in this process.
+    void MoveRangeForward(int fd, off_t srcOffset, off_t dstOffset, size_t byteLength, size_t pieceLength)
+    {
+        bool useCopyFileRange = true;
+        std::vector<char> copyBuffer;
+
+        for (size_t bytesRemaining = byteLength; bytesRemaining > 0U;)
+        {
+            const size_t byteCount = std::min(pieceLength, bytesRemaining);
+
+            bytesRemaining -= byteCount;
+
+            off_t srcPieceOffset = srcOffset + static_cast<off_t>(bytesRemaining);
+            off_t dstPieceOffset = dstOffset + static_cast<off_t>(bytesRemaining);
+
+            for (size_t pieceRemaining = byteCount; useCopyFileRange && pieceRemaining > 0U;)
+            {
+                const ssize_t bytesCopied = copy_file_range(fd, &srcPieceOffset, fd, &dstPieceOffset, pieceRemaining, 0U);
+
+                if (bytesCopied < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    if (!IsCopyUnsupported(errno))
+                    {
+                        throw GLTFException(std::string("Unable to move the BIN chunk: ") + strerror(errno));
+                    }
+
+                    useCopyFileRange = false;
+                }
+                else if (bytesCopied == 0)
+                {
+                    throw GLTFException("Unexpected end of the GLB");
+                }
+                else
+                {
+                    pieceRemaining -= static_cast<size_t>(bytesCopied);
+                }
+            }
+
+            if (!useCopyFileRange)
+            {
+                // Copy whatever copy_file_range didn't, as the offsets were advanced past any bytes it did copy
+                size_t pieceRemaining = byteCount - static_cast<size_t>(srcPieceOffset - (srcOffset + static_cast<off_t>(bytesRemaining)));
+
+                copyBuffer.resize(std::min(CopyBufferSize, pieceRemaining));
+
+                while (pieceRemaining > 0U)
+                {
+                    const size_t bufferByteCount = std::min(copyBuffer.size(), pieceRemaining);
+
+                    pieceRemaining -= bufferByteCount;
+
+                    ReadAll(fd, copyBuffer.data(), bufferByteCount, srcPieceOffset + static_cast<off_t>(pieceRemaining));
+                    WriteAll(fd, copyBuffer.data(), bufferByteCount, dstPieceOffset + static_cast<off_t>(pieceRemaining));
+                }
+            }
+        }
+    }
+
+    // Makes room for 'byteLength' more bytes at 'offset' in a file by inserting a range with fallocate, which moves no
+    // data but is only supported by some file systems (e.g. ext4 and XFS) and needs both to be multiples of the file
+    // system's block size. Returns false if the range couldn't be inserted.
+    bool InsertRange(int fd, off_t offset, size_t byteLength)
+    {
+#if defined(FALLOC_FL_INSERT_RANGE)
+        while (fallocate(fd, FALLOC_FL_INSERT_RANGE, offset, static_cast<off_t>(byteLength)) != 0)
+        {
+            if (errno != EINTR)
+            {
+                return false;
+            }
+        }
+
+        return true;
+#else
+        static_cast<void>(fd);
+        static_cast<void>(offset);
+        static_cast<void>(byteLength);
+
+        return false;
+#endif
+    }
+#endif
+
+    // Copies byteLength bytes starting at srcOffset to dstOffset, where dstOffset is greater than
+    // srcOffset. The range is copied starting from its end so overlapping ranges are handled correctly.
+    void MoveRangeForward(std::iostream& stream, size_t srcOffset, size_t dstOffset, size_t byteLength)
+    {
+        std::vector<char> copyBuffer(std::min(CopyBufferSize, byteLength));
+
+        for (size_t bytesRemaining = byteLength; bytesRemaining > 0U;)
+        {
+            const size_t byteCount = std::min(copyBuffer.size(), bytesRemaining);
+
+            bytesRemaining -= byteCount;
+
+            stream.seekg(srcOffset + bytesRemaining);
+            StreamUtils::ReadBinary(stream, copyBuffer.data(), byteCount);
+
+            stream.seekp(dstOffset + bytesRemaining);
+            StreamUtils::WriteBinary(stream, copyBuffer.data(), byteCount);
+        }
+    }
+}
+
+GLBRewriter::GLBRewriter(std::shared_ptr<const GLBResourceReader> glbReader, std::shared_ptr<const IStreamWriter> streamWriter)
+    : GLBRewriter(std::move(glbReader), MakeStreamWriterCache<StreamWriterCacheLRU>(std::move(streamWriter), 16U))
+{
+}
+
+GLBRewriter::GLBRewriter(std::shared_ptr<const GLBResourceReader> glbReader, std::unique_ptr<IStreamWriterCache> streamCache)
+    : m_glbReader(std::move(glbReader)),
+    m_streamWriterCache(std::move(streamCache)),
+    m_bufferViewData(),
+    m_removedBufferViews(),
+    m_sourceStream(),
+    m_sourceStreamPos(),
+    m_segments(),
+    m_binaryChunkLength(0U),
+    m_isUpdated(false)
+{
+    if (!m_glbReader)
+    {
+        throw GLTFException("A GLBResourceReader must be specified");
+    }
+}
+
+void GLBRewriter::SetBufferViewData(const std::string& bufferViewId, std::vector<uint8_t> data)
+{
+    if (m_isUpdated)
+    {
+        throw GLTFException("Buffer view data cannot be set once the document has been updated");
+    }
+
+    if (data.empty())
+    {
+        throw InvalidGLTFException("Replacement data for buffer view " + bufferViewId + " must not be empty");
+    }
+
+    m_bufferViewData[bufferViewId] = std::move(data);
+}
+
+bool GLBRewriter::HasBufferViewData(const std::string& bufferViewId) const
+{
+    return m_bufferViewData.find(bufferViewId) != m_bufferViewData.end();
+}
+
+void GLBRewriter::RemoveBufferView(const std::string& bufferViewId)
+{
+    if (m_isUpdated)
+    {
+        throw GLTFException("Buffer views cannot be removed once the document has been updated");
+    }
+
+    m_removedBufferViews.insert(bufferViewId);
+}
+
+void GLBRewriter::Update(Document& document)
+{
+    UpdateLayout(document, nullptr);
+}
+
+void GLBRewriter::Update(Document& document, const std::vector<size_t>& bufferViewOrder)
+{
+    UpdateLayout(document, &bufferViewOrder);
+}
+
+void GLBRewriter::UpdateLayout(Document& document, const std::vector<size_t>* bufferViewOrder)
+{
+    if (m_isUpdated)
+    {
+        throw GLTFException("The document has already been updated");
+    }
+
+    auto itBuffer = std::find_if(document.buffers.Elements().begin(), document.buffers.Elements().end(), IsGLBBuffer);
+
+    if (itBuffer == document.buffers.Elements().end())
+    {
+        throw GLTFException("The document doesn't contain a GLB buffer");
+    }
+
+    for (const auto& bufferViewData : m_bufferViewData)
+    {
+        if (document.bufferViews.Get(bufferViewData.first).bufferId != itBuffer->id)
+        {
+            throw GLTFException("Buffer view " + bufferViewData.first + " is not stored in the GLB buffer");
+        }
+
+        if (m_removedBufferViews.find(bufferViewData.first) != m_removedBufferViews.end())
+        {
+            throw GLTFException("Buffer view " + bufferViewData.first + " cannot be both replaced and removed");
+        }
+    }
+
+    for (const auto& bufferViewId : m_removedBufferViews)
+    {
+        if (document.bufferViews.Get(bufferViewId).bufferId != itBuffer->id)
+        {
+            throw GLTFException("Buffer view " + bufferViewId + " is not stored in the GLB buffer");
+        }
+
+        if (IsBufferViewReferenced(document, bufferViewId))
+        {
+            throw GLTFException("Buffer view " + bufferViewId + " cannot be removed as it is still referenced");
+        }
+    }
+
+    Buffer buffer = *itBuffer;
+
+    m_sourceStream = m_glbReader->GetBinaryStream(buffer);
+    m_sourceStreamPos = m_glbReader->GetBinaryStreamPos(buffer);
+
+    if (bufferViewOrder)
+    {
+        ValidateBufferViewOrder(document, buffer, *bufferViewOrder);
+    }
+
+    const auto spans = GetSpans(document, buffer, bufferViewOrder ? *bufferViewOrder : GetBufferViewOrder(document, buffer), m_removedBufferViews);
+
+    size_t offset = 0U;
+
+    for (const auto& span : spans)
+    {
+        const std::vector<uint8_t>* data = nullptr;
+
+        if (span.bufferViewIndices.size() == 1U)
+        {
+            auto it = m_bufferViewData.find(document.bufferViews[span.bufferViewIndices.front()].id);
+
+            if (it != m_bufferViewData.end())
+            {
+                data = &(it->second);
+            }
+        }
+        else
+        {
+            for (auto index : span.bufferViewIndices)
+            {
+                if (HasBufferViewData(document.bufferViews[index].id))
+                {
+                    throw GLTFException("Buffer view " + document.bufferViews[index].id + " overlaps other buffer views and cannot be replaced");
+                }
+            }
+        }
+
+        const size_t padding = (offset % GLB_BUFFER_OFFSET_ALIGNMENT) ? GLB_BUFFER_OFFSET_ALIGNMENT - (offset % GLB_BUFFER_OFFSET_ALIGNMENT) : 0U;
+        const size_t spanOffset = offset + padding;
+        const size_t spanLength = data ? data->size() : span.byteLength;
+
+        AddSegment(padding, spanLength, span.byteOffset, data);
+
+        for (auto index : span.bufferViewIndices)
+        {
+            BufferView bufferView = document.bufferViews[index];
+
+            bufferView.byteOffset = spanOffset + (bufferView.byteOffset - span.byteOffset);
+
+            if (data)
+            {
+                bufferView.byteLength = data->size();
+            }
+
+            document.bufferViews.Replace(std::move(bufferView));
+        }
+
+        offset = spanOffset + spanLength;
+    }
+
+    for (const auto& bufferViewId : m_removedBufferViews)
+    {
+        document.bufferViews.Remove(bufferViewId);
+    }
+
+    buffer.byteLength = offset;
+    document.buffers.Replace(std::move(buffer));
+
+    m_binaryChunkLength = offset;
+    m_isUpdated = true;
+}
+
+void GLBRewriter::Flush(const std::string& manifest, const std::string& uri)
+{
+    if (!m_isUpdated)
+    {
+        throw GLTFException("Update must be called before the GLB can be flushed");
+    }
+
+    WriteGLB(*m_streamWriterCache->Get(uri), manifest);
+}
+
+void GLBRewriter::FlushToFile(const std::string& manifest, const std::string& sourcePath, const std::string& path)
+{
+    if (!m_isUpdated)
+    {
+        throw GLTFException("Update must be called before the GLB can be flushed");
+    }
+
+#if defined(__linux__)
+    FileDescriptor source(sourcePath, O_RDONLY);
+    FileDescriptor destination(path, O_WRONLY | O_CREAT);
+
+    // Check before truncating the destination, which would otherwise destroy the data still to be copied
+    if (IsSameFile(source.Get(), destination.Get()))
+    {
+        throw GLTFException("A GLB cannot be rewritten over its source file");
+    }
+
+    if (ftruncate(destination.Get(), 0) != 0)
+    {
+        throw GLTFException("Unable to truncate " + path + ": " + strerror(errno));
+    }
+
+    std::ostringstream header;
+    WriteGLBHeader(header, manifest, m_binaryChunkLength);
+
+    const std::string headerData = header.str();
+    WriteAll(destination.Get(), headerData.data(), headerData.size());
+
+    std::vector<char> copyBuffer;
+
+    WriteBinaryChunk([&destination](const char* data, size_t byteLength)
+    {
+        WriteAll(destination.Get(), data, byteLength);
+    }, [&](std::streamoff sourceOffset, size_t byteLength)
+    {
+        CopyRange(source.Get(), static_cast<off_t>(sourceOffset), destination.Get(), byteLength, copyBuffer);
+    });
+#else
+    static_cast<void>(sourcePath);
+
+    std::ofstream stream(path, std::ios_base::binary | std::ios_base::trunc);
+
+    if (!stream)
+    {
+        throw GLTFException("Unable to open " + path);
+    }
+
+    WriteGLB(stream, manifest);
+#endif
+}
+
+void GLBRewriter::WriteGLB(std::ostream& stream, const std::string& manifest) const
+{
+    WriteGLBHeader(stream, manifest, m_binaryChunkLength);
+
+    // Replaced buffer views are written from memory, everything else is copied from the source GLB
+    std::vector<char> copyBuffer;
+
+    WriteBinaryChunk([&stream](const char* data, size_t byteLength)
+    {
+        StreamUtils::WriteBinary(stream, data, byteLength);
+    }, [&](std::streamoff sourceOffset, size_t byteLength)
+    {
+        CopyRange(*m_sourceStream, sourceOffset, stream, byteLength, copyBuffer);
+    });
+}
+
+void GLBRewriter::WriteBinaryChunk(const std::function<void(const char*, size_t)>& fnWrite, const std::function<void(std::streamoff, size_t)>& fnCopy) const
+{
+    const char padding[GLB_BUFFER_OFFSET_ALIGNMENT] = {};
+
+    for (const auto& segment : m_segments)
+    {
+        if (segment.padding > 0)
+        {
+            fnWrite(padding, segment.padding);
+        }
+
+        if (segment.data)
+        {
+            fnWrite(reinterpret_cast<const char*>(segment.data->data()), segment.data->size());
+        }
+        else
+        {
+            fnCopy(static_cast<std::streamoff>(m_sourceStreamPos) + static_cast<std::streamoff>(segment.sourceOffset), segment.byteLength);
+        }
+    }
+
+    const size_t binaryPaddingLength = ::CalculatePadding(m_binaryChunkLength);
+
+    if (binaryPaddingLength > 0)
+    {
+        // GLB spec requires the BIN chunk to be padded with trailing zeros (0x00) to satisfy alignment requirements
+        fnWrite(padding, binaryPaddingLength);
+    }
+}
+
+void GLBRewriter::AddSegment(size_t padding, size_t byteLength, size_t sourceOffset, const std::vector<uint8_t>* data)
+{
+    if (!data && !m_segments.empty())
+    {
+        auto& segment = m_segments.back();
+
+        // If the padding needed before this range is the same size as the gap that precedes it in the
+        // source GLB then extend the previous copy so both ranges are read and written in one pass
+        if (!segment.data && (segment.sourceOffset + segment.byteLength + padding == sourceOffset))
+        {
+            segment.byteLength += padding + byteLength;
+            return;
+        }
+    }
+
+    m_segments.push_back({ padding, byteLength, sourceOffset, data });
+}
+
+bool Microsoft::glTF::RewriteGLBManifest(std::iostream& glbStream, const std::string& manifest)
+{
+    glbStream.seekg(0);
+
+    const auto header = ReadGLBHeader(glbStream);
+
+    size_t newJsonChunkLength = manifest.length() + ::CalculatePadding(manifest.length());
+    size_t newLength = header.length;
+
+    const bool isInPlace = (newJsonChunkLength <= header.jsonChunkLength);
+
+    if (isInPlace)
+    {
+        // Keep the existing chunk length and pad the remainder of the chunk with spaces
+        newJsonChunkLength = header.jsonChunkLength;
+    }
+    else
+    {
+        const size_t binaryChunkOffset = GLB_HEADER_BYTE_SIZE + header.jsonChunkLength;
+        const size_t binaryChunkLength = header.length - binaryChunkOffset; // Includes the BIN chunk header
+
+        newLength = GLB_HEADER_BYTE_SIZE + newJsonChunkLength + binaryChunkLength;
+
+        if (newLength > std::numeric_limits<uint32_t>::max())
+        {
+            throw GLTFException("The rewritten GLB would exceed the maximum GLB length");
+        }
+
+        // Grow the stream first - not every stream type supports seeking past its end before writing
+        glbStream.seekp(header.length);
+        StreamUtils::WriteBinary(glbStream, std::string(newLength - header.length, '\0'));
+
+        MoveRangeForward(glbStream, binaryChunkOffset, GLB_HEADER_BYTE_SIZE + newJsonChunkLength, binaryChunkLength);
+    }
+
+    glbStream.seekp(GLB_HEADER_MAGIC_STRING_SIZE + sizeof(uint32_t));
+    WriteManifest(glbStream, newLength, manifest, newJsonChunkLength);
+
+    glbStream.flush();
+
+    return isInPlace;
+}
+
+bool Microsoft::glTF::RewriteGLBManifest(const std::string& path, const std::string& manifest)
+{
+#if defined(__linux__)
+    FileDescriptor file(path, O_RDWR);
+
+    char headerData[GLB_HEADER_BYTE_SIZE];
+    ReadAll(file.Get(), headerData, sizeof(headerData), 0);
+
+    std::istringstream headerStream(std::string(headerData, sizeof(headerData)));
+    const auto header = ReadGLBHeader(headerStream);
+
+    size_t newJsonChunkLength = manifest.length() + ::CalculatePadding(manifest.length());
+    size_t newLength = header.length;
+
+    const bool isInPlace = (newJsonChunkLength <= header.jsonChunkLength);
+
+    if (isInPlace)
+    {
+        newJsonChunkLength = header.jsonChunkLength;
+    }
+    else
+    {
+        const size_t binaryChunkOffset = GLB_HEADER_BYTE_SIZE + header.jsonChunkLength;
+        const size_t binaryChunkLength = header.length - binaryChunkOffset; // Includes the BIN chunk header
+
+        struct stat fileStat;
+
+        if (fstat(file.Get(), &fileStat) != 0)
+        {
+            throw GLTFException("Unable to query " + path + ": " + strerror(errno));
+        }
+
+        // The BIN chunk moves by a whole number of blocks, which keeps its chunks aligned, and the JSON chunk takes up
+        // the extra space with trailing spaces
+        const size_t blockSize = std::max<size_t>(static_cast<size_t>(fileStat.st_blksize), GLB_CHUNK_ALIGNMENT_SIZE);
+        const size_t minShift = std::max(newJsonChunkLength - header.jsonChunkLength, binaryChunkLength / MaxMovePieceCount);
+        const size_t shift = ((minShift + blockSize - 1U) / blockSize) * blockSize;
+
+        newJsonChunkLength = header.jsonChunkLength + shift;
+        newLength = header.length + shift;
+
+        if (newLength > std::numeric_limits<uint32_t>::max())
+        {
+            throw GLTFException("The rewritten GLB would exceed the maximum GLB length");
+        }
+
+        // Inserting a range at the start of the block that holds the start of the BIN chunk also moves the end of the JSON
+        // chunk (or the whole GLB), which is overwritten below
+        const off_t insertOffset = static_cast<off_t>((binaryChunkOffset / blockSize) * blockSize);
+
+        if (!InsertRange(file.Get(), insertOffset, shift))
+        {
+            MoveRangeForward(file.Get(), static_cast<off_t>(binaryChunkOffset), static_cast<off_t>(binaryChunkOffset + shift), binaryChunkLength, shift);
+        }
+
+        if (insertOffset == 0)
+        {
+            // The inserted range moved the magic string and version too
+            WriteAll(file.Get(), headerData, GLB_HEADER_MAGIC_STRING_SIZE + sizeof(uint32_t), 0);
+        }
+    }
+
+    std::ostringstream manifestStream;
+    WriteManifest(manifestStream, newLength, manifest, newJsonChunkLength);
+
+    const std::string manifestData = manifestStream.str();
+    WriteAll(file.Get(), manifestData.data(), manifestData.size(), GLB_HEADER_MAGIC_STRING_SIZE + sizeof(uint32_t));
+
+    return isInPlace;
+#else
+    std::fstream glbStream(path, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+
+    if (!glbStream)
+    {
+        throw GLTFException("Unable to open " + path);
+    }
+
+    return RewriteGLBManifest(glbStream, manifest);
+#endif
+}
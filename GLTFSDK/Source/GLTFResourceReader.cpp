@@ -2,53 +2,59 @@
 // Licensed under the MIT License.
 
 #include <GLTFSDK/GLTFResourceReader.h>
-#include <GLTFSDK/ResourceReaderUtils.h>
+#include <GLTFSDK/ConversionKernels.h>
 
 using namespace Microsoft::glTF;
 
 namespace
 {
+    // The raw components are read into the front of the float buffer and then converted in place
     template<typename T>
-    std::vector<float> DecodeToFloats(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
+    size_t DecodeToFloats(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, float* floatData, size_t floatCount)
     {
-        std::vector<T> rawData = reader.ReadBinaryData<T>(doc, accessor);
-
-        std::vector<float> floatData;
-        floatData.reserve(rawData.size());
-
-        if (accessor.normalized)
-        {
-            for (size_t i = 0; i < rawData.size(); ++i)
-                floatData.push_back(ComponentToFloat(rawData[i]));
-        }
-        else
-        {
-            for (size_t i = 0; i < rawData.size(); ++i)
-                floatData.push_back(static_cast<float>(rawData[i]));
-        }
-
-        return floatData;
+        static_assert(sizeof(T) <= sizeof(float), "Component type is wider than float");
+
+        const size_t count = reader.ReadBinaryData<T>(doc, accessor, reinterpret_cast<T*>(floatData), floatCount);
+
+        ConversionKernels::ToFloat(reinterpret_cast<const T*>(floatData), floatData, count, accessor.normalized);
+
+        return count;
     }
 }
 
 std::vector<float> GLTFResourceReader::ReadFloatData(const Document& gltfDocument, const Accessor& accessor) const
+{
+    if (accessor.componentType == COMPONENT_FLOAT)
+    {
+        return ReadBinaryData<float>(gltfDocument, accessor);
+    }
+
+    // Validate the accessor before its count is used to size the output
+    Validation::ValidateAccessor(gltfDocument, accessor);
+
+    std::vector<float> floatData(accessor.count * Accessor::GetTypeCount(accessor.type));
+    ReadFloatData(gltfDocument, accessor, floatData.data(), floatData.size());
+    return floatData;
+}
+
+size_t GLTFResourceReader::ReadFloatData(const Document& gltfDocument, const Accessor& accessor, float* data, size_t dataCount) const
 {
     switch (accessor.componentType)
     {
     case COMPONENT_BYTE:
-        return DecodeToFloats<int8_t>(gltfDocument, *this, accessor);
+        return DecodeToFloats<int8_t>(gltfDocument, *this, accessor, data, dataCount);
 
     case COMPONENT_UNSIGNED_BYTE:
-        return DecodeToFloats<uint8_t>(gltfDocument, *this, accessor);
+        return DecodeToFloats<uint8_t>(gltfDocument, *this, accessor, data, dataCount);
 
     case COMPONENT_SHORT:
-        return DecodeToFloats<int16_t>(gltfDocument, *this, accessor);
+        return DecodeToFloats<int16_t>(gltfDocument, *this, accessor, data, dataCount);
 
     case COMPONENT_UNSIGNED_SHORT:
-        return DecodeToFloats<uint16_t>(gltfDocument, *this, accessor);
+        return DecodeToFloats<uint16_t>(gltfDocument, *this, accessor, data, dataCount);
 
     case COMPONENT_FLOAT:
-        return ReadBinaryData<float>(gltfDocument, accessor);
+        return ReadBinaryData<float>(gltfDocument, accessor, data, dataCount);
 
     default:
         throw GLTFException("Unsupported accessor ComponentType");
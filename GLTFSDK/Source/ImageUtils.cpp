@@ -0,0 +1,341 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/ImageUtils.h>
+
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    // Number of bytes read from a buffer view when first attempting to parse an image header
+    const size_t ImageHeaderPrefixSize = 4096U;
+
+    const uint8_t PNG_SIGNATURE[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    const uint8_t KTX2_IDENTIFIER[] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+    uint16_t ReadUInt16BE(const uint8_t* data)
+    {
+        return static_cast<uint16_t>(data[0] << 8U | data[1]);
+    }
+
+    uint32_t ReadUInt32BE(const uint8_t* data)
+    {
+        return static_cast<uint32_t>(data[0]) << 24U | static_cast<uint32_t>(data[1]) << 16U | static_cast<uint32_t>(data[2]) << 8U | data[3];
+    }
+
+    uint32_t ReadUInt24LE(const uint8_t* data)
+    {
+        return static_cast<uint32_t>(data[2]) << 16U | static_cast<uint32_t>(data[1]) << 8U | data[0];
+    }
+
+    uint32_t ReadUInt32LE(const uint8_t* data)
+    {
+        return static_cast<uint32_t>(data[3]) << 24U | ReadUInt24LE(data);
+    }
+
+    bool HasSignature(const uint8_t* data, size_t size, const void* signature, size_t signatureSize)
+    {
+        return size >= signatureSize && memcmp(data, signature, signatureSize) == 0;
+    }
+
+    // Each parser returns false if the data ends before the header has been parsed
+    bool ParsePNG(const uint8_t* data, size_t size, ImageInfo& info)
+    {
+        // The IHDR chunk must immediately follow the signature: length (4), type (4), width (4), height (4), bit depth (1), color type (1)
+        if (size < 26U)
+        {
+            return false;
+        }
+
+        if (memcmp(data + 12U, "IHDR", 4U) != 0)
+        {
+            throw GLTFException("Invalid PNG image, IHDR chunk not found");
+        }
+
+        info.width = ReadUInt32BE(data + 16U);
+        info.height = ReadUInt32BE(data + 20U);
+        info.bitDepth = data[24U];
+
+        switch (data[25U])
+        {
+        case 0U: info.channelCount = 1U; break; // Greyscale
+        case 2U: info.channelCount = 3U; break; // RGB
+        case 3U: info.channelCount = 3U; break; // Palette
+        case 4U: info.channelCount = 2U; break; // Greyscale + alpha
+        case 6U: info.channelCount = 4U; break; // RGBA
+        default:
+            throw GLTFException("Invalid PNG image, unknown color type " + std::to_string(data[25U]));
+        }
+
+        return true;
+    }
+
+    bool ParseJPEG(const uint8_t* data, size_t size, ImageInfo& info)
+    {
+        // Walk the marker segments that follow SOI until a start of frame marker is found
+        size_t offset = 2U;
+
+        while (true)
+        {
+            if (offset + 4U > size)
+            {
+                return false;
+            }
+
+            if (data[offset] != 0xFF)
+            {
+                throw GLTFException("Invalid JPEG image, marker expected at offset " + std::to_string(offset));
+            }
+
+            const uint8_t marker = data[offset + 1U];
+
+            if (marker == 0xFF)
+            {
+                offset++; // Fill byte
+                continue;
+            }
+
+            if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7))
+            {
+                offset += 2U; // Standalone markers have no length
+                continue;
+            }
+
+            if (marker == 0xD9 || marker == 0xDA)
+            {
+                throw GLTFException("Invalid JPEG image, no frame header found");
+            }
+
+            const size_t segmentLength = ReadUInt16BE(data + offset + 2U);
+
+            // SOF0-SOF15 except DHT (C4), JPG (C8) and DAC (CC)
+            if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+            {
+                // Length (2), precision (1), height (2), width (2), component count (1)
+                if (offset + 10U > size)
+                {
+                    return false;
+                }
+
+                info.bitDepth = data[offset + 4U];
+                info.height = ReadUInt16BE(data + offset + 5U);
+                info.width = ReadUInt16BE(data + offset + 7U);
+                info.channelCount = data[offset + 9U];
+                return true;
+            }
+
+            offset += 2U + segmentLength;
+        }
+    }
+
+    uint32_t GetKTX2ChannelCount(const uint8_t* dfd, size_t dfdSize, uint32_t vkFormat)
+    {
+        // Basic data format descriptor block: total size (4), then a 24 byte block header followed by 16 byte samples
+        if (dfdSize < 28U)
+        {
+            return 0U;
+        }
+
+        const uint8_t* block = dfd + 4U;
+        const uint32_t blockSize = ReadUInt32LE(block + 4U) >> 16U;
+
+        if (blockSize < 24U || 4U + blockSize > dfdSize)
+        {
+            return 0U;
+        }
+
+        const uint8_t colorModel = block[8U];
+        const uint32_t sampleCount = (blockSize - 24U) / 16U;
+
+        if (vkFormat != 0U)
+        {
+            return sampleCount; // Uncompressed formats have one sample per channel
+        }
+
+        uint32_t channelCount = 0U;
+
+        for (uint32_t i = 0U; i < sampleCount; i++)
+        {
+            const uint8_t channelType = block[24U + i * 16U + 3U] & 0x0F;
+
+            if (colorModel == 163U) // KHR_DF_MODEL_ETC1S: RGB, RRR, GGG, AAA
+            {
+                channelCount += (channelType == 0U) ? 3U : 1U;
+            }
+            else if (colorModel == 166U) // KHR_DF_MODEL_UASTC: RGB, RGBA, RRR, RRRG, RG
+            {
+                const uint32_t uastcChannels[] = { 3U, 4U, 1U, 2U, 2U };
+                channelCount += (channelType < 5U) ? uastcChannels[channelType] : 0U;
+            }
+            else
+            {
+                return 0U;
+            }
+        }
+
+        return channelCount;
+    }
+
+    bool ParseKTX2(const uint8_t* data, size_t size, ImageInfo& info)
+    {
+        // Identifier (12), vkFormat, typeSize, pixelWidth, pixelHeight, ... then dfdByteOffset and dfdByteLength at 48
+        if (size < 56U)
+        {
+            return false;
+        }
+
+        const uint32_t vkFormat = ReadUInt32LE(data + 12U);
+        const uint32_t typeSize = ReadUInt32LE(data + 16U);
+
+        info.width = ReadUInt32LE(data + 20U);
+        info.height = std::max(ReadUInt32LE(data + 24U), 1U);
+        info.bitDepth = (vkFormat != 0U) ? typeSize * 8U : 8U;
+
+        const uint32_t dfdOffset = ReadUInt32LE(data + 48U);
+        const uint32_t dfdLength = ReadUInt32LE(data + 52U);
+
+        if (dfdLength > 0U)
+        {
+            if (static_cast<size_t>(dfdOffset) + dfdLength > size)
+            {
+                return false;
+            }
+
+            info.channelCount = GetKTX2ChannelCount(data + dfdOffset, dfdLength, vkFormat);
+        }
+
+        return true;
+    }
+
+    bool ParseWebP(const uint8_t* data, size_t size, ImageInfo& info)
+    {
+        // RIFF header (12) followed by the first chunk's FourCC (4) and size (4)
+        if (size < 30U)
+        {
+            return false;
+        }
+
+        const uint8_t* chunk = data + 20U;
+
+        info.bitDepth = 8U;
+
+        if (memcmp(data + 12U, "VP8 ", 4U) == 0)
+        {
+            // Lossy: frame tag (3), start code (3), then 14 bit width and height
+            if (chunk[3U] != 0x9D || chunk[4U] != 0x01 || chunk[5U] != 0x2A)
+            {
+                throw GLTFException("Invalid WebP image, VP8 start code not found");
+            }
+
+            info.width = (chunk[6U] | chunk[7U] << 8U) & 0x3FFFU;
+            info.height = (chunk[8U] | chunk[9U] << 8U) & 0x3FFFU;
+            info.channelCount = 3U;
+        }
+        else if (memcmp(data + 12U, "VP8L", 4U) == 0)
+        {
+            // Lossless: signature (1), then 14 bit width - 1, 14 bit height - 1 and the alpha hint
+            if (chunk[0U] != 0x2F)
+            {
+                throw GLTFException("Invalid WebP image, VP8L signature not found");
+            }
+
+            const uint32_t bits = ReadUInt32LE(chunk + 1U);
+
+            info.width = (bits & 0x3FFFU) + 1U;
+            info.height = ((bits >> 14U) & 0x3FFFU) + 1U;
+            info.channelCount = ((bits >> 28U) & 1U) ? 4U : 3U;
+        }
+        else if (memcmp(data + 12U, "VP8X", 4U) == 0)
+        {
+            // Extended: flags (1), reserved (3), 24 bit canvas width - 1 and height - 1
+            info.width = ReadUInt24LE(chunk + 4U) + 1U;
+            info.height = ReadUInt24LE(chunk + 7U) + 1U;
+            info.channelCount = (chunk[0U] & 0x10U) ? 4U : 3U;
+        }
+        else
+        {
+            throw GLTFException("Invalid WebP image, unknown chunk type");
+        }
+
+        return true;
+    }
+
+    bool TryParseImageInfo(const uint8_t* data, size_t size, ImageInfo& info)
+    {
+        info = ImageInfo();
+
+        if (HasSignature(data, size, PNG_SIGNATURE, sizeof(PNG_SIGNATURE)))
+        {
+            info.format = ImageFormat::PNG;
+            return ParsePNG(data, size, info);
+        }
+
+        if (size >= 3U && data[0U] == 0xFF && data[1U] == 0xD8 && data[2U] == 0xFF)
+        {
+            info.format = ImageFormat::JPEG;
+            return ParseJPEG(data, size, info);
+        }
+
+        if (HasSignature(data, size, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)))
+        {
+            info.format = ImageFormat::KTX2;
+            return ParseKTX2(data, size, info);
+        }
+
+        if (size >= 12U && memcmp(data, "RIFF", 4U) == 0 && memcmp(data + 8U, "WEBP", 4U) == 0)
+        {
+            info.format = ImageFormat::WebP;
+            return ParseWebP(data, size, info);
+        }
+
+        return true;
+    }
+}
+
+ImageInfo ImageUtils::ParseImageInfo(const uint8_t* data, size_t size)
+{
+    ImageInfo info;
+
+    if (!TryParseImageInfo(data, size, info))
+    {
+        throw GLTFException("Image data ends before the end of the image header");
+    }
+
+    return info;
+}
+
+ImageInfo ImageUtils::ParseImageInfo(const std::vector<uint8_t>& data)
+{
+    return ParseImageInfo(data.data(), data.size());
+}
+
+ImageInfo ImageUtils::ReadImageInfo(const Document& doc, const GLTFResourceReader& reader, const Image& image)
+{
+    if (image.uri.empty() && !image.bufferViewId.empty())
+    {
+        const auto& bufferView = doc.bufferViews.Get(image.bufferViewId);
+
+        if (bufferView.byteLength > ImageHeaderPrefixSize)
+        {
+            BufferView prefix = bufferView;
+            prefix.byteLength = ImageHeaderPrefixSize;
+
+            const auto data = reader.ReadBinaryData<uint8_t>(doc, prefix);
+
+            ImageInfo info;
+
+            if (TryParseImageInfo(data.data(), data.size(), info))
+            {
+                return info;
+            }
+        }
+    }
+
+    return ParseImageInfo(reader.ReadBinaryData(doc, image));
+}
@@ -94,3 +94,54 @@ bool Quaternion::operator!=(const Quaternion& other) const
     return !operator==(other);
 }
 
+
+Matrix4 Math::Multiply(const Matrix4& lhs, const Matrix4& rhs)
+{
+    Matrix4 result;
+
+    for (size_t column = 0U; column < 4U; column++)
+    {
+        for (size_t row = 0U; row < 4U; row++)
+        {
+            float value = 0.0f;
+
+            for (size_t i = 0U; i < 4U; i++)
+            {
+                value += lhs.values[i * 4U + row] * rhs.values[column * 4U + i];
+            }
+
+            result.values[column * 4U + row] = value;
+        }
+    }
+
+    return result;
+}
+
+Matrix4 Math::ToMatrix(const Vector3& translation, const Quaternion& rotation, const Vector3& scale)
+{
+    const float x = rotation.x;
+    const float y = rotation.y;
+    const float z = rotation.z;
+    const float w = rotation.w;
+
+    Matrix4 result;
+
+    result.values = {{
+        (1.0f - 2.0f * (y * y + z * z)) * scale.x, 2.0f * (x * y + z * w) * scale.x, 2.0f * (x * z - y * w) * scale.x, 0.0f,
+        2.0f * (x * y - z * w) * scale.y, (1.0f - 2.0f * (x * x + z * z)) * scale.y, 2.0f * (y * z + x * w) * scale.y, 0.0f,
+        2.0f * (x * z + y * w) * scale.z, 2.0f * (y * z - x * w) * scale.z, (1.0f - 2.0f * (x * x + y * y)) * scale.z, 0.0f,
+        translation.x, translation.y, translation.z, 1.0f
+    }};
+
+    return result;
+}
+
+Vector3 Math::TransformPoint(const Matrix4& matrix, const Vector3& point)
+{
+    const auto& m = matrix.values;
+
+    return Vector3(
+        m[0] * point.x + m[4] * point.y + m[8] * point.z + m[12],
+        m[1] * point.x + m[5] * point.y + m[9] * point.z + m[13],
+        m[2] * point.x + m[6] * point.y + m[10] * point.z + m[14]);
+}
@@ -0,0 +1,209 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/MemoryUsage.h>
+
+#include <GLTFSDK/Document.h>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    // Strings no longer than this are stored inline (the 'small string optimization') rather than on the heap
+    const size_t StringLocalCapacity = std::string().capacity();
+}
+
+size_t MemoryUsage::EstimateHeapSize(const std::string& value)
+{
+    return value.capacity() > StringLocalCapacity ? value.capacity() + 1U : 0U;
+}
+
+size_t MemoryUsage::EstimateHeapSize(const glTFProperty& property)
+{
+    size_t size = EstimateHeapSize(property.extensions) + EstimateHeapSize(property.extras);
+
+    // The registered extensions map isn't accessible so, as with IndexedContainer, one bucket per extension is assumed
+    for (const Extension& extension : property.GetExtensions())
+    {
+        size += sizeof(void*) + sizeof(std::pair<const std::type_index, std::unique_ptr<Extension>>) + HashNodeOverhead + extension.EstimateMemoryUsage();
+    }
+
+    return size;
+}
+
+size_t MemoryUsage::EstimateHeapSize(const glTFChildOfRootProperty& property)
+{
+    return EstimateHeapSize(static_cast<const glTFProperty&>(property)) + EstimateHeapSize(property.id) + EstimateHeapSize(property.name);
+}
+
+size_t MemoryUsage::EstimateHeapSize(const Accessor& accessor)
+{
+    return EstimateHeapSize(static_cast<const glTFChildOfRootProperty&>(accessor))
+        + EstimateHeapSize(accessor.bufferViewId)
+        + EstimateHeapSize(accessor.max)
+        + EstimateHeapSize(accessor.min)
+        + EstimateHeapSize(accessor.sparse.indicesBufferViewId)
+        + EstimateHeapSize(accessor.sparse.valuesBufferViewId);
+}
+
+size_t MemoryUsage::EstimateHeapSize(const Animation& animation)
+{
+    return EstimateHeapSize(static_cast<const glTFChildOfRootProperty&>(animation))
+        + EstimateHeapSize(animation.channels)
+        + EstimateHeapSize(animation.samplers);
+}
+
+size_t MemoryUsage::EstimateHeapSize(const AnimationChannel& channel)
+{
+    return EstimateHeapSize(static_cast<const glTFProperty&>(channel))
+        + EstimateHeapSize(channel.id)
+        + EstimateHeapSize(channel.samplerId)
+        + EstimateHeapSize(static_cast<const glTFProperty&>(channel.target))
+        + EstimateHeapSize(channel.target.nodeId);
+}
+
+size_t MemoryUsage::EstimateHeapSize(const AnimationSampler& sampler)
+{
+    return EstimateHeapSize(static_cast<const glTFProperty&>(sampler))
+        + EstimateHeapSize(sampler.id)
+        + EstimateHeapSize(sampler.inputAccessorId)
+        + EstimateHeapSize(sampler.outputAccessorId);
+}
+
+size_t MemoryUsage::EstimateHeapSize(const Asset& asset)
+{
+    return EstimateHeapSize(static_cast<const glTFProperty&>(asset))
+        + EstimateHeapSize(asset.copyright)
+        + EstimateHeapSize(asset.generator)
+        + EstimateHeapSize(asset.version)
+        + EstimateHeapSize(asset.minVersion);
+}
+
+size_t MemoryUsage::EstimateHeapSize(const Buffer& buffer)
+{
+    return EstimateHeapSize(static_cast<const glTFChildOfRootProperty&>(buffer)) + EstimateHeapSize(buffer.uri);
+}
+
+size_t MemoryUsage::EstimateHeapSize(const BufferView& bufferView)
+{
+    return EstimateHeapSize(static_cast<const glTFChildOfRootProperty&>(bufferView)) + EstimateHeapSize(bufferView.bufferId);
+}
+
+size_t MemoryUsage::EstimateHeapSize(const Camera& camera)
+{
+    size_t size = EstimateHeapSize(static_cast<const glTFChildOfRootProperty&>(camera));
+
+    if (camera.projection)
+    {
+        const auto projectionType = camera.projection->GetProjectionType();
+
+        size += (projectionType == PROJECTION_PERSPECTIVE) ? sizeof(Perspective) : sizeof(Orthographic);
+        size += EstimateHeapSize(static_cast<const glTFProperty&>(*camera.projection));
+    }
+
+    return size;
+}
+
+size_t MemoryUsage::EstimateHeapSize(const Image& image)
+{
+    return EstimateHeapSize(static_cast<const glTFChildOfRootProperty&>(image))
+        + EstimateHeapSize(image.uri)
+        + EstimateHeapSize(image.mimeType)
+        + EstimateHeapSize(image.bufferViewId);
+}
+
+size_t MemoryUsage::EstimateHeapSize(const Material& material)
+{
+    return EstimateHeapSize(static_cast<const glTFChildOfRootProperty&>(material))
+        + EstimateHeapSize(static_cast<const glTFProperty&>(material.metallicRoughness))
+        + EstimateHeapSize(material.metallicRoughness.baseColorTexture)
+        + EstimateHeapSize(material.metallicRoughness.metallicRoughnessTexture)
+        + EstimateHeapSize(material.normalTexture)
+        + EstimateHeapSize(material.occlusionTexture)
+        + EstimateHeapSize(material.emissiveTexture);
+}
+
+size_t MemoryUsage::EstimateHeapSize(const Mesh& mesh)
+{
+    return EstimateHeapSize(static_cast<const glTFChildOfRootProperty&>(mesh))
+        + EstimateHeapSize(mesh.primitives)
+        + EstimateHeapSize(mesh.weights);
+}
+
+size_t MemoryUsage::EstimateHeapSize(const MeshPrimitive& meshPrimitive)
+{
+    return EstimateHeapSize(static_cast<const glTFProperty&>(meshPrimitive))
+        + EstimateHeapSize(meshPrimitive.attributes)
+        + EstimateHeapSize(meshPrimitive.indicesAccessorId)
+        + EstimateHeapSize(meshPrimitive.materialId)
+        + EstimateHeapSize(meshPrimitive.targets);
+}
+
+size_t MemoryUsage::EstimateHeapSize(const MorphTarget& morphTarget)
+{
+    return EstimateHeapSize(morphTarget.positionsAccessorId)
+        + EstimateHeapSize(morphTarget.normalsAccessorId)
+        + EstimateHeapSize(morphTarget.tangentsAccessorId);
+}
+
+size_t MemoryUsage::EstimateHeapSize(const Node& node)
+{
+    return EstimateHeapSize(static_cast<const glTFChildOfRootProperty&>(node))
+        + EstimateHeapSize(node.cameraId)
+        + EstimateHeapSize(node.children)
+        + EstimateHeapSize(node.skinId)
+        + EstimateHeapSize(node.meshId)
+        + EstimateHeapSize(node.weights);
+}
+
+size_t MemoryUsage::EstimateHeapSize(const Sampler& sampler)
+{
+    return EstimateHeapSize(static_cast<const glTFChildOfRootProperty&>(sampler));
+}
+
+size_t MemoryUsage::EstimateHeapSize(const Scene& scene)
+{
+    return EstimateHeapSize(static_cast<const glTFChildOfRootProperty&>(scene)) + EstimateHeapSize(scene.nodes);
+}
+
+size_t MemoryUsage::EstimateHeapSize(const Skin& skin)
+{
+    return EstimateHeapSize(static_cast<const glTFChildOfRootProperty&>(skin))
+        + EstimateHeapSize(skin.inverseBindMatricesAccessorId)
+        + EstimateHeapSize(skin.skeletonId)
+        + EstimateHeapSize(skin.jointIds);
+}
+
+size_t MemoryUsage::EstimateHeapSize(const Texture& texture)
+{
+    return EstimateHeapSize(static_cast<const glTFChildOfRootProperty&>(texture))
+        + EstimateHeapSize(texture.samplerId)
+        + EstimateHeapSize(texture.imageId);
+}
+
+size_t MemoryUsage::EstimateHeapSize(const TextureInfo& textureInfo)
+{
+    return EstimateHeapSize(static_cast<const glTFProperty&>(textureInfo)) + EstimateHeapSize(textureInfo.textureId);
+}
+
+size_t MemoryUsage::EstimateHeapSize(const Document& document)
+{
+    return EstimateHeapSize(static_cast<const glTFProperty&>(document))
+        + EstimateHeapSize(document.asset)
+        + EstimateHeapSize(document.accessors)
+        + EstimateHeapSize(document.animations)
+        + EstimateHeapSize(document.buffers)
+        + EstimateHeapSize(document.bufferViews)
+        + EstimateHeapSize(document.cameras)
+        + EstimateHeapSize(document.images)
+        + EstimateHeapSize(document.materials)
+        + EstimateHeapSize(document.meshes)
+        + EstimateHeapSize(document.nodes)
+        + EstimateHeapSize(document.samplers)
+        + EstimateHeapSize(document.scenes)
+        + EstimateHeapSize(document.skins)
+        + EstimateHeapSize(document.textures)
+        + EstimateHeapSize(document.extensionsUsed)
+        + EstimateHeapSize(document.extensionsRequired)
+        + EstimateHeapSize(document.defaultSceneId);
+}
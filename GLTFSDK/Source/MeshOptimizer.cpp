@@ -0,0 +1,1006 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/MeshOptimizer.h>
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/MeshPrimitiveUtils.h>
+#include <GLTFSDK/Parallel.h>
+#include <GLTFSDK/Validation.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::MeshOptimizer;
+
+namespace
+{
+    void ValidateIndex(uint32_t index, size_t vertexCount)
+    {
+        if (index >= vertexCount)
+        {
+            throw GLTFException("Index " + std::to_string(index) + " is out of range for a mesh with " + std::to_string(vertexCount) + " vertices");
+        }
+    }
+
+    template<typename T>
+    void ReadComponents(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, VertexStream& stream)
+    {
+        const size_t componentCount = accessor.count * Accessor::GetTypeCount(accessor.type);
+
+        stream.data.resize(componentCount * sizeof(T));
+        reader.ReadBinaryData<T>(doc, accessor, reinterpret_cast<T*>(stream.data.data()), componentCount);
+    }
+
+    VertexStream ReadVertexStream(const Document& doc, const GLTFResourceReader& reader, const std::string& semantic, const std::string& accessorId, size_t vertexCount)
+    {
+        const Accessor& accessor = doc.accessors.Get(accessorId);
+
+        // Validated first so that a corrupt count is reported rather than used to size the stream
+        Validation::ValidateAccessor(doc, accessor);
+
+        if (accessor.count != vertexCount)
+        {
+            throw GLTFException("Accessor " + accessor.id + " has " + std::to_string(accessor.count) + " elements but the mesh primitive has " + std::to_string(vertexCount) + " vertices");
+        }
+
+        VertexStream stream;
+        stream.semantic = semantic;
+        stream.accessorType = accessor.type;
+        stream.componentType = accessor.componentType;
+        stream.normalized = accessor.normalized;
+
+        switch (accessor.componentType)
+        {
+        case COMPONENT_BYTE:
+            ReadComponents<int8_t>(doc, reader, accessor, stream);
+            break;
+        case COMPONENT_UNSIGNED_BYTE:
+            ReadComponents<uint8_t>(doc, reader, accessor, stream);
+            break;
+        case COMPONENT_SHORT:
+            ReadComponents<int16_t>(doc, reader, accessor, stream);
+            break;
+        case COMPONENT_UNSIGNED_SHORT:
+            ReadComponents<uint16_t>(doc, reader, accessor, stream);
+            break;
+        case COMPONENT_UNSIGNED_INT:
+            ReadComponents<uint32_t>(doc, reader, accessor, stream);
+            break;
+        case COMPONENT_FLOAT:
+            ReadComponents<float>(doc, reader, accessor, stream);
+            break;
+        default:
+            throw GLTFException("Unsupported accessor ComponentType");
+        }
+
+        return stream;
+    }
+
+    template<typename T>
+    float ReadComponent(const uint8_t* data)
+    {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return static_cast<float>(value);
+    }
+
+    float ReadComponent(const uint8_t* data, ComponentType componentType)
+    {
+        switch (componentType)
+        {
+        case COMPONENT_BYTE:
+            return ReadComponent<int8_t>(data);
+        case COMPONENT_UNSIGNED_BYTE:
+            return ReadComponent<uint8_t>(data);
+        case COMPONENT_SHORT:
+            return ReadComponent<int16_t>(data);
+        case COMPONENT_UNSIGNED_SHORT:
+            return ReadComponent<uint16_t>(data);
+        case COMPONENT_UNSIGNED_INT:
+            return ReadComponent<uint32_t>(data);
+        case COMPONENT_FLOAT:
+            return ReadComponent<float>(data);
+        default:
+            throw GLTFException("Unsupported accessor ComponentType");
+        }
+    }
+
+    // Accessor min and max are expressed in the accessor's component type (before any normalization is applied)
+    void ComputeMinMax(const VertexStream& stream, size_t vertexCount, std::vector<float>& minValues, std::vector<float>& maxValues)
+    {
+        const size_t typeCount = Accessor::GetTypeCount(stream.accessorType);
+        const size_t componentSize = Accessor::GetComponentTypeSize(stream.componentType);
+
+        minValues.assign(typeCount, std::numeric_limits<float>::max());
+        maxValues.assign(typeCount, std::numeric_limits<float>::lowest());
+
+        for (size_t i = 0U; i < vertexCount * typeCount; i++)
+        {
+            const float value = ReadComponent(stream.data.data() + i * componentSize, stream.componentType);
+
+            minValues[i % typeCount] = std::min(minValues[i % typeCount], value);
+            maxValues[i % typeCount] = std::max(maxValues[i % typeCount], value);
+        }
+    }
+
+    // Primitive restart values are InvalidIndex, which each narrower component type truncates to its own largest value
+    std::string WriteIndices(const std::vector<uint32_t>& indices, ComponentType componentType, BufferBuilder& bufferBuilder)
+    {
+        bufferBuilder.AddBufferView(BufferViewTarget::ELEMENT_ARRAY_BUFFER);
+
+        switch (componentType)
+        {
+        case COMPONENT_UNSIGNED_BYTE:
+            return bufferBuilder.AddAccessor(std::vector<uint8_t>(indices.begin(), indices.end()), { TYPE_SCALAR, componentType }).id;
+        case COMPONENT_UNSIGNED_SHORT:
+            return bufferBuilder.AddAccessor(std::vector<uint16_t>(indices.begin(), indices.end()), { TYPE_SCALAR, componentType }).id;
+        case COMPONENT_UNSIGNED_INT:
+            return bufferBuilder.AddAccessor(indices, { TYPE_SCALAR, componentType }).id;
+        default:
+            throw GLTFException("Indices must be unsigned bytes, shorts or ints");
+        }
+    }
+
+    std::string WriteVertexStream(const VertexStream& stream, size_t vertexCount, BufferBuilder& bufferBuilder)
+    {
+        AccessorDesc desc(stream.accessorType, stream.componentType, stream.normalized);
+
+        if (stream.semantic == ACCESSOR_POSITION)
+        {
+            ComputeMinMax(stream, vertexCount, desc.minValues, desc.maxValues);
+        }
+
+        bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+
+        const size_t elementSize = stream.GetElementSize();
+
+        if (elementSize % 4U == 0U)
+        {
+            return bufferBuilder.AddAccessor(stream.data.data(), vertexCount, std::move(desc)).id;
+        }
+
+        // Each element of a vertex attribute must start on a 4-byte boundary so smaller elements are padded
+        const size_t byteStride = (elementSize + 3U) & ~size_t(3U);
+
+        std::vector<uint8_t> padded(vertexCount * byteStride);
+
+        for (size_t i = 0U; i < vertexCount; i++)
+        {
+            std::memcpy(padded.data() + i * byteStride, stream.data.data() + i * elementSize, elementSize);
+        }
+
+        std::string accessorId;
+        bufferBuilder.AddAccessors(padded.data(), vertexCount, byteStride, &desc, 1U, &accessorId);
+        return accessorId;
+    }
+
+    void RemapVertexStream(VertexStream& stream, const std::vector<uint32_t>& remap, size_t vertexCount)
+    {
+        const size_t elementSize = stream.GetElementSize();
+
+        std::vector<uint8_t> data(vertexCount * elementSize);
+
+        // Visited in reverse so that the first of several vertices mapped to the same index is the one that's kept
+        for (size_t i = remap.size(); i-- > 0U;)
+        {
+            if (remap[i] != InvalidIndex)
+            {
+                std::memcpy(data.data() + remap[i] * elementSize, stream.data.data() + i * elementSize, elementSize);
+            }
+        }
+
+        stream.data = std::move(data);
+    }
+
+    void ReadVertexStreams(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, MeshData& meshData)
+    {
+        for (const auto& attribute : meshPrimitive.attributes)
+        {
+            meshData.attributes.push_back(ReadVertexStream(doc, reader, attribute.first, attribute.second, meshData.vertexCount));
+        }
+
+        // Attributes are held in an unordered map so they're sorted to make the output independent of its ordering
+        std::sort(meshData.attributes.begin(), meshData.attributes.end(), [](const VertexStream& a, const VertexStream& b)
+        {
+            return a.semantic < b.semantic;
+        });
+
+        for (const auto& morphTarget : meshPrimitive.targets)
+        {
+            std::vector<VertexStream> target;
+
+            const std::pair<const char*, const std::string*> targetAttributes[] = {
+                { ACCESSOR_POSITION, &morphTarget.positionsAccessorId },
+                { ACCESSOR_NORMAL, &morphTarget.normalsAccessorId },
+                { ACCESSOR_TANGENT, &morphTarget.tangentsAccessorId }
+            };
+
+            for (const auto& targetAttribute : targetAttributes)
+            {
+                if (!targetAttribute.second->empty())
+                {
+                    target.push_back(ReadVertexStream(doc, reader, targetAttribute.first, *targetAttribute.second, meshData.vertexCount));
+                }
+            }
+
+            meshData.targets.push_back(std::move(target));
+        }
+    }
+
+    void WriteVertexStreams(const MeshData& meshData, MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder)
+    {
+        meshPrimitive.attributes.clear();
+
+        for (const auto& stream : meshData.attributes)
+        {
+            meshPrimitive.attributes[stream.semantic] = WriteVertexStream(stream, meshData.vertexCount, bufferBuilder);
+        }
+
+        meshPrimitive.targets.clear();
+
+        for (const auto& target : meshData.targets)
+        {
+            MorphTarget morphTarget;
+
+            for (const auto& stream : target)
+            {
+                const std::string accessorId = WriteVertexStream(stream, meshData.vertexCount, bufferBuilder);
+
+                if (stream.semantic == ACCESSOR_POSITION)
+                {
+                    morphTarget.positionsAccessorId = accessorId;
+                }
+                else if (stream.semantic == ACCESSOR_NORMAL)
+                {
+                    morphTarget.normalsAccessorId = accessorId;
+                }
+                else if (stream.semantic == ACCESSOR_TANGENT)
+                {
+                    morphTarget.tangentsAccessorId = accessorId;
+                }
+                else
+                {
+                    throw GLTFException("Morph targets can't contain " + stream.semantic + " attributes");
+                }
+            }
+
+            meshPrimitive.targets.push_back(std::move(morphTarget));
+        }
+    }
+
+    uint32_t GetRestartIndex(ComponentType componentType)
+    {
+        switch (componentType)
+        {
+        case COMPONENT_UNSIGNED_BYTE:
+            return std::numeric_limits<uint8_t>::max();
+        case COMPONENT_UNSIGNED_SHORT:
+            return std::numeric_limits<uint16_t>::max();
+        case COMPONENT_UNSIGNED_INT:
+            return std::numeric_limits<uint32_t>::max();
+        default:
+            throw GLTFException("Indices must be unsigned bytes, shorts or ints");
+        }
+    }
+
+    // Welding compares each vertex's data from every stream as a single key. Streams that are snapped to a grid contribute
+    // their snapped components rather than their original data.
+    struct WeldStream
+    {
+        const VertexStream* stream;
+        float epsilon;
+    };
+
+    std::vector<WeldStream> GetWeldStreams(const MeshData& meshData, const WeldOptions& options)
+    {
+        std::vector<WeldStream> streams;
+
+        for (const auto& stream : meshData.attributes)
+        {
+            float epsilon = 0.0f;
+
+            if (stream.componentType == COMPONENT_FLOAT)
+            {
+                if (stream.semantic == ACCESSOR_POSITION)
+                {
+                    epsilon = options.positionEpsilon;
+                }
+                else if (stream.semantic == ACCESSOR_NORMAL)
+                {
+                    epsilon = options.normalEpsilon;
+                }
+            }
+
+            streams.push_back({ &stream, epsilon });
+        }
+
+        for (const auto& target : meshData.targets)
+        {
+            for (const auto& stream : target)
+            {
+                streams.push_back({ &stream, 0.0f });
+            }
+        }
+
+        return streams;
+    }
+
+    void WriteVertexKey(const std::vector<WeldStream>& streams, size_t vertex, uint8_t* key)
+    {
+        for (const auto& weldStream : streams)
+        {
+            const size_t elementSize = weldStream.stream->GetElementSize();
+            const uint8_t* element = weldStream.stream->data.data() + vertex * elementSize;
+
+            if (weldStream.epsilon > 0.0f)
+            {
+                for (size_t i = 0U; i < elementSize; i += sizeof(float))
+                {
+                    float value;
+                    std::memcpy(&value, element + i, sizeof(float));
+
+                    // Adding zero turns -0 into +0 so that both snap to the same key
+                    if (std::isfinite(value))
+                    {
+                        value = std::floor(value / weldStream.epsilon + 0.5f) + 0.0f;
+                    }
+
+                    std::memcpy(key + i, &value, sizeof(float));
+                }
+            }
+            else
+            {
+                std::memcpy(key, element, elementSize);
+            }
+
+            key += elementSize;
+        }
+    }
+
+    // FNV-1a over the key's 32-bit words, which are zero padded
+    uint64_t HashVertexKey(const uint8_t* key, size_t keyStride)
+    {
+        uint64_t hash = 14695981039346656037ULL;
+
+        for (size_t i = 0U; i < keyStride; i += sizeof(uint32_t))
+        {
+            uint32_t word;
+            std::memcpy(&word, key + i, sizeof(uint32_t));
+
+            hash = (hash ^ word) * 1099511628211ULL;
+        }
+
+        return hash ^ (hash >> 32U);
+    }
+
+    // Tom Forsyth's vertex scoring. Vertices used by the most recent triangle get a fixed score (lower than that of the
+    // next few cache positions, so that the next triangle doesn't simply reuse all of them), the rest decay with their
+    // LRU cache position and vertices with few remaining triangles are boosted so they're finished off rather than
+    // left behind as isolated triangles that each cause several cache misses later on.
+    const size_t ForsythCacheSize = 32U;
+    const size_t ForsythMaxValence = 32U;
+
+    const float CacheDecayPower = 1.5f;
+    const float LastTriangleScore = 0.75f;
+    const float ValenceBoostScale = 2.0f;
+    const float ValenceBoostPower = 0.5f;
+
+    class VertexScores
+    {
+    public:
+        VertexScores()
+        {
+            for (size_t i = 0U; i < ForsythCacheSize; i++)
+            {
+                m_cacheScores[i] = i < 3U ? LastTriangleScore : std::pow(1.0f - (i - 3U) / static_cast<float>(ForsythCacheSize - 3U), CacheDecayPower);
+            }
+
+            for (size_t i = 0U; i < ForsythMaxValence; i++)
+            {
+                m_valenceScores[i] = GetValenceScore(i);
+            }
+        }
+
+        // A cache position of ForsythCacheSize or more means the vertex isn't cached
+        float Get(size_t cachePosition, size_t remainingTriangles) const
+        {
+            if (remainingTriangles == 0U)
+            {
+                return -1.0f;
+            }
+
+            const float cacheScore = cachePosition < ForsythCacheSize ? m_cacheScores[cachePosition] : 0.0f;
+            const float valenceScore = remainingTriangles < ForsythMaxValence ? m_valenceScores[remainingTriangles] : GetValenceScore(remainingTriangles);
+
+            return cacheScore + valenceScore;
+        }
+
+    private:
+        static float GetValenceScore(size_t remainingTriangles)
+        {
+            return remainingTriangles == 0U ? 0.0f : ValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -ValenceBoostPower);
+        }
+
+        float m_cacheScores[ForsythCacheSize];
+        float m_valenceScores[ForsythMaxValence];
+    };
+}
+
+size_t MeshOptimizer::VertexStream::GetElementSize() const
+{
+    return Accessor::GetTypeCount(accessorType) * Accessor::GetComponentTypeSize(componentType);
+}
+
+MeshData MeshOptimizer::ReadMeshData(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
+{
+    if (meshPrimitive.mode != MESH_TRIANGLES && meshPrimitive.mode != MESH_TRIANGLE_STRIP && meshPrimitive.mode != MESH_TRIANGLE_FAN)
+    {
+        throw GLTFException("Mesh primitive isn't made of triangles");
+    }
+
+    MeshData meshData;
+    meshData.vertexCount = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_POSITION)).count;
+    meshData.indices = MeshPrimitiveUtils::GetTriangulatedIndices32(doc, reader, meshPrimitive);
+
+    for (uint32_t index : meshData.indices)
+    {
+        ValidateIndex(index, meshData.vertexCount);
+    }
+
+    ReadVertexStreams(doc, reader, meshPrimitive, meshData);
+
+    return meshData;
+}
+
+MeshPrimitive MeshOptimizer::WriteMeshData(const MeshData& meshData, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder)
+{
+    if (meshData.indices.empty())
+    {
+        throw GLTFException("Mesh primitive has no triangles");
+    }
+
+    MeshPrimitive result = meshPrimitive;
+    result.mode = MESH_TRIANGLES;
+    result.indicesAccessorId = WriteIndices(meshData.indices, GetIndexComponentType(meshData.vertexCount, false), bufferBuilder);
+
+    WriteVertexStreams(meshData, result, bufferBuilder);
+
+    return result;
+}
+
+void MeshOptimizer::RemapVertices(MeshData& meshData, const std::vector<uint32_t>& remap, size_t vertexCount)
+{
+    if (remap.size() != meshData.vertexCount)
+    {
+        throw GLTFException("Remap table has " + std::to_string(remap.size()) + " entries but the mesh has " + std::to_string(meshData.vertexCount) + " vertices");
+    }
+
+    for (uint32_t index : remap)
+    {
+        if (index != InvalidIndex)
+        {
+            ValidateIndex(index, vertexCount);
+        }
+    }
+
+    std::vector<uint32_t> indices(meshData.indices.size());
+
+    for (size_t i = 0U; i < indices.size(); i++)
+    {
+        ValidateIndex(meshData.indices[i], meshData.vertexCount);
+
+        indices[i] = remap[meshData.indices[i]];
+
+        if (indices[i] == InvalidIndex)
+        {
+            throw GLTFException("Remap table removes a vertex that is referenced by the mesh's indices");
+        }
+    }
+
+    meshData.indices = std::move(indices);
+
+    for (auto& stream : meshData.attributes)
+    {
+        RemapVertexStream(stream, remap, vertexCount);
+    }
+
+    for (auto& target : meshData.targets)
+    {
+        for (auto& stream : target)
+        {
+            RemapVertexStream(stream, remap, vertexCount);
+        }
+    }
+
+    meshData.vertexCount = vertexCount;
+}
+
+VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize)
+{
+    VertexCacheStatistics statistics;
+
+    // A FIFO cache is simulated by recording when each vertex was added: a vertex has been evicted once 'cacheSize'
+    // other vertices have been added after it
+    std::vector<size_t> cacheTimestamps(vertexCount, 0U);
+    size_t timestamp = cacheSize + 1U;
+
+    for (uint32_t index : indices)
+    {
+        ValidateIndex(index, vertexCount);
+
+        if (timestamp - cacheTimestamps[index] > cacheSize)
+        {
+            cacheTimestamps[index] = timestamp++;
+            statistics.transformedVertexCount++;
+        }
+    }
+
+    const size_t triangleCount = indices.size() / 3U;
+
+    statistics.acmr = triangleCount == 0U ? 0.0f : static_cast<float>(statistics.transformedVertexCount) / triangleCount;
+    statistics.atvr = vertexCount == 0U ? 0.0f : static_cast<float>(statistics.transformedVertexCount) / vertexCount;
+
+    return statistics;
+}
+
+std::vector<uint32_t> MeshOptimizer::OptimizeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount)
+{
+    if (indices.size() % 3U != 0U)
+    {
+        throw GLTFException("Index count " + std::to_string(indices.size()) + " isn't a multiple of 3");
+    }
+
+    const size_t triangleCount = indices.size() / 3U;
+    const size_t NoTriangle = std::numeric_limits<size_t>::max();
+
+    // Each vertex's remaining triangles are the first 'remainingTriangles[v]' entries of its adjacency list
+    std::vector<uint32_t> remainingTriangles(vertexCount, 0U);
+
+    for (uint32_t index : indices)
+    {
+        ValidateIndex(index, vertexCount);
+        remainingTriangles[index]++;
+    }
+
+    std::vector<size_t> adjacencyOffsets(vertexCount + 1U, 0U);
+    std::partial_sum(remainingTriangles.begin(), remainingTriangles.end(), adjacencyOffsets.begin() + 1U);
+
+    std::vector<uint32_t> adjacency(indices.size());
+
+    {
+        std::vector<size_t> adjacencyEnds(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1U);
+
+        for (size_t i = 0U; i < indices.size(); i++)
+        {
+            adjacency[adjacencyEnds[indices[i]]++] = static_cast<uint32_t>(i / 3U);
+        }
+    }
+
+    const VertexScores scores;
+
+    std::vector<float> vertexScores(vertexCount);
+
+    for (size_t i = 0U; i < vertexCount; i++)
+    {
+        vertexScores[i] = scores.Get(ForsythCacheSize, remainingTriangles[i]);
+    }
+
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<bool> isEmitted(triangleCount, false);
+
+    size_t bestTriangle = NoTriangle;
+    float bestScore = -1.0f;
+
+    for (size_t i = 0U; i < triangleCount; i++)
+    {
+        triangleScores[i] = vertexScores[indices[i * 3U]] + vertexScores[indices[i * 3U + 1U]] + vertexScores[indices[i * 3U + 2U]];
+
+        if (triangleScores[i] > bestScore)
+        {
+            bestTriangle = i;
+            bestScore = triangleScores[i];
+        }
+    }
+
+    // The cache holds the vertices of the most recent triangle at its front. It has room for the three vertices that
+    // are pushed out of it by each triangle so that their scores can be updated.
+    uint32_t cache[ForsythCacheSize + 3U];
+    size_t cacheCount = 0U;
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+
+    size_t nextTriangle = 0U;
+
+    for (size_t emittedCount = 0U; emittedCount < triangleCount; emittedCount++)
+    {
+        if (bestTriangle == NoTriangle)
+        {
+            // No cached vertex has any remaining triangles, so continue from the next triangle in the input's order
+            while (isEmitted[nextTriangle])
+            {
+                nextTriangle++;
+            }
+
+            bestTriangle = nextTriangle;
+        }
+
+        const uint32_t* triangle = indices.data() + bestTriangle * 3U;
+
+        result.insert(result.end(), triangle, triangle + 3U);
+        isEmitted[bestTriangle] = true;
+
+        // Remove the triangle from each of its vertices' adjacency lists (twice from a vertex that it uses twice)
+        for (size_t i = 0U; i < 3U; i++)
+        {
+            uint32_t* vertexTriangles = adjacency.data() + adjacencyOffsets[triangle[i]];
+            uint32_t& remaining = remainingTriangles[triangle[i]];
+
+            std::swap(*std::find(vertexTriangles, vertexTriangles + remaining, static_cast<uint32_t>(bestTriangle)), vertexTriangles[remaining - 1U]);
+            remaining--;
+        }
+
+        // Move the triangle's vertices to the front of the cache
+        uint32_t newCache[ForsythCacheSize + 3U];
+        size_t newCacheCount = 0U;
+
+        for (size_t i = 0U; i < 3U; i++)
+        {
+            if (std::find(newCache, newCache + newCacheCount, triangle[i]) == newCache + newCacheCount)
+            {
+                newCache[newCacheCount++] = triangle[i];
+            }
+        }
+
+        for (size_t i = 0U; i < cacheCount; i++)
+        {
+            if (std::find(triangle, triangle + 3U, cache[i]) == triangle + 3U)
+            {
+                newCache[newCacheCount++] = cache[i];
+            }
+        }
+
+        // Rescore the cache's vertices, including those just pushed out of it, along with their remaining triangles
+        for (size_t i = 0U; i < newCacheCount; i++)
+        {
+            const uint32_t vertex = newCache[i];
+            const float score = scores.Get(i, remainingTriangles[vertex]);
+            const float scoreDelta = score - vertexScores[vertex];
+
+            vertexScores[vertex] = score;
+
+            for (size_t j = 0U; j < remainingTriangles[vertex]; j++)
+            {
+                triangleScores[adjacency[adjacencyOffsets[vertex] + j]] += scoreDelta;
+            }
+        }
+
+        cacheCount = std::min(newCacheCount, ForsythCacheSize);
+        std::copy(newCache, newCache + cacheCount, cache);
+
+        // The next triangle is the best of those that use a cached vertex
+        bestTriangle = NoTriangle;
+        bestScore = -1.0f;
+
+        for (size_t i = 0U; i < cacheCount; i++)
+        {
+            const uint32_t vertex = cache[i];
+
+            for (size_t j = 0U; j < remainingTriangles[vertex]; j++)
+            {
+                const uint32_t candidate = adjacency[adjacencyOffsets[vertex] + j];
+
+                if (triangleScores[candidate] > bestScore)
+                {
+                    bestTriangle = candidate;
+                    bestScore = triangleScores[candidate];
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+std::vector<uint32_t> MeshOptimizer::OptimizeVertexFetch(const std::vector<uint32_t>& indices, size_t& vertexCount)
+{
+    std::vector<uint32_t> remap(vertexCount, InvalidIndex);
+    uint32_t nextVertex = 0U;
+
+    for (uint32_t index : indices)
+    {
+        ValidateIndex(index, vertexCount);
+
+        if (remap[index] == InvalidIndex)
+        {
+            remap[index] = nextVertex++;
+        }
+    }
+
+    vertexCount = nextVertex;
+
+    return remap;
+}
+
+void MeshOptimizer::OptimizeVertexOrder(MeshData& meshData, VertexOrderStatistics* statistics)
+{
+    if (statistics)
+    {
+        statistics->before = AnalyzeVertexCache(meshData.indices, meshData.vertexCount);
+    }
+
+    meshData.indices = OptimizeVertexCache(meshData.indices, meshData.vertexCount);
+
+    size_t vertexCount = meshData.vertexCount;
+    const auto remap = OptimizeVertexFetch(meshData.indices, vertexCount);
+
+    RemapVertices(meshData, remap, vertexCount);
+
+    if (statistics)
+    {
+        statistics->after = AnalyzeVertexCache(meshData.indices, meshData.vertexCount);
+    }
+}
+
+MeshData MeshOptimizer::OptimizeVertexOrder(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, VertexOrderStatistics* statistics)
+{
+    auto meshData = ReadMeshData(doc, reader, meshPrimitive);
+
+    OptimizeVertexOrder(meshData, statistics);
+
+    return meshData;
+}
+
+MeshPrimitive MeshOptimizer::OptimizeVertexOrder(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder, VertexOrderStatistics* statistics)
+{
+    return WriteMeshData(OptimizeVertexOrder(doc, reader, meshPrimitive, statistics), meshPrimitive, bufferBuilder);
+}
+
+std::vector<uint32_t> MeshOptimizer::GenerateWeldRemap(const MeshData& meshData, size_t& vertexCount, const WeldOptions& options)
+{
+    const size_t count = meshData.vertexCount;
+
+    if (count >= InvalidIndex)
+    {
+        throw GLTFException("Mesh has too many vertices to weld");
+    }
+
+    const auto streams = GetWeldStreams(meshData, options);
+
+    size_t keySize = 0U;
+
+    for (const auto& weldStream : streams)
+    {
+        keySize += weldStream.stream->GetElementSize();
+    }
+
+    const size_t keyStride = (keySize + 3U) & ~size_t(3U);
+    const size_t threadCount = count < options.minParallelVertexCount ? 1U : Parallel::GetThreadCount(options.threadCount);
+
+    std::vector<uint8_t> keys(count * keyStride, 0U);
+    std::vector<uint64_t> hashes(count);
+
+    const size_t blockSize = 4096U;
+
+    Parallel::For((count + blockSize - 1U) / blockSize, threadCount, [&](size_t block)
+    {
+        for (size_t i = block * blockSize; i < std::min(count, (block + 1U) * blockSize); i++)
+        {
+            WriteVertexKey(streams, i, keys.data() + i * keyStride);
+            hashes[i] = HashVertexKey(keys.data() + i * keyStride, keyStride);
+        }
+    });
+
+    // Vertices are partitioned by hash, so identical vertices are always in the same partition and each partition's
+    // hash table can be built independently. Each vertex is mapped to the first vertex that is identical to it.
+    std::vector<uint32_t> firstVertices(count);
+
+    auto getPartition = [threadCount](uint64_t hash)
+    {
+        return static_cast<size_t>(hash >> 32U) % threadCount;
+    };
+
+    Parallel::For(threadCount, threadCount, [&](size_t partition)
+    {
+        size_t partitionCount = 0U;
+
+        for (size_t i = 0U; i < count; i++)
+        {
+            if (getPartition(hashes[i]) == partition)
+            {
+                partitionCount++;
+            }
+        }
+
+        size_t tableSize = 1U;
+
+        while (tableSize < partitionCount * 2U)
+        {
+            tableSize *= 2U;
+        }
+
+        std::vector<uint32_t> table(tableSize, InvalidIndex);
+
+        for (size_t i = 0U; i < count; i++)
+        {
+            if (getPartition(hashes[i]) != partition)
+            {
+                continue;
+            }
+
+            for (size_t slot = hashes[i] & (tableSize - 1U);; slot = (slot + 1U) & (tableSize - 1U))
+            {
+                const uint32_t candidate = table[slot];
+
+                if (candidate == InvalidIndex)
+                {
+                    table[slot] = static_cast<uint32_t>(i);
+                    firstVertices[i] = static_cast<uint32_t>(i);
+                    break;
+                }
+
+                if (hashes[candidate] == hashes[i] && std::memcmp(keys.data() + candidate * keyStride, keys.data() + i * keyStride, keyStride) == 0)
+                {
+                    firstVertices[i] = candidate;
+                    break;
+                }
+            }
+        }
+    });
+
+    std::vector<uint32_t> remap(count);
+    uint32_t nextVertex = 0U;
+
+    for (size_t i = 0U; i < count; i++)
+    {
+        remap[i] = firstVertices[i] == i ? nextVertex++ : remap[firstVertices[i]];
+    }
+
+    vertexCount = nextVertex;
+
+    return remap;
+}
+
+void MeshOptimizer::WeldVertices(MeshData& meshData, const WeldOptions& options)
+{
+    size_t vertexCount;
+    const auto remap = GenerateWeldRemap(meshData, vertexCount, options);
+
+    RemapVertices(meshData, remap, vertexCount);
+}
+
+MeshData MeshOptimizer::WeldVertices(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, const WeldOptions& options)
+{
+    auto meshData = ReadMeshData(doc, reader, meshPrimitive);
+
+    WeldVertices(meshData, options);
+
+    return meshData;
+}
+
+MeshPrimitive MeshOptimizer::WeldVertices(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder, const WeldOptions& options)
+{
+    return WriteMeshData(WeldVertices(doc, reader, meshPrimitive, options), meshPrimitive, bufferBuilder);
+}
+
+ComponentType MeshOptimizer::GetIndexComponentType(size_t vertexCount, bool allowUnsignedByte)
+{
+    // The largest value of each component type is reserved for primitive restart
+    if (allowUnsignedByte && vertexCount <= std::numeric_limits<uint8_t>::max())
+    {
+        return COMPONENT_UNSIGNED_BYTE;
+    }
+
+    if (vertexCount <= std::numeric_limits<uint16_t>::max())
+    {
+        return COMPONENT_UNSIGNED_SHORT;
+    }
+
+    return COMPONENT_UNSIGNED_INT;
+}
+
+MeshPrimitive MeshOptimizer::CompactIndices(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder, const CompactOptions& options)
+{
+    if (meshPrimitive.indicesAccessorId.empty() || meshPrimitive.attributes.empty())
+    {
+        return meshPrimitive;
+    }
+
+    const Accessor& indicesAccessor = doc.accessors.Get(meshPrimitive.indicesAccessorId);
+    const uint32_t restartIndex = GetRestartIndex(indicesAccessor.componentType);
+
+    MeshData meshData;
+    meshData.vertexCount = doc.accessors.Get(meshPrimitive.attributes.begin()->second).count;
+    meshData.indices = MeshPrimitiveUtils::GetIndices32(doc, reader, indicesAccessor);
+
+    // Referenced vertices are numbered in their original order
+    std::vector<uint32_t> remap(meshData.vertexCount, InvalidIndex);
+
+    for (auto& index : meshData.indices)
+    {
+        if (index == restartIndex)
+        {
+            index = InvalidIndex;
+        }
+        else
+        {
+            ValidateIndex(index, meshData.vertexCount);
+            remap[index] = 0U;
+        }
+    }
+
+    uint32_t referencedVertexCount = 0U;
+
+    for (auto& index : remap)
+    {
+        if (index != InvalidIndex)
+        {
+            index = referencedVertexCount++;
+        }
+    }
+
+    const bool isRebased = referencedVertexCount < meshData.vertexCount && referencedVertexCount <= options.maxReferencedVertexRatio * meshData.vertexCount;
+    const auto componentType = GetIndexComponentType(isRebased ? referencedVertexCount : meshData.vertexCount, options.allowUnsignedByteIndices);
+
+    if (!isRebased && Accessor::GetComponentTypeSize(componentType) >= Accessor::GetComponentTypeSize(indicesAccessor.componentType))
+    {
+        return meshPrimitive;
+    }
+
+    MeshPrimitive result = meshPrimitive;
+
+    if (isRebased)
+    {
+        ReadVertexStreams(doc, reader, meshPrimitive, meshData);
+
+        for (auto& stream : meshData.attributes)
+        {
+            RemapVertexStream(stream, remap, referencedVertexCount);
+        }
+
+        for (auto& target : meshData.targets)
+        {
+            for (auto& stream : target)
+            {
+                RemapVertexStream(stream, remap, referencedVertexCount);
+            }
+        }
+
+        for (auto& index : meshData.indices)
+        {
+            if (index != InvalidIndex)
+            {
+                index = remap[index];
+            }
+        }
+
+        meshData.vertexCount = referencedVertexCount;
+
+        WriteVertexStreams(meshData, result, bufferBuilder);
+    }
+
+    result.indicesAccessorId = WriteIndices(meshData.indices, componentType, bufferBuilder);
+
+    return result;
+}
+
+void MeshOptimizer::CompactIndices(Document& doc, const GLTFResourceReader& reader, BufferBuilder& bufferBuilder, const CompactOptions& options)
+{
+    for (size_t i = 0U; i < doc.meshes.Size(); i++)
+    {
+        Mesh mesh = doc.meshes[i];
+
+        for (auto& meshPrimitive : mesh.primitives)
+        {
+            meshPrimitive = CompactIndices(doc, reader, meshPrimitive, bufferBuilder, options);
+        }
+
+        doc.meshes.Replace(std::move(mesh));
+    }
+}
@@ -6,386 +6,335 @@
 #include <GLTFSDK/GLTF.h>
 #include <GLTFSDK/GLTFResourceReader.h>
 #include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/ConversionKernels.h>
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
 #include <numeric>
 
 using namespace Microsoft::glTF;
 
 namespace
 {
-    uint64_t ToUint64(const uint16_t short0, const uint16_t short1, const uint16_t short2, const uint16_t short3)
+    void ValidateOutputCount(size_t outputCount, size_t requiredCount)
     {
-        return
-            static_cast<uint64_t>(short3) << 48UL |
-            static_cast<uint64_t>(short2) << 32UL |
-            static_cast<uint64_t>(short1) << 16UL |
-            static_cast<uint64_t>(short0);
+        if (outputCount < requiredCount)
+        {
+            throw GLTFException("Output buffer has space for " + std::to_string(outputCount) + " values but " + std::to_string(requiredCount) + " are required");
+        }
     }
 
-    uint64_t ToUint64(const uint8_t byte0, const uint8_t byte1, const uint8_t byte2, const uint8_t byte3)
+    // Allocates the result of a vector returning getter. The accessor is validated first so that a corrupt
+    // count is reported as a GLTFException rather than an attempt to allocate an arbitrary amount of memory.
+    template<typename T>
+    std::vector<T> MakeOutput(const Document& doc, const Accessor& accessor, size_t valuesPerElement)
     {
-        return
-            static_cast<uint64_t>(byte3) << 48UL |
-            static_cast<uint64_t>(byte2) << 32UL |
-            static_cast<uint64_t>(byte1) << 16UL |
-            static_cast<uint64_t>(byte0);
-    }
+        Validation::ValidateAccessor(doc, accessor);
 
-    uint32_t ToUint32(const uint8_t byte0, const uint8_t byte1, const uint8_t byte2, const uint8_t byte3)
-    {
-        return
-            static_cast<uint32_t>(byte3) << 24U |
-            static_cast<uint32_t>(byte2) << 16U |
-            static_cast<uint32_t>(byte1) <<  8U |
-            static_cast<uint32_t>(byte0);
+        return std::vector<T>(accessor.count * valuesPerElement);
     }
 
+    // The output buffer getters read the accessor's raw components into the front of the caller's buffer and then
+    // convert them in place with the vectorized ConversionKernels. Each converted value is at least as large as the
+    // components it's made from so the kernels can do this without overwriting any component before it's read.
     template<typename TIn, typename TOut>
-    std::vector<TOut> ReadIndices(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
+    size_t ReadIndices(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, TOut* output, size_t outputCount, void (*fnWiden)(const TIn*, TOut*, size_t))
     {
-        assert(sizeof(TOut) > sizeof(TIn));
+        const size_t count = reader.ReadBinaryData<TIn>(doc, accessor, reinterpret_cast<TIn*>(output), outputCount);
 
-        const auto indices = reader.ReadBinaryData<TIn>(doc, accessor);
-        return std::vector<TOut>(indices.begin(), indices.end());
+        fnWiden(reinterpret_cast<const TIn*>(output), output, count);
+
+        return count;
     }
 
-    std::vector<uint32_t> PackColorsRGBA(const std::vector<float>& colors)
+    // Reads an accessor whose elements, e.g. four 8-bit joint indices, are already laid out as the packed output value.
+    // glTF binary data is little-endian, as is the packed output format, so no conversion is required.
+    template<typename TIn, typename TOut>
+    TIn* ReadPacked(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, TOut* output, size_t outputCount)
     {
-        assert(colors.size() % 4 == 0);
+        assert(Accessor::GetTypeCount(accessor.type) * sizeof(TIn) <= sizeof(TOut));
 
-        std::vector<uint32_t> colors32;
-        colors32.reserve(colors.size() / 4);
-
-        for (size_t i = 0; i < colors.size(); i += 4)
-        {
-            colors32.push_back(Color4(colors[i], colors[i + 1], colors[i + 2], colors[i + 3]).AsUint32RGBA());
-        }
+        ValidateOutputCount(outputCount, accessor.count);
 
-        return colors32;
+        const auto rawData = reinterpret_cast<TIn*>(output);
+        reader.ReadBinaryData<TIn>(doc, accessor, rawData, (outputCount * sizeof(TOut)) / sizeof(TIn));
+        return rawData;
     }
 
-    std::vector<uint32_t> PackColorsRGB(const std::vector<float>& colors)
+    // Unlike the other conversions, packing floats shrinks the data so it can't be done in place
+    size_t PackFloats(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, uint32_t* output, size_t outputCount)
     {
-        assert(colors.size() % 3 == 0);
+        ValidateOutputCount(outputCount, accessor.count);
 
-        std::vector<uint32_t> colors32;
-        colors32.reserve(colors.size() / 3);
+        const std::vector<float> floatData = reader.ReadFloatData(doc, accessor);
 
-        for (size_t i = 0; i < colors.size(); i += 3)
+        if (accessor.type == TYPE_VEC4)
         {
-            colors32.push_back(Color4(colors[i], colors[i + 1], colors[i + 2], 1.0f).AsUint32RGBA());
+            ConversionKernels::PackUnorm8x4(floatData.data(), output, accessor.count);
         }
-
-        return colors32;
-    }
-
-    std::vector<uint32_t> PackColorsRGBA(const std::vector<uint8_t>& colors)
-    {
-        assert(colors.size() % 4 == 0);
-
-        std::vector<uint32_t> colors32;
-        colors32.reserve(colors.size() / 4);
-
-        for (size_t i = 0; i < colors.size(); i += 4)
+        else
         {
-            uint8_t r = colors[i];
-            uint8_t g = colors[i + 1];
-            uint8_t b = colors[i + 2];
-            uint8_t a = colors[i + 3];
-            uint32_t rgba = ToUint32(r, g, b, a);
-            colors32.push_back(rgba);
+            ConversionKernels::PackUnorm8x3(floatData.data(), output, accessor.count);
         }
 
-        return colors32;
+        return accessor.count;
     }
 
-    std::vector<uint32_t> PackColorsRGB(const std::vector<uint8_t>& colors)
+    size_t PackColors(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, uint32_t* colors32, size_t colors32Count)
     {
-        assert(colors.size() % 3 == 0);
+        if (accessor.componentType == COMPONENT_UNSIGNED_BYTE)
+        {
+            const uint8_t* rawData = ReadPacked<uint8_t>(doc, reader, accessor, colors32, colors32Count);
 
-        std::vector<uint32_t> colors32;
-        colors32.reserve(colors.size() / 3);
+            if (accessor.type == TYPE_VEC3)
+            {
+                ConversionKernels::ExpandRGB8ToRGBA8(rawData, colors32, accessor.count);
+            }
 
-        for (size_t i = 0; i < colors.size(); i += 3)
+            return accessor.count;
+        }
+        else
         {
-            uint8_t r = colors[i];
-            uint8_t g = colors[i + 1];
-            uint8_t b = colors[i + 2];
-            uint32_t rgba = ToUint32(r, g, b, 255);
-            colors32.push_back(rgba);
+            return PackFloats(doc, reader, accessor, colors32, colors32Count);
         }
-
-        return colors32;
     }
 
-    std::vector<uint32_t> ReadJoints32(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
+    size_t PackWeights32(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, uint32_t* weights32, size_t weights32Count)
     {
-        std::vector<uint8_t> joints = reader.ReadBinaryData<uint8_t>(doc, accessor);
-        std::vector<uint32_t> joints32;
-        joints32.reserve(joints.size() / 4);
-        for (size_t i = 0; i < joints.size(); i += 4)
+        if (accessor.componentType == COMPONENT_UNSIGNED_BYTE)
         {
-            joints32.push_back(ToUint32(joints[i], joints[i + 1], joints[i + 2], joints[i + 3]));
+            ReadPacked<uint8_t>(doc, reader, accessor, weights32, weights32Count);
+            return accessor.count;
         }
-        return joints32;
-    }
-
-    std::vector<uint64_t> ReadJoints64(const std::vector<uint8_t>& joints)
-    {
-        std::vector<uint64_t> joints64;
-        joints64.reserve(joints.size() / 4);
-        for (size_t i = 0; i < joints.size(); i += 4)
+        else
         {
-            joints64.push_back(ToUint64(joints[i], joints[i + 1], joints[i + 2], joints[i + 3]));
+            return PackFloats(doc, reader, accessor, weights32, weights32Count);
         }
-        return joints64;
     }
 
-    std::vector<uint64_t> ReadJoints64(const std::vector<uint16_t>& joints)
+    size_t GetRawIndexCount(const Document& doc, const MeshPrimitive& meshPrimitive)
     {
-        std::vector<uint64_t> joints64;
-        joints64.reserve(joints.size() / 4);
-        for (size_t i = 0; i < joints.size(); i += 4)
+        if (doc.accessors.Has(meshPrimitive.indicesAccessorId))
         {
-            joints64.push_back(ToUint64(joints[i], joints[i + 1], joints[i + 2], joints[i + 3]));
+            return doc.accessors.Get(meshPrimitive.indicesAccessorId).count;
         }
-        return joints64;
-    }
 
-    template<typename T>
-    std::vector<uint64_t> ReadJoints64(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
-    {
-        std::vector<T> joints = reader.ReadBinaryData<T>(doc, accessor);
-        return ReadJoints64(joints);
+        return doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_POSITION)).count;
     }
 
-    std::vector<uint32_t> PackWeights32(const std::vector<float>& weights)
+    size_t GetTriangulatedIndexCount(const MeshMode meshMode, size_t rawIndexCount)
     {
-        std::vector<uint32_t> weights32;
-        weights32.reserve(weights.size() / 4);
-        for (size_t i = 0; i < weights.size(); i += 4)
+        if (rawIndexCount < 3)
         {
-            weights32.push_back(
-                ToUint32(
-                    Math::FloatToByte(weights[i]),
-                    Math::FloatToByte(weights[i + 1]),
-                    Math::FloatToByte(weights[i + 2]),
-                    Math::FloatToByte(weights[i + 3])));
+            throw GLTFException("MeshPrimitive has fewer than 3 indices.");
         }
-        return weights32;
-    }
 
-    std::vector<uint32_t> PackWeights32(const std::vector<uint8_t>& weights)
-    {
-        std::vector<uint32_t> weights32;
-        weights32.reserve(weights.size() / 4);
-        for (size_t i = 0; i < weights.size(); i += 4)
+        switch (meshMode)
         {
-            weights32.push_back(
-                ToUint32(
-                    weights[i],
-                    weights[i + 1],
-                    weights[i + 2],
-                    weights[i + 3]));
+        case MESH_TRIANGLES:
+            if (rawIndexCount % 3 != 0)
+            {
+                throw GLTFException("MeshPrimitives with mode MESH_TRIANGLES has non-multiple-of-3 indices.");
+            }
+            return rawIndexCount;
+        case MESH_TRIANGLE_STRIP:
+        case MESH_TRIANGLE_FAN:
+            return (rawIndexCount - 2) * 3;
+        default:
+            throw GLTFException("Invalid mesh mode for triangulation " + std::to_string(meshMode));
         }
-        return weights32;
     }
 
-    template<typename T>
-    std::vector<T> GetTrianglesFromTriangleStrip(const std::vector<T>& stripIndices)
+    size_t GetSegmentedIndexCount(const MeshMode meshMode, size_t rawIndexCount)
     {
-        if (stripIndices.size() < 3)
+        if (rawIndexCount < 2)
         {
-            throw GLTFException("Triangle strip must contain at least 3 vertices.");
+            throw GLTFException("MeshPrimitive has fewer than 2 indices.");
         }
 
-        const size_t triangleCount = stripIndices.size() - 2;
-
-        std::vector<T> indices;
-        indices.reserve(triangleCount * 3);
-
-        // vertexCount = 5
-        // triangleCount = 3
-        // indices:
-        //     0,1,2
-        //     1,3,2
-        //     2,3,4
-        for (size_t i = 0; i < triangleCount; i++)
+        switch (meshMode)
         {
-            if (i % 2 == 0)
-            {
-                indices.push_back(stripIndices[i]);
-                indices.push_back(stripIndices[i + 1]);
-                indices.push_back(stripIndices[i + 2]);
-            }
-            else
+        case MESH_LINES:
+            if (rawIndexCount % 2 != 0)
             {
-                indices.push_back(stripIndices[i]);
-                indices.push_back(stripIndices[i + 2]);
-                indices.push_back(stripIndices[i + 1]);
+                throw GLTFException("MeshPrimitives with mode MESH_LINES has non-multiple-of-2 indices.");
             }
+            return rawIndexCount;
+        case MESH_LINE_STRIP:
+            return (rawIndexCount - 1) * 2;
+        case MESH_LINE_LOOP:
+            return rawIndexCount * 2;
+        default:
+            throw GLTFException("Invalid mesh mode for triangulation " + std::to_string(meshMode));
         }
-
-        return indices;
     }
 
-    template<typename T>
-    std::vector<T> GetTrianglesFromTriangleFan(const std::vector<T>& fanIndices)
+    size_t GetOrCreateIndices(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint16_t* indices, size_t indexCount)
     {
-        if (fanIndices.size() < 3)
+        if (doc.accessors.Has(meshPrimitive.indicesAccessorId))
         {
-            throw GLTFException("Triangle fan must contain at least 3 vertices.");
+            const auto& indicesAccessor = doc.accessors.Get(meshPrimitive.indicesAccessorId);
+            return MeshPrimitiveUtils::GetIndices16(doc, reader, indicesAccessor, indices, indexCount);
         }
+        else
+        {
+            size_t vertexCount = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_POSITION)).count;
+
+            if (vertexCount > std::numeric_limits<uint16_t>::max())
+            {
+                throw GLTFException("Cannot generate 16-bit indices for MeshPrimitive with " + std::to_string(vertexCount) + " vertices.");
+            }
 
-        const size_t triangleCount = fanIndices.size() - 2;
+            ValidateOutputCount(indexCount, vertexCount);
 
-        std::vector<T> indices;
-        indices.reserve(triangleCount * 3);
+            std::iota(indices, indices + vertexCount, static_cast<uint16_t>(0U));
+            return vertexCount;
+        }
+    }
 
-        // vertexCount = 5
-        // triangleCount = 3
-        // indices:
-        //     0,1,2
-        //     0,2,3
-        //     0,3,4
-        for (size_t i = 0; i < triangleCount; i++)
+    size_t GetOrCreateIndices(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint32_t* indices, size_t indexCount)
+    {
+        if (doc.accessors.Has(meshPrimitive.indicesAccessorId))
         {
-            indices.push_back(fanIndices[0]);
-            indices.push_back(fanIndices[i + 1]);
-            indices.push_back(fanIndices[i + 2]);
+            const auto& indicesAccessor = doc.accessors.Get(meshPrimitive.indicesAccessorId);
+            return MeshPrimitiveUtils::GetIndices32(doc, reader, indicesAccessor, indices, indexCount);
         }
+        else
+        {
+            size_t vertexCount = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_POSITION)).count;
 
-        return indices;
+            ValidateOutputCount(indexCount, vertexCount);
+
+            std::iota(indices, indices + vertexCount, static_cast<uint32_t>(0U));
+            return vertexCount;
+        }
     }
 
+    // Primitive restart values aren't allowed in glTF indices accessors but are common in strip encoded source data.
+    // The restart value is the largest value of the accessor's component type, which generated indices never contain.
     template<typename T>
-    std::vector<T> GetSegmentsFromLineStrip(const std::vector<T>& stripIndices)
+    T GetRestartIndex(const Document& doc, const MeshPrimitive& meshPrimitive)
     {
-        if (stripIndices.size() < 2)
+        if (doc.accessors.Has(meshPrimitive.indicesAccessorId))
         {
-            throw GLTFException("Line must contain at least 2 vertices.");
+            switch (doc.accessors.Get(meshPrimitive.indicesAccessorId).componentType)
+            {
+            case COMPONENT_UNSIGNED_BYTE:
+                return std::numeric_limits<uint8_t>::max();
+            case COMPONENT_UNSIGNED_SHORT:
+                return static_cast<T>(std::numeric_limits<uint16_t>::max());
+            default:
+                break;
+            }
         }
 
-        const size_t segmentCount = stripIndices.size() - 1;
+        return std::numeric_limits<T>::max();
+    }
 
-        std::vector<T> indices;
-        indices.reserve(segmentCount * 2);
+    // Expands each run of indices between restart values with 'fnExpand', skipping any that are too short to form
+    // a primitive, and returns the total number of indices written to 'output'
+    template<typename T, typename FnExpand>
+    size_t ExpandRuns(const T* indices, size_t indexCount, T restartIndex, size_t minRunLength, T* output, FnExpand fnExpand)
+    {
+        size_t outputCount = 0U;
 
-        // vertexCount = 4
-        // segmentCount = 3
-        // indices:
-        //     0,1
-        //     1,2
-        //     2,3
-        //     3,4
-        for (size_t i = 0; i < segmentCount; i++)
+        for (size_t runStart = 0U; runStart < indexCount;)
         {
-            indices.push_back(stripIndices[i]);
-            indices.push_back(stripIndices[i + 1]);
+            const size_t runEnd = std::find(indices + runStart, indices + indexCount, restartIndex) - indices;
+
+            if (runEnd - runStart >= minRunLength)
+            {
+                outputCount += fnExpand(indices + runStart, runEnd - runStart, output + outputCount);
+            }
+
+            runStart = runEnd + 1U;
         }
 
-        return indices;
+        return outputCount;
     }
 
     template<typename T>
-    std::vector<T> GetSegmentsFromLineLoop(const std::vector<T>& stripIndices)
+    size_t LineLoopToList(const T* indices, size_t indexCount, T* output)
     {
-        auto indices = GetSegmentsFromLineStrip(stripIndices);
+        const T index0 = indices[indexCount - 1U];
+        const T index1 = indices[0];
 
-        const size_t segmentCount = stripIndices.size();
-        indices.push_back(stripIndices[segmentCount - 1]);
-        indices.push_back(stripIndices[0]);
+        ConversionKernels::LineStripToList(indices, output, indexCount - 1U);
 
-        return indices;
+        output[(indexCount - 1U) * 2U] = index0;
+        output[(indexCount - 1U) * 2U + 1U] = index1;
+
+        return indexCount * 2U;
     }
 
+    // Strips, fans and loops are expanded front to back from raw indices read into the back of the output buffer. Each
+    // primitive consumes at least one raw index, so the expanded indices never overwrite a raw index before it's read.
     template<typename T>
-    std::vector<T> GetTriangulatedIndices(const MeshMode meshMode, const std::vector<T>& rawIndices)
+    size_t GetTriangulatedIndices(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, T* indices, size_t indexCount)
     {
-        if (rawIndices.size() < 3)
-        {
-            throw GLTFException("MeshPrimitive has fewer than 3 indices.");
-        }
+        const size_t rawIndexCount = GetRawIndexCount(doc, meshPrimitive);
+        const size_t triangulatedIndexCount = GetTriangulatedIndexCount(meshPrimitive.mode, rawIndexCount);
 
-        switch (meshMode)
+        ValidateOutputCount(indexCount, triangulatedIndexCount);
+
+        if (meshPrimitive.mode == MESH_TRIANGLES)
         {
-        case MESH_TRIANGLES:
-            if (rawIndices.size() % 3 != 0)
-            {
-                throw GLTFException("MeshPrimitives with mode MESH_TRIANGLES has non-multiple-of-3 indices.");
-            }
-            return rawIndices;
-        case MESH_TRIANGLE_STRIP:
-            return GetTrianglesFromTriangleStrip(rawIndices);
-        case MESH_TRIANGLE_FAN:
-            return GetTrianglesFromTriangleFan(rawIndices);
-        default:
-            throw GLTFException("Invalid mesh mode for triangulation " + std::to_string(meshMode));
+            return GetOrCreateIndices(doc, reader, meshPrimitive, indices, indexCount);
         }
-    }
 
-    template<typename T>
-    std::vector<T> GetSegmentedIndices(const MeshMode meshMode, const std::vector<T>& rawIndices)
-    {
-        if (rawIndices.size() < 2)
+        T* rawIndices = indices + (triangulatedIndexCount - rawIndexCount);
+        GetOrCreateIndices(doc, reader, meshPrimitive, rawIndices, rawIndexCount);
+
+        const T restartIndex = GetRestartIndex<T>(doc, meshPrimitive);
+
+        if (meshPrimitive.mode == MESH_TRIANGLE_STRIP)
         {
-            throw GLTFException("MeshPrimitive has fewer than 2 indices.");
+            return ExpandRuns(rawIndices, rawIndexCount, restartIndex, 3U, indices, [](const T* run, size_t runLength, T* output)
+            {
+                ConversionKernels::TriangleStripToList(run, output, runLength - 2U);
+                return (runLength - 2U) * 3U;
+            });
         }
-
-        switch (meshMode)
+        else
         {
-        case MESH_LINES:
-            if (rawIndices.size() % 2 != 0)
+            return ExpandRuns(rawIndices, rawIndexCount, restartIndex, 3U, indices, [](const T* run, size_t runLength, T* output)
             {
-                throw GLTFException("MeshPrimitives with mode MESH_LINES has non-multiple-of-2 indices.");
-            }
-            return rawIndices;
-        case MESH_LINE_STRIP:
-            return GetSegmentsFromLineStrip(rawIndices);
-        case MESH_LINE_LOOP:
-            return GetSegmentsFromLineLoop(rawIndices);
-        default:
-            throw GLTFException("Invalid mesh mode for triangulation " + std::to_string(meshMode));
+                ConversionKernels::TriangleFanToList(run, output, runLength - 2U);
+                return (runLength - 2U) * 3U;
+            });
         }
     }
 
-    std::vector<uint16_t> GetOrCreateIndices16(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
+    template<typename T>
+    size_t GetSegmentedIndices(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, T* indices, size_t indexCount)
     {
-        if (doc.accessors.Has(meshPrimitive.indicesAccessorId))
+        const size_t rawIndexCount = GetRawIndexCount(doc, meshPrimitive);
+        const size_t segmentedIndexCount = GetSegmentedIndexCount(meshPrimitive.mode, rawIndexCount);
+
+        ValidateOutputCount(indexCount, segmentedIndexCount);
+
+        if (meshPrimitive.mode == MESH_LINES)
         {
-            const auto& indicesAccessor = doc.accessors.Get(meshPrimitive.indicesAccessorId);
-            return MeshPrimitiveUtils::GetIndices16(doc, reader, indicesAccessor);
+            return GetOrCreateIndices(doc, reader, meshPrimitive, indices, indexCount);
         }
-        else
-        {
-            size_t vertexCount = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_POSITION)).count;
 
-            if (vertexCount > std::numeric_limits<uint16_t>::max())
-            {
-                throw GLTFException("Cannot generate 16-bit indices for MeshPrimitive with " + std::to_string(vertexCount) + " vertices.");
-            }
+        T* rawIndices = indices + (segmentedIndexCount - rawIndexCount);
+        GetOrCreateIndices(doc, reader, meshPrimitive, rawIndices, rawIndexCount);
 
-            std::vector<uint16_t> rawIndices(vertexCount);
-            std::iota(rawIndices.begin(), rawIndices.end(), static_cast<uint16_t>(0U));
-            return rawIndices;
-        }
-    }
+        const T restartIndex = GetRestartIndex<T>(doc, meshPrimitive);
 
-    std::vector<uint32_t> GetOrCreateIndices32(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
-    {
-        if (doc.accessors.Has(meshPrimitive.indicesAccessorId))
+        if (meshPrimitive.mode == MESH_LINE_STRIP)
         {
-            const auto& indicesAccessor = doc.accessors.Get(meshPrimitive.indicesAccessorId);
-            return MeshPrimitiveUtils::GetIndices32(doc, reader, indicesAccessor);
+            return ExpandRuns(rawIndices, rawIndexCount, restartIndex, 2U, indices, [](const T* run, size_t runLength, T* output)
+            {
+                ConversionKernels::LineStripToList(run, output, runLength - 1U);
+                return (runLength - 1U) * 2U;
+            });
         }
         else
         {
-            size_t vertexCount = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_POSITION)).count;
-
-            std::vector<uint32_t> rawIndices(vertexCount);
-            std::iota(rawIndices.begin(), rawIndices.end(), static_cast<uint32_t>(0U));
-            return rawIndices;
+            return ExpandRuns(rawIndices, rawIndexCount, restartIndex, 2U, indices, &LineLoopToList<T>);
         }
     }
 
@@ -512,7 +461,8 @@ namespace
     }
 }
 
-std::vector<uint16_t> MeshPrimitiveUtils::GetIndices16(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
+// Indices
+size_t MeshPrimitiveUtils::GetIndices16(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, uint16_t* output, size_t outputCount)
 {
     if (accessor.type != TYPE_SCALAR)
     {
@@ -522,10 +472,10 @@ std::vector<uint16_t> MeshPrimitiveUtils::GetIndices16(const Document& doc, cons
     switch (accessor.componentType)
     {
     case COMPONENT_UNSIGNED_BYTE:
-        return ReadIndices<uint8_t, uint16_t>(doc, reader, accessor);
+        return ReadIndices(doc, reader, accessor, output, outputCount, &ConversionKernels::WidenU8ToU16);
 
     case COMPONENT_UNSIGNED_SHORT:
-        return reader.ReadBinaryData<uint16_t>(doc, accessor);
+        return reader.ReadBinaryData<uint16_t>(doc, accessor, output, outputCount);
 
     case COMPONENT_UNSIGNED_INT:
         throw GLTFException("Cannot convert 32-bit indices to 16-bit");
@@ -535,13 +485,26 @@ std::vector<uint16_t> MeshPrimitiveUtils::GetIndices16(const Document& doc, cons
     }
 }
 
+size_t MeshPrimitiveUtils::GetIndices16(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint16_t* output, size_t outputCount)
+{
+    const auto& accessor = doc.accessors.Get(meshPrimitive.indicesAccessorId);
+    return GetIndices16(doc, reader, accessor, output, outputCount);
+}
+
+std::vector<uint16_t> MeshPrimitiveUtils::GetIndices16(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
+{
+    auto indices = MakeOutput<uint16_t>(doc, accessor, 1U);
+    GetIndices16(doc, reader, accessor, indices.data(), indices.size());
+    return indices;
+}
+
 std::vector<uint16_t> MeshPrimitiveUtils::GetIndices16(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
 {
     const auto& accessor = doc.accessors.Get(meshPrimitive.indicesAccessorId);
     return GetIndices16(doc, reader, accessor);
 }
 
-std::vector<uint32_t> MeshPrimitiveUtils::GetIndices32(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
+size_t MeshPrimitiveUtils::GetIndices32(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, uint32_t* output, size_t outputCount)
 {
     if (accessor.type != TYPE_SCALAR)
     {
@@ -551,48 +514,99 @@ std::vector<uint32_t> MeshPrimitiveUtils::GetIndices32(const Document& doc, cons
     switch (accessor.componentType)
     {
     case COMPONENT_UNSIGNED_BYTE:
-        return ReadIndices<uint8_t, uint32_t>(doc, reader, accessor);
+        return ReadIndices(doc, reader, accessor, output, outputCount, &ConversionKernels::WidenU8ToU32);
 
     case COMPONENT_UNSIGNED_SHORT:
-        return ReadIndices<uint16_t, uint32_t>(doc, reader, accessor);
+        return ReadIndices(doc, reader, accessor, output, outputCount, &ConversionKernels::WidenU16ToU32);
 
     case COMPONENT_UNSIGNED_INT:
-        return reader.ReadBinaryData<uint32_t>(doc, accessor);
+        return reader.ReadBinaryData<uint32_t>(doc, accessor, output, outputCount);
 
     default:
         throw GLTFException("Invalid componentType for indices accessor " + accessor.id);
     }
 }
 
+size_t MeshPrimitiveUtils::GetIndices32(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint32_t* output, size_t outputCount)
+{
+    const auto& accessor = doc.accessors.Get(meshPrimitive.indicesAccessorId);
+    return GetIndices32(doc, reader, accessor, output, outputCount);
+}
+
+std::vector<uint32_t> MeshPrimitiveUtils::GetIndices32(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
+{
+    auto indices = MakeOutput<uint32_t>(doc, accessor, 1U);
+    GetIndices32(doc, reader, accessor, indices.data(), indices.size());
+    return indices;
+}
+
 std::vector<uint32_t> MeshPrimitiveUtils::GetIndices32(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
 {
     const auto& accessor = doc.accessors.Get(meshPrimitive.indicesAccessorId);
     return GetIndices32(doc, reader, accessor);
 }
 
+// Triangulated & segmented indices
+size_t MeshPrimitiveUtils::GetTriangulatedIndexCount(const Document& doc, const MeshPrimitive& meshPrimitive)
+{
+    return ::GetTriangulatedIndexCount(meshPrimitive.mode, GetRawIndexCount(doc, meshPrimitive));
+}
+
+size_t MeshPrimitiveUtils::GetSegmentedIndexCount(const Document& doc, const MeshPrimitive& meshPrimitive)
+{
+    return ::GetSegmentedIndexCount(meshPrimitive.mode, GetRawIndexCount(doc, meshPrimitive));
+}
+
+size_t MeshPrimitiveUtils::GetTriangulatedIndices16(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint16_t* output, size_t outputCount)
+{
+    return GetTriangulatedIndices<uint16_t>(doc, reader, meshPrimitive, output, outputCount);
+}
+
+size_t MeshPrimitiveUtils::GetTriangulatedIndices32(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint32_t* output, size_t outputCount)
+{
+    return GetTriangulatedIndices<uint32_t>(doc, reader, meshPrimitive, output, outputCount);
+}
+
+size_t MeshPrimitiveUtils::GetSegmentedIndices16(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint16_t* output, size_t outputCount)
+{
+    return GetSegmentedIndices<uint16_t>(doc, reader, meshPrimitive, output, outputCount);
+}
+
+size_t MeshPrimitiveUtils::GetSegmentedIndices32(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint32_t* output, size_t outputCount)
+{
+    return GetSegmentedIndices<uint32_t>(doc, reader, meshPrimitive, output, outputCount);
+}
+
 std::vector<uint16_t> MeshPrimitiveUtils::GetTriangulatedIndices16(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
 {
-    return GetTriangulatedIndices<uint16_t>(meshPrimitive.mode, GetOrCreateIndices16(doc, reader, meshPrimitive));
+    std::vector<uint16_t> indices(GetTriangulatedIndexCount(doc, meshPrimitive));
+    indices.resize(GetTriangulatedIndices16(doc, reader, meshPrimitive, indices.data(), indices.size()));
+    return indices;
 }
 
 std::vector<uint32_t> MeshPrimitiveUtils::GetTriangulatedIndices32(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
 {
-    return GetTriangulatedIndices<uint32_t>(meshPrimitive.mode, GetOrCreateIndices32(doc, reader, meshPrimitive));
+    std::vector<uint32_t> indices(GetTriangulatedIndexCount(doc, meshPrimitive));
+    indices.resize(GetTriangulatedIndices32(doc, reader, meshPrimitive, indices.data(), indices.size()));
+    return indices;
 }
 
 std::vector<uint16_t> MeshPrimitiveUtils::GetSegmentedIndices16(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
 {
-
-    return GetSegmentedIndices<uint16_t>(meshPrimitive.mode, GetOrCreateIndices16(doc, reader, meshPrimitive));
+    std::vector<uint16_t> indices(GetSegmentedIndexCount(doc, meshPrimitive));
+    indices.resize(GetSegmentedIndices16(doc, reader, meshPrimitive, indices.data(), indices.size()));
+    return indices;
 }
 
 std::vector<uint32_t> MeshPrimitiveUtils::GetSegmentedIndices32(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
 {
-    return GetSegmentedIndices<uint32_t>(meshPrimitive.mode, GetOrCreateIndices32(doc, reader, meshPrimitive));
+    std::vector<uint32_t> indices(GetSegmentedIndexCount(doc, meshPrimitive));
+    indices.resize(GetSegmentedIndices32(doc, reader, meshPrimitive, indices.data(), indices.size()));
+    return indices;
 }
 
 // Positions
-std::vector<float> MeshPrimitiveUtils::GetPositions(const Document& doc, const GLTFResourceReader& reader, const Accessor& positionsAccessor)
+size_t MeshPrimitiveUtils::GetPositions(const Document& doc, const GLTFResourceReader& reader, const Accessor& positionsAccessor, float* output, size_t outputCount)
 {
     if (positionsAccessor.type != TYPE_VEC3)
     {
@@ -604,7 +618,26 @@ std::vector<float> MeshPrimitiveUtils::GetPositions(const Document& doc, const G
         throw GLTFException("Invalid component type for positions accessor " + positionsAccessor.id);
     }
 
-    return reader.ReadFloatData(doc, positionsAccessor);
+    return reader.ReadFloatData(doc, positionsAccessor, output, outputCount);
+}
+
+size_t MeshPrimitiveUtils::GetPositions(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, float* output, size_t outputCount)
+{
+    const auto& positionsAccessor = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_POSITION));
+    return GetPositions(doc, reader, positionsAccessor, output, outputCount);
+}
+
+size_t MeshPrimitiveUtils::GetPositions(const Document& doc, const GLTFResourceReader& reader, const MorphTarget& morphTarget, float* output, size_t outputCount)
+{
+    const auto& positionsAccessor = doc.accessors.Get(morphTarget.positionsAccessorId);
+    return GetPositions(doc, reader, positionsAccessor, output, outputCount);
+}
+
+std::vector<float> MeshPrimitiveUtils::GetPositions(const Document& doc, const GLTFResourceReader& reader, const Accessor& positionsAccessor)
+{
+    auto positions = MakeOutput<float>(doc, positionsAccessor, 3U);
+    GetPositions(doc, reader, positionsAccessor, positions.data(), positions.size());
+    return positions;
 }
 
 std::vector<float> MeshPrimitiveUtils::GetPositions(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
@@ -620,7 +653,7 @@ std::vector<float> MeshPrimitiveUtils::GetPositions(const Document& doc, const G
 }
 
 // Normals
-std::vector<float> MeshPrimitiveUtils::GetNormals(const Document& doc, const GLTFResourceReader& reader, const Accessor& normalsAccessor)
+size_t MeshPrimitiveUtils::GetNormals(const Document& doc, const GLTFResourceReader& reader, const Accessor& normalsAccessor, float* output, size_t outputCount)
 {
     if (normalsAccessor.type != TYPE_VEC3)
     {
@@ -632,7 +665,26 @@ std::vector<float> MeshPrimitiveUtils::GetNormals(const Document& doc, const GLT
         throw GLTFException("Invalid component type for normals accessor " + normalsAccessor.id);
     }
 
-    return reader.ReadFloatData(doc, normalsAccessor);
+    return reader.ReadFloatData(doc, normalsAccessor, output, outputCount);
+}
+
+size_t MeshPrimitiveUtils::GetNormals(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, float* output, size_t outputCount)
+{
+    const auto& accessor = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_NORMAL));
+    return GetNormals(doc, reader, accessor, output, outputCount);
+}
+
+size_t MeshPrimitiveUtils::GetNormals(const Document& doc, const GLTFResourceReader& reader, const MorphTarget& morphTarget, float* output, size_t outputCount)
+{
+    const auto& accessor = doc.accessors.Get(morphTarget.normalsAccessorId);
+    return GetNormals(doc, reader, accessor, output, outputCount);
+}
+
+std::vector<float> MeshPrimitiveUtils::GetNormals(const Document& doc, const GLTFResourceReader& reader, const Accessor& normalsAccessor)
+{
+    auto normals = MakeOutput<float>(doc, normalsAccessor, 3U);
+    GetNormals(doc, reader, normalsAccessor, normals.data(), normals.size());
+    return normals;
 }
 
 std::vector<float> MeshPrimitiveUtils::GetNormals(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
@@ -648,7 +700,7 @@ std::vector<float> MeshPrimitiveUtils::GetNormals(const Document& doc, const GLT
 }
 
 // Tangents
-std::vector<float> MeshPrimitiveUtils::GetTangents(const Document& doc, const GLTFResourceReader& reader, const Accessor& tangentsAccessor)
+size_t MeshPrimitiveUtils::GetTangents(const Document& doc, const GLTFResourceReader& reader, const Accessor& tangentsAccessor, float* output, size_t outputCount)
 {
     if (tangentsAccessor.type != TYPE_VEC4)
     {
@@ -660,7 +712,26 @@ std::vector<float> MeshPrimitiveUtils::GetTangents(const Document& doc, const GL
         throw GLTFException("Invalid component type for tangents accessor " + tangentsAccessor.id);
     }
 
-    return reader.ReadFloatData(doc, tangentsAccessor);
+    return reader.ReadFloatData(doc, tangentsAccessor, output, outputCount);
+}
+
+size_t MeshPrimitiveUtils::GetTangents(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, float* output, size_t outputCount)
+{
+    const auto& accessor = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_TANGENT));
+    return GetTangents(doc, reader, accessor, output, outputCount);
+}
+
+size_t MeshPrimitiveUtils::GetTangents(const Document& doc, const GLTFResourceReader& reader, const MorphTarget& morphTarget, float* output, size_t outputCount)
+{
+    const auto& accessor = doc.accessors.Get(morphTarget.tangentsAccessorId);
+    return GetMorphTangents(doc, reader, accessor, output, outputCount);
+}
+
+std::vector<float> MeshPrimitiveUtils::GetTangents(const Document& doc, const GLTFResourceReader& reader, const Accessor& tangentsAccessor)
+{
+    auto tangents = MakeOutput<float>(doc, tangentsAccessor, 4U);
+    GetTangents(doc, reader, tangentsAccessor, tangents.data(), tangents.size());
+    return tangents;
 }
 
 std::vector<float> MeshPrimitiveUtils::GetTangents(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
@@ -669,8 +740,14 @@ std::vector<float> MeshPrimitiveUtils::GetTangents(const Document& doc, const GL
     return GetTangents(doc, reader, accessor);
 }
 
+std::vector<float> MeshPrimitiveUtils::GetTangents(const Document& doc, const GLTFResourceReader& reader, const MorphTarget& morphTarget)
+{
+    const auto& accessor = doc.accessors.Get(morphTarget.tangentsAccessorId);
+    return GetMorphTangents(doc, reader, accessor);
+}
+
 // Morph Target Tangents (which have a different accessor type than base mesh tangents)
-std::vector<float> MeshPrimitiveUtils::GetMorphTangents(const Document& doc, const GLTFResourceReader& reader, const Accessor& tangentsAccessor)
+size_t MeshPrimitiveUtils::GetMorphTangents(const Document& doc, const GLTFResourceReader& reader, const Accessor& tangentsAccessor, float* output, size_t outputCount)
 {
     if (tangentsAccessor.type != TYPE_VEC3)
     {
@@ -682,17 +759,18 @@ std::vector<float> MeshPrimitiveUtils::GetMorphTangents(const Document& doc, con
         throw GLTFException("Invalid component type for tangents accessor " + tangentsAccessor.id);
     }
 
-    return reader.ReadFloatData(doc, tangentsAccessor);
+    return reader.ReadFloatData(doc, tangentsAccessor, output, outputCount);
 }
 
-std::vector<float> MeshPrimitiveUtils::GetTangents(const Document& doc, const GLTFResourceReader& reader, const MorphTarget& morphTarget)
+std::vector<float> MeshPrimitiveUtils::GetMorphTangents(const Document& doc, const GLTFResourceReader& reader, const Accessor& tangentsAccessor)
 {
-    const auto& accessor = doc.accessors.Get(morphTarget.tangentsAccessorId);
-    return GetMorphTangents(doc, reader, accessor);
+    auto tangents = MakeOutput<float>(doc, tangentsAccessor, 3U);
+    GetMorphTangents(doc, reader, tangentsAccessor, tangents.data(), tangents.size());
+    return tangents;
 }
 
 // Texcoords
-std::vector<float> MeshPrimitiveUtils::GetTexCoords(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
+size_t MeshPrimitiveUtils::GetTexCoords(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor, float* output, size_t outputCount)
 {
     if (accessor.type != TYPE_VEC2)
     {
@@ -704,7 +782,26 @@ std::vector<float> MeshPrimitiveUtils::GetTexCoords(const Document& doc, const G
         throw GLTFException("Invalid component type for texcoords accessor " + accessor.id);
     }
 
-    return reader.ReadFloatData(doc, accessor);
+    return reader.ReadFloatData(doc, accessor, output, outputCount);
+}
+
+size_t MeshPrimitiveUtils::GetTexCoords_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, float* output, size_t outputCount)
+{
+    const auto& accessor = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_TEXCOORD_0));
+    return GetTexCoords(doc, reader, accessor, output, outputCount);
+}
+
+size_t MeshPrimitiveUtils::GetTexCoords_1(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, float* output, size_t outputCount)
+{
+    const auto& accessor = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_TEXCOORD_1));
+    return GetTexCoords(doc, reader, accessor, output, outputCount);
+}
+
+std::vector<float> MeshPrimitiveUtils::GetTexCoords(const Document& doc, const GLTFResourceReader& reader, const Accessor& accessor)
+{
+    auto texCoords = MakeOutput<float>(doc, accessor, 2U);
+    GetTexCoords(doc, reader, accessor, texCoords.data(), texCoords.size());
+    return texCoords;
 }
 
 std::vector<float> MeshPrimitiveUtils::GetTexCoords_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
@@ -720,7 +817,7 @@ std::vector<float> MeshPrimitiveUtils::GetTexCoords_1(const Document& doc, const
 }
 
 // Colors
-std::vector<uint32_t> MeshPrimitiveUtils::GetColors(const Document& doc, const GLTFResourceReader& reader, const Accessor& colorsAccessor)
+size_t MeshPrimitiveUtils::GetColors(const Document& doc, const GLTFResourceReader& reader, const Accessor& colorsAccessor, uint32_t* output, size_t outputCount)
 {
     if (colorsAccessor.type != TYPE_VEC4 && colorsAccessor.type != TYPE_VEC3)
     {
@@ -732,24 +829,20 @@ std::vector<uint32_t> MeshPrimitiveUtils::GetColors(const Document& doc, const G
         throw GLTFException("Invalid component type for colors accessor " + colorsAccessor.id);
     }
 
-    if (colorsAccessor.componentType == COMPONENT_UNSIGNED_BYTE)
-    {
-        std::vector<uint8_t> colorData = reader.ReadBinaryData<uint8_t>(doc, colorsAccessor);
+    return PackColors(doc, reader, colorsAccessor, output, outputCount);
+}
 
-        if (colorsAccessor.type == TYPE_VEC4)
-            return PackColorsRGBA(colorData);
-        else
-            return PackColorsRGB(colorData);
-    }
-    else
-    {
-        std::vector<float> colorData = reader.ReadFloatData(doc, colorsAccessor);
+size_t MeshPrimitiveUtils::GetColors_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint32_t* output, size_t outputCount)
+{
+    const auto& accessor = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_COLOR_0));
+    return GetColors(doc, reader, accessor, output, outputCount);
+}
 
-        if (colorsAccessor.type == TYPE_VEC4)
-            return PackColorsRGBA(colorData);
-        else
-            return PackColorsRGB(colorData);
-    }
+std::vector<uint32_t> MeshPrimitiveUtils::GetColors(const Document& doc, const GLTFResourceReader& reader, const Accessor& colorsAccessor)
+{
+    auto colors = MakeOutput<uint32_t>(doc, colorsAccessor, 1U);
+    GetColors(doc, reader, colorsAccessor, colors.data(), colors.size());
+    return colors;
 }
 
 std::vector<uint32_t> MeshPrimitiveUtils::GetColors_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
@@ -759,7 +852,7 @@ std::vector<uint32_t> MeshPrimitiveUtils::GetColors_0(const Document& doc, const
 }
 
 // Joints
-std::vector<uint32_t> MeshPrimitiveUtils::GetJointIndices32(const Document& doc, const GLTFResourceReader& reader, const Accessor& jointsAccessor)
+size_t MeshPrimitiveUtils::GetJointIndices32(const Document& doc, const GLTFResourceReader& reader, const Accessor& jointsAccessor, uint32_t* output, size_t outputCount)
 {
     if (jointsAccessor.type != TYPE_VEC4)
     {
@@ -769,7 +862,8 @@ std::vector<uint32_t> MeshPrimitiveUtils::GetJointIndices32(const Document& doc,
     switch (jointsAccessor.componentType)
     {
     case COMPONENT_UNSIGNED_BYTE:
-        return ReadJoints32(doc, reader, jointsAccessor);
+        ReadPacked<uint8_t>(doc, reader, jointsAccessor, output, outputCount);
+        return jointsAccessor.count;
 
     case COMPONENT_UNSIGNED_SHORT:
         throw GLTFException("Cannot pack 4 x 16-bit indices into 32-bits");
@@ -779,13 +873,26 @@ std::vector<uint32_t> MeshPrimitiveUtils::GetJointIndices32(const Document& doc,
     }
 }
 
+size_t MeshPrimitiveUtils::GetJointIndices32_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint32_t* output, size_t outputCount)
+{
+    const auto& accessor = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_JOINTS_0));
+    return GetJointIndices32(doc, reader, accessor, output, outputCount);
+}
+
+std::vector<uint32_t> MeshPrimitiveUtils::GetJointIndices32(const Document& doc, const GLTFResourceReader& reader, const Accessor& jointsAccessor)
+{
+    auto joints = MakeOutput<uint32_t>(doc, jointsAccessor, 1U);
+    GetJointIndices32(doc, reader, jointsAccessor, joints.data(), joints.size());
+    return joints;
+}
+
 std::vector<uint32_t> MeshPrimitiveUtils::GetJointIndices32_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
 {
     const auto& accessor = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_JOINTS_0));
     return GetJointIndices32(doc, reader, accessor);
 }
 
-std::vector<uint64_t> MeshPrimitiveUtils::GetJointIndices64(const Document& doc, const GLTFResourceReader& reader, const Accessor& jointsAccessor)
+size_t MeshPrimitiveUtils::GetJointIndices64(const Document& doc, const GLTFResourceReader& reader, const Accessor& jointsAccessor, uint64_t* output, size_t outputCount)
 {
     if (jointsAccessor.type != TYPE_VEC4)
     {
@@ -795,16 +902,35 @@ std::vector<uint64_t> MeshPrimitiveUtils::GetJointIndices64(const Document& doc,
     switch (jointsAccessor.componentType)
     {
     case COMPONENT_UNSIGNED_BYTE:
-        return ReadJoints64<uint8_t>(doc, reader, jointsAccessor);
+    {
+        // Widening each 8-bit index to 16-bits gives the same layout as four 16-bit indices
+        const uint8_t* rawData = ReadPacked<uint8_t>(doc, reader, jointsAccessor, output, outputCount);
+        ConversionKernels::WidenU8ToU16(rawData, reinterpret_cast<uint16_t*>(output), jointsAccessor.count * 4U);
+        return jointsAccessor.count;
+    }
 
     case COMPONENT_UNSIGNED_SHORT:
-        return ReadJoints64<uint16_t>(doc, reader, jointsAccessor);
+        ReadPacked<uint16_t>(doc, reader, jointsAccessor, output, outputCount);
+        return jointsAccessor.count;
 
     default:
         throw GLTFException("Invalid componentType for joints accessor " + jointsAccessor.id);
     }
 }
 
+size_t MeshPrimitiveUtils::GetJointIndices64_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint64_t* output, size_t outputCount)
+{
+    const auto& accessor = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_JOINTS_0));
+    return GetJointIndices64(doc, reader, accessor, output, outputCount);
+}
+
+std::vector<uint64_t> MeshPrimitiveUtils::GetJointIndices64(const Document& doc, const GLTFResourceReader& reader, const Accessor& jointsAccessor)
+{
+    auto joints = MakeOutput<uint64_t>(doc, jointsAccessor, 1U);
+    GetJointIndices64(doc, reader, jointsAccessor, joints.data(), joints.size());
+    return joints;
+}
+
 std::vector<uint64_t> MeshPrimitiveUtils::GetJointIndices64_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
 {
     const auto& accessor = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_JOINTS_0));
@@ -812,7 +938,7 @@ std::vector<uint64_t> MeshPrimitiveUtils::GetJointIndices64_0(const Document& do
 }
 
 // Weights
-std::vector<uint32_t> MeshPrimitiveUtils::GetJointWeights32(const Document& doc, const GLTFResourceReader& reader, const Accessor& weightsAccessor)
+size_t MeshPrimitiveUtils::GetJointWeights32(const Document& doc, const GLTFResourceReader& reader, const Accessor& weightsAccessor, uint32_t* output, size_t outputCount)
 {
     if (weightsAccessor.type != TYPE_VEC4)
     {
@@ -824,18 +950,20 @@ std::vector<uint32_t> MeshPrimitiveUtils::GetJointWeights32(const Document& doc,
         throw GLTFException("Invalid component type for weights accessor " + weightsAccessor.id);
     }
 
-    if (weightsAccessor.componentType == COMPONENT_UNSIGNED_BYTE)
-    {
-        std::vector<uint8_t> weightsData = reader.ReadBinaryData<uint8_t>(doc, weightsAccessor);
+    return PackWeights32(doc, reader, weightsAccessor, output, outputCount);
+}
 
-        return PackWeights32(weightsData);
-    }
-    else
-    {
-        std::vector<float> weightsData = reader.ReadFloatData(doc, weightsAccessor);
+size_t MeshPrimitiveUtils::GetJointWeights32_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, uint32_t* output, size_t outputCount)
+{
+    const auto& accessor = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(ACCESSOR_WEIGHTS_0));
+    return GetJointWeights32(doc, reader, accessor, output, outputCount);
+}
 
-        return PackWeights32(weightsData);
-    }
+std::vector<uint32_t> MeshPrimitiveUtils::GetJointWeights32(const Document& doc, const GLTFResourceReader& reader, const Accessor& weightsAccessor)
+{
+    auto weights = MakeOutput<uint32_t>(doc, weightsAccessor, 1U);
+    GetJointWeights32(doc, reader, weightsAccessor, weights.data(), weights.size());
+    return weights;
 }
 
 std::vector<uint32_t> MeshPrimitiveUtils::GetJointWeights32_0(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive)
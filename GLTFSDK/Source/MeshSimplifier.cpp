@@ -0,0 +1,889 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/MeshSimplifier.h>
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/ConversionKernels.h>
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/ExtensionsMSFT.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/Parallel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::MeshOptimizer;
+using namespace Microsoft::glTF::MeshSimplifier;
+
+namespace
+{
+    struct Point
+    {
+        float x;
+        float y;
+        float z;
+    };
+
+    Point Subtract(const Point& a, const Point& b)
+    {
+        return { a.x - b.x, a.y - b.y, a.z - b.z };
+    }
+
+    Point Cross(const Point& a, const Point& b)
+    {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+
+    float Dot(const Point& a, const Point& b)
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    // The sum of the squared distances to a set of weighted planes, divided by their total weight so that a vertex's
+    // error is a squared distance regardless of the size of the triangles around it
+    class Quadric
+    {
+    public:
+        // 'normal' must be unit length
+        void AddPlane(const Point& normal, float distance, float weight)
+        {
+            m_a00 += weight * normal.x * normal.x;
+            m_a01 += weight * normal.x * normal.y;
+            m_a02 += weight * normal.x * normal.z;
+            m_a11 += weight * normal.y * normal.y;
+            m_a12 += weight * normal.y * normal.z;
+            m_a22 += weight * normal.z * normal.z;
+            m_b0 += weight * normal.x * distance;
+            m_b1 += weight * normal.y * distance;
+            m_b2 += weight * normal.z * distance;
+            m_c += weight * distance * distance;
+            m_weight += weight;
+        }
+
+        Quadric& operator+=(const Quadric& other)
+        {
+            m_a00 += other.m_a00;
+            m_a01 += other.m_a01;
+            m_a02 += other.m_a02;
+            m_a11 += other.m_a11;
+            m_a12 += other.m_a12;
+            m_a22 += other.m_a22;
+            m_b0 += other.m_b0;
+            m_b1 += other.m_b1;
+            m_b2 += other.m_b2;
+            m_c += other.m_c;
+            m_weight += other.m_weight;
+
+            return *this;
+        }
+
+        double Evaluate(const Point& p) const
+        {
+            if (m_weight <= 0.0)
+            {
+                return 0.0;
+            }
+
+            const double x = p.x;
+            const double y = p.y;
+            const double z = p.z;
+
+            const double error =
+                m_a00 * x * x + m_a11 * y * y + m_a22 * z * z +
+                2.0 * (m_a01 * x * y + m_a02 * x * z + m_a12 * y * z) +
+                2.0 * (m_b0 * x + m_b1 * y + m_b2 * z) +
+                m_c;
+
+            return std::max(error, 0.0) / m_weight;
+        }
+
+    private:
+        double m_a00 = 0.0, m_a01 = 0.0, m_a02 = 0.0, m_a11 = 0.0, m_a12 = 0.0, m_a22 = 0.0;
+        double m_b0 = 0.0, m_b1 = 0.0, m_b2 = 0.0;
+        double m_c = 0.0;
+        double m_weight = 0.0;
+    };
+
+    // Planes through open border edges, perpendicular to their triangles, are weighted heavily so that borders keep
+    // their shape
+    const float BorderWeight = 10.0f;
+
+    uint64_t GetEdgeKey(uint32_t a, uint32_t b)
+    {
+        return static_cast<uint64_t>(a) << 32U | b;
+    }
+
+    // Positions scaled so that the largest dimension of their bounds is 1, making errors relative to the mesh's size
+    std::vector<Point> GetNormalizedPositions(const VertexStream& positions, size_t vertexCount, float& scale)
+    {
+        if (positions.accessorType != TYPE_VEC3 || positions.componentType != COMPONENT_FLOAT)
+        {
+            throw GLTFException("Only mesh primitives with float VEC3 positions can be simplified");
+        }
+
+        std::vector<Point> points(vertexCount);
+        std::memcpy(points.data(), positions.data.data(), vertexCount * sizeof(Point));
+
+        Point minimum = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+        Point maximum = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+
+        for (const auto& point : points)
+        {
+            minimum = { std::min(minimum.x, point.x), std::min(minimum.y, point.y), std::min(minimum.z, point.z) };
+            maximum = { std::max(maximum.x, point.x), std::max(maximum.y, point.y), std::max(maximum.z, point.z) };
+        }
+
+        const float extent = std::max(std::max(maximum.x - minimum.x, maximum.y - minimum.y), maximum.z - minimum.z);
+
+        scale = extent > 0.0f ? 1.0f / extent : 1.0f;
+
+        for (auto& point : points)
+        {
+            point = { (point.x - minimum.x) * scale, (point.y - minimum.y) * scale, (point.z - minimum.z) * scale };
+        }
+
+        return points;
+    }
+
+    // Decodes a stream's components as floats, or returns false for a stream of integers that aren't normalized (e.g.
+    // joint indices) whose differences are meaningless
+    bool DecodeStream(const VertexStream& stream, size_t vertexCount, float scale, std::vector<float>& values)
+    {
+        if (stream.componentType != COMPONENT_FLOAT && !stream.normalized)
+        {
+            return false;
+        }
+
+        const size_t componentCount = vertexCount * Accessor::GetTypeCount(stream.accessorType);
+
+        values.resize(componentCount);
+
+        switch (stream.componentType)
+        {
+        case COMPONENT_FLOAT:
+            std::memcpy(values.data(), stream.data.data(), componentCount * sizeof(float));
+            break;
+        case COMPONENT_BYTE:
+            ConversionKernels::ToFloat(reinterpret_cast<const int8_t*>(stream.data.data()), values.data(), componentCount, stream.normalized);
+            break;
+        case COMPONENT_UNSIGNED_BYTE:
+            ConversionKernels::ToFloat(reinterpret_cast<const uint8_t*>(stream.data.data()), values.data(), componentCount, stream.normalized);
+            break;
+        case COMPONENT_SHORT:
+            ConversionKernels::ToFloat(reinterpret_cast<const int16_t*>(stream.data.data()), values.data(), componentCount, stream.normalized);
+            break;
+        case COMPONENT_UNSIGNED_SHORT:
+            ConversionKernels::ToFloat(reinterpret_cast<const uint16_t*>(stream.data.data()), values.data(), componentCount, stream.normalized);
+            break;
+        default:
+            return false;
+        }
+
+        for (auto& value : values)
+        {
+            value *= scale;
+        }
+
+        return true;
+    }
+
+    // Unit normals and tangents (and their morph target displacements) span [-1, 1], so they are halved to weigh the
+    // same as attributes such as texture coordinates and colors that span [0, 1]
+    float GetAttributeScale(const std::string& semantic)
+    {
+        return semantic == ACCESSOR_NORMAL || semantic == ACCESSOR_TANGENT ? 0.5f : 1.0f;
+    }
+
+    // Every attribute other than POSITION, and every morph target's displacements, interleaved per vertex. The first
+    // 'displacementCount' components are morph target position displacements, in the same units as the normalized
+    // positions; the rest are scaled by GetAttributeScale.
+    std::vector<float> GetVertexAttributes(const MeshData& meshData, float positionScale, size_t& attributeCount, size_t& displacementCount)
+    {
+        std::vector<std::vector<float>> streams;
+        std::vector<float> values;
+
+        for (const auto& target : meshData.targets)
+        {
+            for (const auto& stream : target)
+            {
+                if (stream.semantic == ACCESSOR_POSITION && DecodeStream(stream, meshData.vertexCount, positionScale, values))
+                {
+                    streams.push_back(std::move(values));
+                }
+            }
+        }
+
+        displacementCount = 0U;
+
+        for (const auto& stream : streams)
+        {
+            displacementCount += stream.size() / std::max<size_t>(meshData.vertexCount, 1U);
+        }
+
+        for (const auto& stream : meshData.attributes)
+        {
+            if (stream.semantic != ACCESSOR_POSITION && DecodeStream(stream, meshData.vertexCount, GetAttributeScale(stream.semantic), values))
+            {
+                streams.push_back(std::move(values));
+            }
+        }
+
+        for (const auto& target : meshData.targets)
+        {
+            for (const auto& stream : target)
+            {
+                if (stream.semantic != ACCESSOR_POSITION && DecodeStream(stream, meshData.vertexCount, GetAttributeScale(stream.semantic), values))
+                {
+                    streams.push_back(std::move(values));
+                }
+            }
+        }
+
+        attributeCount = 0U;
+
+        for (const auto& stream : streams)
+        {
+            attributeCount += stream.size() / std::max<size_t>(meshData.vertexCount, 1U);
+        }
+
+        std::vector<float> attributes(meshData.vertexCount * attributeCount);
+        size_t offset = 0U;
+
+        for (const auto& stream : streams)
+        {
+            const size_t typeCount = stream.size() / std::max<size_t>(meshData.vertexCount, 1U);
+
+            for (size_t i = 0U; i < meshData.vertexCount; i++)
+            {
+                std::copy(stream.begin() + i * typeCount, stream.begin() + (i + 1U) * typeCount, attributes.begin() + i * attributeCount + offset);
+            }
+
+            offset += typeCount;
+        }
+
+        return attributes;
+    }
+
+    // Vertices with the same position, which are on a seam in their other attributes, are grouped so that topology
+    // (borders and degenerate triangles) is determined by position alone
+    std::vector<uint32_t> GetPositionGroups(const MeshData& meshData, const VertexStream& positions, size_t threadCount, std::vector<uint32_t>& groupSizes)
+    {
+        MeshData positionsOnly;
+        positionsOnly.vertexCount = meshData.vertexCount;
+        positionsOnly.attributes.push_back(positions);
+
+        WeldOptions weldOptions;
+        weldOptions.threadCount = threadCount;
+
+        size_t groupCount;
+        auto groups = GenerateWeldRemap(positionsOnly, groupCount, weldOptions);
+
+        groupSizes.assign(groupCount, 0U);
+
+        for (uint32_t group : groups)
+        {
+            groupSizes[group]++;
+        }
+
+        return groups;
+    }
+
+    struct Collapse
+    {
+        uint32_t from;
+        uint32_t to;
+        double error;
+    };
+
+    class Simplifier
+    {
+    public:
+        Simplifier(MeshData& meshData, const SimplifyOptions& options) :
+            m_meshData(meshData),
+            m_options(options),
+            m_maxError(static_cast<double>(options.maxError) * options.maxError)
+        {
+            const auto itPositions = std::find_if(meshData.attributes.begin(), meshData.attributes.end(), [](const VertexStream& stream)
+            {
+                return stream.semantic == ACCESSOR_POSITION;
+            });
+
+            if (itPositions == meshData.attributes.end())
+            {
+                throw GLTFException("Mesh primitives must have positions to be simplified");
+            }
+
+            float scale;
+            m_positions = GetNormalizedPositions(*itPositions, meshData.vertexCount, scale);
+            m_attributes = GetVertexAttributes(meshData, scale, m_attributeCount, m_displacementCount);
+            m_groups = GetPositionGroups(meshData, *itPositions, options.threadCount, m_groupSizes);
+            m_quadrics.resize(m_groupSizes.size());
+        }
+
+        float Run()
+        {
+            const size_t targetTriangleCount = static_cast<size_t>(m_meshData.indices.size() / 3U * std::max(0.0f, std::min(m_options.targetRatio, 1.0f)));
+
+            double resultError = 0.0;
+
+            UpdateTopology();
+            ComputeQuadrics();
+
+            while (m_meshData.indices.size() / 3U > targetTriangleCount)
+            {
+                auto collapses = GetCollapses();
+
+                std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b)
+                {
+                    return a.error < b.error || (a.error == b.error && (a.from < b.from || (a.from == b.from && a.to < b.to)));
+                });
+
+                if (!ApplyCollapses(collapses, m_meshData.indices.size() / 3U - targetTriangleCount, resultError))
+                {
+                    break;
+                }
+
+                UpdateTopology();
+            }
+
+            return static_cast<float>(std::sqrt(resultError));
+        }
+
+    private:
+        uint32_t GetGroup(uint32_t vertex) const
+        {
+            return m_groups[vertex];
+        }
+
+        bool IsBorderEdge(uint32_t a, uint32_t b) const
+        {
+            const bool hasForward = m_edges.count(GetEdgeKey(GetGroup(a), GetGroup(b))) != 0U;
+            const bool hasBackward = m_edges.count(GetEdgeKey(GetGroup(b), GetGroup(a))) != 0U;
+
+            return hasForward != hasBackward;
+        }
+
+        // Rebuilds the set of (directed) edges, which vertices are on a border and which triangles use each vertex
+        void UpdateTopology()
+        {
+            const auto& indices = m_meshData.indices;
+
+            m_edges.clear();
+            m_edges.reserve(indices.size());
+
+            for (size_t i = 0U; i < indices.size(); i += 3U)
+            {
+                for (size_t j = 0U; j < 3U; j++)
+                {
+                    m_edges.insert(GetEdgeKey(GetGroup(indices[i + j]), GetGroup(indices[i + (j + 1U) % 3U])));
+                }
+            }
+
+            m_isBorder.assign(m_groupSizes.size(), false);
+
+            for (size_t i = 0U; i < indices.size(); i += 3U)
+            {
+                for (size_t j = 0U; j < 3U; j++)
+                {
+                    const uint32_t a = indices[i + j];
+                    const uint32_t b = indices[i + (j + 1U) % 3U];
+
+                    if (IsBorderEdge(a, b))
+                    {
+                        m_isBorder[GetGroup(a)] = true;
+                        m_isBorder[GetGroup(b)] = true;
+                    }
+                }
+            }
+
+            m_triangleOffsets.assign(m_meshData.vertexCount + 1U, 0U);
+
+            for (uint32_t index : indices)
+            {
+                m_triangleOffsets[index + 1U]++;
+            }
+
+            std::partial_sum(m_triangleOffsets.begin(), m_triangleOffsets.end(), m_triangleOffsets.begin());
+
+            m_vertexTriangles.resize(indices.size());
+
+            std::vector<uint32_t> ends(m_triangleOffsets.begin(), m_triangleOffsets.end() - 1U);
+
+            for (size_t i = 0U; i < indices.size(); i++)
+            {
+                m_vertexTriangles[ends[indices[i]]++] = static_cast<uint32_t>(i / 3U);
+            }
+        }
+
+        void ComputeQuadrics()
+        {
+            const auto& indices = m_meshData.indices;
+
+            for (size_t i = 0U; i < indices.size(); i += 3U)
+            {
+                const Point& p0 = m_positions[indices[i]];
+                const Point& p1 = m_positions[indices[i + 1U]];
+                const Point& p2 = m_positions[indices[i + 2U]];
+
+                Point normal = Cross(Subtract(p1, p0), Subtract(p2, p0));
+                const float length = std::sqrt(Dot(normal, normal));
+
+                if (length <= 0.0f)
+                {
+                    continue;
+                }
+
+                normal = { normal.x / length, normal.y / length, normal.z / length };
+
+                Quadric quadric;
+                quadric.AddPlane(normal, -Dot(normal, p0), length * 0.5f);
+
+                for (size_t j = 0U; j < 3U; j++)
+                {
+                    m_quadrics[GetGroup(indices[i + j])] += quadric;
+                }
+
+                for (size_t j = 0U; j < 3U; j++)
+                {
+                    const uint32_t a = indices[i + j];
+                    const uint32_t b = indices[i + (j + 1U) % 3U];
+
+                    if (!IsBorderEdge(a, b))
+                    {
+                        continue;
+                    }
+
+                    const Point edge = Subtract(m_positions[b], m_positions[a]);
+                    const float edgeLengthSquared = Dot(edge, edge);
+
+                    Point borderNormal = Cross(edge, normal);
+                    const float borderNormalLength = std::sqrt(Dot(borderNormal, borderNormal));
+
+                    if (borderNormalLength <= 0.0f)
+                    {
+                        continue;
+                    }
+
+                    borderNormal = { borderNormal.x / borderNormalLength, borderNormal.y / borderNormalLength, borderNormal.z / borderNormalLength };
+
+                    Quadric borderQuadric;
+                    borderQuadric.AddPlane(borderNormal, -Dot(borderNormal, m_positions[a]), edgeLengthSquared * BorderWeight);
+
+                    m_quadrics[GetGroup(a)] += borderQuadric;
+                    m_quadrics[GetGroup(b)] += borderQuadric;
+                }
+            }
+        }
+
+        // Vertices on attribute seams are never moved and vertices on borders can only move along the border
+        bool CanCollapse(uint32_t from, uint32_t to) const
+        {
+            const uint32_t fromGroup = GetGroup(from);
+
+            if (fromGroup == GetGroup(to) || m_groupSizes[fromGroup] > 1U)
+            {
+                return false;
+            }
+
+            return !m_isBorder[fromGroup] || IsBorderEdge(from, to);
+        }
+
+        double GetCollapseError(uint32_t from, uint32_t to) const
+        {
+            Quadric quadric = m_quadrics[GetGroup(from)];
+            quadric += m_quadrics[GetGroup(to)];
+
+            double displacementError = 0.0;
+            double attributeError = 0.0;
+
+            for (size_t i = 0U; i < m_attributeCount; i++)
+            {
+                const double difference = m_attributes[from * m_attributeCount + i] - m_attributes[to * m_attributeCount + i];
+
+                (i < m_displacementCount ? displacementError : attributeError) += difference * difference;
+            }
+
+            // Like an attribute quadric, which integrates the difference over the area of the triangles around the vertex,
+            // the difference in other attributes is scaled by the squared length of the collapsed edge. The attributes
+            // of a finely tessellated smooth surface then vary little relative to the size of each collapse.
+            const Point edge = Subtract(m_positions[to], m_positions[from]);
+
+            return quadric.Evaluate(m_positions[to]) + m_options.attributeWeight * (displacementError + Dot(edge, edge) * attributeError);
+        }
+
+        std::vector<Collapse> GetCollapses() const
+        {
+            const auto& indices = m_meshData.indices;
+
+            std::vector<Collapse> collapses;
+            collapses.reserve(indices.size());
+
+            for (size_t i = 0U; i < indices.size(); i += 3U)
+            {
+                for (size_t j = 0U; j < 3U; j++)
+                {
+                    const uint32_t a = indices[i + j];
+                    const uint32_t b = indices[i + (j + 1U) % 3U];
+
+                    const bool canCollapseAB = CanCollapse(a, b);
+                    const bool canCollapseBA = CanCollapse(b, a);
+
+                    if (!canCollapseAB && !canCollapseBA)
+                    {
+                        continue;
+                    }
+
+                    const double errorAB = canCollapseAB ? GetCollapseError(a, b) : std::numeric_limits<double>::max();
+                    const double errorBA = canCollapseBA ? GetCollapseError(b, a) : std::numeric_limits<double>::max();
+
+                    if (errorAB <= errorBA)
+                    {
+                        collapses.push_back({ a, b, errorAB });
+                    }
+                    else
+                    {
+                        collapses.push_back({ b, a, errorBA });
+                    }
+                }
+            }
+
+            return collapses;
+        }
+
+        // Returns true if moving 'from' onto 'to' would flip any of the triangles that remain
+        bool IsFlipped(uint32_t from, uint32_t to) const
+        {
+            const auto& indices = m_meshData.indices;
+
+            for (size_t i = m_triangleOffsets[from]; i < m_triangleOffsets[from + 1U]; i++)
+            {
+                const uint32_t* triangle = indices.data() + m_vertexTriangles[i] * 3U;
+
+                if (GetGroup(triangle[0]) == GetGroup(to) || GetGroup(triangle[1]) == GetGroup(to) || GetGroup(triangle[2]) == GetGroup(to))
+                {
+                    continue; // This triangle is removed by the collapse
+                }
+
+                Point before[3];
+                Point after[3];
+
+                for (size_t j = 0U; j < 3U; j++)
+                {
+                    before[j] = m_positions[triangle[j]];
+                    after[j] = triangle[j] == from ? m_positions[to] : before[j];
+                }
+
+                const Point normalBefore = Cross(Subtract(before[1], before[0]), Subtract(before[2], before[0]));
+                const Point normalAfter = Cross(Subtract(after[1], after[0]), Subtract(after[2], after[0]));
+
+                if (Dot(normalBefore, normalAfter) <= 0.0f)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // Applies the cheapest collapses, at most one in each vertex's neighbourhood so that the topology they were
+        // validated against doesn't change, until enough triangles have been removed. Returns false if none were applied.
+        bool ApplyCollapses(const std::vector<Collapse>& collapses, size_t triangleRemovalCount, double& resultError)
+        {
+            auto& indices = m_meshData.indices;
+
+            std::vector<uint32_t> targets(m_meshData.vertexCount);
+            std::iota(targets.begin(), targets.end(), 0U);
+
+            std::vector<bool> isLocked(m_meshData.vertexCount, false);
+
+            size_t removedCount = 0U;
+            bool isCollapsed = false;
+
+            for (const auto& collapse : collapses)
+            {
+                if (collapse.error > m_maxError || removedCount >= triangleRemovalCount)
+                {
+                    break;
+                }
+
+                if (isLocked[collapse.from] || isLocked[collapse.to] || IsFlipped(collapse.from, collapse.to))
+                {
+                    continue;
+                }
+
+                targets[collapse.from] = collapse.to;
+                m_quadrics[GetGroup(collapse.to)] += m_quadrics[GetGroup(collapse.from)];
+
+                resultError = std::max(resultError, collapse.error);
+                isCollapsed = true;
+
+                isLocked[collapse.to] = true;
+
+                for (size_t i = m_triangleOffsets[collapse.from]; i < m_triangleOffsets[collapse.from + 1U]; i++)
+                {
+                    const uint32_t* triangle = indices.data() + m_vertexTriangles[i] * 3U;
+
+                    if (GetGroup(triangle[0]) == GetGroup(collapse.to) || GetGroup(triangle[1]) == GetGroup(collapse.to) || GetGroup(triangle[2]) == GetGroup(collapse.to))
+                    {
+                        removedCount++;
+                    }
+
+                    isLocked[triangle[0]] = true;
+                    isLocked[triangle[1]] = true;
+                    isLocked[triangle[2]] = true;
+                }
+            }
+
+            if (!isCollapsed)
+            {
+                return false;
+            }
+
+            // Triangles with two vertices at the same position are removed
+            size_t writeOffset = 0U;
+
+            for (size_t i = 0U; i < indices.size(); i += 3U)
+            {
+                const uint32_t a = targets[indices[i]];
+                const uint32_t b = targets[indices[i + 1U]];
+                const uint32_t c = targets[indices[i + 2U]];
+
+                if (GetGroup(a) != GetGroup(b) && GetGroup(b) != GetGroup(c) && GetGroup(c) != GetGroup(a))
+                {
+                    indices[writeOffset++] = a;
+                    indices[writeOffset++] = b;
+                    indices[writeOffset++] = c;
+                }
+            }
+
+            indices.resize(writeOffset);
+
+            return true;
+        }
+
+        MeshData& m_meshData;
+        const SimplifyOptions& m_options;
+        const double m_maxError;
+
+        std::vector<Point> m_positions;
+        std::vector<float> m_attributes;
+        size_t m_attributeCount;
+        size_t m_displacementCount;
+
+        std::vector<uint32_t> m_groups;
+        std::vector<uint32_t> m_groupSizes;
+        std::vector<Quadric> m_quadrics;
+
+        std::unordered_set<uint64_t> m_edges;
+        std::vector<bool> m_isBorder;
+        std::vector<size_t> m_triangleOffsets;
+        std::vector<uint32_t> m_vertexTriangles;
+    };
+
+    bool IsSimplifiable(const Document& doc, const MeshPrimitive& meshPrimitive)
+    {
+        if (meshPrimitive.mode != MESH_TRIANGLES && meshPrimitive.mode != MESH_TRIANGLE_STRIP && meshPrimitive.mode != MESH_TRIANGLE_FAN)
+        {
+            return false;
+        }
+
+        std::string positionsAccessorId;
+
+        if (!meshPrimitive.TryGetAttributeAccessorId(ACCESSOR_POSITION, positionsAccessorId))
+        {
+            return false;
+        }
+
+        const Accessor& positions = doc.accessors.Get(positionsAccessorId);
+
+        return positions.type == TYPE_VEC3 && positions.componentType == COMPONENT_FLOAT;
+    }
+
+    // A mesh's primitives at one level of detail. Primitives that can't be simplified (e.g. lines) are left as they are.
+    struct MeshLevel
+    {
+        std::vector<MeshData> primitives;
+        size_t triangleCount = 0U;
+    };
+
+    size_t GetTriangleCount(const std::vector<MeshData>& primitives)
+    {
+        size_t triangleCount = 0U;
+
+        for (const auto& meshData : primitives)
+        {
+            triangleCount += meshData.indices.size() / 3U;
+        }
+
+        return triangleCount;
+    }
+}
+
+float MeshSimplifier::Simplify(MeshData& meshData, const SimplifyOptions& options)
+{
+    if (meshData.indices.size() % 3U != 0U)
+    {
+        throw GLTFException("Index count " + std::to_string(meshData.indices.size()) + " isn't a multiple of 3");
+    }
+
+    for (uint32_t index : meshData.indices)
+    {
+        if (index >= meshData.vertexCount)
+        {
+            throw GLTFException("Index " + std::to_string(index) + " is out of range for a mesh with " + std::to_string(meshData.vertexCount) + " vertices");
+        }
+    }
+
+    return Simplifier(meshData, options).Run();
+}
+
+void MeshSimplifier::GenerateLods(Document& doc, const GLTFResourceReader& reader, BufferBuilder& bufferBuilder, const LodOptions& options)
+{
+    // Each mesh used by a node (that doesn't already have levels of detail) is read once, in the order it's first used
+    std::vector<std::string> meshIds;
+    std::unordered_map<std::string, size_t> meshIndices;
+
+    for (const auto& node : doc.nodes.Elements())
+    {
+        if (!node.meshId.empty() && !node.HasExtension<MSFT::Nodes::Lod>() && meshIndices.emplace(node.meshId, meshIds.size()).second)
+        {
+            meshIds.push_back(node.meshId);
+        }
+    }
+
+    // Reading is done on the calling thread as stream readers aren't required to support concurrent reads
+    std::vector<std::vector<MeshData>> sourceMeshes(meshIds.size());
+
+    for (size_t i = 0U; i < meshIds.size(); i++)
+    {
+        for (const auto& meshPrimitive : doc.meshes.Get(meshIds[i]).primitives)
+        {
+            sourceMeshes[i].push_back(IsSimplifiable(doc, meshPrimitive) ? ReadMeshData(doc, reader, meshPrimitive) : MeshData());
+        }
+    }
+
+    const size_t levelCount = options.levelRatios.size();
+
+    std::vector<MeshLevel> levels(meshIds.size() * levelCount);
+
+    Parallel::For(levels.size(), options.threadCount, [&](size_t task)
+    {
+        const auto& source = sourceMeshes[task / levelCount];
+        auto& level = levels[task];
+
+        SimplifyOptions simplifyOptions;
+        simplifyOptions.targetRatio = options.levelRatios[task % levelCount];
+        simplifyOptions.maxError = options.maxError;
+        simplifyOptions.attributeWeight = options.attributeWeight;
+        simplifyOptions.threadCount = 1U; // Levels are already simplified in parallel
+
+        level.primitives = source;
+
+        for (auto& meshData : level.primitives)
+        {
+            if (!meshData.indices.empty())
+            {
+                Simplify(meshData, simplifyOptions);
+                OptimizeVertexOrder(meshData);
+            }
+        }
+
+        level.triangleCount = GetTriangleCount(level.primitives);
+    });
+
+    // Each level's mesh is written and then used by a new node for every node that uses the original mesh
+    std::vector<std::vector<std::string>> lodMeshIds(meshIds.size());
+
+    for (size_t i = 0U; i < meshIds.size(); i++)
+    {
+        const Mesh mesh = doc.meshes.Get(meshIds[i]); // A copy, as appending LOD meshes invalidates references
+
+        size_t previousTriangleCount = GetTriangleCount(sourceMeshes[i]);
+
+        for (size_t j = 0U; j < levelCount; j++)
+        {
+            const auto& level = levels[i * levelCount + j];
+
+            if (level.triangleCount >= previousTriangleCount)
+            {
+                continue;
+            }
+
+            previousTriangleCount = level.triangleCount;
+
+            Mesh lodMesh = mesh;
+            lodMesh.id.clear();
+            lodMesh.name = mesh.name.empty() ? std::string() : mesh.name + "_LOD" + std::to_string(lodMeshIds[i].size() + 1U);
+            lodMesh.primitives.clear();
+
+            for (size_t k = 0U; k < mesh.primitives.size(); k++)
+            {
+                const auto& meshData = level.primitives[k];
+
+                if (meshData.indices.empty() && sourceMeshes[i][k].indices.empty())
+                {
+                    lodMesh.primitives.push_back(mesh.primitives[k]);
+                }
+                else if (!meshData.indices.empty())
+                {
+                    lodMesh.primitives.push_back(WriteMeshData(meshData, mesh.primitives[k], bufferBuilder));
+                }
+            }
+
+            if (!lodMesh.primitives.empty())
+            {
+                lodMeshIds[i].push_back(doc.meshes.Append(std::move(lodMesh), AppendIdPolicy::GenerateOnEmpty).id);
+            }
+        }
+    }
+
+    const size_t nodeCount = doc.nodes.Size();
+    bool isLodUsed = false;
+
+    for (size_t i = 0U; i < nodeCount; i++)
+    {
+        Node node = doc.nodes[i];
+
+        const auto itMesh = meshIndices.find(node.meshId);
+
+        if (itMesh == meshIndices.end() || node.HasExtension<MSFT::Nodes::Lod>() || lodMeshIds[itMesh->second].empty())
+        {
+            continue;
+        }
+
+        auto lod = std::make_unique<MSFT::Nodes::Lod>();
+
+        for (const auto& lodMeshId : lodMeshIds[itMesh->second])
+        {
+            // LOD nodes replace the original so they share its transform and skin but not its children
+            Node lodNode;
+            lodNode.name = node.name.empty() ? std::string() : node.name + "_LOD" + std::to_string(lod->ids.size() + 1U);
+            lodNode.skinId = node.skinId;
+            lodNode.matrix = node.matrix;
+            lodNode.meshId = lodMeshId;
+            lodNode.rotation = node.rotation;
+            lodNode.scale = node.scale;
+            lodNode.translation = node.translation;
+            lodNode.weights = node.weights;
+
+            lod->ids.push_back(doc.nodes.Append(std::move(lodNode), AppendIdPolicy::GenerateOnEmpty).id);
+        }
+
+        node.SetExtension(std::move(lod));
+        doc.nodes.Replace(std::move(node));
+
+        isLodUsed = true;
+    }
+
+    if (isLodUsed)
+    {
+        doc.extensionsUsed.insert(MSFT::Nodes::LOD_NAME);
+    }
+}
@@ -0,0 +1,595 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/MeshTangentSpace.h>
+
+#include <GLTFSDK/BufferBuilder.h>
+#include <GLTFSDK/ConversionKernels.h>
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/MeshPrimitiveUtils.h>
+#include <GLTFSDK/Parallel.h>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::MeshTangentSpace;
+
+namespace
+{
+    // The number of triangles (or vertices) processed by each task
+    const size_t BlockSize = 4096U;
+
+    Vector3 Add(const Vector3& a, const Vector3& b)
+    {
+        return Vector3(a.x + b.x, a.y + b.y, a.z + b.z);
+    }
+
+    Vector3 Subtract(const Vector3& a, const Vector3& b)
+    {
+        return Vector3(a.x - b.x, a.y - b.y, a.z - b.z);
+    }
+
+    Vector3 Scale(const Vector3& v, float s)
+    {
+        return Vector3(v.x * s, v.y * s, v.z * s);
+    }
+
+    Vector3 Cross(const Vector3& a, const Vector3& b)
+    {
+        return Vector3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+    }
+
+    float Dot(const Vector3& a, const Vector3& b)
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    float Length(const Vector3& v)
+    {
+        return std::sqrt(Dot(v, v));
+    }
+
+    // The component of 'v' perpendicular to the unit vector 'normal'
+    Vector3 ProjectOntoPlane(const Vector3& v, const Vector3& normal)
+    {
+        return Subtract(v, Scale(normal, Dot(normal, v)));
+    }
+
+    // The angle between two vectors of any length, accurate for small and large angles alike. Zero if either is zero.
+    float GetAngle(const Vector3& a, const Vector3& b)
+    {
+        return std::atan2(Length(Cross(a, b)), Dot(a, b));
+    }
+
+    Vector3 LoadVector(const std::vector<float>& values, size_t index)
+    {
+        return Vector3(values[index * 3U], values[index * 3U + 1U], values[index * 3U + 2U]);
+    }
+
+    void StoreVector(const Vector3& v, float* dst)
+    {
+        dst[0] = v.x;
+        dst[1] = v.y;
+        dst[2] = v.z;
+    }
+
+    // Calls fn(begin, end) for each block of [0, count)
+    template<typename Fn>
+    void ForBlocks(size_t count, size_t threadCount, Fn fn)
+    {
+        Parallel::For((count + BlockSize - 1U) / BlockSize, threadCount, [&](size_t block)
+        {
+            fn(block * BlockSize, std::min((block + 1U) * BlockSize, count));
+        });
+    }
+
+    size_t GetThreadCount(size_t triangleCount, const TangentSpaceOptions& options)
+    {
+        return triangleCount < options.minParallelTriangleCount ? 1U : Parallel::GetThreadCount(options.threadCount);
+    }
+
+    size_t GetVertexCount(const std::vector<uint32_t>& indices, const std::vector<float>& positions)
+    {
+        if (positions.size() % 3U != 0U)
+        {
+            throw GLTFException("Positions must have three components per vertex");
+        }
+
+        if (indices.size() % 3U != 0U)
+        {
+            throw GLTFException("The number of indices in a triangle list must be a multiple of 3");
+        }
+
+        if (indices.size() > std::numeric_limits<uint32_t>::max())
+        {
+            throw GLTFException("Too many indices to generate a tangent space");
+        }
+
+        const size_t vertexCount = positions.size() / 3U;
+
+        for (uint32_t index : indices)
+        {
+            if (index >= vertexCount)
+            {
+                throw GLTFException("Index " + std::to_string(index) + " is out of range for a mesh with " + std::to_string(vertexCount) + " vertices");
+            }
+        }
+
+        return vertexCount;
+    }
+
+    // Maps each vertex to the first vertex with an identical position
+    std::vector<uint32_t> GetPositionGroups(const std::vector<float>& positions)
+    {
+        using Key = std::array<uint32_t, 3>;
+
+        struct KeyHash
+        {
+            size_t operator()(const Key& key) const
+            {
+                uint64_t hash = key[0];
+                hash = hash * 0x9E3779B97F4A7C15ULL ^ key[1];
+                hash = hash * 0x9E3779B97F4A7C15ULL ^ key[2];
+                return static_cast<size_t>(hash ^ (hash >> 32U));
+            }
+        };
+
+        const size_t vertexCount = positions.size() / 3U;
+
+        std::vector<uint32_t> groups(vertexCount);
+        std::unordered_map<Key, uint32_t, KeyHash> firstVertices(vertexCount);
+
+        for (size_t i = 0U; i < vertexCount; i++)
+        {
+            Key key;
+
+            for (size_t j = 0U; j < 3U; j++)
+            {
+                const float value = positions[i * 3U + j] + 0.0f; // Adding zero makes -0 equal to +0
+                std::memcpy(&key[j], &value, sizeof(float));
+            }
+
+            groups[i] = firstVertices.emplace(key, static_cast<uint32_t>(i)).first->second;
+        }
+
+        return groups;
+    }
+
+    // The triangle corners (indices of 'indices') around each vertex, or around each group of vertices
+    struct CornerAdjacency
+    {
+        std::vector<uint32_t> offsets; // The corners around vertex 'i' are [offsets[i], offsets[i + 1])
+        std::vector<uint32_t> corners;
+    };
+
+    CornerAdjacency GetCornerAdjacency(const std::vector<uint32_t>& indices, const std::vector<uint32_t>& groups, size_t vertexCount)
+    {
+        auto getKey = [&groups](uint32_t index)
+        {
+            return groups.empty() ? index : groups[index];
+        };
+
+        CornerAdjacency adjacency;
+        adjacency.offsets.assign(vertexCount + 1U, 0U);
+        adjacency.corners.resize(indices.size());
+
+        for (uint32_t index : indices)
+        {
+            adjacency.offsets[getKey(index) + 1U]++;
+        }
+
+        std::partial_sum(adjacency.offsets.begin(), adjacency.offsets.end(), adjacency.offsets.begin());
+
+        std::vector<uint32_t> next(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+
+        for (size_t i = 0U; i < indices.size(); i++)
+        {
+            adjacency.corners[next[getKey(indices[i])]++] = static_cast<uint32_t>(i);
+        }
+
+        return adjacency;
+    }
+
+    // A unit vector perpendicular to the unit vector 'normal'
+    Vector3 GetPerpendicular(const Vector3& normal)
+    {
+        const Vector3 axis = std::abs(normal.x) < 0.9f ? Vector3(1.0f, 0.0f, 0.0f) : Vector3(0.0f, 1.0f, 0.0f);
+        const Vector3 perpendicular = ProjectOntoPlane(axis, normal);
+
+        return Scale(perpendicular, 1.0f / Length(perpendicular));
+    }
+
+    bool IsTriangles(MeshMode mode)
+    {
+        return mode == MESH_TRIANGLES || mode == MESH_TRIANGLE_STRIP || mode == MESH_TRIANGLE_FAN;
+    }
+
+    // The inputs and outputs for generating a primitive's tangent space
+    struct TangentSpaceJob
+    {
+        bool generateNormals = false;
+        bool generateTangents = false;
+        bool removeTangents = false;
+
+        std::vector<uint32_t> indices;
+        std::vector<float> positions;
+        std::vector<float> normals;
+        std::vector<float> texcoords;
+        std::vector<float> tangents;
+    };
+
+    std::vector<float> ReadAttribute(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, const std::string& semantic, AccessorType accessorType)
+    {
+        const Accessor& accessor = doc.accessors.Get(meshPrimitive.GetAttributeAccessorId(semantic));
+
+        if (accessor.type != accessorType)
+        {
+            throw GLTFException("Invalid type for " + semantic + " accessor " + accessor.id);
+        }
+
+        return reader.ReadFloatData(doc, accessor);
+    }
+
+    // Reads what's needed to generate the primitive's tangent space, or returns false if it doesn't need generating
+    bool ReadJob(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, const TangentSpaceOptions& options, TangentSpaceJob& job)
+    {
+        if (!IsTriangles(meshPrimitive.mode) || !meshPrimitive.HasAttribute(ACCESSOR_POSITION))
+        {
+            return false;
+        }
+
+        const bool hasNormals = meshPrimitive.HasAttribute(ACCESSOR_NORMAL);
+        const bool hasTangents = meshPrimitive.HasAttribute(ACCESSOR_TANGENT);
+
+        std::string texcoordSemantic;
+
+        if (!meshPrimitive.materialId.empty())
+        {
+            const Material& material = doc.materials.Get(meshPrimitive.materialId);
+
+            if (!material.normalTexture.textureId.empty())
+            {
+                texcoordSemantic = "TEXCOORD_" + std::to_string(material.normalTexture.texCoord);
+            }
+        }
+
+        // A primitive's tangents are ignored when it doesn't have normals
+        job.generateNormals = !hasNormals || options.replaceExisting;
+        job.generateTangents = !texcoordSemantic.empty() && meshPrimitive.HasAttribute(texcoordSemantic) && (!hasNormals || !hasTangents || options.replaceExisting);
+        job.removeTangents = !hasNormals && hasTangents && !job.generateTangents;
+
+        if (!job.generateNormals && !job.generateTangents)
+        {
+            return false;
+        }
+
+        job.indices = MeshPrimitiveUtils::GetTriangulatedIndices32(doc, reader, meshPrimitive);
+        job.positions = ReadAttribute(doc, reader, meshPrimitive, ACCESSOR_POSITION, TYPE_VEC3);
+
+        if (!job.generateNormals)
+        {
+            job.normals = ReadAttribute(doc, reader, meshPrimitive, ACCESSOR_NORMAL, TYPE_VEC3);
+
+            // Quantized normals are only approximately unit length
+            ConversionKernels::NormalizeFloat3(job.normals.data(), job.normals.data(), job.normals.size() / 3U);
+        }
+
+        if (job.generateTangents)
+        {
+            job.texcoords = ReadAttribute(doc, reader, meshPrimitive, texcoordSemantic, TYPE_VEC2);
+        }
+
+        return true;
+    }
+
+    void RunJob(TangentSpaceJob& job, const TangentSpaceOptions& options)
+    {
+        if (job.generateNormals)
+        {
+            job.normals = GenerateNormals(job.indices, job.positions, options);
+        }
+
+        if (job.generateTangents)
+        {
+            job.tangents = GenerateTangents(job.indices, job.positions, job.normals, job.texcoords, options);
+        }
+    }
+
+    std::string WriteAttribute(const std::vector<float>& values, AccessorType accessorType, BufferBuilder& bufferBuilder)
+    {
+        bufferBuilder.AddBufferView(BufferViewTarget::ARRAY_BUFFER);
+        return bufferBuilder.AddAccessor(values, { accessorType, COMPONENT_FLOAT }).id;
+    }
+
+    MeshPrimitive WriteJob(const TangentSpaceJob& job, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder)
+    {
+        MeshPrimitive result = meshPrimitive;
+
+        if (job.generateNormals)
+        {
+            result.attributes[ACCESSOR_NORMAL] = WriteAttribute(job.normals, TYPE_VEC3, bufferBuilder);
+        }
+
+        if (job.generateTangents)
+        {
+            result.attributes[ACCESSOR_TANGENT] = WriteAttribute(job.tangents, TYPE_VEC4, bufferBuilder);
+        }
+        else if (job.removeTangents)
+        {
+            result.attributes.erase(ACCESSOR_TANGENT);
+        }
+
+        return result;
+    }
+}
+
+std::vector<float> MeshTangentSpace::GenerateNormals(const std::vector<uint32_t>& indices, const std::vector<float>& positions, const TangentSpaceOptions& options)
+{
+    const size_t vertexCount = GetVertexCount(indices, positions);
+    const size_t triangleCount = indices.size() / 3U;
+    const size_t threadCount = GetThreadCount(triangleCount, options);
+
+    // Each triangle corner's weighted contribution to its vertex's normal
+    std::vector<float> cornerNormals(indices.size() * 3U, 0.0f);
+
+    ForBlocks(triangleCount, threadCount, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            const uint32_t* triangle = indices.data() + i * 3U;
+
+            const Vector3 p[3] = { LoadVector(positions, triangle[0]), LoadVector(positions, triangle[1]), LoadVector(positions, triangle[2]) };
+
+            // Its length is twice the triangle's area
+            const Vector3 cross = Cross(Subtract(p[1], p[0]), Subtract(p[2], p[0]));
+            const float crossLength = Length(cross);
+
+            if (!(crossLength > 0.0f))
+            {
+                continue;
+            }
+
+            for (size_t j = 0U; j < 3U; j++)
+            {
+                Vector3 normal = cross;
+
+                if (options.normalWeighting != NormalWeighting::Area)
+                {
+                    const float angle = GetAngle(Subtract(p[(j + 1U) % 3U], p[j]), Subtract(p[(j + 2U) % 3U], p[j]));
+
+                    normal = Scale(cross, options.normalWeighting == NormalWeighting::Angle ? angle / crossLength : angle);
+                }
+
+                StoreVector(normal, cornerNormals.data() + (i * 3U + j) * 3U);
+            }
+        }
+    });
+
+    const auto groups = options.smoothSeams ? GetPositionGroups(positions) : std::vector<uint32_t>();
+    const auto adjacency = GetCornerAdjacency(indices, groups, vertexCount);
+
+    std::vector<float> normals(positions.size());
+
+    ForBlocks(vertexCount, threadCount, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            const size_t key = groups.empty() ? i : groups[i];
+
+            Vector3 sum(0.0f, 0.0f, 0.0f);
+
+            for (size_t j = adjacency.offsets[key]; j < adjacency.offsets[key + 1U]; j++)
+            {
+                sum = Add(sum, LoadVector(cornerNormals, adjacency.corners[j]));
+            }
+
+            StoreVector(sum, normals.data() + i * 3U);
+        }
+
+        float* blockNormals = normals.data() + begin * 3U;
+
+        ConversionKernels::NormalizeFloat3(blockNormals, blockNormals, end - begin);
+
+        for (size_t i = begin; i < end; i++)
+        {
+            if (LoadVector(normals, i) == Vector3(0.0f, 0.0f, 0.0f))
+            {
+                StoreVector(Vector3(0.0f, 0.0f, 1.0f), normals.data() + i * 3U);
+            }
+        }
+    });
+
+    return normals;
+}
+
+std::vector<float> MeshTangentSpace::GenerateTangents(const std::vector<uint32_t>& indices, const std::vector<float>& positions, const std::vector<float>& normals, const std::vector<float>& texcoords, const TangentSpaceOptions& options)
+{
+    const size_t vertexCount = GetVertexCount(indices, positions);
+
+    if (normals.size() != positions.size() || texcoords.size() != vertexCount * 2U)
+    {
+        throw GLTFException("Generating tangents requires a normal and texture coordinates for every vertex");
+    }
+
+    const size_t triangleCount = indices.size() / 3U;
+    const size_t threadCount = GetThreadCount(triangleCount, options);
+
+    // Each triangle corner's tangent (weighted by its angle) in xyz and its weighted orientation in w
+    std::vector<float> cornerTangents(indices.size() * 4U, 0.0f);
+
+    ForBlocks(triangleCount, threadCount, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            const uint32_t* triangle = indices.data() + i * 3U;
+
+            const Vector3 p[3] = { LoadVector(positions, triangle[0]), LoadVector(positions, triangle[1]), LoadVector(positions, triangle[2]) };
+
+            const Vector3 d1 = Subtract(p[1], p[0]);
+            const Vector3 d2 = Subtract(p[2], p[0]);
+
+            // MikkTSpace's texture space has a bottom-left origin, so glTF's v coordinates are negated
+            const float s21 = texcoords[triangle[1] * 2U] - texcoords[triangle[0] * 2U];
+            const float s31 = texcoords[triangle[2] * 2U] - texcoords[triangle[0] * 2U];
+            const float t21 = texcoords[triangle[0] * 2U + 1U] - texcoords[triangle[1] * 2U + 1U];
+            const float t31 = texcoords[triangle[0] * 2U + 1U] - texcoords[triangle[2] * 2U + 1U];
+
+            const float signedArea = s21 * t31 - t21 * s31;
+
+            // The direction in which s increases, flipped when the texture is mirrored
+            const Vector3 tangent = Subtract(Scale(d1, t31), Scale(d2, t21));
+            const float tangentLength = Length(tangent);
+
+            if (!(std::abs(signedArea) > 0.0f) || !(tangentLength > 0.0f))
+            {
+                continue;
+            }
+
+            const float orientation = signedArea > 0.0f ? 1.0f : -1.0f;
+            const Vector3 unitTangent = Scale(tangent, orientation / tangentLength);
+
+            for (size_t j = 0U; j < 3U; j++)
+            {
+                const Vector3 normal = LoadVector(normals, triangle[j]);
+                const Vector3 projected = ProjectOntoPlane(unitTangent, normal);
+                const float projectedLength = Length(projected);
+
+                if (!(projectedLength > 0.0f))
+                {
+                    continue;
+                }
+
+                const Vector3 edge1 = ProjectOntoPlane(Subtract(p[(j + 1U) % 3U], p[j]), normal);
+                const Vector3 edge2 = ProjectOntoPlane(Subtract(p[(j + 2U) % 3U], p[j]), normal);
+                const float angle = GetAngle(edge1, edge2);
+
+                float* cornerTangent = cornerTangents.data() + (i * 3U + j) * 4U;
+
+                StoreVector(Scale(projected, angle / projectedLength), cornerTangent);
+                cornerTangent[3] = orientation * angle;
+            }
+        }
+    });
+
+    const auto adjacency = GetCornerAdjacency(indices, {}, vertexCount);
+
+    std::vector<float> tangents(vertexCount * 4U);
+
+    ForBlocks(vertexCount, threadCount, [&](size_t begin, size_t end)
+    {
+        // The block's tangent directions, packed for normalizing
+        std::vector<float> directions((end - begin) * 3U);
+
+        for (size_t i = begin; i < end; i++)
+        {
+            Vector3 sum(0.0f, 0.0f, 0.0f);
+            float orientation = 0.0f;
+
+            for (size_t j = adjacency.offsets[i]; j < adjacency.offsets[i + 1U]; j++)
+            {
+                const float* cornerTangent = cornerTangents.data() + adjacency.corners[j] * 4U;
+
+                sum = Add(sum, Vector3(cornerTangent[0], cornerTangent[1], cornerTangent[2]));
+                orientation += cornerTangent[3];
+            }
+
+            StoreVector(ProjectOntoPlane(sum, LoadVector(normals, i)), directions.data() + (i - begin) * 3U);
+            tangents[i * 4U + 3U] = orientation < 0.0f ? -1.0f : 1.0f;
+        }
+
+        ConversionKernels::NormalizeFloat3(directions.data(), directions.data(), end - begin);
+
+        for (size_t i = begin; i < end; i++)
+        {
+            Vector3 direction = LoadVector(directions, i - begin);
+
+            if (direction == Vector3(0.0f, 0.0f, 0.0f))
+            {
+                direction = GetPerpendicular(LoadVector(normals, i));
+            }
+
+            StoreVector(direction, tangents.data() + i * 4U);
+        }
+    });
+
+    return tangents;
+}
+
+MeshPrimitive MeshTangentSpace::GenerateTangentSpace(const Document& doc, const GLTFResourceReader& reader, const MeshPrimitive& meshPrimitive, BufferBuilder& bufferBuilder, const TangentSpaceOptions& options)
+{
+    TangentSpaceJob job;
+
+    if (!ReadJob(doc, reader, meshPrimitive, options, job))
+    {
+        return meshPrimitive;
+    }
+
+    RunJob(job, options);
+
+    return WriteJob(job, meshPrimitive, bufferBuilder);
+}
+
+void MeshTangentSpace::GenerateTangentSpace(Document& doc, const GLTFResourceReader& reader, BufferBuilder& bufferBuilder, const TangentSpaceOptions& options)
+{
+    struct PrimitiveJob
+    {
+        size_t meshIndex;
+        size_t primitiveIndex;
+        TangentSpaceJob job;
+    };
+
+    std::vector<PrimitiveJob> jobs;
+
+    for (size_t i = 0U; i < doc.meshes.Size(); i++)
+    {
+        const Mesh& mesh = doc.meshes[i];
+
+        for (size_t j = 0U; j < mesh.primitives.size(); j++)
+        {
+            TangentSpaceJob job;
+
+            if (ReadJob(doc, reader, mesh.primitives[j], options, job))
+            {
+                jobs.push_back({ i, j, std::move(job) });
+            }
+        }
+    }
+
+    // Large primitives are processed one at a time, each using every thread, and the rest in parallel with each other
+    std::vector<size_t> smallJobs;
+
+    for (size_t i = 0U; i < jobs.size(); i++)
+    {
+        if (jobs[i].job.indices.size() / 3U >= options.minParallelTriangleCount)
+        {
+            RunJob(jobs[i].job, options);
+        }
+        else
+        {
+            smallJobs.push_back(i);
+        }
+    }
+
+    Parallel::For(smallJobs.size(), options.threadCount, [&](size_t i)
+    {
+        RunJob(jobs[smallJobs[i]].job, options);
+    });
+
+    for (size_t i = 0U; i < jobs.size();)
+    {
+        Mesh mesh = doc.meshes[jobs[i].meshIndex];
+
+        for (const size_t meshIndex = jobs[i].meshIndex; i < jobs.size() && jobs[i].meshIndex == meshIndex; i++)
+        {
+            mesh.primitives[jobs[i].primitiveIndex] = WriteJob(jobs[i].job, mesh.primitives[jobs[i].primitiveIndex], bufferBuilder);
+        }
+
+        doc.meshes.Replace(std::move(mesh));
+    }
+}
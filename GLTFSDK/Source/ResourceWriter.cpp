@@ -3,6 +3,8 @@
 
 #include <GLTFSDK/ResourceWriter.h>
 
+#include <GLTFSDK/Tracing.h>
+
 using namespace Microsoft::glTF;
 
 ResourceWriter::ResourceWriter(std::unique_ptr<IStreamWriterCache> streamWriterCache) : m_streamWriterCache(std::move(streamWriterCache))
@@ -53,6 +55,7 @@ void ResourceWriter::WriteExternal(const std::string& uri, const void* data, siz
     if (auto stream = m_streamWriterCache->Get(uri))
     {
         StreamUtils::WriteBinary(*stream, data, byteLength);
+        GLTFSDK_TRACE_COUNT("BytesWritten", byteLength);
     }
 }
 
@@ -89,5 +92,6 @@ void ResourceWriter::WriteImpl(const BufferView& bufferView, const void* data, s
         }
 
         SetBufferOffset(bufferView.bufferId, totalOffset + totalByteLength);
+        GLTFSDK_TRACE_COUNT("BytesWritten", totalByteLength);
     }
 }
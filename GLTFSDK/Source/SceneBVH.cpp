@@ -0,0 +1,1324 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/SceneBVH.h>
+
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/MeshPrimitiveUtils.h>
+#include <GLTFSDK/Parallel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <istream>
+#include <numeric>
+#include <ostream>
+#include <tuple>
+#include <unordered_map>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    const uint32_t SerializationMagic = 0x48564247U; // "GBVH" in little-endian byte order
+    const uint32_t SerializationVersion = 1U;
+
+    // Surface area heuristic splits can be unbalanced, so deeper nodes are split at the median to bound the depth
+    const size_t MaxSahDepth = 64U;
+
+    // The number of triangles (or nodes) processed by each task when work is split across threads
+    const size_t BlockSize = 4096U;
+
+    // The cost of visiting a node, relative to the cost of intersecting a triangle
+    const float TraversalCost = 1.0f;
+
+    Vector3 Add(const Vector3& a, const Vector3& b)
+    {
+        return Vector3(a.x + b.x, a.y + b.y, a.z + b.z);
+    }
+
+    Vector3 Subtract(const Vector3& a, const Vector3& b)
+    {
+        return Vector3(a.x - b.x, a.y - b.y, a.z - b.z);
+    }
+
+    Vector3 Scale(const Vector3& v, float s)
+    {
+        return Vector3(v.x * s, v.y * s, v.z * s);
+    }
+
+    Vector3 Cross(const Vector3& a, const Vector3& b)
+    {
+        return Vector3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+    }
+
+    float Dot(const Vector3& a, const Vector3& b)
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    Vector3 LoadVector(const float* v)
+    {
+        return Vector3(v[0], v[1], v[2]);
+    }
+
+    float GetComponent(const Vector3& v, size_t axis)
+    {
+        return axis == 0U ? v.x : (axis == 1U ? v.y : v.z);
+    }
+
+    struct Box
+    {
+        float min[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+        float max[3] = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+
+        void Grow(const float* point)
+        {
+            for (size_t i = 0U; i < 3U; i++)
+            {
+                min[i] = std::min(min[i], point[i]);
+                max[i] = std::max(max[i], point[i]);
+            }
+        }
+
+        void Grow(const Box& other)
+        {
+            for (size_t i = 0U; i < 3U; i++)
+            {
+                min[i] = std::min(min[i], other.min[i]);
+                max[i] = std::max(max[i], other.max[i]);
+            }
+        }
+
+        bool IsEmpty() const
+        {
+            return min[0] > max[0] || min[1] > max[1] || min[2] > max[2];
+        }
+
+        // Half the surface area, which is all the surface area heuristic needs
+        float GetArea() const
+        {
+            if (IsEmpty())
+            {
+                return 0.0f;
+            }
+
+            const float x = max[0] - min[0];
+            const float y = max[1] - min[1];
+            const float z = max[2] - min[2];
+
+            return x * y + y * z + z * x;
+        }
+    };
+
+    SceneBVH::Node MakeNode(const Box& box)
+    {
+        SceneBVH::Node node = {};
+
+        std::copy(box.min, box.min + 3, node.min);
+        std::copy(box.max, box.max + 3, node.max);
+
+        return node;
+    }
+
+    // Splits [begin, end) into blocks, calls 'fnRange' for each (in parallel when there is more than one) and merges
+    // their results in order
+    template<typename TResult, typename FnRange, typename FnMerge>
+    TResult ReduceRange(size_t begin, size_t end, size_t threadCount, FnRange fnRange, FnMerge fnMerge)
+    {
+        const size_t blockCount = threadCount > 1U ? (end - begin + BlockSize - 1U) / BlockSize : 1U;
+
+        if (blockCount <= 1U)
+        {
+            return fnRange(begin, end);
+        }
+
+        std::vector<TResult> results(blockCount);
+
+        Parallel::For(blockCount, threadCount, [&](size_t i)
+        {
+            results[i] = fnRange(begin + i * BlockSize, std::min(begin + (i + 1U) * BlockSize, end));
+        });
+
+        for (size_t i = 1U; i < blockCount; i++)
+        {
+            fnMerge(results[0], results[i]);
+        }
+
+        return results[0];
+    }
+
+    class Builder
+    {
+    public:
+        Builder(const std::vector<float>& vertices, const BVHOptions& options) :
+            m_triangleCount(vertices.size() / 9U),
+            m_threadCount(Parallel::GetThreadCount(options.threadCount)),
+            m_maxLeafSize(std::max<size_t>(options.maxLeafSize, 1U)),
+            m_binCount(std::max<size_t>(options.binCount, 2U)),
+            m_boxes(m_triangleCount),
+            m_centroids(m_triangleCount * 3U),
+            m_order(m_triangleCount)
+        {
+            std::iota(m_order.begin(), m_order.end(), 0U);
+
+            Parallel::For((m_triangleCount + BlockSize - 1U) / BlockSize, m_threadCount, [&](size_t block)
+            {
+                for (size_t i = block * BlockSize; i < std::min((block + 1U) * BlockSize, m_triangleCount); i++)
+                {
+                    const float* triangle = vertices.data() + i * 9U;
+
+                    m_boxes[i].Grow(triangle);
+                    m_boxes[i].Grow(triangle + 3U);
+                    m_boxes[i].Grow(triangle + 6U);
+
+                    for (size_t axis = 0U; axis < 3U; axis++)
+                    {
+                        m_centroids[i * 3U + axis] = (m_boxes[i].min[axis] + m_boxes[i].max[axis]) * 0.5f;
+                    }
+                }
+            });
+        }
+
+        // Builds the hierarchy, returning its nodes and the order of the triangles that its leaves refer to
+        std::vector<SceneBVH::Node> Build(std::vector<uint32_t>& order)
+        {
+            std::vector<SceneBVH::Node> nodes;
+
+            if (m_triangleCount > 0U)
+            {
+                // Subtrees small enough to leave some tasks for every thread are built in parallel
+                const size_t taskSize = m_threadCount > 1U ? std::max(BlockSize, m_triangleCount / (m_threadCount * 4U)) : m_triangleCount;
+
+                const size_t root = BuildTop(0U, m_triangleCount, 0U, taskSize);
+
+                Parallel::For(m_tasks.size(), m_threadCount, [&](size_t i)
+                {
+                    auto& task = m_tasks[i];
+                    BuildSubtree(task.begin, task.end, task.depth, task.nodes);
+                });
+
+                Flatten(root, nodes);
+            }
+
+            order = std::move(m_order);
+
+            return nodes;
+        }
+
+    private:
+        struct Bounds
+        {
+            Box box;
+            Box centroids;
+        };
+
+        struct Bin
+        {
+            Box box;
+            size_t count = 0U;
+        };
+
+        struct Split
+        {
+            size_t axis = 3U; // No split was found
+            size_t bin = 0U;  // Triangles in this bin and those before it go to the first child
+            float cost = std::numeric_limits<float>::max();
+        };
+
+        // A node split on the calling thread, above the subtrees that are built in parallel
+        struct TopNode
+        {
+            Box box;
+            size_t children[2];
+            size_t task;
+        };
+
+        struct Task
+        {
+            size_t begin;
+            size_t end;
+            size_t depth;
+            std::vector<SceneBVH::Node> nodes;
+        };
+
+        Bounds GetBounds(size_t begin, size_t end, size_t threadCount) const
+        {
+            return ReduceRange<Bounds>(begin, end, threadCount, [this](size_t rangeBegin, size_t rangeEnd)
+            {
+                Bounds bounds;
+
+                for (size_t i = rangeBegin; i < rangeEnd; i++)
+                {
+                    bounds.box.Grow(m_boxes[m_order[i]]);
+                    bounds.centroids.Grow(m_centroids.data() + m_order[i] * 3U);
+                }
+
+                return bounds;
+            },
+            [](Bounds& bounds, const Bounds& other)
+            {
+                bounds.box.Grow(other.box);
+                bounds.centroids.Grow(other.centroids);
+            });
+        }
+
+        size_t GetBin(uint32_t triangle, size_t axis, const Box& centroids) const
+        {
+            const float extent = centroids.max[axis] - centroids.min[axis];
+            const float offset = m_centroids[triangle * 3U + axis] - centroids.min[axis];
+
+            return std::min(static_cast<size_t>(offset / extent * m_binCount), m_binCount - 1U);
+        }
+
+        Split FindSplit(size_t begin, size_t end, const Box& centroids, size_t threadCount) const
+        {
+            // The bins for all three axes, in a single pass over the triangles
+            const auto bins = ReduceRange<std::vector<Bin>>(begin, end, threadCount, [&](size_t rangeBegin, size_t rangeEnd)
+            {
+                std::vector<Bin> rangeBins(m_binCount * 3U);
+
+                for (size_t axis = 0U; axis < 3U; axis++)
+                {
+                    if (centroids.max[axis] <= centroids.min[axis])
+                    {
+                        continue;
+                    }
+
+                    for (size_t i = rangeBegin; i < rangeEnd; i++)
+                    {
+                        auto& bin = rangeBins[axis * m_binCount + GetBin(m_order[i], axis, centroids)];
+
+                        bin.box.Grow(m_boxes[m_order[i]]);
+                        bin.count++;
+                    }
+                }
+
+                return rangeBins;
+            },
+            [](std::vector<Bin>& rangeBins, const std::vector<Bin>& other)
+            {
+                for (size_t i = 0U; i < rangeBins.size(); i++)
+                {
+                    rangeBins[i].box.Grow(other[i].box);
+                    rangeBins[i].count += other[i].count;
+                }
+            });
+
+            Split split;
+
+            std::vector<float> secondAreas(m_binCount);
+            std::vector<size_t> secondCounts(m_binCount);
+
+            for (size_t axis = 0U; axis < 3U; axis++)
+            {
+                if (centroids.max[axis] <= centroids.min[axis])
+                {
+                    continue;
+                }
+
+                const Bin* axisBins = bins.data() + axis * m_binCount;
+
+                // Sweep from the last bin to find the area and count of the second child for each split
+                Box box;
+                size_t count = 0U;
+
+                for (size_t i = m_binCount - 1U; i > 0U; i--)
+                {
+                    box.Grow(axisBins[i].box);
+                    count += axisBins[i].count;
+
+                    secondAreas[i - 1U] = box.GetArea();
+                    secondCounts[i - 1U] = count;
+                }
+
+                box = Box();
+                count = 0U;
+
+                for (size_t i = 0U; i + 1U < m_binCount; i++)
+                {
+                    box.Grow(axisBins[i].box);
+                    count += axisBins[i].count;
+
+                    if (count == 0U || secondCounts[i] == 0U)
+                    {
+                        continue;
+                    }
+
+                    const float cost = box.GetArea() * count + secondAreas[i] * secondCounts[i];
+
+                    if (cost < split.cost)
+                    {
+                        split.axis = axis;
+                        split.bin = i;
+                        split.cost = cost;
+                    }
+                }
+            }
+
+            return split;
+        }
+
+        // Chooses where to split [begin, end) and partitions its triangles. Returns false if it should be a leaf.
+        bool Partition(size_t begin, size_t end, const Bounds& bounds, size_t depth, size_t threadCount, size_t& middle)
+        {
+            const size_t count = end - begin;
+
+            if (count <= 1U)
+            {
+                return false;
+            }
+
+            if (depth < MaxSahDepth)
+            {
+                const Split split = FindSplit(begin, end, bounds.centroids, threadCount);
+
+                if (split.axis < 3U)
+                {
+                    const float area = bounds.box.GetArea();
+
+                    if (count <= m_maxLeafSize && count * area <= TraversalCost * area + split.cost)
+                    {
+                        return false;
+                    }
+
+                    const auto it = std::partition(m_order.begin() + begin, m_order.begin() + end, [&](uint32_t triangle)
+                    {
+                        return GetBin(triangle, split.axis, bounds.centroids) <= split.bin;
+                    });
+
+                    middle = static_cast<size_t>(it - m_order.begin());
+
+                    return true;
+                }
+            }
+
+            if (count <= m_maxLeafSize)
+            {
+                return false;
+            }
+
+            // The centroids coincide (or the hierarchy is too deep), so split the triangles in half along the longest axis
+            size_t axis = 0U;
+
+            for (size_t i = 1U; i < 3U; i++)
+            {
+                if (bounds.centroids.max[i] - bounds.centroids.min[i] > bounds.centroids.max[axis] - bounds.centroids.min[axis])
+                {
+                    axis = i;
+                }
+            }
+
+            middle = begin + count / 2U;
+
+            std::nth_element(m_order.begin() + begin, m_order.begin() + middle, m_order.begin() + end, [&](uint32_t a, uint32_t b)
+            {
+                return std::make_tuple(m_centroids[a * 3U + axis], a) < std::make_tuple(m_centroids[b * 3U + axis], b);
+            });
+
+            return true;
+        }
+
+        size_t BuildTop(size_t begin, size_t end, size_t depth, size_t taskSize)
+        {
+            const size_t topIndex = m_topNodes.size();
+
+            m_topNodes.push_back({ Box(), { 0U, 0U }, m_tasks.size() });
+
+            const Bounds bounds = GetBounds(begin, end, m_threadCount);
+
+            size_t middle;
+
+            if (end - begin <= taskSize || !Partition(begin, end, bounds, depth, m_threadCount, middle))
+            {
+                m_tasks.push_back({ begin, end, depth, {} });
+                return topIndex;
+            }
+
+            const size_t first = BuildTop(begin, middle, depth + 1U, taskSize);
+            const size_t second = BuildTop(middle, end, depth + 1U, taskSize);
+
+            m_topNodes[topIndex] = { bounds.box, { first, second }, std::numeric_limits<size_t>::max() };
+
+            return topIndex;
+        }
+
+        void BuildSubtree(size_t begin, size_t end, size_t depth, std::vector<SceneBVH::Node>& nodes)
+        {
+            const Bounds bounds = GetBounds(begin, end, 1U);
+            const size_t nodeIndex = nodes.size();
+
+            nodes.push_back(MakeNode(bounds.box));
+
+            size_t middle;
+
+            if (!Partition(begin, end, bounds, depth, 1U, middle))
+            {
+                nodes[nodeIndex].index = static_cast<uint32_t>(begin);
+                nodes[nodeIndex].count = static_cast<uint32_t>(end - begin);
+                return;
+            }
+
+            BuildSubtree(begin, middle, depth + 1U, nodes);
+            nodes[nodeIndex].index = static_cast<uint32_t>(nodes.size());
+            BuildSubtree(middle, end, depth + 1U, nodes);
+        }
+
+        void Flatten(size_t topIndex, std::vector<SceneBVH::Node>& nodes) const
+        {
+            const TopNode& topNode = m_topNodes[topIndex];
+
+            if (topNode.task < m_tasks.size())
+            {
+                // The task's nodes refer to each other from zero
+                const auto base = static_cast<uint32_t>(nodes.size());
+
+                for (auto node : m_tasks[topNode.task].nodes)
+                {
+                    if (node.count == 0U)
+                    {
+                        node.index += base;
+                    }
+
+                    nodes.push_back(node);
+                }
+
+                return;
+            }
+
+            const size_t nodeIndex = nodes.size();
+
+            nodes.push_back(MakeNode(topNode.box));
+
+            Flatten(topNode.children[0], nodes);
+            nodes[nodeIndex].index = static_cast<uint32_t>(nodes.size());
+            Flatten(topNode.children[1], nodes);
+        }
+
+        const size_t m_triangleCount;
+        const size_t m_threadCount;
+        const size_t m_maxLeafSize;
+        const size_t m_binCount;
+
+        std::vector<Box> m_boxes;
+        std::vector<float> m_centroids;
+        std::vector<uint32_t> m_order;
+
+        std::vector<TopNode> m_topNodes;
+        std::vector<Task> m_tasks;
+    };
+
+    bool IsTriangles(MeshMode mode)
+    {
+        return mode == MESH_TRIANGLES || mode == MESH_TRIANGLE_STRIP || mode == MESH_TRIANGLE_FAN;
+    }
+
+    // The nodes with meshes in the scene's hierarchies, or in the whole document if 'sceneId' is empty
+    std::vector<size_t> GetMeshNodes(const Document& doc, const std::string& sceneId)
+    {
+        std::vector<size_t> nodes;
+
+        if (sceneId.empty())
+        {
+            for (size_t i = 0U; i < doc.nodes.Size(); i++)
+            {
+                if (!doc.nodes[i].meshId.empty())
+                {
+                    nodes.push_back(i);
+                }
+            }
+
+            return nodes;
+        }
+
+        std::vector<std::string> stack = doc.scenes.Get(sceneId).nodes;
+
+        while (!stack.empty())
+        {
+            const size_t nodeIndex = doc.nodes.GetIndex(stack.back());
+            stack.pop_back();
+
+            const Node& node = doc.nodes[nodeIndex];
+
+            if (!node.meshId.empty())
+            {
+                nodes.push_back(nodeIndex);
+            }
+
+            stack.insert(stack.end(), node.children.rbegin(), node.children.rend());
+        }
+
+        return nodes;
+    }
+
+    bool IntersectBox(const SceneBVH::Node& node, const Vector3& origin, const Vector3& inverseDirection, float tMin, float tMax, float& tNear)
+    {
+        const float tx0 = (node.min[0] - origin.x) * inverseDirection.x;
+        const float tx1 = (node.max[0] - origin.x) * inverseDirection.x;
+        const float ty0 = (node.min[1] - origin.y) * inverseDirection.y;
+        const float ty1 = (node.max[1] - origin.y) * inverseDirection.y;
+        const float tz0 = (node.min[2] - origin.z) * inverseDirection.z;
+        const float tz1 = (node.max[2] - origin.z) * inverseDirection.z;
+
+        tNear = std::max(std::max(tMin, std::min(tx0, tx1)), std::max(std::min(ty0, ty1), std::min(tz0, tz1)));
+
+        const float tFar = std::min(std::min(tMax, std::max(tx0, tx1)), std::min(std::max(ty0, ty1), std::max(tz0, tz1)));
+
+        return tNear <= tFar;
+    }
+
+    // Möller-Trumbore, without culling back faces
+    bool IntersectTriangle(const float* vertices, const Ray& ray, float tMax, float& t, float& u, float& v)
+    {
+        const Vector3 v0 = LoadVector(vertices);
+        const Vector3 edge1 = Subtract(LoadVector(vertices + 3U), v0);
+        const Vector3 edge2 = Subtract(LoadVector(vertices + 6U), v0);
+
+        const Vector3 p = Cross(ray.direction, edge2);
+        const float determinant = Dot(edge1, p);
+
+        if (determinant == 0.0f)
+        {
+            return false; // The ray is parallel to the triangle, or the triangle is degenerate
+        }
+
+        const float inverseDeterminant = 1.0f / determinant;
+        const Vector3 s = Subtract(ray.origin, v0);
+
+        u = Dot(s, p) * inverseDeterminant;
+
+        if (u < 0.0f || u > 1.0f)
+        {
+            return false;
+        }
+
+        const Vector3 q = Cross(s, edge1);
+
+        v = Dot(ray.direction, q) * inverseDeterminant;
+
+        if (v < 0.0f || u + v > 1.0f)
+        {
+            return false;
+        }
+
+        t = Dot(edge2, q) * inverseDeterminant;
+
+        return t >= ray.tMin && t <= tMax;
+    }
+
+    bool OverlapsBox(const SceneBVH::Node& node, const SceneBounds::BoundingBox& box)
+    {
+        return node.min[0] <= box.max.x && node.max[0] >= box.min.x &&
+               node.min[1] <= box.max.y && node.max[1] >= box.min.y &&
+               node.min[2] <= box.max.z && node.max[2] >= box.min.z;
+    }
+
+    // Separating axis test (Akenine-Möller) between a triangle and a box given by its center and half its size
+    bool TriangleOverlapsBox(const float* vertices, const Vector3& center, const Vector3& halfSize)
+    {
+        const Vector3 v[3] = {
+            Subtract(LoadVector(vertices), center),
+            Subtract(LoadVector(vertices + 3U), center),
+            Subtract(LoadVector(vertices + 6U), center)
+        };
+
+        auto isSeparatingAxis = [&](const Vector3& axis)
+        {
+            const float p0 = Dot(v[0], axis);
+            const float p1 = Dot(v[1], axis);
+            const float p2 = Dot(v[2], axis);
+
+            const float radius = halfSize.x * std::abs(axis.x) + halfSize.y * std::abs(axis.y) + halfSize.z * std::abs(axis.z);
+
+            return std::min(std::min(p0, p1), p2) > radius || std::max(std::max(p0, p1), p2) < -radius;
+        };
+
+        // The box's face normals
+        if (isSeparatingAxis(Vector3(1.0f, 0.0f, 0.0f)) || isSeparatingAxis(Vector3(0.0f, 1.0f, 0.0f)) || isSeparatingAxis(Vector3(0.0f, 0.0f, 1.0f)))
+        {
+            return false;
+        }
+
+        const Vector3 edges[3] = { Subtract(v[1], v[0]), Subtract(v[2], v[1]), Subtract(v[0], v[2]) };
+
+        // The triangle's normal
+        if (isSeparatingAxis(Cross(edges[0], edges[1])))
+        {
+            return false;
+        }
+
+        // The cross products of the box's axes and the triangle's edges
+        for (const auto& edge : edges)
+        {
+            if (isSeparatingAxis(Vector3(0.0f, -edge.z, edge.y)) ||
+                isSeparatingAxis(Vector3(edge.z, 0.0f, -edge.x)) ||
+                isSeparatingAxis(Vector3(-edge.y, edge.x, 0.0f)))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    float GetDistanceSquared(const SceneBVH::Node& node, const Vector3& point)
+    {
+        float distanceSquared = 0.0f;
+
+        for (size_t axis = 0U; axis < 3U; axis++)
+        {
+            const float value = GetComponent(point, axis);
+            const float outside = std::max(std::max(node.min[axis] - value, value - node.max[axis]), 0.0f);
+
+            distanceSquared += outside * outside;
+        }
+
+        return distanceSquared;
+    }
+
+    // From Real-Time Collision Detection (Ericson), section 5.1.5
+    Vector3 GetClosestPoint(const float* vertices, const Vector3& p)
+    {
+        const Vector3 a = LoadVector(vertices);
+        const Vector3 b = LoadVector(vertices + 3U);
+        const Vector3 c = LoadVector(vertices + 6U);
+
+        const Vector3 ab = Subtract(b, a);
+        const Vector3 ac = Subtract(c, a);
+        const Vector3 ap = Subtract(p, a);
+
+        const float d1 = Dot(ab, ap);
+        const float d2 = Dot(ac, ap);
+
+        if (d1 <= 0.0f && d2 <= 0.0f)
+        {
+            return a;
+        }
+
+        const Vector3 bp = Subtract(p, b);
+
+        const float d3 = Dot(ab, bp);
+        const float d4 = Dot(ac, bp);
+
+        if (d3 >= 0.0f && d4 <= d3)
+        {
+            return b;
+        }
+
+        const float vc = d1 * d4 - d3 * d2;
+
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+        {
+            return Add(a, Scale(ab, d1 / (d1 - d3)));
+        }
+
+        const Vector3 cp = Subtract(p, c);
+
+        const float d5 = Dot(ab, cp);
+        const float d6 = Dot(ac, cp);
+
+        if (d6 >= 0.0f && d5 <= d6)
+        {
+            return c;
+        }
+
+        const float vb = d5 * d2 - d1 * d6;
+
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+        {
+            return Add(a, Scale(ac, d2 / (d2 - d6)));
+        }
+
+        const float va = d3 * d6 - d5 * d4;
+
+        if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f)
+        {
+            return Add(b, Scale(Subtract(c, b), (d4 - d3) / ((d4 - d3) + (d5 - d6))));
+        }
+
+        const float denominator = 1.0f / (va + vb + vc);
+
+        return Add(a, Add(Scale(ab, vb * denominator), Scale(ac, vc * denominator)));
+    }
+
+    template<typename T>
+    void WriteValue(std::ostream& stream, const T& value)
+    {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    void WriteVector(std::ostream& stream, const std::vector<T>& values)
+    {
+        WriteValue<uint64_t>(stream, values.size());
+        stream.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+
+    template<typename T>
+    T ReadValue(std::istream& stream)
+    {
+        T value;
+
+        if (!stream.read(reinterpret_cast<char*>(&value), sizeof(T)))
+        {
+            throw GLTFException("Unexpected end of BVH data");
+        }
+
+        return value;
+    }
+
+    template<typename T>
+    std::vector<T> ReadVector(std::istream& stream)
+    {
+        // Read in chunks so that a corrupt count fails at the end of the stream rather than allocating excessive memory
+        const size_t ChunkSize = 65536U;
+
+        uint64_t remaining = ReadValue<uint64_t>(stream);
+
+        std::vector<T> values;
+
+        while (remaining > 0U)
+        {
+            const size_t chunk = static_cast<size_t>(std::min<uint64_t>(remaining, ChunkSize));
+            const size_t offset = values.size();
+
+            values.resize(offset + chunk);
+
+            if (!stream.read(reinterpret_cast<char*>(values.data() + offset), chunk * sizeof(T)))
+            {
+                throw GLTFException("Unexpected end of BVH data");
+            }
+
+            remaining -= chunk;
+        }
+
+        return values;
+    }
+}
+
+bool TriangleRef::operator==(const TriangleRef& other) const
+{
+    return std::tie(nodeIndex, meshIndex, primitiveIndex, triangleIndex) == std::tie(other.nodeIndex, other.meshIndex, other.primitiveIndex, other.triangleIndex);
+}
+
+bool TriangleRef::operator!=(const TriangleRef& other) const
+{
+    return !operator==(other);
+}
+
+SceneBVH::SceneBVH() = default;
+
+SceneBVH SceneBVH::Build(const Document& doc, const GLTFResourceReader& reader, const BVHOptions& options)
+{
+    SceneBVH bvh;
+
+    const auto worldTransforms = SceneBounds::ComputeWorldTransforms(doc, options.threadCount);
+
+    // Each primitive's data is read once, however many nodes use its mesh
+    std::unordered_map<uint64_t, uint32_t> dataIndices;
+
+    for (size_t nodeIndex : GetMeshNodes(doc, options.sceneId))
+    {
+        const size_t meshIndex = doc.meshes.GetIndex(doc.nodes[nodeIndex].meshId);
+        const Mesh& mesh = doc.meshes[meshIndex];
+
+        for (size_t primitiveIndex = 0U; primitiveIndex < mesh.primitives.size(); primitiveIndex++)
+        {
+            const MeshPrimitive& meshPrimitive = mesh.primitives[primitiveIndex];
+
+            std::string positionsAccessorId;
+
+            if (!IsTriangles(meshPrimitive.mode) || !meshPrimitive.TryGetAttributeAccessorId(ACCESSOR_POSITION, positionsAccessorId))
+            {
+                continue;
+            }
+
+            const uint64_t key = static_cast<uint64_t>(meshIndex) << 32U | primitiveIndex;
+
+            auto itData = dataIndices.find(key);
+
+            if (itData == dataIndices.end())
+            {
+                const Accessor& positionsAccessor = doc.accessors.Get(positionsAccessorId);
+
+                if (positionsAccessor.type != TYPE_VEC3)
+                {
+                    throw GLTFException("Invalid type for positions accessor " + positionsAccessor.id);
+                }
+
+                PrimitiveData data;
+                data.positions = reader.ReadFloatData(doc, positionsAccessor);
+                data.indices = MeshPrimitiveUtils::GetTriangulatedIndices32(doc, reader, meshPrimitive);
+
+                for (uint32_t index : data.indices)
+                {
+                    if (index >= positionsAccessor.count)
+                    {
+                        throw GLTFException("Index " + std::to_string(index) + " is out of range for positions accessor " + positionsAccessor.id);
+                    }
+                }
+
+                itData = dataIndices.emplace(key, static_cast<uint32_t>(bvh.m_primitiveData.size())).first;
+                bvh.m_primitiveData.push_back(std::move(data));
+            }
+
+            const auto instance = static_cast<uint32_t>(bvh.m_instances.size());
+            const size_t triangleCount = bvh.m_primitiveData[itData->second].indices.size() / 3U;
+
+            if (bvh.m_triangles.size() + triangleCount > std::numeric_limits<uint32_t>::max())
+            {
+                throw GLTFException("The scene has too many triangles for a BVH");
+            }
+
+            bvh.m_instances.push_back({ static_cast<uint32_t>(nodeIndex), static_cast<uint32_t>(meshIndex), static_cast<uint32_t>(primitiveIndex), itData->second });
+
+            for (size_t i = 0U; i < triangleCount; i++)
+            {
+                bvh.m_triangles.push_back({ instance, static_cast<uint32_t>(i) });
+            }
+        }
+    }
+
+    bvh.TransformTriangles(worldTransforms, options.threadCount);
+
+    std::vector<uint32_t> order;
+    bvh.m_nodes = Builder(bvh.m_vertices, options).Build(order);
+
+    // The triangles are stored in the order the leaves refer to them
+    std::vector<Triangle> triangles(order.size());
+    std::vector<float> vertices(bvh.m_vertices.size());
+
+    for (size_t i = 0U; i < order.size(); i++)
+    {
+        triangles[i] = bvh.m_triangles[order[i]];
+        std::copy_n(bvh.m_vertices.begin() + order[i] * 9U, 9U, vertices.begin() + i * 9U);
+    }
+
+    bvh.m_triangles = std::move(triangles);
+    bvh.m_vertices = std::move(vertices);
+
+    return bvh;
+}
+
+size_t SceneBVH::GetTriangleCount() const
+{
+    return m_triangles.size();
+}
+
+const std::vector<SceneBVH::Node>& SceneBVH::GetNodes() const
+{
+    return m_nodes;
+}
+
+SceneBounds::BoundingBox SceneBVH::GetBounds() const
+{
+    if (m_nodes.empty())
+    {
+        return SceneBounds::BoundingBox();
+    }
+
+    const Node& root = m_nodes.front();
+
+    return SceneBounds::BoundingBox(LoadVector(root.min), LoadVector(root.max));
+}
+
+bool SceneBVH::Intersect(const Ray& ray, RayHit& hit) const
+{
+    struct StackEntry
+    {
+        uint32_t node;
+        float tNear;
+    };
+
+    if (m_nodes.empty())
+    {
+        return false;
+    }
+
+    const Vector3 inverseDirection(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+
+    float tClosest = ray.tMax;
+    bool isHit = false;
+
+    float tRoot;
+
+    if (!IntersectBox(m_nodes[0], ray.origin, inverseDirection, ray.tMin, tClosest, tRoot))
+    {
+        return false;
+    }
+
+    std::vector<StackEntry> stack = { { 0U, tRoot } };
+
+    while (!stack.empty())
+    {
+        const StackEntry entry = stack.back();
+        stack.pop_back();
+
+        if (entry.tNear > tClosest)
+        {
+            continue;
+        }
+
+        const Node& node = m_nodes[entry.node];
+
+        if (node.count > 0U)
+        {
+            for (size_t i = node.index; i < node.index + node.count; i++)
+            {
+                float t, u, v;
+
+                if (IntersectTriangle(GetVertices(i), ray, tClosest, t, u, v))
+                {
+                    tClosest = t;
+                    hit = { GetTriangleRef(i), t, u, v };
+                    isHit = true;
+                }
+            }
+
+            continue;
+        }
+
+        StackEntry children[2] = { { entry.node + 1U, 0.0f }, { node.index, 0.0f } };
+
+        const bool isHit0 = IntersectBox(m_nodes[children[0].node], ray.origin, inverseDirection, ray.tMin, tClosest, children[0].tNear);
+        const bool isHit1 = IntersectBox(m_nodes[children[1].node], ray.origin, inverseDirection, ray.tMin, tClosest, children[1].tNear);
+
+        // The nearer child is pushed last so that it's visited first
+        if (isHit0 && isHit1 && children[0].tNear < children[1].tNear)
+        {
+            std::swap(children[0], children[1]);
+        }
+
+        if (isHit0 && isHit1)
+        {
+            stack.push_back(children[0]);
+            stack.push_back(children[1]);
+        }
+        else if (isHit0 || isHit1)
+        {
+            stack.push_back(children[isHit0 ? 0 : 1]);
+        }
+    }
+
+    return isHit;
+}
+
+std::vector<TriangleRef> SceneBVH::Query(const SceneBounds::BoundingBox& box) const
+{
+    std::vector<TriangleRef> triangles;
+
+    if (m_nodes.empty() || box.IsEmpty())
+    {
+        return triangles;
+    }
+
+    const Vector3 center = Scale(Add(box.min, box.max), 0.5f);
+    const Vector3 halfSize = Scale(Subtract(box.max, box.min), 0.5f);
+
+    std::vector<uint32_t> stack = { 0U };
+
+    while (!stack.empty())
+    {
+        const Node& node = m_nodes[stack.back()];
+        const uint32_t nodeIndex = stack.back();
+
+        stack.pop_back();
+
+        if (!OverlapsBox(node, box))
+        {
+            continue;
+        }
+
+        if (node.count > 0U)
+        {
+            for (size_t i = node.index; i < node.index + node.count; i++)
+            {
+                if (TriangleOverlapsBox(GetVertices(i), center, halfSize))
+                {
+                    triangles.push_back(GetTriangleRef(i));
+                }
+            }
+        }
+        else
+        {
+            stack.push_back(node.index);
+            stack.push_back(nodeIndex + 1U);
+        }
+    }
+
+    return triangles;
+}
+
+bool SceneBVH::FindNearest(const Vector3& point, NearestPoint& nearest, float maxDistance) const
+{
+    struct StackEntry
+    {
+        uint32_t node;
+        float distanceSquared;
+    };
+
+    if (m_nodes.empty())
+    {
+        return false;
+    }
+
+    float closestSquared = maxDistance * maxDistance;
+    bool isFound = false;
+
+    std::vector<StackEntry> stack = { { 0U, GetDistanceSquared(m_nodes[0], point) } };
+
+    while (!stack.empty())
+    {
+        const StackEntry entry = stack.back();
+        stack.pop_back();
+
+        if (entry.distanceSquared > closestSquared)
+        {
+            continue;
+        }
+
+        const Node& node = m_nodes[entry.node];
+
+        if (node.count > 0U)
+        {
+            for (size_t i = node.index; i < node.index + node.count; i++)
+            {
+                const Vector3 closest = GetClosestPoint(GetVertices(i), point);
+                const Vector3 offset = Subtract(closest, point);
+                const float distanceSquared = Dot(offset, offset);
+
+                if (distanceSquared <= closestSquared)
+                {
+                    closestSquared = distanceSquared;
+                    nearest = { GetTriangleRef(i), closest, std::sqrt(distanceSquared) };
+                    isFound = true;
+                }
+            }
+
+            continue;
+        }
+
+        StackEntry children[2] = {
+            { entry.node + 1U, GetDistanceSquared(m_nodes[entry.node + 1U], point) },
+            { node.index, GetDistanceSquared(m_nodes[node.index], point) }
+        };
+
+        // The nearer child is pushed last so that it's visited first
+        if (children[0].distanceSquared < children[1].distanceSquared)
+        {
+            std::swap(children[0], children[1]);
+        }
+
+        stack.push_back(children[0]);
+        stack.push_back(children[1]);
+    }
+
+    return isFound;
+}
+
+void SceneBVH::Refit(const std::vector<Matrix4>& worldTransforms, size_t threadCount)
+{
+    TransformTriangles(worldTransforms, threadCount);
+
+    Parallel::For((m_nodes.size() + BlockSize - 1U) / BlockSize, threadCount, [&](size_t block)
+    {
+        for (size_t i = block * BlockSize; i < std::min((block + 1U) * BlockSize, m_nodes.size()); i++)
+        {
+            Node& node = m_nodes[i];
+
+            if (node.count > 0U)
+            {
+                Box box;
+
+                for (size_t j = node.index * 9U; j < (node.index + node.count) * 9U; j += 3U)
+                {
+                    box.Grow(m_vertices.data() + j);
+                }
+
+                std::copy(box.min, box.min + 3, node.min);
+                std::copy(box.max, box.max + 3, node.max);
+            }
+        }
+    });
+
+    // Children always follow their parent, so visiting the nodes in reverse updates the children first
+    for (size_t i = m_nodes.size(); i-- > 0U;)
+    {
+        Node& node = m_nodes[i];
+
+        if (node.count == 0U)
+        {
+            const Node& first = m_nodes[i + 1U];
+            const Node& second = m_nodes[node.index];
+
+            for (size_t axis = 0U; axis < 3U; axis++)
+            {
+                node.min[axis] = std::min(first.min[axis], second.min[axis]);
+                node.max[axis] = std::max(first.max[axis], second.max[axis]);
+            }
+        }
+    }
+}
+
+void SceneBVH::Refit(const Document& doc, size_t threadCount)
+{
+    Refit(SceneBounds::ComputeWorldTransforms(doc, threadCount), threadCount);
+}
+
+void SceneBVH::Serialize(std::ostream& stream) const
+{
+    WriteValue(stream, SerializationMagic);
+    WriteValue(stream, SerializationVersion);
+
+    WriteVector(stream, m_instances);
+
+    WriteValue<uint64_t>(stream, m_primitiveData.size());
+
+    for (const auto& data : m_primitiveData)
+    {
+        WriteVector(stream, data.positions);
+        WriteVector(stream, data.indices);
+    }
+
+    WriteVector(stream, m_triangles);
+    WriteVector(stream, m_vertices);
+    WriteVector(stream, m_nodes);
+
+    if (!stream)
+    {
+        throw GLTFException("Failed to write BVH data");
+    }
+}
+
+SceneBVH SceneBVH::Deserialize(std::istream& stream)
+{
+    if (ReadValue<uint32_t>(stream) != SerializationMagic)
+    {
+        throw GLTFException("The data isn't a serialized BVH");
+    }
+
+    const auto version = ReadValue<uint32_t>(stream);
+
+    if (version != SerializationVersion)
+    {
+        throw GLTFException("Unsupported BVH version " + std::to_string(version));
+    }
+
+    SceneBVH bvh;
+
+    bvh.m_instances = ReadVector<Instance>(stream);
+
+    uint64_t dataCount = ReadValue<uint64_t>(stream);
+
+    while (dataCount-- > 0U)
+    {
+        PrimitiveData data;
+        data.positions = ReadVector<float>(stream);
+        data.indices = ReadVector<uint32_t>(stream);
+
+        bvh.m_primitiveData.push_back(std::move(data));
+    }
+
+    bvh.m_triangles = ReadVector<Triangle>(stream);
+    bvh.m_vertices = ReadVector<float>(stream);
+    bvh.m_nodes = ReadVector<Node>(stream);
+
+    bvh.Validate();
+
+    return bvh;
+}
+
+TriangleRef SceneBVH::GetTriangleRef(size_t triangle) const
+{
+    const Instance& instance = m_instances[m_triangles[triangle].instance];
+
+    return { instance.nodeIndex, instance.meshIndex, instance.primitiveIndex, m_triangles[triangle].index };
+}
+
+const float* SceneBVH::GetVertices(size_t triangle) const
+{
+    return m_vertices.data() + triangle * 9U;
+}
+
+void SceneBVH::TransformTriangles(const std::vector<Matrix4>& worldTransforms, size_t threadCount)
+{
+    for (const auto& instance : m_instances)
+    {
+        if (instance.nodeIndex >= worldTransforms.size())
+        {
+            throw GLTFException("There is no world transform for node " + std::to_string(instance.nodeIndex));
+        }
+    }
+
+    m_vertices.resize(m_triangles.size() * 9U);
+
+    Parallel::For((m_triangles.size() + BlockSize - 1U) / BlockSize, threadCount, [&](size_t block)
+    {
+        for (size_t i = block * BlockSize; i < std::min((block + 1U) * BlockSize, m_triangles.size()); i++)
+        {
+            const Instance& instance = m_instances[m_triangles[i].instance];
+            const PrimitiveData& data = m_primitiveData[instance.dataIndex];
+            const Matrix4& worldTransform = worldTransforms[instance.nodeIndex];
+
+            for (size_t j = 0U; j < 3U; j++)
+            {
+                const uint32_t index = data.indices[m_triangles[i].index * 3U + j];
+                const Vector3 vertex = Math::TransformPoint(worldTransform, LoadVector(data.positions.data() + index * 3U));
+
+                m_vertices[i * 9U + j * 3U] = vertex.x;
+                m_vertices[i * 9U + j * 3U + 1U] = vertex.y;
+                m_vertices[i * 9U + j * 3U + 2U] = vertex.z;
+            }
+        }
+    });
+}
+
+// Checks that deserialized data is consistent so that queries and refits can't read out of bounds
+void SceneBVH::Validate() const
+{
+    for (const auto& data : m_primitiveData)
+    {
+        const size_t vertexCount = data.positions.size() / 3U;
+
+        if (data.positions.size() % 3U != 0U || data.indices.size() % 3U != 0U ||
+            std::any_of(data.indices.begin(), data.indices.end(), [vertexCount](uint32_t index) { return index >= vertexCount; }))
+        {
+            throw GLTFException("Invalid BVH primitive data");
+        }
+    }
+
+    for (const auto& instance : m_instances)
+    {
+        if (instance.dataIndex >= m_primitiveData.size())
+        {
+            throw GLTFException("Invalid BVH instance");
+        }
+    }
+
+    for (const auto& triangle : m_triangles)
+    {
+        if (triangle.instance >= m_instances.size() || triangle.index >= m_primitiveData[m_instances[triangle.instance].dataIndex].indices.size() / 3U)
+        {
+            throw GLTFException("Invalid BVH triangle");
+        }
+    }
+
+    if (m_vertices.size() != m_triangles.size() * 9U || m_nodes.empty() != m_triangles.empty())
+    {
+        throw GLTFException("Invalid BVH data");
+    }
+
+    for (size_t i = 0U; i < m_nodes.size(); i++)
+    {
+        const Node& node = m_nodes[i];
+
+        const bool isValid = node.count == 0U ?
+            (i + 1U < m_nodes.size() && node.index > i + 1U && node.index < m_nodes.size()) :
+            (static_cast<uint64_t>(node.index) + node.count <= m_triangles.size());
+
+        if (!isValid)
+        {
+            throw GLTFException("Invalid BVH node " + std::to_string(i));
+        }
+    }
+}
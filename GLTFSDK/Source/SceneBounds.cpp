@@ -0,0 +1,606 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/SceneBounds.h>
+
+#include <GLTFSDK/AnimationUtils.h>
+#include <GLTFSDK/ConversionKernels.h>
+#include <GLTFSDK/Document.h>
+#include <GLTFSDK/GLTFResourceReader.h>
+#include <GLTFSDK/Parallel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <unordered_map>
+
+using namespace Microsoft::glTF;
+using namespace Microsoft::glTF::SceneBounds;
+
+namespace
+{
+    const size_t InvalidNodeIndex = std::numeric_limits<size_t>::max();
+
+    float Length(const Vector3& v)
+    {
+        return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+    }
+
+    // The bounds of a positions accessor's values. The radius is the distance from the box's center to the farthest value,
+    // which is only computed for the positions of mesh primitives (not morph targets) when spheres are requested.
+    struct AccessorBounds
+    {
+        BoundingBox box;
+        float radius = -1.0f;
+    };
+
+    typedef std::unordered_map<std::string, AccessorBounds> AccessorBoundsMap;
+
+    bool HasUsableMinMax(const Accessor& accessor)
+    {
+        // The min and max of normalized accessors are in the unnormalized integer range
+        return accessor.min.size() == 3U && accessor.max.size() == 3U && !accessor.normalized;
+    }
+
+    void ScanPositions(const std::vector<float>& positions, AccessorBounds& bounds, bool computeRadius)
+    {
+        const size_t count = positions.size() / 3U;
+
+        float min[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+        float max[3] = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+
+        ConversionKernels::MinMaxFloat3(positions.data(), count, min, max);
+
+        bounds.box = BoundingBox(Vector3(min[0], min[1], min[2]), Vector3(max[0], max[1], max[2]));
+
+        if (computeRadius && !bounds.box.IsEmpty())
+        {
+            const Vector3 center((min[0] + max[0]) * 0.5f, (min[1] + max[1]) * 0.5f, (min[2] + max[2]) * 0.5f);
+
+            float radiusSquared = 0.0f;
+
+            for (size_t i = 0U; i < positions.size(); i += 3U)
+            {
+                const float x = positions[i] - center.x;
+                const float y = positions[i + 1U] - center.y;
+                const float z = positions[i + 2U] - center.z;
+
+                radiusSquared = std::max(radiusSquared, x * x + y * y + z * z);
+            }
+
+            bounds.radius = std::sqrt(radiusSquared);
+        }
+    }
+
+    // Computes the bounds of every positions accessor used by the meshes. Accessors are read on the calling thread, as
+    // stream readers aren't required to support concurrent reads, and then scanned in parallel.
+    AccessorBoundsMap ComputeAccessorBounds(const Document& doc, const GLTFResourceReader& reader, const std::vector<const Mesh*>& meshes, const BoundsOptions& options)
+    {
+        AccessorBoundsMap accessorBounds;
+
+        std::vector<std::string> scanIds;
+        std::vector<bool> scanRadii;
+        std::vector<std::vector<float>> scanPositions;
+
+        auto addAccessor = [&](const std::string& accessorId, bool computeRadius)
+        {
+            if (accessorId.empty() || !accessorBounds.emplace(accessorId, AccessorBounds()).second)
+            {
+                return;
+            }
+
+            const Accessor& accessor = doc.accessors.Get(accessorId);
+
+            if (accessor.type != TYPE_VEC3)
+            {
+                throw GLTFException("Invalid type for positions accessor " + accessor.id);
+            }
+
+            if (options.useAccessorMinMax && HasUsableMinMax(accessor) && !computeRadius)
+            {
+                accessorBounds[accessorId].box = BoundingBox(
+                    Vector3(accessor.min[0], accessor.min[1], accessor.min[2]),
+                    Vector3(accessor.max[0], accessor.max[1], accessor.max[2]));
+            }
+            else
+            {
+                scanIds.push_back(accessorId);
+                scanRadii.push_back(computeRadius);
+                scanPositions.push_back(reader.ReadFloatData(doc, accessor));
+            }
+        };
+
+        for (const Mesh* mesh : meshes)
+        {
+            for (const auto& meshPrimitive : mesh->primitives)
+            {
+                std::string positionsAccessorId;
+
+                if (!meshPrimitive.TryGetAttributeAccessorId(ACCESSOR_POSITION, positionsAccessorId))
+                {
+                    continue;
+                }
+
+                addAccessor(positionsAccessorId, options.computeSpheres);
+
+                for (const auto& target : meshPrimitive.targets)
+                {
+                    addAccessor(target.positionsAccessorId, false);
+                }
+            }
+        }
+
+        std::vector<AccessorBounds> scannedBounds(scanIds.size());
+
+        Parallel::For(scanIds.size(), options.threadCount, [&](size_t i)
+        {
+            ScanPositions(scanPositions[i], scannedBounds[i], scanRadii[i]);
+        });
+
+        for (size_t i = 0U; i < scanIds.size(); i++)
+        {
+            accessorBounds[scanIds[i]] = scannedBounds[i];
+        }
+
+        return accessorBounds;
+    }
+
+    Bounds GetMeshBounds(const Mesh& mesh, const AccessorBoundsMap& accessorBounds, bool computeSpheres)
+    {
+        Bounds meshBounds;
+
+        for (const auto& meshPrimitive : mesh.primitives)
+        {
+            std::string positionsAccessorId;
+
+            if (!meshPrimitive.TryGetAttributeAccessorId(ACCESSOR_POSITION, positionsAccessorId))
+            {
+                continue;
+            }
+
+            const auto& positionsBounds = accessorBounds.at(positionsAccessorId);
+
+            if (positionsBounds.box.IsEmpty())
+            {
+                continue;
+            }
+
+            // Each target displaces the vertices by at most its extents, in whichever direction its weight allows
+            Vector3 displacementMin = Vector3::ZERO;
+            Vector3 displacementMax = Vector3::ZERO;
+            float displacementRadius = 0.0f;
+
+            for (const auto& target : meshPrimitive.targets)
+            {
+                if (target.positionsAccessorId.empty())
+                {
+                    continue;
+                }
+
+                const auto& targetBox = accessorBounds.at(target.positionsAccessorId).box;
+
+                if (targetBox.IsEmpty())
+                {
+                    continue;
+                }
+
+                displacementMin.x += std::min(targetBox.min.x, 0.0f);
+                displacementMin.y += std::min(targetBox.min.y, 0.0f);
+                displacementMin.z += std::min(targetBox.min.z, 0.0f);
+                displacementMax.x += std::max(targetBox.max.x, 0.0f);
+                displacementMax.y += std::max(targetBox.max.y, 0.0f);
+                displacementMax.z += std::max(targetBox.max.z, 0.0f);
+
+                displacementRadius += Length(Vector3(
+                    std::max(std::abs(targetBox.min.x), std::abs(targetBox.max.x)),
+                    std::max(std::abs(targetBox.min.y), std::abs(targetBox.max.y)),
+                    std::max(std::abs(targetBox.min.z), std::abs(targetBox.max.z))));
+            }
+
+            const auto& box = positionsBounds.box;
+
+            meshBounds.box.Merge(BoundingBox(
+                Vector3(box.min.x + displacementMin.x, box.min.y + displacementMin.y, box.min.z + displacementMin.z),
+                Vector3(box.max.x + displacementMax.x, box.max.y + displacementMax.y, box.max.z + displacementMax.z)));
+
+            if (computeSpheres)
+            {
+                const Vector3 center((box.min.x + box.max.x) * 0.5f, (box.min.y + box.max.y) * 0.5f, (box.min.z + box.max.z) * 0.5f);
+
+                meshBounds.sphere.Merge(BoundingSphere(center, positionsBounds.radius + displacementRadius));
+            }
+        }
+
+        return meshBounds;
+    }
+
+    Bounds TransformBounds(const Bounds& bounds, const Matrix4& matrix)
+    {
+        return { bounds.box.Transform(matrix), bounds.sphere.Transform(matrix) };
+    }
+
+    void MergeBounds(Bounds& bounds, const Bounds& other)
+    {
+        bounds.box.Merge(other.box);
+        bounds.sphere.Merge(other.sphere);
+    }
+
+    std::vector<size_t> GetNodeIndices(const Document& doc, const std::vector<std::string>& nodeIds)
+    {
+        std::vector<size_t> nodeIndices;
+        nodeIndices.reserve(nodeIds.size());
+
+        for (const auto& nodeId : nodeIds)
+        {
+            nodeIndices.push_back(doc.nodes.GetIndex(nodeId));
+        }
+
+        return nodeIndices;
+    }
+
+    // The nodes without a parent, each of which is the root of a hierarchy that can be processed independently
+    std::vector<size_t> GetRootNodes(const Document& doc)
+    {
+        std::vector<size_t> parents(doc.nodes.Size(), InvalidNodeIndex);
+
+        for (size_t i = 0U; i < doc.nodes.Size(); i++)
+        {
+            for (size_t child : GetNodeIndices(doc, doc.nodes[i].children))
+            {
+                if (parents[child] != InvalidNodeIndex)
+                {
+                    throw GLTFException("Node " + doc.nodes[child].id + " has more than one parent");
+                }
+
+                parents[child] = i;
+            }
+        }
+
+        std::vector<size_t> roots;
+
+        for (size_t i = 0U; i < parents.size(); i++)
+        {
+            if (parents[i] == InvalidNodeIndex)
+            {
+                roots.push_back(i);
+            }
+        }
+
+        return roots;
+    }
+
+    // A hierarchy's nodes in depth-first order, so that each node comes before its descendants
+    std::vector<size_t> GetHierarchy(const Document& doc, size_t root)
+    {
+        std::vector<size_t> hierarchy;
+        std::vector<size_t> stack = { root };
+
+        while (!stack.empty())
+        {
+            const size_t node = stack.back();
+            stack.pop_back();
+
+            hierarchy.push_back(node);
+
+            const auto children = GetNodeIndices(doc, doc.nodes[node].children);
+            stack.insert(stack.end(), children.rbegin(), children.rend());
+        }
+
+        return hierarchy;
+    }
+
+    std::vector<std::vector<size_t>> GetHierarchies(const Document& doc, size_t threadCount)
+    {
+        const auto roots = GetRootNodes(doc);
+
+        std::vector<std::vector<size_t>> hierarchies(roots.size());
+
+        Parallel::For(roots.size(), threadCount, [&](size_t i)
+        {
+            hierarchies[i] = GetHierarchy(doc, roots[i]);
+        });
+
+        // Every node has at most one parent, so nodes that aren't in any hierarchy must form a cycle
+        const size_t nodeCount = std::accumulate(hierarchies.begin(), hierarchies.end(), size_t(0U), [](size_t count, const std::vector<size_t>& hierarchy)
+        {
+            return count + hierarchy.size();
+        });
+
+        if (nodeCount != doc.nodes.Size())
+        {
+            throw GLTFException("The node hierarchy contains a cycle");
+        }
+
+        return hierarchies;
+    }
+
+    std::vector<Matrix4> ComputeHierarchyTransforms(const Document& doc, const std::vector<std::vector<size_t>>& hierarchies, size_t threadCount)
+    {
+        std::vector<Matrix4> worldTransforms(doc.nodes.Size());
+
+        Parallel::For(hierarchies.size(), threadCount, [&](size_t i)
+        {
+            const auto& hierarchy = hierarchies[i];
+
+            worldTransforms[hierarchy.front()] = GetLocalTransform(doc.nodes[hierarchy.front()]);
+
+            for (size_t node : hierarchy)
+            {
+                for (size_t child : GetNodeIndices(doc, doc.nodes[node].children))
+                {
+                    worldTransforms[child] = Math::Multiply(worldTransforms[node], GetLocalTransform(doc.nodes[child]));
+                }
+            }
+        });
+
+        return worldTransforms;
+    }
+
+    std::vector<Matrix4> ReadInverseBindMatrices(const Document& doc, const GLTFResourceReader& reader, const Skin& skin)
+    {
+        std::vector<Matrix4> inverseBindMatrices(skin.jointIds.size());
+
+        if (!skin.inverseBindMatricesAccessorId.empty())
+        {
+            const auto values = AnimationUtils::GetInverseBindMatrices(doc, reader, skin);
+
+            if (values.size() < inverseBindMatrices.size() * 16U)
+            {
+                throw GLTFException("Skin " + skin.id + " has fewer inverse bind matrices than joints");
+            }
+
+            for (size_t i = 0U; i < inverseBindMatrices.size(); i++)
+            {
+                std::copy(values.begin() + i * 16U, values.begin() + (i + 1U) * 16U, inverseBindMatrices[i].values.begin());
+            }
+        }
+
+        return inverseBindMatrices;
+    }
+}
+
+BoundingBox::BoundingBox() :
+    min(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()),
+    max(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest())
+{
+}
+
+BoundingBox::BoundingBox(const Vector3& min, const Vector3& max) :
+    min(min),
+    max(max)
+{
+}
+
+bool BoundingBox::IsEmpty() const
+{
+    return min.x > max.x || min.y > max.y || min.z > max.z;
+}
+
+void BoundingBox::Merge(const Vector3& point)
+{
+    min = Vector3(std::min(min.x, point.x), std::min(min.y, point.y), std::min(min.z, point.z));
+    max = Vector3(std::max(max.x, point.x), std::max(max.y, point.y), std::max(max.z, point.z));
+}
+
+void BoundingBox::Merge(const BoundingBox& other)
+{
+    if (!other.IsEmpty())
+    {
+        Merge(other.min);
+        Merge(other.max);
+    }
+}
+
+BoundingBox BoundingBox::Transform(const Matrix4& matrix) const
+{
+    if (IsEmpty())
+    {
+        return BoundingBox();
+    }
+
+    // Transforms the center and then accumulates each axis' contribution to the extents (Arvo's method)
+    const Vector3 center((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f);
+    const float extents[3] = { (max.x - min.x) * 0.5f, (max.y - min.y) * 0.5f, (max.z - min.z) * 0.5f };
+
+    const Vector3 transformedCenter = Math::TransformPoint(matrix, center);
+    float transformedExtents[3] = {};
+
+    for (size_t row = 0U; row < 3U; row++)
+    {
+        for (size_t column = 0U; column < 3U; column++)
+        {
+            transformedExtents[row] += std::abs(matrix.values[column * 4U + row]) * extents[column];
+        }
+    }
+
+    return BoundingBox(
+        Vector3(transformedCenter.x - transformedExtents[0], transformedCenter.y - transformedExtents[1], transformedCenter.z - transformedExtents[2]),
+        Vector3(transformedCenter.x + transformedExtents[0], transformedCenter.y + transformedExtents[1], transformedCenter.z + transformedExtents[2]));
+}
+
+bool BoundingBox::operator==(const BoundingBox& other) const
+{
+    return std::tie(min, max) == std::tie(other.min, other.max);
+}
+
+bool BoundingBox::operator!=(const BoundingBox& other) const
+{
+    return !operator==(other);
+}
+
+BoundingSphere::BoundingSphere() :
+    radius(-1.0f)
+{
+}
+
+BoundingSphere::BoundingSphere(const Vector3& center, float radius) :
+    center(center),
+    radius(radius)
+{
+}
+
+bool BoundingSphere::IsEmpty() const
+{
+    return radius < 0.0f;
+}
+
+void BoundingSphere::Merge(const BoundingSphere& other)
+{
+    if (other.IsEmpty())
+    {
+        return;
+    }
+
+    if (IsEmpty())
+    {
+        *this = other;
+        return;
+    }
+
+    const Vector3 offset(other.center.x - center.x, other.center.y - center.y, other.center.z - center.z);
+    const float distance = Length(offset);
+
+    if (distance + other.radius <= radius)
+    {
+        return;
+    }
+
+    if (distance + radius <= other.radius)
+    {
+        *this = other;
+        return;
+    }
+
+    // The merged sphere touches the far side of each sphere, along the line between their centers
+    const float mergedRadius = (distance + radius + other.radius) * 0.5f;
+    const float t = (mergedRadius - radius) / distance;
+
+    center = Vector3(center.x + offset.x * t, center.y + offset.y * t, center.z + offset.z * t);
+    radius = mergedRadius;
+}
+
+BoundingSphere BoundingSphere::Transform(const Matrix4& matrix) const
+{
+    if (IsEmpty())
+    {
+        return BoundingSphere();
+    }
+
+    const auto& m = matrix.values;
+
+    const float scale = std::max(std::max(
+        Length(Vector3(m[0], m[1], m[2])),
+        Length(Vector3(m[4], m[5], m[6]))),
+        Length(Vector3(m[8], m[9], m[10])));
+
+    return BoundingSphere(Math::TransformPoint(matrix, center), radius * scale);
+}
+
+Matrix4 SceneBounds::GetLocalTransform(const Node& node)
+{
+    if (node.GetTransformationType() == TRANSFORMATION_MATRIX)
+    {
+        return node.matrix;
+    }
+
+    return Math::ToMatrix(node.translation, node.rotation, node.scale);
+}
+
+std::vector<Matrix4> SceneBounds::ComputeWorldTransforms(const Document& doc, size_t threadCount)
+{
+    return ComputeHierarchyTransforms(doc, GetHierarchies(doc, threadCount), threadCount);
+}
+
+Bounds SceneBounds::ComputeMeshBounds(const Document& doc, const GLTFResourceReader& reader, const Mesh& mesh, const BoundsOptions& options)
+{
+    return GetMeshBounds(mesh, ComputeAccessorBounds(doc, reader, { &mesh }, options), options.computeSpheres);
+}
+
+DocumentBounds SceneBounds::ComputeBounds(const Document& doc, const GLTFResourceReader& reader, const BoundsOptions& options)
+{
+    DocumentBounds documentBounds;
+
+    std::vector<const Mesh*> meshes;
+
+    for (const auto& mesh : doc.meshes.Elements())
+    {
+        meshes.push_back(&mesh);
+    }
+
+    const auto accessorBounds = ComputeAccessorBounds(doc, reader, meshes, options);
+
+    documentBounds.meshes.resize(meshes.size());
+
+    for (size_t i = 0U; i < meshes.size(); i++)
+    {
+        documentBounds.meshes[i] = GetMeshBounds(*meshes[i], accessorBounds, options.computeSpheres);
+    }
+
+    std::vector<std::vector<Matrix4>> inverseBindMatrices;
+
+    for (const auto& skin : doc.skins.Elements())
+    {
+        inverseBindMatrices.push_back(ReadInverseBindMatrices(doc, reader, skin));
+    }
+
+    // Skinned meshes depend on the world transforms of joints in any hierarchy, so every transform is computed first
+    const auto hierarchies = GetHierarchies(doc, options.threadCount);
+
+    documentBounds.worldTransforms = ComputeHierarchyTransforms(doc, hierarchies, options.threadCount);
+    documentBounds.nodes.resize(doc.nodes.Size());
+
+    Parallel::For(hierarchies.size(), options.threadCount, [&](size_t i)
+    {
+        const auto& hierarchy = hierarchies[i];
+
+        // Descendants are visited before their ancestors so that each node's bounds are complete before they're merged
+        for (auto it = hierarchy.rbegin(); it != hierarchy.rend(); ++it)
+        {
+            const Node& node = doc.nodes[*it];
+            Bounds& nodeBounds = documentBounds.nodes[*it];
+
+            if (!node.meshId.empty())
+            {
+                const Bounds& meshBounds = documentBounds.meshes[doc.meshes.GetIndex(node.meshId)];
+
+                if (!node.skinId.empty() && !doc.skins.Get(node.skinId).jointIds.empty())
+                {
+                    const size_t skinIndex = doc.skins.GetIndex(node.skinId);
+                    const auto joints = GetNodeIndices(doc, doc.skins[skinIndex].jointIds);
+
+                    for (size_t j = 0U; j < joints.size(); j++)
+                    {
+                        const Matrix4 jointMatrix = Math::Multiply(documentBounds.worldTransforms[joints[j]], inverseBindMatrices[skinIndex][j]);
+
+                        MergeBounds(nodeBounds, TransformBounds(meshBounds, jointMatrix));
+                    }
+                }
+                else
+                {
+                    MergeBounds(nodeBounds, TransformBounds(meshBounds, documentBounds.worldTransforms[*it]));
+                }
+            }
+
+            for (size_t child : GetNodeIndices(doc, node.children))
+            {
+                MergeBounds(nodeBounds, documentBounds.nodes[child]);
+            }
+        }
+    });
+
+    for (const auto& scene : doc.scenes.Elements())
+    {
+        Bounds sceneBounds;
+
+        for (size_t node : GetNodeIndices(doc, scene.nodes))
+        {
+            MergeBounds(sceneBounds, documentBounds.nodes[node]);
+        }
+
+        documentBounds.scenes.push_back(sceneBounds);
+    }
+
+    return documentBounds;
+}
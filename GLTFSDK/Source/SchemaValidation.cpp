@@ -3,6 +3,7 @@
 
 #include <GLTFSDK/SchemaValidation.h>
 #include <GLTFSDK/Exceptions.h>
+#include <GLTFSDK/Tracing.h>
 
 #include <unordered_map>
 
@@ -56,6 +57,8 @@ namespace
 
 void Microsoft::glTF::ValidateDocumentAgainstSchema(const rapidjson::Document& document, const std::string& schemaUri, std::unique_ptr<const ISchemaLocator> schemaLocator)
 {
+    GLTFSDK_TRACE_SPAN("ValidateDocumentAgainstSchema");
+
     if (!schemaLocator)
     {
         throw GLTFException("ISchemaLocator instance must not be null");
@@ -7,6 +7,7 @@
 #include <GLTFSDK/ExtensionHandlers.h>
 #include <GLTFSDK/GLTF.h>
 #include <GLTFSDK/RapidJsonUtils.h>
+#include <GLTFSDK/Tracing.h>
 
 using namespace Microsoft::glTF;
 
@@ -827,6 +828,8 @@ namespace
 
     rapidjson::Document CreateJsonDocument(const Document& gltfDocument, const ExtensionSerializer& extensionSerializer)
     {
+        GLTFSDK_TRACE_SPAN("Serialize::BuildJson");
+
         rapidjson::Document document(rapidjson::kObjectType);
 
         SerializeAsset(gltfDocument, document, extensionSerializer);
@@ -868,8 +871,12 @@ std::string Microsoft::glTF::Serialize(const Document& gltfDocument, SerializeFl
 
 std::string Microsoft::glTF::Serialize(const Document& gltfDocument, const ExtensionSerializer& extensionSerializer, SerializeFlags flags)
 {
+    GLTFSDK_TRACE_SPAN("Serialize");
+
     auto doc = CreateJsonDocument(gltfDocument, extensionSerializer);
 
+    GLTFSDK_TRACE_SPAN("Serialize::WriteJson");
+
     rapidjson::StringBuffer stringBuffer;
     if (HasFlag(flags, SerializeFlags::Pretty))
     {
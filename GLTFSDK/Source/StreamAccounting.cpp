@@ -0,0 +1,371 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/StreamAccounting.h>
+
+#include <iomanip>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    // Unbuffered stream buffer that forwards every operation to the decorated stream's buffer so each
+    // read, write and seek issued by the SDK is observed (and timed) individually
+    class AccountingStreamBuf : public std::streambuf
+    {
+    public:
+        AccountingStreamBuf(std::shared_ptr<std::ios> stream, StreamAccounting& accounting, StreamStats& stats) :
+            m_stream(std::move(stream)),
+            m_source(m_stream->rdbuf()),
+            m_accounting(accounting),
+            m_stats(stats)
+        {
+        }
+
+    protected:
+        int_type underflow() override
+        {
+            return Timed([this]() { return m_source->sgetc(); });
+        }
+
+        int_type uflow() override
+        {
+            const auto result = Timed([this]() { return m_source->sbumpc(); });
+
+            if (!traits_type::eq_int_type(result, traits_type::eof()))
+            {
+                RecordRead(1U);
+            }
+
+            return result;
+        }
+
+        std::streamsize xsgetn(char_type* s, std::streamsize count) override
+        {
+            const auto result = Timed([&]() { return m_source->sgetn(s, count); });
+
+            RecordRead(static_cast<size_t>(result));
+
+            return result;
+        }
+
+        std::streamsize showmanyc() override
+        {
+            return m_source->in_avail();
+        }
+
+        int_type pbackfail(int_type c) override
+        {
+            return traits_type::eq_int_type(c, traits_type::eof()) ? m_source->sungetc() : m_source->sputbackc(traits_type::to_char_type(c));
+        }
+
+        int_type overflow(int_type c) override
+        {
+            if (traits_type::eq_int_type(c, traits_type::eof()))
+            {
+                return traits_type::not_eof(c);
+            }
+
+            const auto result = Timed([&]() { return m_source->sputc(traits_type::to_char_type(c)); });
+
+            if (!traits_type::eq_int_type(result, traits_type::eof()))
+            {
+                RecordWrite(1U);
+            }
+
+            return result;
+        }
+
+        std::streamsize xsputn(const char_type* s, std::streamsize count) override
+        {
+            const auto result = Timed([&]() { return m_source->sputn(s, count); });
+
+            RecordWrite(static_cast<size_t>(result));
+
+            return result;
+        }
+
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+        {
+            const auto result = Timed([&]() { return m_source->pubseekoff(off, dir, which); });
+
+            // A zero offset relative to the current position is how tellg/tellp query the position - it doesn't move it
+            if (off != 0 || dir != std::ios_base::cur)
+            {
+                RecordSeek();
+            }
+
+            return result;
+        }
+
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+        {
+            const auto result = Timed([&]() { return m_source->pubseekpos(pos, which); });
+
+            RecordSeek();
+
+            return result;
+        }
+
+        int sync() override
+        {
+            return Timed([this]() { return m_source->pubsync(); });
+        }
+
+    private:
+        template<typename Fn>
+        auto Timed(Fn fn) -> decltype(fn())
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const auto result = fn();
+            m_elapsed += std::chrono::steady_clock::now() - start;
+
+            return result;
+        }
+
+        void RecordRead(size_t byteCount)
+        {
+            Record([byteCount](StreamStats& stats)
+            {
+                stats.reads++;
+                stats.bytesRead += byteCount;
+                stats.readSizeHistogram[StreamStats::GetReadSizeBucket(byteCount)]++;
+            });
+        }
+
+        void RecordWrite(size_t byteCount)
+        {
+            Record([byteCount](StreamStats& stats)
+            {
+                stats.writes++;
+                stats.bytesWritten += byteCount;
+            });
+        }
+
+        void RecordSeek()
+        {
+            Record([](StreamStats& stats) { stats.seeks++; });
+        }
+
+        template<typename Fn>
+        void Record(Fn fn)
+        {
+            const auto elapsed = m_elapsed;
+            m_elapsed = std::chrono::nanoseconds::zero();
+
+            m_accounting.Update(m_stats, [&](StreamStats& stats)
+            {
+                fn(stats);
+                stats.timeBlocked += elapsed;
+            });
+        }
+
+        const std::shared_ptr<std::ios> m_stream;
+        std::streambuf* const m_source;
+
+        StreamAccounting& m_accounting;
+        StreamStats& m_stats;
+
+        // Time spent in calls that haven't yet been recorded (e.g. peeks via underflow)
+        std::chrono::nanoseconds m_elapsed = std::chrono::nanoseconds::zero();
+    };
+
+    template<typename TBase>
+    class AccountingStream : public TBase
+    {
+    public:
+        AccountingStream(std::shared_ptr<std::ios> stream, std::shared_ptr<StreamAccounting> accounting, StreamStats& stats) :
+            TBase(nullptr),
+            m_accounting(std::move(accounting)),
+            m_buffer(stream, *m_accounting, stats)
+        {
+            this->rdbuf(&m_buffer);
+            this->setstate(stream->rdstate());
+        }
+
+    private:
+        const std::shared_ptr<StreamAccounting> m_accounting; // Keeps the StreamStats referenced by m_buffer alive
+        AccountingStreamBuf m_buffer;
+    };
+
+    template<typename TStream, typename Fn>
+    std::shared_ptr<TStream> OpenStream(const std::string& uri, const std::shared_ptr<StreamAccounting>& accounting, Fn fnOpen)
+    {
+        auto& stats = accounting->GetStatsEntry(uri);
+
+        const auto start = std::chrono::steady_clock::now();
+        auto stream = fnOpen();
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        accounting->Update(stats, [&](StreamStats& s)
+        {
+            s.opens++;
+            s.timeBlocked += elapsed;
+        });
+
+        if (!stream)
+        {
+            return nullptr;
+        }
+
+        return std::make_shared<AccountingStream<TStream>>(std::move(stream), accounting, stats);
+    }
+}
+
+size_t StreamStats::GetReadSizeBucket(size_t byteCount)
+{
+    size_t bucket = 0U;
+
+    while ((byteCount >>= 1) != 0U && bucket < (ReadSizeBucketCount - 1U))
+    {
+        bucket++;
+    }
+
+    return bucket;
+}
+
+StreamStats& StreamStats::operator+=(const StreamStats& other)
+{
+    opens += other.opens;
+    cacheLookups += other.cacheLookups;
+    reads += other.reads;
+    writes += other.writes;
+    seeks += other.seeks;
+    bytesRead += other.bytesRead;
+    bytesWritten += other.bytesWritten;
+
+    for (size_t i = 0U; i < ReadSizeBucketCount; i++)
+    {
+        readSizeHistogram[i] += other.readSizeHistogram[i];
+    }
+
+    timeBlocked += other.timeBlocked;
+
+    return *this;
+}
+
+StreamStats StreamAccounting::GetStats(const std::string& uri) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_stats.find(uri);
+
+    return it == m_stats.end() ? StreamStats() : it->second;
+}
+
+std::map<std::string, StreamStats> StreamAccounting::GetAllStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_stats;
+}
+
+StreamStats StreamAccounting::GetTotalStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    StreamStats total;
+
+    for (const auto& stats : m_stats)
+    {
+        total += stats.second;
+    }
+
+    return total;
+}
+
+void StreamAccounting::Reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Entries are reset rather than erased as open streams hold references to them
+    for (auto& stats : m_stats)
+    {
+        stats.second = StreamStats();
+    }
+}
+
+void StreamAccounting::WriteReport(std::ostream& stream) const
+{
+    const auto allStats = GetAllStats();
+
+    auto writeLine = [&stream](const std::string& uri, const StreamStats& stats)
+    {
+        stream << std::quoted(uri)
+            << " opens=" << stats.opens
+            << " lookups=" << stats.cacheLookups
+            << " reads=" << stats.reads
+            << " bytesRead=" << stats.bytesRead
+            << " writes=" << stats.writes
+            << " bytesWritten=" << stats.bytesWritten
+            << " seeks=" << stats.seeks
+            << " blockedMs=" << std::chrono::duration<double, std::milli>(stats.timeBlocked).count();
+
+        stream << " readSizes=[";
+
+        bool isFirst = true;
+
+        for (size_t i = 0U; i < StreamStats::ReadSizeBucketCount; i++)
+        {
+            if (stats.readSizeHistogram[i] > 0U)
+            {
+                stream << (isFirst ? "" : " ") << (size_t(1U) << i) << ":" << stats.readSizeHistogram[i];
+                isFirst = false;
+            }
+        }
+
+        stream << "]\n";
+    };
+
+    StreamStats total;
+
+    for (const auto& stats : allStats)
+    {
+        writeLine(stats.first, stats.second);
+        total += stats.second;
+    }
+
+    writeLine("<total>", total);
+}
+
+StreamStats& StreamAccounting::GetStatsEntry(const std::string& uri)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_stats[uri];
+}
+
+AccountingStreamReader::AccountingStreamReader(std::shared_ptr<const IStreamReader> streamReader, std::shared_ptr<StreamAccounting> accounting) :
+    m_streamReader(std::move(streamReader)),
+    m_accounting(std::move(accounting))
+{
+}
+
+std::shared_ptr<std::istream> AccountingStreamReader::GetInputStream(const std::string& uri) const
+{
+    return OpenStream<std::istream>(uri, m_accounting, [&]() { return m_streamReader->GetInputStream(uri); });
+}
+
+const std::shared_ptr<StreamAccounting>& AccountingStreamReader::GetAccounting() const
+{
+    return m_accounting;
+}
+
+AccountingStreamWriter::AccountingStreamWriter(std::shared_ptr<const IStreamWriter> streamWriter, std::shared_ptr<StreamAccounting> accounting) :
+    m_streamWriter(std::move(streamWriter)),
+    m_accounting(std::move(accounting))
+{
+}
+
+std::shared_ptr<std::ostream> AccountingStreamWriter::GetOutputStream(const std::string& uri) const
+{
+    return OpenStream<std::ostream>(uri, m_accounting, [&]() { return m_streamWriter->GetOutputStream(uri); });
+}
+
+const std::shared_ptr<StreamAccounting>& AccountingStreamWriter::GetAccounting() const
+{
+    return m_accounting;
+}
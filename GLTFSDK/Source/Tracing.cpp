@@ -0,0 +1,137 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <GLTFSDK/Tracing.h>
+
+#include <GLTFSDK/RapidJsonUtils.h>
+
+#include <rapidjson/ostreamwrapper.h>
+#include <rapidjson/writer.h>
+
+#include <atomic>
+
+using namespace Microsoft::glTF;
+
+namespace
+{
+    std::atomic<ITracer*> g_tracer(nullptr);
+}
+
+void Tracing::SetTracer(ITracer* tracer)
+{
+    g_tracer.store(tracer);
+}
+
+ITracer* Tracing::GetTracer()
+{
+    return g_tracer.load(std::memory_order_relaxed);
+}
+
+// The tracer is captured on construction so that a span is always ended on the tracer that began it
+Tracing::ScopedSpan::ScopedSpan(const char* name) : m_tracer(GetTracer()), m_name(name)
+{
+    if (m_tracer)
+    {
+        m_tracer->BeginSpan(m_name);
+    }
+}
+
+Tracing::ScopedSpan::~ScopedSpan()
+{
+    if (m_tracer)
+    {
+        m_tracer->EndSpan(m_name);
+    }
+}
+
+void Tracing::Count(const char* name, int64_t delta)
+{
+    if (auto tracer = GetTracer())
+    {
+        tracer->Count(name, delta);
+    }
+}
+
+ChromeTracer::ChromeTracer() : m_start(std::chrono::steady_clock::now())
+{
+}
+
+void ChromeTracer::BeginSpan(const char* name)
+{
+    AddEvent(name, 'B', 0);
+}
+
+void ChromeTracer::EndSpan(const char* name)
+{
+    AddEvent(name, 'E', 0);
+}
+
+void ChromeTracer::Count(const char* name, int64_t delta)
+{
+    AddEvent(name, 'C', delta);
+}
+
+void ChromeTracer::AddEvent(const char* name, char phase, int64_t value)
+{
+    const auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Thread ids are remapped to small sequential integers, which the trace viewers display more readably
+    auto itThread = m_threadIds.emplace(std::this_thread::get_id(), static_cast<uint32_t>(m_threadIds.size() + 1U)).first;
+
+    if (phase == 'C')
+    {
+        value = (m_counters[name] += value);
+    }
+
+    m_events.push_back({ name, phase, static_cast<int64_t>(timestamp), itThread->second, value });
+}
+
+void ChromeTracer::Write(std::ostream& stream) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    rapidjson::OStreamWrapper streamWrapper(stream);
+    rapidjson::Writer<rapidjson::OStreamWrapper> writer(streamWrapper);
+
+    writer.StartObject();
+    writer.Key("traceEvents");
+    writer.StartArray();
+
+    for (const auto& event : m_events)
+    {
+        writer.StartObject();
+
+        writer.Key("name");
+        writer.String(event.name);
+        writer.Key("cat");
+        writer.String("glTF");
+        writer.Key("ph");
+        writer.String(&event.phase, 1U);
+        writer.Key("ts");
+        writer.Int64(event.timestamp);
+        writer.Key("pid");
+        writer.Uint(1U);
+        writer.Key("tid");
+        writer.Uint(event.threadId);
+
+        if (event.phase == 'C')
+        {
+            writer.Key("args");
+            writer.StartObject();
+            writer.Key("value");
+            writer.Int64(event.value);
+            writer.EndObject();
+        }
+
+        writer.EndObject();
+    }
+
+    writer.EndArray();
+    writer.Key("displayTimeUnit");
+    writer.String("ms");
+    writer.EndObject();
+
+    writer.Flush();
+}